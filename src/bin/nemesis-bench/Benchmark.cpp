@@ -0,0 +1,1318 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ErrorSystem.hpp>
+#include <PluginDatabase.hpp>
+#include <GlobalSetup.hpp>
+#include <RootList.hpp>
+#include <GlobalObjectList.hpp>
+#include <PhysicalQuantities.hpp>
+#include <WorkPanelList.hpp>
+#include <GlobalDesktop.hpp>
+#include <ProjectList.hpp>
+#include <GraphicsSetupProfile.hpp>
+#include <ElementColorsList.hpp>
+#include <InserterList.hpp>
+#include <JobScheduler.hpp>
+#include <OptimizerSetupList.hpp>
+#include <MouseDriverSetup.hpp>
+#include <RecentFileList.hpp>
+#include <BatchJobList.hpp>
+#include <Project.hpp>
+#include <HistoryList.hpp>
+#include <HistoryNode.hpp>
+#include <StructureList.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <BondList.hpp>
+#include <ResidueList.hpp>
+#include <Residue.hpp>
+#include <Atom.hpp>
+#include <Bond.hpp>
+#include <PeriodicTable.hpp>
+#include <ASLMask.hpp>
+#include <TrajectoryList.hpp>
+#include <Trajectory.hpp>
+#include <XYZTrajSegment.hpp>
+#include <PDBQTTrajSegment.hpp>
+#include <TrajectoryAnalysis.hpp>
+#include <PropertyList.hpp>
+#include <DistanceProperty.hpp>
+#include <PropertyAtomList.hpp>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QThread>
+#include <QFile>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+
+#include "Benchmark.hpp"
+
+//------------------------------------------------------------------------------
+
+// water model, positions are relative to oxygen
+static const int    WaterZ[3] = { 8, 1, 1 };
+static const char*  WaterNames[3] = { "O", "H1", "H2" };
+static const double WaterPos[3][3] = { { 0.0000, 0.0000, 0.0000 },
+                                       { 0.9572, 0.0000, 0.0000 },
+                                       {-0.2400, 0.9266, 0.0000 } };
+static const double WaterSpacing = 3.1;
+
+// alanine-like residue, positions are relative to nitrogen
+static const int    ChainZ[5] = { 7, 6, 6, 8, 6 };
+static const char*  ChainNames[5] = { "N", "CA", "C", "O", "CB" };
+static const double ChainPos[5][3] = { { 0.00, 0.00, 0.00 },
+                                       { 1.45, 0.00, 0.00 },
+                                       { 2.50, 1.00, 0.00 },
+                                       { 2.50, 2.23, 0.00 },
+                                       { 1.45,-0.90, 1.20 } };
+static const double ChainStep = 3.6;    // distance between residues
+static const double ChainRowSpacing = 6.0;
+static const int    ChainRowLength = 20;
+static const int    ChainLayerRows = 10;
+
+// system sizes for the comparison of per-atom and bulk creation
+static const int    ScalingSizes[3] = { 10000, 100000, 1000000 };
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBenchmarkSystem::CBenchmarkSystem(void)
+{
+    BoxSize = 0.0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBenchmark::CBenchmark(void)
+{
+    FileCounter = 0;
+    NumOfFailures = 0;
+    SubsystemsReady = false;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CBenchmark::Init(int argc,char* argv[])
+{
+    // encode program options
+    int result = Options.ParseCmdLine(argc,argv);
+
+    // should we exit or was it error?
+    if( result != SO_CONTINUE ) return(result);
+
+    if( WorkDir.isValid() == false ){
+        ES_ERROR("unable to create working directory");
+        return(SO_USER_ERROR);
+    }
+
+    result = InitSubsystems();
+    SubsystemsReady = result == SO_CONTINUE;
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBenchmark::Run(void)
+{
+    try {
+        BenchAtomCreation();
+        if( Options.GetOptScaling() ){
+            BenchAtomCreationScaling();
+        }
+        BenchProjectSaveLoad(false);
+        BenchProjectSaveLoad(true);
+        BenchMaskSelection();
+        BenchBondPerception();
+        BenchSuperCell();
+        BenchTrajectoryLoading(false);
+        BenchTrajectoryLoading(true);
+        BenchSnapshotStepping();
+        BenchTrajectoryAnalysis();
+        BenchHistory();
+        BenchHistoryPacking();
+    } catch(std::exception& e) {
+        ES_ERROR_FROM_EXCEPTION("benchmark was terminated",e);
+        AddFailure("suite","",e.what());
+    }
+
+    if( WriteReport() == false ) return(false);
+    return(NumOfFailures == 0);
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::Finalize(void)
+{
+    if( SubsystemsReady ){
+        FinalizeSubsystems();
+    }
+
+    if( ErrorSystem.IsError() || Options.GetOptVerbose() ){
+        ErrorSystem.PrintErrors(stderr);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CBenchmark::InitSubsystems(void)
+{
+    PrintProgress("Global objects ....");
+    GlobalSetup = new CGlobalSetup();
+    GlobalSetup->Init();
+
+    RootList = new CRootList(NULL);
+    Projects = new CProjectList(RootList);
+    GlobalObjectList = new CGlobalObjectList(RootList);
+    GraphicsSetupProfile = new CGraphicsSetupProfile(GlobalObjectList);
+    WorkPanels = new CWorkPanelList(GlobalObjectList);
+    PhysicalQuantities = new CPhysicalQuantities(GlobalObjectList);
+    Inserters = new CInserterList(GlobalObjectList);
+    OptimizerSetups = new COptimizerSetupList(GlobalObjectList);
+    JobScheduler = new CJobScheduler(GlobalObjectList);
+    GlobalDesktop = new CGlobalDesktop(GlobalObjectList);
+    MouseDriverSetup = new CMouseDriverSetup(GlobalObjectList);
+    RecentFiles = new CRecentFileList(GlobalObjectList);
+    BatchJobs = new CBatchJobList(GlobalObjectList);
+
+    // register metaobjects
+    ProObjectRegisterMetaObject();
+    ProjectRegisterMetaObject();
+
+    PrintProgress("Loading Nemesis plugins ....");
+    PluginDatabase.SetPluginPath(GlobalSetup->GetPluginsLocation());
+    PluginDatabase.LoadPlugins(GlobalSetup->GetPluginsSetup());
+
+    // do we have any plugin loaded?
+    if( PluginDatabase.GetNumberOfLoadedModules() == 0 ){
+        ES_ERROR("no plugin modules are loaded");
+        return(SO_USER_ERROR);
+    }
+
+    PrintProgress("Physical quantities ....");
+    PhysicalQuantities->LoadConfig();
+
+    PrintProgress("Graphics setup ....");
+    GraphicsSetupProfile->InitAllSetupObjects();
+    GraphicsSetupProfile->LoadDefaultConfig();
+    ColorsList.LoadColors();
+
+    // the job scheduler is not started, thus trajectories are loaded
+    // in the main thread and the user setup is never saved
+
+    return(SO_CONTINUE);
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::FinalizeSubsystems(void)
+{
+    Projects->RemoveAllProjects();
+
+    // process all events in the loop
+    qApp->processEvents();
+
+    // destroy global objects ---------
+    delete RootList;
+    RootList = NULL;
+    Projects = NULL;
+    GlobalObjectList = NULL;
+    GraphicsSetupProfile = NULL;
+    WorkPanels = NULL;
+    PhysicalQuantities = NULL;
+    Inserters = NULL;
+    OptimizerSetups = NULL;
+    JobScheduler = NULL;
+    GlobalDesktop = NULL;
+    MouseDriverSetup = NULL;
+    RecentFiles = NULL;
+    BatchJobs = NULL;
+
+    // process all events in the loop
+    qApp->processEvents();
+
+    // close all plugins
+    PluginDatabase.UnloadPlugins();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBenchmark::BenchAtomCreation(void)
+{
+    PrintProgress("Atom creation ....");
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        CBenchmarkSystem data;
+        if( system == "water" ){
+            GetWaterBox(Options.GetOptWaters(),data);
+        } else {
+            GetChain(Options.GetOptResidues(),data);
+        }
+        int natoms = data.Atoms.count();
+
+        // per-atom and bulk creation of the same system
+        for(int k=0; k < 2; k++){
+            bool            bulk = k == 1;
+            QString         name = bulk ? "atom_creation_bulk" : "atom_creation";
+            QVector<double> times;
+
+            for(int i=0; i < Options.GetOptRepeats(); i++){
+                CProject* p_project = CreateProject();
+                if( p_project == NULL ){
+                    AddFailure(name,system,"unable to create project");
+                    return;
+                }
+
+                QElapsedTimer timer;
+                timer.start();
+                BuildSystem(p_project,data,bulk,false);
+                times.append(timer.nsecsElapsed()*1.0e-6);
+
+                DestroyProject(p_project);
+            }
+
+            AddResult(name,system,natoms,times);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchAtomCreationScaling(void)
+{
+    PrintProgress("Atom creation scaling ....");
+
+    for(int s=0; s < 3; s++){
+        CBenchmarkSystem system;
+        GetWaterBox((ScalingSizes[s] + 2) / 3,system);
+        int natoms = system.Atoms.count();
+
+        for(int k=0; k < 2; k++){
+            bool            bulk = k == 1;
+            QVector<double> times;
+
+            for(int i=0; i < Options.GetOptRepeats(); i++){
+                CProject* p_project = CreateProject();
+                if( p_project == NULL ){
+                    AddFailure("atom_creation_scaling","water","unable to create project");
+                    return;
+                }
+
+                QElapsedTimer timer;
+                timer.start();
+                BuildSystem(p_project,system,bulk,true);
+                times.append(timer.nsecsElapsed()*1.0e-6);
+
+                DestroyProject(p_project);
+            }
+
+            AddResult("atom_creation_scaling","water",natoms,times,
+                      bulk ? "bulk, with bonds" : "per-atom, with bonds");
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchProjectSaveLoad(bool binary)
+{
+    QString format = binary ? "binary" : "xml";
+    QString ext = binary ? ".npb" : ".npr";
+
+    PrintProgress(QString("Project save/load (%1) ....").arg(format));
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        QString save_name = "project_save_" + format;
+        QString load_name = "project_load_" + format;
+
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure(save_name,system,"unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,system);
+        p_str->GetBonds()->AddBonds(false,false);
+        int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QVector<double> save_times;
+        QVector<double> load_times;
+
+        for(int i=0; i < Options.GetOptRepeats(); i++){
+            QString name = GetWorkFileName(ext);
+
+            QElapsedTimer timer;
+            timer.start();
+            bool result = p_project->SaveProjectAs(name);
+            save_times.append(timer.nsecsElapsed()*1.0e-6);
+            if( result == false ){
+                AddFailure(save_name,system,"unable to save project");
+                break;
+            }
+
+            timer.start();
+            CProject* p_loaded = Projects->OpenProject(name);
+            load_times.append(timer.nsecsElapsed()*1.0e-6);
+            if( p_loaded == NULL ){
+                AddFailure(load_name,system,"unable to open project");
+                break;
+            }
+            DestroyProject(p_loaded);
+        }
+
+        DestroyProject(p_project);
+
+        if( load_times.count() == Options.GetOptRepeats() ){
+            AddResult(save_name,system,natoms,save_times);
+            AddResult(load_name,system,natoms,load_times);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchMaskSelection(void)
+{
+    PrintProgress("Mask selection ....");
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("mask_selection",system,"unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,system);
+        p_str->GetBonds()->AddBonds(false,false);
+        int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QStringList masks;
+        if( system == "water" ){
+            masks << "@O" << ":1-100" << ":WAT@H1,H2";
+        } else {
+            masks << "@CA" << ":1-100" << ":ALA@CA,CB";
+        }
+
+        foreach(QString mask,masks){
+            QVector<double> times;
+            bool            result = true;
+
+            for(int i=0; i < Options.GetOptRepeats(); i++){
+                CASLMask asl_mask(p_str);
+
+                QElapsedTimer timer;
+                timer.start();
+                result = asl_mask.SetMask(mask);
+                if( result ) asl_mask.GetSelectedAtoms();
+                times.append(timer.nsecsElapsed()*1.0e-6);
+
+                if( result == false ) break;
+            }
+
+            if( result ){
+                AddResult("mask_selection",system,natoms,times,mask);
+            } else {
+                AddFailure("mask_selection",system,QString("unable to set mask %1").arg(mask));
+            }
+        }
+
+        DestroyProject(p_project);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchBondPerception(void)
+{
+    PrintProgress("Bond perception ....");
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        QVector<double> times;
+        int             natoms = 0;
+        int             nbonds = 0;
+
+        for(int i=0; i < Options.GetOptRepeats(); i++){
+            CProject* p_project = CreateProject();
+            if( p_project == NULL ){
+                AddFailure("bond_perception",system,"unable to create project");
+                return;
+            }
+            CStructure* p_str = CreateSystem(p_project,system);
+
+            QElapsedTimer timer;
+            timer.start();
+            p_str->GetBonds()->AddBonds(false,false);
+            times.append(timer.nsecsElapsed()*1.0e-6);
+
+            natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+            nbonds = p_str->GetBonds()->GetNumberOfBonds();
+            DestroyProject(p_project);
+        }
+
+        AddResult("bond_perception",system,natoms,times,QString("%1 bonds").arg(nbonds));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchSuperCell(void)
+{
+    PrintProgress("Super cell ....");
+
+    // only the water box is periodic
+    QVector<double> times;
+    int             natoms = 0;
+
+    for(int i=0; i < Options.GetOptRepeats(); i++){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("supercell_build","water","unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,"water");
+        p_str->GetBonds()->AddBonds(false,false);
+        natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QElapsedTimer timer;
+        timer.start();
+        bool result = p_str->BuildSuperCellWH(2,2,2);
+        times.append(timer.nsecsElapsed()*1.0e-6);
+
+        DestroyProject(p_project);
+
+        if( result == false ){
+            AddFailure("supercell_build","water","unable to build super cell");
+            return;
+        }
+    }
+
+    AddResult("supercell_build","water",natoms,times,"2x2x2");
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchTrajectoryLoading(bool pdbqt)
+{
+    QString format = pdbqt ? "pdbqt" : "xyz";
+    QString name = "trajectory_load_" + format;
+
+    PrintProgress(QString("Trajectory loading (%1) ....").arg(format));
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure(name,system,"unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,system);
+        int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QVector<double> times;
+        bool            result = true;
+
+        for(int i=0; i < Options.GetOptRepeats(); i++){
+            // each measurement reads a new file, so the sidecar index is not reused
+            QString file_name = GetWorkFileName(pdbqt ? ".pdbqt" : ".xyz");
+            if( pdbqt ){
+                result = WritePDBQTTrajectory(p_str,file_name);
+            } else {
+                result = WriteXYZTrajectory(p_str,file_name);
+            }
+            if( result == false ){
+                AddFailure(name,system,"unable to write trajectory");
+                break;
+            }
+
+            CTrajectorySegment* p_seg = CreateTrajectory(p_str,file_name,pdbqt);
+
+            QElapsedTimer timer;
+            timer.start();
+            p_seg->LoadTrajectoryData();
+            times.append(timer.nsecsElapsed()*1.0e-6);
+
+            result = p_seg->GetNumberOfSnapshots() == Options.GetOptFrames();
+            p_seg->GetTrajectory()->RemoveFromBaseList();
+            if( result == false ){
+                AddFailure(name,system,"incorrect number of loaded snapshots");
+                break;
+            }
+        }
+
+        DestroyProject(p_project);
+
+        if( result ){
+            AddResult(name,system,natoms,times,QString("%1 frames").arg(Options.GetOptFrames()));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchSnapshotStepping(void)
+{
+    PrintProgress("Snapshot stepping ....");
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("snapshot_stepping",system,"unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,system);
+        int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QString file_name = GetWorkFileName(".xyz");
+        if( WriteXYZTrajectory(p_str,file_name) == false ){
+            AddFailure("snapshot_stepping",system,"unable to write trajectory");
+            DestroyProject(p_project);
+            continue;
+        }
+        CTrajectorySegment* p_seg = CreateTrajectory(p_str,file_name,false);
+        p_seg->LoadTrajectoryData();
+        CTrajectory* p_traj = p_seg->GetTrajectory();
+
+        QVector<double> times;
+        bool            result = true;
+
+        for(int i=0; i < Options.GetOptRepeats(); i++){
+            QElapsedTimer timer;
+            timer.start();
+            int nsnaps = 0;
+            if( p_traj->FirstSnapshot() ){
+                nsnaps++;
+                while( p_traj->NextSnapshot() ) nsnaps++;
+            }
+            times.append(timer.nsecsElapsed()*1.0e-6);
+
+            if( nsnaps != Options.GetOptFrames() ){
+                result = false;
+                break;
+            }
+        }
+
+        DestroyProject(p_project);
+
+        if( result ){
+            AddResult("snapshot_stepping",system,natoms,times,QString("%1 frames").arg(Options.GetOptFrames()));
+        } else {
+            AddFailure("snapshot_stepping",system,"incorrect number of visited snapshots");
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+// number of properties evaluated in the trajectory analysis benchmark
+#define BENCH_NUM_OF_PROPERTIES 20
+
+void CBenchmark::BenchTrajectoryAnalysis(void)
+{
+    PrintProgress("Trajectory analysis ....");
+
+    foreach(QString system,QStringList() << "water" << "chain"){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("trajectory_analysis",system,"unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,system);
+        int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        QString file_name = GetWorkFileName(".xyz");
+        if( WriteXYZTrajectory(p_str,file_name) == false ){
+            AddFailure("trajectory_analysis",system,"unable to write trajectory");
+            DestroyProject(p_project);
+            continue;
+        }
+        CTrajectorySegment* p_seg = CreateTrajectory(p_str,file_name,false);
+        p_seg->LoadTrajectoryData();
+        CTrajectory* p_traj = p_seg->GetTrajectory();
+
+        // distances between atoms spread over the structure
+        QList<CProperty*> properties;
+        QList<QObject*> atoms = p_str->GetAtoms()->children();
+        for(int i=0; i < BENCH_NUM_OF_PROPERTIES; i++){
+            CDistanceProperty* p_prop = dynamic_cast<CDistanceProperty*>(
+                        p_project->GetProperties()->CreateProperty(DistancePropertyID));
+            if( p_prop == NULL ) break;
+            int ia = ((qint64)i*atoms.count())/BENCH_NUM_OF_PROPERTIES;
+            int ib = (ia + atoms.count()/2) % atoms.count();
+            p_prop->GetPointA()->AddAtom(static_cast<CAtom*>(atoms[ia]));
+            p_prop->GetPointB()->AddAtom(static_cast<CAtom*>(atoms[ib]));
+            properties.append(p_prop);
+        }
+        if( properties.count() != BENCH_NUM_OF_PROPERTIES ){
+            AddFailure("trajectory_analysis",system,"unable to create properties");
+            DestroyProject(p_project);
+            continue;
+        }
+
+        QString detail = QString("%1 properties, %2 frames").arg(BENCH_NUM_OF_PROPERTIES).arg(Options.GetOptFrames());
+
+        // reference - stepping the live structure
+        QVector<double> times;
+        bool            result = true;
+        double          sum1 = 0.0;
+        for(int i=0; i < Options.GetOptRepeats(); i++){
+            QElapsedTimer timer;
+            timer.start();
+            int nsnaps = 0;
+            sum1 = 0.0;
+            if( p_traj->FirstSnapshot() ){
+                do {
+                    nsnaps++;
+                    foreach(CProperty* p_prop,properties){
+                        sum1 += p_prop->GetScalarValue();
+                    }
+                } while( p_traj->NextSnapshot() );
+            }
+            times.append(timer.nsecsElapsed()*1.0e-6);
+            if( nsnaps != Options.GetOptFrames() ){
+                result = false;
+                break;
+            }
+        }
+        if( result ){
+            AddResult("trajectory_analysis_stepping",system,natoms,times,detail);
+        } else {
+            AddFailure("trajectory_analysis_stepping",system,"incorrect number of visited snapshots");
+        }
+
+        // parallel evaluation without touching the structure
+        CTrajectoryAnalysis analysis(p_traj);
+        foreach(CProperty* p_prop,properties){
+            result &= analysis.AddProperty(p_prop);
+        }
+
+        times.clear();
+        double sum2 = 0.0;
+        for(int i=0; (i < Options.GetOptRepeats()) && result; i++){
+            QElapsedTimer timer;
+            timer.start();
+            result = analysis.EvaluateAll();
+            while( result && analysis.IsRunning() ){
+                QThread::msleep(1);
+            }
+            times.append(timer.nsecsElapsed()*1.0e-6);
+
+            result &= analysis.GetNumberOfEvaluatedRows() == Options.GetOptFrames();
+            sum2 = 0.0;
+            for(int p=0; p < properties.count(); p++){
+                QVector<double> values;
+                analysis.GetColumn(p,values);
+                foreach(double value,values) sum2 += value;
+            }
+        }
+
+        // both paths must give the same values
+        if( result && (fabs(sum1 - sum2) > 1.0e-6*(fabs(sum1) + 1.0)) ){
+            AddFailure("trajectory_analysis",system,"values differ from the snapshot stepping");
+        } else if( result ){
+            AddResult("trajectory_analysis",system,natoms,times,detail);
+        } else {
+            AddFailure("trajectory_analysis",system,"trajectory analysis failed");
+        }
+
+        analysis.RemoveAllProperties();
+        DestroyProject(p_project);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchHistory(void)
+{
+    PrintProgress("History undo/redo ....");
+
+    QVector<double> undo_bonds_times;
+    QVector<double> undo_cell_times;
+    QVector<double> redo_bonds_times;
+    QVector<double> redo_cell_times;
+    int             natoms = 0;
+
+    for(int i=0; i < Options.GetOptRepeats(); i++){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("history_undo","water","unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,"water");
+        natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        if( (p_str->GetBonds()->AddBondsWH() == false) || (p_str->BuildSuperCellWH(2,2,2) == false) ){
+            AddFailure("history_undo","water","unable to record changes");
+            DestroyProject(p_project);
+            return;
+        }
+
+        CHistoryList*   p_history = p_project->GetHistory();
+        QElapsedTimer   timer;
+        bool            result = true;
+
+        timer.start();
+        result &= p_history->Undo();
+        undo_cell_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        timer.start();
+        result &= p_history->Undo();
+        undo_bonds_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        timer.start();
+        result &= p_history->Redo();
+        redo_bonds_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        timer.start();
+        result &= p_history->Redo();
+        redo_cell_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        DestroyProject(p_project);
+
+        if( result == false ){
+            AddFailure("history_undo","water","unable to undo or redo changes");
+            return;
+        }
+    }
+
+    AddResult("history_undo","water",natoms,undo_cell_times,"build super cell");
+    AddResult("history_undo","water",natoms,undo_bonds_times,"add bonds");
+    AddResult("history_redo","water",natoms,redo_bonds_times,"add bonds");
+    AddResult("history_redo","water",natoms,redo_cell_times,"build super cell");
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::BenchHistoryPacking(void)
+{
+    PrintProgress("History pack/unpack ....");
+
+    QVector<double> undo_times;
+    QVector<double> redo_times;
+    int             natoms = 0;
+
+    for(int i=0; i < Options.GetOptRepeats(); i++){
+        CProject* p_project = CreateProject();
+        if( p_project == NULL ){
+            AddFailure("history_packed","water","unable to create project");
+            return;
+        }
+        CStructure* p_str = CreateSystem(p_project,"water");
+        natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+        // older changes are packed and spilled to disk, thus their items
+        // are restored by CHistoryItem::LoadData before undo/redo
+        CHistoryList* p_history = p_project->GetHistory();
+        p_history->SetMemoryBudget(0);
+
+        QStringList states;
+        bool        result = true;
+
+        states << GetStructureState(p_project);
+        result &= p_str->GetBonds()->AddBondsWH();
+        states << GetStructureState(p_project);
+        result &= p_str->BuildSuperCellWH(2,2,2);
+        states << GetStructureState(p_project);
+        result &= p_str->GetAtoms()->FreezeAllAtomsWH();
+        states << GetStructureState(p_project);
+
+        if( result == false ){
+            AddFailure("history_packed","water","unable to record changes");
+            DestroyProject(p_project);
+            return;
+        }
+
+        int npacked = 0;
+        foreach(QObject* p_qobj,p_history->children()){
+            CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(p_qobj);
+            if( (p_node != NULL) && p_node->IsPacked() ) npacked++;
+        }
+        if( npacked == 0 ){
+            AddFailure("history_packed","water","no change was packed");
+            DestroyProject(p_project);
+            return;
+        }
+
+        // each undo/redo must restore the recorded state
+        QElapsedTimer timer;
+        timer.start();
+        for(int k = states.count() - 2; (k >= 0) && result; k--){
+            result &= p_history->Undo();
+            result &= GetStructureState(p_project) == states[k];
+        }
+        undo_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        timer.start();
+        for(int k = 1; (k < states.count()) && result; k++){
+            result &= p_history->Redo();
+            result &= GetStructureState(p_project) == states[k];
+        }
+        redo_times.append(timer.nsecsElapsed()*1.0e-6);
+
+        DestroyProject(p_project);
+
+        if( result == false ){
+            AddFailure("history_packed","water","packed changes do not restore the recorded state");
+            return;
+        }
+    }
+
+    AddResult("history_packed_undo","water",natoms,undo_times,"freeze, super cell, bonds");
+    AddResult("history_packed_redo","water",natoms,redo_times,"bonds, super cell, freeze");
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CProject* CBenchmark::CreateProject(void)
+{
+    CExtUUID mp_uuid(NULL);
+    mp_uuid.LoadFromString("{BUILD_PROJECT:b64d16f0-b73f-4747-9a13-212ab9a15d38}");
+    CProject* p_project = Projects->NewProject(mp_uuid);
+    if( p_project == NULL ){
+        ES_ERROR("unable to create build project");
+    }
+    return(p_project);
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::DestroyProject(CProject* p_project)
+{
+    if( p_project == NULL ) return;
+    p_project->CloseProject();
+
+    // the project is deleted later
+    QCoreApplication::sendPostedEvents(NULL,QEvent::DeferredDelete);
+    qApp->processEvents();
+}
+
+//------------------------------------------------------------------------------
+
+CStructure* CBenchmark::CreateSystem(CProject* p_project,const QString& system)
+{
+    CBenchmarkSystem data;
+    if( system == "water" ){
+        GetWaterBox(Options.GetOptWaters(),data);
+    } else if( system == "chain" ){
+        GetChain(Options.GetOptResidues(),data);
+    } else {
+        INVALID_ARGUMENT("unsupported system");
+    }
+    return(BuildSystem(p_project,data,false,false));
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::GetWaterBox(int nwaters,CBenchmarkSystem& system)
+{
+    int nside = static_cast<int>(ceil(pow(nwaters,1.0/3.0)));
+
+    system.Name = "water box";
+    system.Atoms.resize(3*nwaters);
+    system.Bonds.resize(2*nwaters);
+    system.Residues.clear();
+    system.BoxSize = nside*WaterSpacing;
+
+    for(int i=0; i < nwaters; i++){
+        CPoint orig;
+        orig.x = (i % nside + 0.5)*WaterSpacing;
+        orig.y = ((i / nside) % nside + 0.5)*WaterSpacing;
+        orig.z = (i / (nside*nside) + 0.5)*WaterSpacing;
+
+        system.Residues.append("WAT");
+        for(int j=0; j < 3; j++){
+            CAtomData& atom_data = system.Atoms[3*i+j];
+            atom_data.Name = WaterNames[j];
+            atom_data.SerIndex = 3*i+j+1;
+            atom_data.LocIndex = j+1;
+            atom_data.Z = WaterZ[j];
+            atom_data.Pos = orig + CPoint(WaterPos[j][0],WaterPos[j][1],WaterPos[j][2]);
+            atom_data.Residue = i;
+        }
+        for(int j=0; j < 2; j++){
+            CBondData& bond_data = system.Bonds[2*i+j];
+            bond_data.A1 = 3*i;
+            bond_data.A2 = 3*i+j+1;
+            bond_data.Order = BO_SINGLE;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::GetChain(int nresidues,CBenchmarkSystem& system)
+{
+    system.Name = "chain";
+    system.Atoms.resize(5*nresidues);
+    system.Bonds.clear();
+    system.Residues.clear();
+    system.BoxSize = 0.0;
+
+    // the chain is folded into rows and layers to be compact
+    for(int i=0; i < nresidues; i++){
+        int row = i / ChainRowLength;
+        CPoint orig;
+        orig.x = (i % ChainRowLength)*ChainStep;
+        orig.y = (row % ChainLayerRows)*ChainRowSpacing;
+        orig.z = (row / ChainLayerRows)*ChainRowSpacing;
+
+        system.Residues.append("ALA");
+        for(int j=0; j < 5; j++){
+            CAtomData& atom_data = system.Atoms[5*i+j];
+            atom_data.Name = ChainNames[j];
+            atom_data.SerIndex = 5*i+j+1;
+            atom_data.LocIndex = j+1;
+            atom_data.Z = ChainZ[j];
+            atom_data.Pos = orig + CPoint(ChainPos[j][0],ChainPos[j][1],ChainPos[j][2]);
+            atom_data.Residue = i;
+        }
+
+        // N-CA, CA-C, C=O, CA-CB, and the peptide bond to the next residue
+        static const int bonds[4][3] = { {0,1,BO_SINGLE}, {1,2,BO_SINGLE}, {2,3,BO_DOUBLE}, {1,4,BO_SINGLE} };
+        for(int j=0; j < 4; j++){
+            CBondData bond_data;
+            bond_data.A1 = 5*i+bonds[j][0];
+            bond_data.A2 = 5*i+bonds[j][1];
+            bond_data.Order = static_cast<EBondOrder>(bonds[j][2]);
+            system.Bonds.append(bond_data);
+        }
+        if( i+1 < nresidues ){
+            CBondData bond_data;
+            bond_data.A1 = 5*i+2;
+            bond_data.A2 = 5*(i+1);
+            bond_data.Order = BO_SINGLE;
+            system.Bonds.append(bond_data);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+CStructure* CBenchmark::BuildSystem(CProject* p_project,const CBenchmarkSystem& system,
+                                    bool bulk,bool with_bonds)
+{
+    CStructure* p_str = p_project->GetStructures()->CreateStructure(system.Name);
+
+    p_str->BeginUpdate();
+
+    // residues are created first in both cases
+    QVector<CResidue*> residues(system.Residues.count());
+    for(int i=0; i < system.Residues.count(); i++){
+        residues[i] = p_str->GetResidues()->CreateResidue(system.Residues.at(i),"A",i+1);
+    }
+
+    if( bulk ){
+        QVector<CAtomData> atoms = system.Atoms;
+        for(int i=0; i < atoms.count(); i++){
+            if( atoms[i].Residue >= 0 ) atoms[i].Residue = residues.at(atoms[i].Residue)->GetIndex();
+        }
+        QVector<CAtom*> new_atoms;
+        p_str->CreateAtomsAndBonds(atoms,with_bonds ? system.Bonds : QVector<CBondData>(),new_atoms);
+    } else {
+        QVector<CAtom*> new_atoms(system.Atoms.count());
+        for(int i=0; i < system.Atoms.count(); i++){
+            const CAtomData& atom_data = system.Atoms.at(i);
+            CAtom* p_atom = p_str->GetAtoms()->CreateAtom(atom_data);
+            if( atom_data.Residue >= 0 ) residues.at(atom_data.Residue)->AddAtom(p_atom);
+            new_atoms[i] = p_atom;
+        }
+        if( with_bonds ){
+            foreach(CBondData bond_data,system.Bonds){
+                p_str->GetBonds()->CreateBond(new_atoms.at(bond_data.A1),new_atoms.at(bond_data.A2),
+                                              bond_data.Order);
+            }
+        }
+    }
+
+    p_str->EndUpdate();
+
+    if( system.BoxSize > 0.0 ){
+        double size = system.BoxSize;
+        p_str->SetBox(true,true,true,CPoint(size,size,size),CPoint(M_PI/2.0,M_PI/2.0,M_PI/2.0));
+    }
+
+    return(p_str);
+}
+
+//------------------------------------------------------------------------------
+
+CTrajectorySegment* CBenchmark::CreateTrajectory(CStructure* p_str,const QString& name,bool pdbqt)
+{
+    CProject* p_project = p_str->GetProject();
+
+    // build project does not have trajectories
+    CTrajectoryList* p_list = p_project->findChild<CTrajectoryList*>(QString(),Qt::FindDirectChildrenOnly);
+    if( p_list == NULL ){
+        p_list = new CTrajectoryList(p_project);
+    }
+
+    CTrajectory* p_traj = p_list->CreateTrajectory();
+    p_traj->SetStructure(p_str);
+
+    CTrajectorySegment* p_seg;
+    if( pdbqt ){
+        p_seg = new CPDBQTTrajSegment(p_traj);
+    } else {
+        p_seg = new CXYZTrajSegment(p_traj);
+    }
+    p_seg->SetFileName(name);
+    p_traj->RegisterSegment(p_seg);
+
+    return(p_seg);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBenchmark::WriteXYZTrajectory(CStructure* p_str,const QString& name)
+{
+    FILE* p_fout = fopen(name.toLocal8Bit().constData(),"w");
+    if( p_fout == NULL ){
+        ES_ERROR("unable to open trajectory file");
+        return(false);
+    }
+
+    int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+    for(int f=0; f < Options.GetOptFrames(); f++){
+        fprintf(p_fout,"%d\n",natoms);
+        fprintf(p_fout,"snapshot %d\n",f+1);
+        int i = 0;
+        foreach(QObject* p_qobj,p_str->GetAtoms()->children()){
+            CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+            CPoint pos = p_atom->GetPos();
+            QByteArray symbol = QString(PeriodicTable.GetSymbol(p_atom->GetZ())).toLatin1();
+            fprintf(p_fout,"%-2s %12.6f %12.6f %12.6f\n",symbol.constData(),
+                    pos.x + 0.01*sin(f+i),pos.y + 0.01*cos(f+i),pos.z + 0.01*sin(0.5*(f+i)));
+            i++;
+        }
+    }
+
+    bool result = ferror(p_fout) == 0;
+    fclose(p_fout);
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBenchmark::WritePDBQTTrajectory(CStructure* p_str,const QString& name)
+{
+    FILE* p_fout = fopen(name.toLocal8Bit().constData(),"w");
+    if( p_fout == NULL ){
+        ES_ERROR("unable to open trajectory file");
+        return(false);
+    }
+
+    for(int f=0; f < Options.GetOptFrames(); f++){
+        fprintf(p_fout,"MODEL %8d\n",f+1);
+        fprintf(p_fout,"REMARK VINA RESULT:    %6.1f      0.000      0.000\n",-10.0+0.01*f);
+        int i = 0;
+        foreach(QObject* p_qobj,p_str->GetAtoms()->children()){
+            CAtom*      p_atom = static_cast<CAtom*>(p_qobj);
+            CPoint      pos = p_atom->GetPos();
+            QByteArray  aname = p_atom->GetName().left(4).toLatin1();
+            QByteArray  rname("UNK");
+            int         rseq = 0;
+            if( p_atom->GetResidue() ){
+                rname = p_atom->GetResidue()->GetName().left(3).toLatin1();
+                rseq = p_atom->GetResidue()->GetSeqIndex() % 10000;
+            }
+            QByteArray symbol = QString(PeriodicTable.GetSymbol(p_atom->GetZ())).toLatin1();
+            fprintf(p_fout,"ATOM  %5d %-4s %3s A%4d    %8.3f%8.3f%8.3f  1.00  0.00    +0.000 %-2s\n",
+                    (i+1) % 100000,aname.constData(),rname.constData(),rseq,
+                    pos.x + 0.01*sin(f+i),pos.y + 0.01*cos(f+i),pos.z + 0.01*sin(0.5*(f+i)),
+                    symbol.constData());
+            i++;
+        }
+        fprintf(p_fout,"ENDMDL\n");
+    }
+
+    bool result = ferror(p_fout) == 0;
+    fclose(p_fout);
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+QString CBenchmark::GetStructureState(CProject* p_project)
+{
+    QStringList lines;
+
+    foreach(QObject* p_sqobj,p_project->GetStructures()->children()){
+        CStructure* p_str = static_cast<CStructure*>(p_sqobj);
+        lines << QString("S %1 %2 %3").arg(p_str->GetIndex()).arg(p_str->GetName())
+                 .arg(static_cast<int>(p_str->GetFlags()) & EPOF_SAVE_MASK);
+
+        foreach(QObject* p_qobj,p_str->GetResidues()->children()){
+            CResidue* p_res = static_cast<CResidue*>(p_qobj);
+            lines << QString("R %1 %2 %3 %4").arg(p_res->GetIndex()).arg(p_res->GetName())
+                     .arg(p_res->GetSeqIndex()).arg(p_res->GetNumberOfAtoms());
+        }
+
+        foreach(QObject* p_qobj,p_str->GetAtoms()->children()){
+            CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+            const CPoint& pos = p_atom->GetPos();
+            lines << QString("A %1 %2 %3 %4 %5 %6 %7 %8").arg(p_atom->GetIndex())
+                     .arg(p_atom->GetName()).arg(p_atom->GetZ())
+                     .arg(static_cast<int>(p_atom->GetFlags()) & EPOF_SAVE_MASK)
+                     .arg(p_atom->GetResidue() ? p_atom->GetResidue()->GetIndex() : -1)
+                     .arg(pos.x,0,'f',6).arg(pos.y,0,'f',6).arg(pos.z,0,'f',6);
+        }
+
+        foreach(QObject* p_qobj,p_str->GetBonds()->children()){
+            CBond* p_bond = static_cast<CBond*>(p_qobj);
+            lines << QString("B %1 %2 %3 %4").arg(p_bond->GetIndex())
+                     .arg(p_bond->GetFirstAtom()->GetIndex())
+                     .arg(p_bond->GetSecondAtom()->GetIndex())
+                     .arg(static_cast<int>(p_bond->GetBondOrder()));
+        }
+    }
+
+    lines.sort();
+    return(lines.join("\n"));
+}
+
+//------------------------------------------------------------------------------
+
+QString CBenchmark::GetWorkFileName(const QString& ext)
+{
+    FileCounter++;
+    return(WorkDir.path() + QString("/bench%1%2").arg(FileCounter).arg(ext));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBenchmark::AddResult(const QString& name,const QString& system,int natoms,
+                           const QVector<double>& times,const QString& detail)
+{
+    if( times.isEmpty() ) return;
+
+    QVector<double> sorted = times;
+    std::sort(sorted.begin(),sorted.end());
+
+    double sum = 0.0;
+    QJsonArray samples;
+    foreach(double time,times){
+        sum += time;
+        samples.append(time);
+    }
+
+    int    n = sorted.count();
+    double median = (n % 2 == 1) ? sorted[n/2] : 0.5*(sorted[n/2-1] + sorted[n/2]);
+
+    QJsonObject result;
+    result["name"] = name;
+    result["system"] = system;
+    if( detail.isEmpty() == false ){
+        result["detail"] = detail;
+    }
+    result["atoms"] = natoms;
+    result["repeats"] = n;
+    result["min_ms"] = sorted.first();
+    result["median_ms"] = median;
+    result["mean_ms"] = sum / n;
+    result["max_ms"] = sorted.last();
+    result["samples_ms"] = samples;
+    result["status"] = QString("ok");
+
+    Results.append(result);
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::AddFailure(const QString& name,const QString& system,const QString& reason)
+{
+    QJsonObject result;
+    result["name"] = name;
+    result["system"] = system;
+    result["status"] = QString("failed");
+    result["reason"] = reason;
+
+    Results.append(result);
+    NumOfFailures++;
+}
+
+//------------------------------------------------------------------------------
+
+bool CBenchmark::WriteReport(void)
+{
+    QJsonObject setup;
+    setup["waters"] = Options.GetOptWaters();
+    setup["residues"] = Options.GetOptResidues();
+    setup["frames"] = Options.GetOptFrames();
+    setup["repeats"] = Options.GetOptRepeats();
+
+    QJsonObject root;
+    root["program"] = QString("nemesis-bench");
+    root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["host"] = QSysInfo::machineHostName();
+    root["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    root["threads"] = QThread::idealThreadCount();
+    root["qt_version"] = QString(qVersion());
+    root["setup"] = setup;
+    root["results"] = Results;
+    root["failures"] = NumOfFailures;
+
+    QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if( Options.GetOptOutput() == "-" ){
+        fwrite(data.constData(),1,data.size(),stdout);
+        fflush(stdout);
+        return(true);
+    }
+
+    QFile file(QString(Options.GetOptOutput()));
+    if( file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false ){
+        ES_ERROR("unable to open output file");
+        return(false);
+    }
+    if( file.write(data) != data.size() ){
+        ES_ERROR("unable to write output file");
+        return(false);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CBenchmark::PrintProgress(const QString& name)
+{
+    if( Options.GetOptVerbose() == false ) return;
+    fprintf(stderr," >>> %s\n",name.toLocal8Bit().constData());
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
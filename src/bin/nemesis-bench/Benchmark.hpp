@@ -0,0 +1,163 @@
+#ifndef BenchmarkH
+#define BenchmarkH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <QString>
+#include <QVector>
+#include <QJsonArray>
+#include <QTemporaryDir>
+#include <QStringList>
+#include <AtomData.hpp>
+#include <BondData.hpp>
+#include "BenchmarkOptions.hpp"
+
+// -----------------------------------------------------------------------------
+
+class CProject;
+class CStructure;
+class CTrajectorySegment;
+
+// -----------------------------------------------------------------------------
+
+///  topology and coordinates of a synthesized test system
+
+class CBenchmarkSystem {
+public:
+    CBenchmarkSystem(void);
+
+// section of public data ------------------------------------------------------
+public:
+    QString             Name;
+    QVector<CAtomData>  Atoms;      // Residue is position in Residues
+    QVector<CBondData>  Bonds;      // A1 and A2 are positions in Atoms
+    QStringList         Residues;   // residue names
+    double              BoxSize;    // cubic box, zero for non-periodic systems
+};
+
+// -----------------------------------------------------------------------------
+
+///  headless benchmarks of core data paths
+/*! test systems are synthesized (water box, protein-like chain), each
+    operation is measured several times on a fresh copy of the system
+    and the results are reported in the JSON format
+*/
+
+class CBenchmark {
+public:
+// constructor and destructor --------------------------------------------------
+    CBenchmark(void);
+
+// main methods ----------------------------------------------------------------
+    /// init options and nemesis subsystems
+    int Init(int argc,char* argv[]);
+
+    /// run all benchmarks
+    bool Run(void);
+
+    /// finalize program
+    void Finalize(void);
+
+// section of private data -----------------------------------------------------
+private:
+    CBenchmarkOptions   Options;
+    QTemporaryDir       WorkDir;        // synthesized files
+    int                 FileCounter;
+    QJsonArray          Results;
+    int                 NumOfFailures;
+    bool                SubsystemsReady;
+
+    /// init nemesis subsystems without GUI
+    int  InitSubsystems(void);
+
+    /// destroy nemesis subsystems
+    void FinalizeSubsystems(void);
+
+// benchmarks ------------------------------------------------------------------
+    void BenchAtomCreation(void);
+    void BenchAtomCreationScaling(void);
+    void BenchProjectSaveLoad(bool binary);
+    void BenchMaskSelection(void);
+    void BenchBondPerception(void);
+    void BenchSuperCell(void);
+    void BenchTrajectoryLoading(bool pdbqt);
+    void BenchSnapshotStepping(void);
+    void BenchTrajectoryAnalysis(void);
+    void BenchHistory(void);
+    void BenchHistoryPacking(void);
+
+// test systems ----------------------------------------------------------------
+    /// create empty build project
+    CProject* CreateProject(void);
+
+    /// close the project and release its data
+    void DestroyProject(CProject* p_project);
+
+    /// synthesize periodic box of water molecules
+    void GetWaterBox(int nwaters,CBenchmarkSystem& system);
+
+    /// synthesize chain of residues with protein-like backbone
+    void GetChain(int nresidues,CBenchmarkSystem& system);
+
+    /// create structure of the system
+    /*! atoms are created one by one or by CStructure::CreateAtomsAndBonds,
+        bonds are created only if requested
+    */
+    CStructure* BuildSystem(CProject* p_project,const CBenchmarkSystem& system,
+                            bool bulk,bool with_bonds);
+
+    /// create structure of given system, water or chain, without bonds
+    CStructure* CreateSystem(CProject* p_project,const QString& system);
+
+    /// create trajectory of the structure with a single segment
+    /*! trajectory data are not loaded */
+    CTrajectorySegment* CreateTrajectory(CStructure* p_str,const QString& name,bool pdbqt);
+
+    /// write trajectory with slightly perturbed coordinates of the structure
+    bool WriteXYZTrajectory(CStructure* p_str,const QString& name);
+
+    /// write multi-model PDBQT file with slightly perturbed coordinates
+    bool WritePDBQTTrajectory(CStructure* p_str,const QString& name);
+
+    /// get textual state of all structures in the project
+    /*! objects are identified by their indexes, lines are sorted */
+    QString GetStructureState(CProject* p_project);
+
+    /// get unique name of a file in the working directory
+    QString GetWorkFileName(const QString& ext);
+
+// results ---------------------------------------------------------------------
+    /// record times of one operation in ms
+    void AddResult(const QString& name,const QString& system,int natoms,
+                   const QVector<double>& times,const QString& detail=QString());
+
+    /// record failed operation
+    void AddFailure(const QString& name,const QString& system,const QString& reason);
+
+    /// write JSON report
+    bool WriteReport(void);
+
+    /// print progress if requested
+    void PrintProgress(const QString& name);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,102 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include "BenchmarkOptions.hpp"
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBenchmarkOptions::CBenchmarkOptions(void)
+{
+    SetShowMiniUsage(true);
+    IsError = false;
+}
+
+//------------------------------------------------------------------------------
+
+int CBenchmarkOptions::CheckOptions(void)
+{
+    if( GetOptWaters() <= 0 ){
+        if( IsError == false ) fprintf(stderr,"\n");
+        fprintf(stderr,"%s: number of water molecules has to be greater than zero, but %d is specified\n",
+                (const char*)GetProgramName(),GetOptWaters());
+        IsError = true;
+    }
+
+    if( GetOptResidues() <= 0 ){
+        if( IsError == false ) fprintf(stderr,"\n");
+        fprintf(stderr,"%s: number of residues has to be greater than zero, but %d is specified\n",
+                (const char*)GetProgramName(),GetOptResidues());
+        IsError = true;
+    }
+
+    if( GetOptFrames() <= 0 ){
+        if( IsError == false ) fprintf(stderr,"\n");
+        fprintf(stderr,"%s: number of frames has to be greater than zero, but %d is specified\n",
+                (const char*)GetProgramName(),GetOptFrames());
+        IsError = true;
+    }
+
+    if( GetOptRepeats() <= 0 ){
+        if( IsError == false ) fprintf(stderr,"\n");
+        fprintf(stderr,"%s: number of repeats has to be greater than zero, but %d is specified\n",
+                (const char*)GetProgramName(),GetOptRepeats());
+        IsError = true;
+    }
+
+    if( IsError == true ) return(SO_OPTS_ERROR);
+    return(SO_CONTINUE);
+}
+
+//------------------------------------------------------------------------------
+
+int CBenchmarkOptions::FinalizeOptions(void)
+{
+    bool ret_opt = false;
+
+    if( GetOptHelp() == true ) {
+        PrintUsage();
+        ret_opt = true;
+    }
+
+    if( GetOptVersion() == true ) {
+        PrintVersion();
+        ret_opt = true;
+    }
+
+    if( ret_opt == true ) {
+        printf("\n");
+        return(SO_EXIT);
+    }
+
+    return(SO_CONTINUE);
+}
+
+//------------------------------------------------------------------------------
+
+int CBenchmarkOptions::CheckArguments(void)
+{
+    return(SO_CONTINUE);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,150 @@
+#ifndef BenchmarkOptionsH
+#define BenchmarkOptionsH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <SimpleOptions.hpp>
+
+//------------------------------------------------------------------------------
+
+class CBenchmarkOptions : public CSimpleOptions {
+public:
+    // constructor - tune option setup
+    CBenchmarkOptions(void);
+
+// program name and description -----------------------------------------------
+    CSO_PROG_NAME_BEGIN
+    "nemesis-bench"
+    CSO_PROG_NAME_END
+
+    CSO_PROG_DESC_BEGIN
+    "Times core data-path operations of NEMESIS on synthetic systems and reports results in the JSON format. "
+    "It does not need any display."
+    CSO_PROG_DESC_END
+
+// list of all options and arguments ------------------------------------------
+    CSO_LIST_BEGIN
+    // options ------------------------------
+    CSO_OPT(int,Waters)
+    CSO_OPT(int,Residues)
+    CSO_OPT(int,Frames)
+    CSO_OPT(int,Repeats)
+    CSO_OPT(CSmallString,Output)
+    CSO_OPT(bool,Scaling)
+    CSO_OPT(bool,Help)
+    CSO_OPT(bool,Version)
+    CSO_OPT(bool,Verbose)
+    CSO_LIST_END
+
+    CSO_MAP_BEGIN
+// description of options -----------------------------------------------------
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(int,                            /* option type */
+                Waters,                         /* option name */
+                3000,                           /* default value */
+                false,                          /* is option mandatory */
+                'w',                            /* short option name */
+                "waters",                       /* long option name */
+                "NUM",                          /* parametr name */
+                "number of water molecules in the water box")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(int,                            /* option type */
+                Residues,                       /* option name */
+                1000,                           /* default value */
+                false,                          /* is option mandatory */
+                'r',                            /* short option name */
+                "residues",                     /* long option name */
+                "NUM",                          /* parametr name */
+                "number of residues of the protein-like chain")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(int,                            /* option type */
+                Frames,                         /* option name */
+                100,                            /* default value */
+                false,                          /* is option mandatory */
+                'f',                            /* short option name */
+                "frames",                       /* long option name */
+                "NUM",                          /* parametr name */
+                "number of snapshots in synthesized trajectories")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(int,                            /* option type */
+                Repeats,                        /* option name */
+                5,                              /* default value */
+                false,                          /* is option mandatory */
+                'n',                            /* short option name */
+                "repeats",                      /* long option name */
+                "NUM",                          /* parametr name */
+                "number of measurements of each operation")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(CSmallString,                   /* option type */
+                Output,                         /* option name */
+                "-",                            /* default value */
+                false,                          /* is option mandatory */
+                'o',                            /* short option name */
+                "output",                       /* long option name */
+                "FILE",                         /* parametr name */
+                "name of JSON report, '-' means the standard output")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(bool,                           /* option type */
+                Scaling,                        /* option name */
+                false,                          /* default value */
+                false,                          /* is option mandatory */
+                's',                            /* short option name */
+                "scaling",                      /* long option name */
+                NULL,                           /* parametr name */
+                "compare per-atom and bulk creation of 10k, 100k, and 1M atoms")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(bool,                           /* option type */
+                Verbose,                        /* option name */
+                false,                          /* default value */
+                false,                          /* is option mandatory */
+                'v',                            /* short option name */
+                "verbose",                      /* long option name */
+                NULL,                           /* parametr name */
+                "print progress and errors to the standard error")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(bool,                           /* option type */
+                Version,                        /* option name */
+                false,                          /* default value */
+                false,                          /* is option mandatory */
+                '\0',                           /* short option name */
+                "version",                      /* long option name */
+                NULL,                           /* parametr name */
+                "output version information and exit")   /* option description */
+    //----------------------------------------------------------------------
+    CSO_MAP_OPT(bool,                           /* option type */
+                Help,                           /* option name */
+                false,                          /* default value */
+                false,                          /* is option mandatory */
+                'h',                            /* short option name */
+                "help",                         /* long option name */
+                NULL,                           /* parametr name */
+                "display this help and exit")   /* option description */
+    CSO_MAP_END
+
+// final operation with options ------------------------------------------------
+private:
+    virtual int CheckOptions(void);
+    virtual int FinalizeOptions(void);
+    virtual int CheckArguments(void);
+};
+
+//------------------------------------------------------------------------------
+
+#endif
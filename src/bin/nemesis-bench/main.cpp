@@ -0,0 +1,45 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <QApplication>
+#include <ErrorSystem.hpp>
+#include "Benchmark.hpp"
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    // no display is required, graphics objects are never rendered
+    if( qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") ){
+        qputenv("QT_QPA_PLATFORM","offscreen");
+    }
+
+    QApplication app(argc,argv);
+
+    CBenchmark object;
+
+    TRY_OBJECT(object)
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -66,8 +66,8 @@ bool COptimizer::InitializeJob(void)
 
     CHistoryNode* p_node = BeginChangeWH(EHCL_GEOMETRY,tr("optimization"));
     if( p_node == NULL ) return(false);
-        // record current molecule coordinates
-        CAtomListCoordinatesHI* p_history = new CAtomListCoordinatesHI(Structure);
+        // record current molecule coordinates, only moved atoms are kept at the end
+        CAtomListDeltaHI* p_history = new CAtomListDeltaHI(Structure,false,false);
         p_node->Register(p_history);
     EndChangeWH();
 
@@ -123,6 +123,7 @@ bool COptimizer::FinalizeJob(void)
 
     CProject* p_project = GetProject();
     p_project->GetHistory()->SetLockModeLevels(BackupLockLevels);
+    CAtomListDeltaHI::CompactLastChange(Structure);
 
     Structure->EndGeometryUpdate();
     QString text = GetStepDescription(true);
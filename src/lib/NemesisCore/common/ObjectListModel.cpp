@@ -0,0 +1,251 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <ObjectListModel.hpp>
+#include <ProObject.hpp>
+#include <QSet>
+
+// -----------------------------------------------------------------------------
+
+// maximum number of removed and inserted row blocks, the model is reset above
+#define MAX_ROW_BLOCKS 64
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CObjectListModel::CObjectListModel(CPluginObject* p_pluginobject,QObject* p_parent)
+    : CContainerModel(p_pluginobject,p_parent)
+{
+    RowOfIndexValid = false;
+}
+
+//------------------------------------------------------------------------------
+
+QObject* CObjectListModel::GetItem(const QModelIndex& index) const
+{
+    if( ! index.isValid() ) return(NULL);
+    CProObject* p_obj = static_cast<CProObject*>(index.internalPointer());
+    return(p_obj);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CObjectListModel::rowCount(const QModelIndex &parent) const
+{
+    if( parent.isValid() ) return(0);
+    return( Rows.count() );
+}
+
+//------------------------------------------------------------------------------
+
+QModelIndex CObjectListModel::index(int row, int column,
+                                    const QModelIndex &parent) const
+{
+    if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
+    if( parent.isValid() )  return( QModelIndex() );
+
+    QModelIndex index = createIndex(row, column, Rows[row]);
+
+    return(index);
+}
+
+//------------------------------------------------------------------------------
+
+QModelIndex CObjectListModel::parent(const QModelIndex &index) const
+{
+    // parent is always invalid
+    return( QModelIndex() );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CObjectListModel::ResetRows(const QObjectList& objects)
+{
+    beginResetModel();
+    Rows.resize(objects.count());
+    for(int i=0; i < objects.count(); i++){
+        Rows[i] = static_cast<CProObject*>(objects[i]);
+    }
+    RowOfIndex.clear();
+    RowOfIndexValid = false;
+    endResetModel();
+}
+
+//------------------------------------------------------------------------------
+
+void CObjectListModel::UpdateRows(const QObjectList& objects)
+{
+    // the same rows - only data are changed
+    bool same = objects.count() == Rows.count();
+    for(int i=0; same && (i < Rows.count()); i++){
+        same = static_cast<CProObject*>(objects[i]) == Rows[i];
+    }
+    if( same ){
+        EmitRowsChanged(0,columnCount(QModelIndex())-1);
+        return;
+    }
+
+    QSet<CProObject*> new_objs;
+    new_objs.reserve(objects.count());
+    foreach(QObject* p_qobj, objects){
+        new_objs.insert(static_cast<CProObject*>(p_qobj));
+    }
+
+    QSet<CProObject*> old_objs;
+    old_objs.reserve(Rows.count());
+    foreach(CProObject* p_obj, Rows){
+        old_objs.insert(p_obj);
+    }
+
+    // count removed blocks
+    int nblocks = 0;
+    bool removed = false;
+    foreach(CProObject* p_obj, Rows){
+        bool curr = new_objs.contains(p_obj) == false;
+        if( curr && (! removed) ) nblocks++;
+        removed = curr;
+    }
+
+    // kept rows must keep their order, count inserted blocks
+    int  kept = 0;
+    bool inserted = false;
+    foreach(QObject* p_qobj, objects){
+        CProObject* p_obj = static_cast<CProObject*>(p_qobj);
+        bool curr = old_objs.contains(p_obj) == false;
+        if( curr && (! inserted) ) nblocks++;
+        inserted = curr;
+        if( curr ) continue;
+        // find the next kept row
+        while( (kept < Rows.count()) && (new_objs.contains(Rows[kept]) == false) ) kept++;
+        if( (kept >= Rows.count()) || (Rows[kept] != p_obj) ){
+            // rows are reordered
+            ResetRows(objects);
+            return;
+        }
+        kept++;
+    }
+
+    if( nblocks > MAX_ROW_BLOCKS ){
+        ResetRows(objects);
+        return;
+    }
+
+    RowOfIndexValid = false;
+
+    // remove rows from the end
+    int i = Rows.count() - 1;
+    while( i >= 0 ){
+        if( new_objs.contains(Rows[i]) ){
+            i--;
+            continue;
+        }
+        int last = i;
+        while( (i >= 0) && (new_objs.contains(Rows[i]) == false) ) i--;
+        beginRemoveRows(QModelIndex(),i+1,last);
+        Rows.remove(i+1,last-i);
+        endRemoveRows();
+    }
+
+    // insert new rows
+    i = 0;
+    while( i < objects.count() ){
+        CProObject* p_obj = static_cast<CProObject*>(objects[i]);
+        if( old_objs.contains(p_obj) ){
+            i++;
+            continue;
+        }
+        int first = i;
+        while( (i < objects.count())
+               && (old_objs.contains(static_cast<CProObject*>(objects[i])) == false) ) i++;
+        beginInsertRows(QModelIndex(),first,i-1);
+        Rows.insert(first,i-first,NULL);
+        for(int j=first; j < i; j++){
+            Rows[j] = static_cast<CProObject*>(objects[j]);
+        }
+        endInsertRows();
+    }
+
+    // data of kept rows can be changed as well
+    EmitRowsChanged(0,columnCount(QModelIndex())-1);
+}
+
+//------------------------------------------------------------------------------
+
+void CObjectListModel::ClearRows(void)
+{
+    beginResetModel();
+    Rows.clear();
+    RowOfIndex.clear();
+    RowOfIndexValid = false;
+    endResetModel();
+}
+
+//------------------------------------------------------------------------------
+
+void CObjectListModel::EmitRowsChanged(int first_column,int last_column)
+{
+    if( Rows.count() == 0 ) return;
+    EmitRowsChanged(0,Rows.count()-1,first_column,last_column);
+}
+
+//------------------------------------------------------------------------------
+
+void CObjectListModel::EmitRowsChanged(int first_row,int last_row,int first_column,int last_column)
+{
+    if( (first_row < 0) || (last_row < first_row) ) return;
+    emit dataChanged(index(first_row,first_column,QModelIndex()),
+                     index(last_row,last_column,QModelIndex()));
+}
+
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CObjectListModel::GetRowOfObject(int object_index) const
+{
+    if( RowOfIndexValid == false ){
+        RowOfIndex.clear();
+        RowOfIndex.reserve(Rows.count());
+        for(int i=0; i < Rows.count(); i++){
+            RowOfIndex.insert(Rows[i]->GetIndex(),i);
+        }
+        RowOfIndexValid = true;
+    }
+    return( RowOfIndex.value(object_index,-1) );
+}
+
+//------------------------------------------------------------------------------
+
+CProObject* CObjectListModel::GetRowObject(int row) const
+{
+    if( (row < 0) || (row >= Rows.count()) ) return(NULL);
+    return(Rows[row]);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,89 @@
+#ifndef ObjectListModelH
+#define ObjectListModelH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <ContainerModel.hpp>
+#include <QVector>
+#include <QHash>
+
+// -----------------------------------------------------------------------------
+
+class CProObject;
+
+// -----------------------------------------------------------------------------
+
+///  base class of flat models of object lists
+/*! rows are cached in the order of list children, UpdateRows compares
+    the cache with the current children and emits rowsRemoved and rowsInserted
+    for changed parts and dataChanged for the rest,
+    the model is reset only if the order of rows is changed or the change
+    is too fragmented
+*/
+
+class NEMESIS_CORE_PACKAGE CObjectListModel : public CContainerModel {
+public:
+// constructors and destructors -----------------------------------------------
+    CObjectListModel(CPluginObject* p_pluginobject,QObject* p_parent);
+
+    /// return object item from model index
+    virtual QObject* GetItem(const QModelIndex& index) const;
+
+// item model methods ---------------------------------------------------------
+    int rowCount(const QModelIndex &parent) const;
+
+    QModelIndex index(int row, int column,
+                      const QModelIndex &parent) const;
+    QModelIndex parent(const QModelIndex &index) const;
+
+// section of protected data --------------------------------------------------
+protected:
+    /// set rows from the list children and reset the model
+    void ResetRows(const QObjectList& objects);
+
+    /// synchronize cached rows with the list children
+    void UpdateRows(const QObjectList& objects);
+
+    /// remove all rows
+    void ClearRows(void);
+
+    /// emit dataChanged for columns of all rows
+    void EmitRowsChanged(int first_column,int last_column);
+
+    /// emit dataChanged for columns of rows
+    void EmitRowsChanged(int first_row,int last_row,int first_column,int last_column);
+
+    /// get row of the object with given index or -1
+    int GetRowOfObject(int object_index) const;
+
+    /// get cached object of the row
+    CProObject* GetRowObject(int row) const;
+
+// section of private data ----------------------------------------------------
+private:
+    QVector<CProObject*>        Rows;
+    mutable QHash<int,int>      RowOfIndex;     // object index -> row, built on demand
+    mutable bool                RowOfIndexValid;
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
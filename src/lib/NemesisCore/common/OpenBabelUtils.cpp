@@ -32,6 +32,10 @@
 #include <ResidueList.hpp>
 #include <Residue.hpp>
 #include <PeriodicTable.hpp>
+#include <Project.hpp>
+#include <AtomData.hpp>
+#include <BondData.hpp>
+#include <QSet>
 
 #include <openbabel/mol.h>
 #include <openbabel/obconversion.h>
@@ -106,6 +110,39 @@ void COpenBabelUtils::Nemesis2OpenBabel(CStructure* p_mol,OpenBabel::OBMol& obmo
 //------------------------------------------------------------------------------
 //==============================================================================
 
+void COpenBabelUtils::PerceiveBondOrders(CStructure* p_mol,const QVector<CBond*>& bonds)
+{
+    if( p_mol == NULL ) {
+        INVALID_ARGUMENT("p_mol is NULL");
+    }
+    if( bonds.isEmpty() ) return;
+
+    OBMol obmol;
+    Nemesis2OpenBabel(p_mol,obmol,true);
+    obmol.PerceiveBondOrders();
+
+    QSet<CBond*> targets;
+    foreach(CBond* p_bond,bonds) {
+        targets.insert(p_bond);
+    }
+
+    // bonds are added in the order of valid bonds, see Nemesis2OpenBabel
+    int ob_id = 0;
+    foreach(QObject* p_qobj,p_mol->GetBonds()->children()) {
+        CBond*  p_bond = static_cast<CBond*>(p_qobj);
+        if( p_bond->IsInvalidBond() ) continue;
+        if( targets.contains(p_bond) ){
+            OBBond* p_obbond = obmol.GetBond(ob_id);
+            if( p_obbond != NULL ){
+                p_bond->SetBondOrder(OBToNemesisBondOrder(p_obbond->GetBondOrder()));
+            }
+        }
+        ob_id++;
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void COpenBabelUtils::Nemesis2OpenBabel(CResidue* p_res,OpenBabel::OBMol& obmol,
                                         bool add_as_conformer,bool add_connectors)
 {
@@ -211,6 +248,11 @@ void COpenBabelUtils::OpenBabel2Nemesis(OpenBabel::OBMol& obmol,CStructure* p_mo
 
     OBResidue* p_last_res = NULL;
 
+    QVector<CAtomData> atoms;
+    QVector<CBondData> bonds;
+    atoms.resize(obmol.NumAtoms());
+    bonds.resize(obmol.NumBonds());
+
     // go throught all atoms in babel mol
     int loc_index = 1;
     for( unsigned int i = 1; i <= obmol.NumAtoms(); i++) {
@@ -227,7 +269,7 @@ void COpenBabelUtils::OpenBabel2Nemesis(OpenBabel::OBMol& obmol,CStructure* p_mo
             loc_index = 1;
         }
 
-        CAtomData data;
+        CAtomData& data = atoms[i-1];
 
         QString name = "%1%2";
         name = name.arg(PeriodicTable.GetSymbol(p_obAtom->GetAtomicNum()));
@@ -238,25 +280,26 @@ void COpenBabelUtils::OpenBabel2Nemesis(OpenBabel::OBMol& obmol,CStructure* p_mo
         data.Pos = CPoint(p_obAtom->x(), p_obAtom->y(), p_obAtom->z());
         data.Charge = p_obAtom->GetPartialCharge();
         data.SerIndex = top_index+i;
-        loc_index++;
-
-        CAtom*  p_nemAtom = p_mol->GetAtoms()->CreateAtom(data,p_history);
-
         if( p_res != NULL ){
-            p_res->AddAtom(p_nemAtom,p_history);
+            // residue index is relative to the base object index
+            data.Residue = p_res->GetIndex() - p_mol->GetProject()->GetBaseObjectIndex();
         }
+        loc_index++;
     }
 
     // bonds ...
     for( unsigned int i = 0; i < obmol.NumBonds(); i++) {
         OBBond* obBond = obmol.GetBond(i);
-        // set new nemesis bond
-        EBondOrder order = COpenBabelUtils::OBToNemesisBondOrder(obBond->GetBondOrder());
-        p_mol->GetBonds()->CreateBond(
-            p_mol->GetAtoms()->SearchBySerIndex(top_index + obBond->GetBeginAtomIdx()),
-            p_mol->GetAtoms()->SearchBySerIndex(top_index + obBond->GetEndAtomIdx()),
-            order,p_history);
+        // set new nemesis bond, atoms are referenced by their positions
+        CBondData& data = bonds[i];
+        data.A1 = obBond->GetBeginAtomIdx() - 1;
+        data.A2 = obBond->GetEndAtomIdx() - 1;
+        data.Order = COpenBabelUtils::OBToNemesisBondOrder(obBond->GetBondOrder());
     }
+
+    // all atoms and bonds are created in one batch
+    QVector<CAtom*> new_atoms;
+    p_mol->CreateAtomsAndBonds(atoms,bonds,new_atoms,p_history);
 }
 
 //------------------------------------------------------------------------------
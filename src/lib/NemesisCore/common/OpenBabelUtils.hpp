@@ -25,6 +25,7 @@
 #include <NemesisCoreMainHeader.hpp>
 #include <openbabel/mol.h>
 #include <QByteArray>
+#include <QVector>
 #include <Bond.hpp>
 
 //------------------------------------------------------------------------------
@@ -46,6 +47,10 @@ public:
     static void Nemesis2OpenBabel(CResidue* p_res,OpenBabel::OBMol& obmol,
                                   bool add_as_conformer=false,bool add_connectors=false);
 
+    /// perceive bond orders of given bonds of the structure
+    /*! bond orders are set without history recording */
+    static void PerceiveBondOrders(CStructure* p_mol,const QVector<CBond*>& bonds);
+
     /// openbabel position to nemesis positions
     static void OpenBabelPos2NemesisPos(OpenBabel::OBMol& obmol,CStructure* p_mol);
 
@@ -33,6 +33,7 @@
 #include <CategoryUUID.hpp>
 #include <PluginObject.hpp>
 #include <GraphicsViewList.hpp>
+#include <PickingBVH.hpp>
 
 // -----------------------------------------------------------------------------
 
@@ -482,6 +483,13 @@ void  CGraphicsObject::Draw(void)
 
 //------------------------------------------------------------------------------
 
+void CGraphicsObject::GetPickPrimitives(QVector<CPickPrimitive>& prims)
+{
+    // nothing to be here
+}
+
+//------------------------------------------------------------------------------
+
 CGraphicsObjectList* CGraphicsObject::GetObjects(void)
 {
     return(dynamic_cast<CGraphicsObjectList*>(parent()));
@@ -27,6 +27,7 @@
 #include <ObjectManipulator.hpp>
 #include <GraphicsSetup.hpp>
 #include <ErrorSystem.hpp>
+#include <QVector>
 
 //------------------------------------------------------------------------------
 
@@ -36,6 +37,7 @@ class CGraphicsProfileList;
 class CGraphics;
 class CGraphicsProfileObject;
 class CGraphicsViewList;
+class CPickPrimitive;
 
 /// for private objects
 
@@ -171,6 +173,11 @@ public:
     /// draw object
     virtual void Draw(void);
 
+    /// append primitives used by CPU picking
+    /*! objects that do not provide primitives cannot be picked in views
+    */
+    virtual void GetPickPrimitives(QVector<CPickPrimitive>& prims);
+
 // local/global coordinate system ----------------------------------------------
     /// apply global view transformation matrix
     void ApplyGlobalViewTransformation(void);
@@ -33,6 +33,7 @@
 #include <GraphicsProfileObject.hpp>
 #include <HistoryNode.hpp>
 #include <GraphicsProfileHistory.hpp>
+#include <PickingBVH.hpp>
 #include <QtOpenGL>
 
 //==============================================================================
@@ -633,6 +634,20 @@ void CGraphicsProfile::SaveData(CXMLElement* p_ele)
     }
 }
 
+//------------------------------------------------------------------------------
+
+void CGraphicsProfile::GetPickPrimitives(QVector<CPickPrimitive>& prims)
+{
+    // the same objects as in Draw()
+    CGraphicsProfileObject* p_gpo = FirstObject;
+    while(p_gpo != NULL){
+        if( p_gpo->IsFlagSet(EPOF_VISIBLE) && p_gpo->GetObject()->IsFlagSet(EPOF_VISIBLE) ){
+            p_gpo->GetObject()->GetPickPrimitives(prims);
+        }
+        p_gpo = p_gpo->NextObject;
+    }
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -27,6 +27,7 @@
 #include <ProObject.hpp>
 #include <Point.hpp>
 #include <Manipulator.hpp>
+#include <QVector>
 
 //------------------------------------------------------------------------------
 
@@ -36,6 +37,7 @@ class CXMLElement;
 class CGraphicsProfileObject;
 class CGraphicsObject;
 class CGraphicsObjectList;
+class CPickPrimitive;
 
 // -----------------------------------------------------------------------------
 
@@ -137,6 +139,9 @@ public:
     /// draw profile objects
     void Draw(void);
 
+    /// collect pickable primitives of visible profile objects
+    void GetPickPrimitives(QVector<CPickPrimitive>& prims);
+
 // registered objects  ---------------------------------------------------------
     /// handle object removal from the profile list
     virtual void RemoveFromRegistered(CProObject* p_object,
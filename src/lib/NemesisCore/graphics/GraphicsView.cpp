@@ -70,6 +70,7 @@ CGraphicsView::CGraphicsView(CGraphicsViewList* p_owner,bool primary)
     SelAreaSize = 4;
     SelBuffSize = 50000;
     SelBuffer = new int[SelBuffSize];
+    PickingValid = false;
 
     FitSceneTimer = new QTimer;
     connect(FitSceneTimer,SIGNAL(timeout(void)),
@@ -741,6 +742,9 @@ void CGraphicsView::DrawGL(void)
 
     GetViews()->RegisterCurrentView(this);
 
+    // scene can be changed, update picking data on the next selection
+    PickingValid = false;
+
     try{
         // GL init
         float lmodel_ambient[] = { 0.0, 0.0, 0.0, 1.0 };
@@ -800,79 +804,122 @@ const CSelObject CGraphicsView::SelectObject(int mousex,int mousey)
 {
     if( DrawGLCanvas == NULL ) return(CSelObject());
 
-    // selection is disabled in stereo mode
-    if( StereoMode != ESM_OFF ){
-        GetProject()->TextNotification(ETNT_WARNING,"selection is disabled in the stereo mode",ETNT_WARNING_DELAY);
-        return(CSelObject());
-    }
+    CSelObject master(GetProfiles()->GetSelectionMasterObject(),SEL_MASTER_OBJ);
 
-    // this is problematic part ...
-    // NVIDIA - cause problems with swapBuffer(), wrong rendering
-    // Intel - cause later crashes
-    // see inside for workaround
-    DrawGLCanvas->ActivateGLContext();
+    if( (GetActiveProfile() == NULL) || GetProfiles()->GetDataManipulationMode() ){
+        return(master);
+    }
 
-    GetViews()->RegisterCurrentView(this);
+    // objects are picked by the ray casted from the camera through the mouse
+    // position, stereo modes use the monoscopic camera
+    CPoint orig,dir;
+    if( GetPickingRay(mousex,mousey,orig,dir) == false ) return(master);
 
     try{
-        // workaround - see GLGetMode();
-        LoadedObjects.Clear();
+        UpdatePicking();
+    } catch(...){
+        ES_ERROR("exception in CGraphicsView::UpdatePicking");
+        PickingBVH.Clear();
+        PickPrimitives.clear();
+        PickingValid = false;
+        return(master);
+    }
 
-//        // set selection buffer
-//        glSelectBuffer(SelBuffSize,SelBuffer);
+    double t;
+    int index = PickingBVH.Intersect(PickPrimitives,orig,dir,t);
+    if( index < 0 ) return(master);
+
+    return(PickPrimitives[index].Object);
+}
 
-//        LoadedObjects.RegisterMasterObject(GetProfiles()->GetSelectionMasterObject());
+//------------------------------------------------------------------------------
 
-//        // init DrawGLCanvas
-//        glDisable(GL_LIGHTING);
-//        glDisable(GL_COLOR_MATERIAL);
-//        glShadeModel(GL_SMOOTH);
+void CGraphicsView::UpdatePicking(void)
+{
+    if( PickingValid ) return;
 
-//        glRenderMode(GL_SELECT);
-//        glInitNames();
-//        glPushName((GLint)~0);
+    QVector<CPickPrimitive> prims;
+    prims.reserve(PickPrimitives.size());
 
-        // init camera
-        InitMonoSelection(mousex,mousey,4,4);
-        ManipDraw();
+    GetViews()->RegisterCurrentView(this);
+    GetActiveProfile()->GetPickPrimitives(prims);
+    GetViews()->RegisterCurrentView(NULL);
 
-    } catch(...){
-        ES_ERROR("exception in CGraphicsView::DrawGL");
+    // refit is sufficient if only positions were changed
+    bool same = prims.size() == PickPrimitives.size();
+    for(int i=0; same && (i < prims.size()); i++){
+        same = prims[i].Object == PickPrimitives[i].Object;
     }
 
-    GetViews()->RegisterCurrentView(NULL);
+    PickPrimitives = prims;
+    if( same && (PickingBVH.GetNumberOfPrimitives() == PickPrimitives.size()) ){
+        PickingBVH.Refit(PickPrimitives);
+    } else {
+        PickingBVH.Build(PickPrimitives);
+    }
 
-    // get object
-    int top_in_buffer = glRenderMode(GL_RENDER);
+    PickingValid = true;
+}
 
-    // this is problematic part ...
-    // see inside for workaround
-    DrawGLCanvas->DoneGLContext();
+//------------------------------------------------------------------------------
 
-    if( top_in_buffer < 1 ) {
-        CSelObject obj = LoadedObjects.FindObject(0);
-        LoadedObjects.Clear();
-        return(obj);    // return master object
-    }
+bool CGraphicsView::GetPickingRay(int x,int y,CPoint& orig,CPoint& dir)
+{
+    int width = DrawGLCanvas->width();
+    int height = DrawGLCanvas->height();
+    if( (width <= 0) || (height <= 0) ) return(false);
 
-    int object_id = -1;
-    int numofnames = SelBuffer[0];
-    unsigned int minz = SelBuffer[1];
-    object_id = SelBuffer[numofnames+2];
-
-    int pos = numofnames + 3;
-    for(int i=0; i<top_in_buffer-1; i++) {
-        numofnames = SelBuffer[pos];
-        if( minz > SelBuffer[pos+1] ) {
-            minz = SelBuffer[pos+1];
-            object_id = SelBuffer[numofnames+pos+2];
-        }
-        pos += numofnames + 3;
+    // the same frustum as in InitMono()
+    double aspect  = width / (double)height;
+    double radians = (M_PI / 180.0) * Fovy / 2.0;
+    double wd2     = Near * tan(radians);
+
+    double ex = (2.0*(x + 0.5)/width - 1.0) * aspect * wd2;
+    double ey = (1.0 - 2.0*(y + 0.5)/height) * wd2;
+
+    // ray in the eye frame
+    CPoint eorig,edir;
+    eorig.SetZero();
+    edir.SetZero();
+    switch(ProjectionMode){
+        case EPM_PERSPECTIVE:
+            edir = CPoint(ex,ey,-Near);
+            break;
+        case EPM_ORTHOGRAPHIC:
+            eorig = CPoint(ex,ey,0.0);
+            edir = CPoint(0.0,0.0,-1.0);
+            break;
     }
 
-    CSelObject obj = LoadedObjects.FindObject(object_id);
-    LoadedObjects.Clear();
-    return(obj);
+    // eye frame -> world frame (inverse of gluLookAt)
+    CPoint f = Reference - Position;
+    if( Size(f) == 0.0 ) return(false);
+    f.Normalize();
+    CPoint s = CrossDot(f,ViewUp);
+    if( Size(s) == 0.0 ) return(false);
+    s.Normalize();
+    CPoint u = CrossDot(s,f);
+
+    CPoint p1 = Position + s*eorig.x + u*eorig.y - f*eorig.z;
+    CPoint p2 = Position + s*(eorig.x+edir.x) + u*(eorig.y+edir.y) - f*(eorig.z+edir.z);
+
+    // world frame -> scene frame (inverse of ManipDraw)
+    double scale = GetScale();
+    if( scale == 0.0 ) return(false);
+
+    CTransformation trans = GetTrans();
+    trans.Invert();
+
+    p1 /= scale;
+    p2 /= scale;
+    p1 = trans.GetTransform(p1 - GetPos()) + GetCentrum();
+    p2 = trans.GetTransform(p2 - GetPos()) + GetCentrum();
+
+    orig = p1;
+    dir = p2 - p1;
+    if( Size(dir) == 0.0 ) return(false);
+
+    return(true);
 }
 
 //------------------------------------------------------------------------------
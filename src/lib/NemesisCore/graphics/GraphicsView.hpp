@@ -28,6 +28,7 @@
 #include <Manipulator.hpp>
 #include <GraphicsProfile.hpp>
 #include <GLSelection.hpp>
+#include <PickingBVH.hpp>
 #include <GraphicsViewManipulator.hpp>
 #include <SmallColor.hpp>
 #include <GraphicsViewStereo.hpp>
@@ -222,6 +223,11 @@ private:
     int     SelBuffSize;
     int* SelBuffer;
 
+    // picking data
+    QVector<CPickPrimitive> PickPrimitives;     // primitives of the active profile
+    CPickingBVH             PickingBVH;         // hierarchy over PickPrimitives
+    bool                    PickingValid;       // is hierarchy up-to-date?
+
     // fit scene data
     QTimer*             FitSceneTimer;
     int                 TickIntervals;
@@ -282,6 +288,13 @@ private:
     /// init monoscopic view for selection
     void InitMonoSelection(int x,int y,int w,int h);
 
+// picking ---------------------------------------
+    /// update picking hierarchy from the active profile
+    void UpdatePicking(void);
+
+    /// get picking ray in the scene coordinates for the mouse position
+    bool GetPickingRay(int x,int y,CPoint& orig,CPoint& dir);
+
 // raw scene painting by manipulator
 public:
     /// move scene
@@ -0,0 +1,584 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2011 Petr Kulhanek, kulhanek@chemi.muni.cz
+//    Copyright (C) 2008 Petr Kulhanek, kulhanek@enzim.hu,
+//                       Jakub Stepan, xstepan3@chemi.muni.cz
+//    Copyright (C) 1998-2004 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+
+#include <StandardModelBatch.hpp>
+#include <StandardModelSetup.hpp>
+#include <ErrorSystem.hpp>
+#include <StructureList.hpp>
+#include <Structure.hpp>
+#include <Residue.hpp>
+#include <Atom.hpp>
+#include <AtomList.hpp>
+#include <BondList.hpp>
+#include <PeriodicTable.hpp>
+#include <ElementColorsList.hpp>
+#include <GOColorMode.hpp>
+#include <GeometryChangeSet.hpp>
+
+//------------------------------------------------------------------------------
+
+// max number of lines of one bond
+#define MAX_BOND_LINES      3
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CModelSphere::CModelSphere(void)
+{
+    Radius = 0.0;
+    Color = NULL;
+    Object = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+CModelCylinder::CModelCylinder(void)
+{
+    Radius = 0.0;
+    Split = 0.5;
+    Color1 = NULL;
+    Color2 = NULL;
+    Object = NULL;
+    Selection = false;
+}
+
+//------------------------------------------------------------------------------
+
+CStandardModelBatchSetup::CStandardModelBatchSetup(void)
+{
+    Atoms = NULL;
+    Bonds = NULL;
+    ColorMode = NULL;
+    ShowHidden = false;
+    ShowHydrogens = true;
+    PBCBonds = false;
+    KA = 0;
+    KB = 0;
+    KC = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CStandardModelBatch::CStandardModelBatch(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStandardModelBatch::Build(const CStandardModelBatchSetup& setup,
+                                const QList<CProObject*>& objects)
+{
+    Clear();
+
+    if( (setup.Atoms == NULL) || (setup.Bonds == NULL) ){
+        INVALID_ARGUMENT("model settings are not set");
+    }
+    Setup = setup;
+
+    foreach(CProObject* p_object,objects) {
+        CStructureList* p_strlist;
+        CStructure*     p_str;
+        CResidue*       p_res;
+        CAtom*          p_atom;
+        CBond*          p_bond;
+
+        KOffset.SetZero();
+        if( (p_strlist = dynamic_cast<CStructureList*>(p_object)) != NULL ){
+            AddStructureList(p_strlist);
+        }
+        if( (p_str = dynamic_cast<CStructure*>(p_object)) != NULL ){
+            SetPBCOffset(p_str);
+            AddStructure(p_str);
+        }
+        if( (p_res = dynamic_cast<CResidue*>(p_object)) != NULL ){
+            SetPBCOffset(p_res->GetStructure());
+            AddResidue(p_res);
+        }
+        if( (p_atom = dynamic_cast<CAtom*>(p_object)) != NULL ){
+            SetPBCOffset(p_atom->GetStructure());
+            AddAtom(p_atom);
+        }
+        if( (p_bond = dynamic_cast<CBond*>(p_object)) != NULL ){
+            SetPBCOffset(p_bond->GetStructure());
+            AddBond(p_bond);
+        }
+    }
+
+    Spheres.squeeze();
+    Cylinders.squeeze();
+    Picks.squeeze();
+    AtomRecords.squeeze();
+    BondRecords.squeeze();
+}
+
+//------------------------------------------------------------------------------
+
+bool CStandardModelBatch::UpdatePositions(const CGeometryChangeSet& changes)
+{
+    CStructure* p_last = NULL;
+    bool        changed = false;
+
+    for(int i=0; i < AtomRecords.count(); i++){
+        CAtomRecord& rec = AtomRecords[i];
+        CStructure* p_str = rec.Atom->GetStructure();
+        if( p_str != p_last ){
+            changed = changes.IsChanged(p_str);
+            p_last = p_str;
+        }
+        if( changed ) SetAtomGeometry(rec);
+    }
+
+    for(int i=0; i < BondRecords.count(); i++){
+        CBondRecord& rec = BondRecords[i];
+        CStructure* p_str = rec.Bond->GetStructure();
+        if( p_str != p_last ){
+            changed = changes.IsChanged(p_str);
+            p_last = p_str;
+        }
+        if( changed ){
+            if( SetBondGeometry(rec,false) == false ) return(false);
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CStandardModelBatch::Clear(void)
+{
+    Spheres.clear();
+    Cylinders.clear();
+    Picks.clear();
+    AtomRecords.clear();
+    BondRecords.clear();
+    Structures.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+const QVector<CModelSphere>& CStandardModelBatch::GetSpheres(void) const
+{
+    return(Spheres);
+}
+
+//------------------------------------------------------------------------------
+
+const QVector<CModelCylinder>& CStandardModelBatch::GetCylinders(void) const
+{
+    return(Cylinders);
+}
+
+//------------------------------------------------------------------------------
+
+const QVector<CPickPrimitive>& CStandardModelBatch::GetPickPrimitives(void) const
+{
+    return(Picks);
+}
+
+//------------------------------------------------------------------------------
+
+const QList<CStructure*>& CStandardModelBatch::GetStructures(void) const
+{
+    return(Structures);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CStandardModelBatch::GetMemoryUsage(void) const
+{
+    return( (qint64)Spheres.capacity()*sizeof(CModelSphere)
+          + (qint64)Cylinders.capacity()*sizeof(CModelCylinder)
+          + (qint64)Picks.capacity()*sizeof(CPickPrimitive)
+          + (qint64)AtomRecords.capacity()*sizeof(CAtomRecord)
+          + (qint64)BondRecords.capacity()*sizeof(CBondRecord) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStandardModelBatch::SetPBCOffset(CStructure* p_str)
+{
+    if( p_str == NULL ) return;
+
+    if( p_str->PBCInfo.IsPeriodicAlongA() ) {
+        KOffset += p_str->PBCInfo.GetAVector()*Setup.KA;
+    }
+    if( p_str->PBCInfo.IsPeriodicAlongB() ) {
+        KOffset += p_str->PBCInfo.GetBVector()*Setup.KB;
+    }
+    if( p_str->PBCInfo.IsPeriodicAlongC() ) {
+        KOffset += p_str->PBCInfo.GetCVector()*Setup.KC;
+    }
+
+    if( Structures.contains(p_str) == false ) Structures.append(p_str);
+}
+
+//------------------------------------------------------------------------------
+
+const CElementColors* CStandardModelBatch::GetColor(CAtom* p_atom)
+{
+    if( Setup.ColorMode != NULL ) return(Setup.ColorMode->GetElementColor(p_atom));
+    return(ColorsList.GetElementColorPointer(p_atom->GetZ()));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStandardModelBatch::AddStructureList(CStructureList* p_sl)
+{
+    if( (Setup.ShowHidden == false) && (p_sl->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+
+    foreach(QObject* p_qobj,p_sl->children()) {
+        CStructure* p_str = static_cast<CStructure*>(p_qobj);
+        KOffset.SetZero();
+        SetPBCOffset(p_str);
+        AddStructure(p_str);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CStandardModelBatch::AddStructure(CStructure* p_str)
+{
+    if( (Setup.ShowHidden == false) && (p_str->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+
+    int natoms = p_str->GetAtoms()->children().count();
+    int nbonds = p_str->GetBonds()->children().count();
+    AtomRecords.reserve(AtomRecords.count() + natoms);
+    Spheres.reserve(Spheres.count() + natoms);
+    BondRecords.reserve(BondRecords.count() + nbonds);
+    Cylinders.reserve(Cylinders.count() + nbonds);
+
+    foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
+        AddAtom(static_cast<CAtom*>(p_qobj));
+    }
+
+    foreach(QObject* p_qobj,p_str->GetBonds()->children()) {
+        AddBond(static_cast<CBond*>(p_qobj));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CStandardModelBatch::AddResidue(CResidue* p_res)
+{
+    if( (Setup.ShowHidden == false) && (p_res->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+
+    foreach(CAtom* p_atom,p_res->GetAtoms()) {
+        AddAtom(p_atom);
+    }
+
+    foreach(CBond* p_bond, p_res->GetBonds(true)){
+        AddBond(p_bond);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CStandardModelBatch::AddAtom(CAtom* p_atom)
+{
+    if( (Setup.ShowHidden == false) && (p_atom->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+
+    if( p_atom->GetResidue() ){
+        if( (Setup.ShowHidden == false) &&
+            (p_atom->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+    }
+
+    int Z = p_atom->GetZ();
+
+    if( PeriodicTable.IsVirtual(Z) ){
+        if( Setup.ShowHydrogens == false ) return;
+    }
+
+    bool selected = p_atom->IsFlagSet(EPOF_SELECTED);
+    if( p_atom->GetStructure() != NULL ) {
+        selected |= p_atom->GetStructure()->IsFlagSet(EPOF_SELECTED);
+    }
+    if( p_atom->GetResidue() != NULL ) {
+        selected |= p_atom->GetResidue()->IsFlagSet(EPOF_SELECTED);
+    }
+
+    float radius;
+    if( Setup.Atoms->Radius != 0 ) {
+        radius = Setup.Atoms->Radius;
+    } else {
+        radius = PeriodicTable.GetVdWRadius(Z);
+        radius *= Setup.Atoms->Ratio;
+    }
+
+    CAtomRecord rec;
+    rec.Atom = p_atom;
+    rec.Offset = KOffset;
+    rec.FirstSphere = Spheres.count();
+    rec.NumOfSpheres = 0;
+    rec.Pick = -1;
+
+    // points are not drawn
+    if( Setup.Atoms->Type != 0 ){
+        CModelSphere sphere;
+        sphere.Radius = radius;
+        sphere.Color = GetColor(p_atom);
+        sphere.Object = p_atom;
+        Spheres.append(sphere);
+        rec.NumOfSpheres++;
+    }
+
+    if( selected ){
+        CModelSphere sphere;
+        sphere.Radius = radius + 0.1;
+        sphere.Color = &ColorsList.SelectionMaterial;
+        sphere.Object = p_atom;
+        Spheres.append(sphere);
+        rec.NumOfSpheres++;
+    }
+
+    // only visible spheres can be picked
+    if( rec.NumOfSpheres > 0 ){
+        rec.Pick = Picks.count();
+        Picks.append(CPickPrimitive(p_atom,CPoint(),selected ? radius + 0.1 : radius));
+    }
+
+    SetAtomGeometry(rec);
+    AtomRecords.append(rec);
+}
+
+//------------------------------------------------------------------------------
+
+void CStandardModelBatch::AddBond(CBond* p_bond)
+{
+    if( Setup.Bonds->Radius == 0 ) return;
+
+    if( p_bond->IsInvalidBond() ) return;
+
+    CAtom* p_atom1 = p_bond->GetFirstAtom();
+    CAtom* p_atom2 = p_bond->GetSecondAtom();
+
+    if( Setup.ShowHidden == false ){
+        if( p_bond->IsFlagSet(EPOF_VISIBLE) == false ) return;
+        if( p_atom1->GetResidue() && (p_atom1->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false)
+            && p_atom2->GetResidue() && (p_atom2->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+    }
+    if( (p_atom1->IsFlagSet(EPOF_VISIBLE) == false) && (p_atom2->IsFlagSet(EPOF_VISIBLE) == false) ) return;
+
+    int Z1 = p_atom1->GetZ();
+    int Z2 = p_atom2->GetZ();
+
+    if( PeriodicTable.IsVirtual(Z1) || PeriodicTable.IsVirtual(Z2) ){
+        if( Setup.ShowHydrogens == false ) return;
+    }
+
+    bool selected = p_bond->IsFlagSet(EPOF_SELECTED);
+    if( p_bond->GetStructure() != NULL ) {
+        selected |= p_bond->GetStructure()->IsFlagSet(EPOF_SELECTED);
+    }
+    selected |= p_bond->IsSelectedByResidues();
+
+    float VdW1 = PeriodicTable.GetVdWRadius(Z1);
+    float VdW2 = PeriodicTable.GetVdWRadius(Z2);
+
+    CBondRecord rec;
+    rec.Bond = p_bond;
+    rec.Offset = KOffset;
+    rec.Split = VdW1 / (VdW1 + VdW2);
+    rec.Selected = selected;
+    rec.Color1 = GetColor(p_atom1);
+    rec.Color2 = GetColor(p_atom2);
+    rec.FirstCylinder = Cylinders.count();
+    rec.NumOfCylinders = 0;
+    rec.FirstPick = Picks.count();
+    rec.NumOfPicks = 0;
+
+    SetBondGeometry(rec,true);
+    BondRecords.append(rec);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStandardModelBatch::SetAtomGeometry(CAtomRecord& rec)
+{
+    CSimplePoint<float> pos = rec.Atom->GetPos() + rec.Offset;
+
+    for(int i=rec.FirstSphere; i < rec.FirstSphere + rec.NumOfSpheres; i++){
+        Spheres[i].Center = pos;
+    }
+
+    if( rec.Pick >= 0 ){
+        Picks[rec.Pick].Pos1 = pos;
+        Picks[rec.Pick].Pos2 = pos;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+bool CStandardModelBatch::SetBondGeometry(CBondRecord& rec,bool append)
+{
+    CBond*              p_bond = rec.Bond;
+    CSimplePoint<float> pos1 = p_bond->GetFirstAtom()->GetPos() + rec.Offset;
+    CSimplePoint<float> pos2 = p_bond->GetSecondAtom()->GetPos() + rec.Offset;
+
+    // bond segments, bonds crossing the box are drawn twice
+    CSimplePoint<float> seg1[2];
+    CSimplePoint<float> seg2[2];
+    int                 nsegs = 1;
+
+    seg1[0] = pos1;
+    seg2[0] = pos2;
+
+    if( Setup.PBCBonds ){
+        CStructure* p_str = p_bond->GetStructure();
+        if( Size(pos1-pos2) > p_str->PBCInfo.GetLargestSphereRadius() ){
+            CPoint diff = p_str->PBCInfo.ImageVector(pos1-pos2);
+            seg1[0] = pos2 + diff;
+            seg2[0] = pos2;
+            seg1[1] = pos1;
+            seg2[1] = pos1 - diff;
+            nsegs = 2;
+        }
+    }
+
+    // lines of bond order
+    EBondOrder  order = p_bond->GetBondOrder();
+    float       offsets[MAX_BOND_LINES];
+    int         nlines = 0;
+
+    // only lines and tubes are drawn, see CStandardModelObject::DrawCylinder
+    if( (Setup.Bonds->Type == 0) || (Setup.Bonds->Type == 1) ){
+        nlines = GetOrderOffsets(order,offsets);
+    }
+
+    CSimplePoint<float> ordervect;
+    if( order > BO_SINGLE ){
+        ordervect = p_bond->GetMainVector();
+        ordervect *= Setup.Bonds->Pitch;
+    }
+
+    int ncyls = nsegs*(nlines + (rec.Selected ? 1 : 0));
+    if( append == false ){
+        // the number of periodic images was changed
+        if( (ncyls != rec.NumOfCylinders) || (nsegs != rec.NumOfPicks) ) return(false);
+    }
+
+    int icyl = rec.FirstCylinder;
+    for(int s=0; s < nsegs; s++){
+        for(int l=0; l < nlines; l++){
+            CSimplePoint<float> p1 = seg1[s] + ordervect*offsets[l];
+            CSimplePoint<float> p2 = seg2[s] + ordervect*offsets[l];
+            if( append ){
+                CModelCylinder cyl;
+                cyl.Pos1 = p1;
+                cyl.Pos2 = p2;
+                cyl.Radius = Setup.Bonds->Radius;
+                cyl.Split = rec.Split;
+                cyl.Color1 = rec.Color1;
+                cyl.Color2 = rec.Color2;
+                cyl.Object = p_bond;
+                Cylinders.append(cyl);
+            } else {
+                Cylinders[icyl].Pos1 = p1;
+                Cylinders[icyl].Pos2 = p2;
+            }
+            icyl++;
+        }
+        if( rec.Selected ){
+            if( append ){
+                CModelCylinder cyl;
+                cyl.Pos1 = seg1[s];
+                cyl.Pos2 = seg2[s];
+                cyl.Radius = Setup.Bonds->Radius + 0.05;
+                cyl.Color1 = &ColorsList.SelectionMaterial;
+                cyl.Color2 = &ColorsList.SelectionMaterial;
+                cyl.Object = p_bond;
+                cyl.Selection = true;
+                Cylinders.append(cyl);
+            } else {
+                Cylinders[icyl].Pos1 = seg1[s];
+                Cylinders[icyl].Pos2 = seg2[s];
+            }
+            icyl++;
+        }
+
+        // picking capsule
+        if( append ){
+            float radius = Setup.Bonds->Radius;
+            if( rec.Selected ) radius += 0.05;
+            Picks.append(CPickPrimitive(p_bond,seg1[s],seg2[s],radius));
+        } else {
+            Picks[rec.FirstPick + s].Pos1 = seg1[s];
+            Picks[rec.FirstPick + s].Pos2 = seg2[s];
+        }
+    }
+
+    if( append ){
+        rec.NumOfCylinders = ncyls;
+        rec.NumOfPicks = nsegs;
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int CStandardModelBatch::GetOrderOffsets(EBondOrder order,float* p_offsets)
+{
+    if( Setup.Bonds->ShowOrder == false ){
+        p_offsets[0] = 0.0;
+        return(1);
+    }
+
+    switch(order) {
+        case BO_SINGLE:
+            p_offsets[0] = 0.0;
+            return(1);
+
+        case BO_SINGLE_H:
+        case BO_DOUBLE:
+            p_offsets[0] = 0.5;
+            p_offsets[1] = -0.5;
+            return(2);
+
+        case BO_DOUBLE_H:
+        case BO_TRIPLE:
+            p_offsets[0] = 0.0;
+            p_offsets[1] = 1.0;
+            p_offsets[2] = -1.0;
+            return(3);
+
+        case BO_NONE:
+        case BO_WEAK:
+        default:
+            return(0);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
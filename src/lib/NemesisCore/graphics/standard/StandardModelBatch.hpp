@@ -0,0 +1,197 @@
+#ifndef StandardModelBatchH
+#define StandardModelBatchH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2011 Petr Kulhanek, kulhanek@chemi.muni.cz
+//    Copyright (C) 2008 Petr Kulhanek, kulhanek@enzim.hu,
+//                       Jakub Stepan, xstepan3@chemi.muni.cz
+//    Copyright (C) 1998-2004 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Point.hpp>
+#include <Bond.hpp>
+#include <PickingBVH.hpp>
+#include <QVector>
+#include <QList>
+
+// -----------------------------------------------------------------------------
+
+class CProObject;
+class CStructureList;
+class CStructure;
+class CResidue;
+class CAtom;
+class CElementColors;
+class CGOColorMode;
+class CAtomModelSettings;
+class CBondModelSettings;
+class CGeometryChangeSet;
+
+// -----------------------------------------------------------------------------
+
+/// sphere instance of the standard model
+
+class NEMESIS_CORE_PACKAGE CModelSphere {
+public:
+    CModelSphere(void);
+
+// section of public data ------------------------------------------------------
+public:
+    CSimplePoint<float>     Center;
+    float                   Radius;
+    const CElementColors*   Color;
+    CProObject*             Object;     // pick id
+};
+
+// -----------------------------------------------------------------------------
+
+/// cylinder instance of the standard model
+
+class NEMESIS_CORE_PACKAGE CModelCylinder {
+public:
+    CModelCylinder(void);
+
+// section of public data ------------------------------------------------------
+public:
+    CSimplePoint<float>     Pos1;
+    CSimplePoint<float>     Pos2;
+    float                   Radius;
+    float                   Split;      // relative position of color change
+    const CElementColors*   Color1;
+    const CElementColors*   Color2;
+    CProObject*             Object;     // pick id
+    bool                    Selection;  // selection envelope, always drawn as tube
+};
+
+// -----------------------------------------------------------------------------
+
+/// parameters of standard model batch
+
+class NEMESIS_CORE_PACKAGE CStandardModelBatchSetup {
+public:
+    CStandardModelBatchSetup(void);
+
+// section of public data ------------------------------------------------------
+public:
+    CAtomModelSettings*     Atoms;
+    CBondModelSettings*     Bonds;
+    CGOColorMode*           ColorMode;  // element colors are used if NULL
+    bool                    ShowHidden;
+    bool                    ShowHydrogens;
+    bool                    PBCBonds;
+    int                     KA;
+    int                     KB;
+    int                     KC;
+};
+
+// -----------------------------------------------------------------------------
+
+///  packed render data of the standard model
+/*! visibility, colors and radii are evaluated only by Build, UpdatePositions
+    changes only coordinates of instances and pick primitives, the batch
+    does not use OpenGL, it must be rebuilt if topology, flags or colors
+    are changed
+*/
+
+class NEMESIS_CORE_PACKAGE CStandardModelBatch {
+public:
+// constructor -----------------------------------------------------------------
+    CStandardModelBatch(void);
+
+// executive methods -----------------------------------------------------------
+    /// build instances for objects of the graphics object
+    void Build(const CStandardModelBatchSetup& setup,const QList<CProObject*>& objects);
+
+    /// update coordinates of atoms from changed structures
+    /*! it returns false if the batch must be rebuilt
+        (e.g. the number of periodic images of a bond was changed)
+    */
+    bool UpdatePositions(const CGeometryChangeSet& changes);
+
+    /// destroy all instances
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get sphere instances
+    const QVector<CModelSphere>& GetSpheres(void) const;
+
+    /// get cylinder instances
+    const QVector<CModelCylinder>& GetCylinders(void) const;
+
+    /// get pick primitives
+    const QVector<CPickPrimitive>& GetPickPrimitives(void) const;
+
+    /// get structures used by the batch
+    const QList<CStructure*>& GetStructures(void) const;
+
+    /// get memory occupied by the batch in bytes
+    qint64 GetMemoryUsage(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    class CAtomRecord {
+    public:
+        CAtom*                  Atom;
+        CPoint                  Offset;
+        int                     FirstSphere;
+        int                     NumOfSpheres;
+        int                     Pick;
+    };
+
+    class CBondRecord {
+    public:
+        CBond*                  Bond;
+        CPoint                  Offset;
+        float                   Split;
+        bool                    Selected;
+        const CElementColors*   Color1;
+        const CElementColors*   Color2;
+        int                     FirstCylinder;
+        int                     NumOfCylinders;
+        int                     FirstPick;
+        int                     NumOfPicks;
+    };
+
+    CStandardModelBatchSetup    Setup;
+    CPoint                      KOffset;
+    QVector<CModelSphere>       Spheres;
+    QVector<CModelCylinder>     Cylinders;
+    QVector<CPickPrimitive>     Picks;
+    QVector<CAtomRecord>        AtomRecords;
+    QVector<CBondRecord>        BondRecords;
+    QList<CStructure*>          Structures;
+
+    void SetPBCOffset(CStructure* p_str);
+
+    // build
+    void AddStructureList(CStructureList* p_sl);
+    void AddStructure(CStructure* p_str);
+    void AddResidue(CResidue* p_res);
+    void AddAtom(CAtom* p_atom);
+    void AddBond(CBond* p_bond);
+    const CElementColors* GetColor(CAtom* p_atom);
+
+    // geometry
+    void SetAtomGeometry(CAtomRecord& rec);
+    bool SetBondGeometry(CBondRecord& rec,bool append);
+
+    /// get relative positions of bond lines for given order
+    int  GetOrderOffsets(EBondOrder order,float* p_offsets);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -36,7 +36,9 @@
 #include <BondList.hpp>
 #include <Residue.hpp>
 #include <StructureList.hpp>
+#include <SelectionList.hpp>
 #include <GOColorMode.hpp>
+#include <PickingBVH.hpp>
 
 #include <StandardModelObject.hpp>
 #include <StandardModelObjectHistory.hpp>
@@ -94,6 +96,15 @@ CStandardModelObject::CStandardModelObject(CGraphicsObjectList* p_gl)
     BondsSet = NULL;
     ModelSet = NULL;
 
+    BatchValid = false;
+
+    connect(this,SIGNAL(OnStatusChanged(EStatusChanged)),
+            this,SLOT(InvalidateBatch(void)));
+    connect(ColorMode,SIGNAL(OnStatusChanged(EStatusChanged)),
+            this,SLOT(InvalidateBatch(void)));
+    connect(this,SIGNAL(OnGraphicsObjectContentsChanged(void)),
+            this,SLOT(InvalidateBatch(void)));
+
     SetModel(MODEL_TUBES_AND_BALLS);
 
     SetFlag<EStandardModelObjectFlag>(ESMOF_SHOW_HYDROGENS,true);
@@ -145,41 +156,32 @@ void CStandardModelObject::Draw(void)
 
     if( IsFlagSet(EPOF_VISIBLE) == false ) return;
 
+    if( BatchValid == false ) UpdateBatch();
+
     // draw individual objects
 //    glShadeModel(GL_SMOOTH);
 
 //    glEnable(GL_LIGHTING);
     SetInitialColorScheme();
 
-    foreach(QObject* p_qobj,Objects) {
-        CProObject* p_object = static_cast<CProObject*>(p_qobj);
-        CStructureList* p_strlist;
-        CStructure*     p_str;
-        CResidue*       p_res;
-        CAtom*          p_atom;
-        CBond*          p_bond;
+    DrawBatch();
+}
 
-        koffset.SetZero();
-        if( (p_strlist = dynamic_cast<CStructureList*>(p_object)) != NULL ){
-            DrawStructureList(p_strlist);
-        }
-        if( (p_str = dynamic_cast<CStructure*>(p_object)) != NULL ){
-            SetPBCOffset(p_str);
-            DrawStructure(p_str);
-        }
-        if( (p_res = dynamic_cast<CResidue*>(p_object)) != NULL ){
-            SetPBCOffset(p_res->GetStructure());
-            DrawResidue(p_res);
-        }
-        if( (p_atom = dynamic_cast<CAtom*>(p_object)) != NULL ){
-            SetPBCOffset(p_atom->GetStructure());
-            DrawAtom(p_atom);
-        }
-        if( (p_bond = dynamic_cast<CBond*>(p_object)) != NULL ){
-            SetPBCOffset(p_bond->GetStructure());
-            DrawBond(p_bond);
-        }
+//------------------------------------------------------------------------------
+
+void CStandardModelObject::GetPickPrimitives(QVector<CPickPrimitive>& prims)
+{
+    Setup = GetSetup<CStandardModelSetup>();
+    if( Setup == NULL ){
+        ES_ERROR("setup is not available");
+        return;
     }
+
+    if( IsFlagSet(EPOF_VISIBLE) == false ) return;
+
+    if( BatchValid == false ) UpdateBatch();
+
+    prims += Batch.GetPickPrimitives();
 }
 
 //------------------------------------------------------------------------------
@@ -230,6 +232,8 @@ void CStandardModelObject::SetupChanged(void)
 
 void CStandardModelObject::UpdateSetup(void)
 {
+    BatchValid = false;
+
     Setup = GetSetup<CStandardModelSetup>();
     if( Setup == NULL ){
         ES_ERROR("setup is not available");
@@ -461,297 +465,134 @@ void CStandardModelObject::SetPBCOffset(CStructure* p_str)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-void CStandardModelObject::DrawStructureList(CStructureList* p_sl)
+void CStandardModelObject::UpdateBatch(void)
 {
-    if( (IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false)
-        && ( p_sl->IsFlagSet(EPOF_VISIBLE) == false) )  return;
+    CStandardModelBatchSetup setup;
 
-    foreach(QObject* p_qobj,p_sl->children()) {
-        CStructure* p_str = static_cast<CStructure*>(p_qobj);
-        koffset.SetZero();
-        SetPBCOffset(p_str);
-        DrawStructure(p_str);
-    }
-}
+    setup.Atoms = AtomsSet;
+    setup.Bonds = BondsSet;
+    setup.ColorMode = ColorMode;
+    setup.ShowHidden = IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN);
+    setup.ShowHydrogens = IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HYDROGENS);
+    setup.PBCBonds = IsFlagSet<EStandardModelObjectFlag>(ESMOF_PBC_BONDS);
+    setup.KA = KA;
+    setup.KB = KB;
+    setup.KC = KC;
 
-//------------------------------------------------------------------------------
+    Batch.Build(setup,Objects);
+    BatchValid = true;
 
-void CStandardModelObject::DrawStructure(CStructure* p_str)
-{
-    if( (IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false)
-        && ( p_str->IsFlagSet(EPOF_VISIBLE) == false) )  return;
+    // the project is not complete when the object is created
+    // so external signals are connected here
+    CStructureList* p_sl = GetProject()->GetStructures();
+    connect(p_sl,SIGNAL(OnStructureListChanged(void)),
+            this,SLOT(InvalidateBatch(void)),Qt::UniqueConnection);
+    connect(p_sl,SIGNAL(OnStatusChanged(EStatusChanged)),
+            this,SLOT(InvalidateBatch(void)),Qt::UniqueConnection);
+    connect(p_sl,SIGNAL(OnObjectFlagsChanged(void)),
+            this,SLOT(InvalidateBatch(void)),Qt::UniqueConnection);
+    connect(p_sl,SIGNAL(OnGeometryChangeTick(void)),
+            this,SLOT(GeometryChangeTick(void)),Qt::UniqueConnection);
+    connect(GetProject()->GetSelection(),SIGNAL(OnSelectionChanged(void)),
+            this,SLOT(InvalidateBatch(void)),Qt::UniqueConnection);
 
-    foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
-        CAtom* p_a = static_cast<CAtom*>(p_qobj);
-        DrawAtom(p_a);
-    }
-
-    foreach(QObject* p_qobj,p_str->GetBonds()->children()) {
-        CBond* p_b = static_cast<CBond*>(p_qobj);
-        DrawBond(p_b);
+    // bond changes are not propagated to the structure list
+    foreach(CStructure* p_str,Batch.GetStructures()){
+        connect(p_str->GetBonds(),SIGNAL(OnBondListChanged(void)),
+                this,SLOT(InvalidateBatch(void)),Qt::UniqueConnection);
     }
 }
 
 //------------------------------------------------------------------------------
 
-void CStandardModelObject::DrawResidue(CResidue* p_res)
+void CStandardModelObject::DrawBatch(void)
 {
-    if( (IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false)
-        && ( p_res->IsFlagSet(EPOF_VISIBLE) == false) )  return;
+    const CElementColors*   p_color = NULL;
+    CProObject*             p_object = NULL;
 
-    // draw atoms
-    foreach(CAtom* p_atom,p_res->GetAtoms()) {
-        DrawAtom(p_atom);
-    }
+    // atoms
+    const QVector<CModelSphere>& spheres = Batch.GetSpheres();
+    for(int i=0; i < spheres.count(); i++){
+        const CModelSphere& sphere = spheres[i];
 
-    // draw bonds
-    foreach(CBond* p_bond, p_res->GetBonds(true)){
-        DrawBond(p_bond);
-    }
-}
-
-//------------------------------------------------------------------------------
-
-void CStandardModelObject::DrawAtom(CAtom* p_atom)
-{
-    if( (IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false) &&
-        (p_atom->IsFlagSet(EPOF_VISIBLE) == false) )  return;
+        if( sphere.Object != p_object ){
+            p_object = sphere.Object;
+            GLLoadObject(p_object);
+        }
+        if( sphere.Color != p_color ){
+            p_color = sphere.Color;
+            p_color->ApplyMaterialColor();
+        }
 
-    if( p_atom->GetResidue() ){
-        if( (IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false) &&
-            (p_atom->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false) )  return;
+//        glPushMatrix();
+//        glTranslatef(sphere.Center.x, sphere.Center.y, sphere.Center.z);
+        if( AtomsSet->Type == 2 ){
+            Sphere.Draw(sphere.Radius);
+        } else {
+            DrawSphere(sphere.Radius,AtomsSet->TessellationQuality,AtomsSet->TessellationQuality);
+        }
+//        glPopMatrix();
     }
 
-    CSimplePoint<float>    pos;
-    float                  radius;
-    CElementColors*        color;
-    bool                   selected;
-    int                    Z;
-
-//    if(AtomsSet->Type > 0 ) {
-//        glEnable(GL_LIGHTING);
-//    } else {
-//        glDisable(GL_LIGHTING);
-//    }
-
-    pos = p_atom->GetPos()+koffset;
-    Z = p_atom->GetZ();
+    // bonds
+    const QVector<CModelCylinder>& cylinders = Batch.GetCylinders();
+    for(int i=0; i < cylinders.count(); i++){
+        const CModelCylinder& cyl = cylinders[i];
 
-    if( PeriodicTable.IsVirtual(Z) ){
-        if( IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HYDROGENS) == false ) return;
-    }
-
-    selected = p_atom->IsFlagSet(EPOF_SELECTED);
-    if( p_atom->GetStructure() != NULL ) {
-        selected |= p_atom->GetStructure()->IsFlagSet(EPOF_SELECTED);
-    }
-    if( p_atom->GetResidue() != NULL ) {
-        selected |= p_atom->GetResidue()->IsFlagSet(EPOF_SELECTED);
-    }
-    color = ColorMode->GetElementColor(p_atom);
+        if( cyl.Object != p_object ){
+            p_object = cyl.Object;
+            GLLoadObject(p_object);
+        }
 
-    GLLoadObject(p_atom);
+        CSimplePoint<float> pos1 = cyl.Pos1;
+        CSimplePoint<float> pos2 = cyl.Pos2;
 
-    if( AtomsSet->Radius != 0 ) {
-        radius = AtomsSet->Radius;
-    } else {
-        radius = PeriodicTable.GetVdWRadius(Z);
-        radius *= AtomsSet->Ratio;
-    }
+        if( cyl.Selection ){
+//            glEnable(GL_BLEND);
+            DrawTube(pos1,pos2,cyl.Radius,cyl.Color1,cyl.Color2);
+//            glDisable(GL_BLEND);
+            continue;
+        }
 
-//    glPushMatrix();
-//    glTranslatef(pos.x, pos.y, pos.z);
-    color->ApplyMaterialColor();
-
-    switch(AtomsSet->Type){
-    case 0:
-        break;
-    case 1:
-        DrawSphere(radius,AtomsSet->TessellationQuality,AtomsSet->TessellationQuality);
-        break;
-    case 2:
-        Sphere.Draw(radius);
-        break;
-    }
+        CSimplePoint<float> posm = pos1 + (pos2 - pos1)*cyl.Split;
 
-    if( selected == true ) {
-//        glEnable(GL_BLEND);
-        ColorsList.SelectionMaterial.ApplyMaterialColor();
-        switch(AtomsSet->Type){
-        case 0:
-            DrawSphere(radius+0.1,AtomsSet->TessellationQuality,AtomsSet->TessellationQuality);
-            break;
-        case 1:
-            DrawSphere(radius+0.1,AtomsSet->TessellationQuality,AtomsSet->TessellationQuality);
+        switch( BondsSet->Type ){
+            case 0:
+//                glLineWidth(cyl.Radius*100);
+                if( BondsSet->Diffuse == true ) {
+                    DrawStick(pos1,pos2,cyl.Color1,cyl.Color2);
+                } else {
+                    DrawStick(pos1,posm,pos2,cyl.Color1,cyl.Color2);
+                }
             break;
-        case 2:
-            Sphere.Draw(radius+0.1);
+            case 1:
+                if( BondsSet->Diffuse == true ) {
+                    DrawTube(pos1,pos2,cyl.Radius,cyl.Color1,cyl.Color2);
+                } else {
+                    DrawTube(pos1,posm,pos2,cyl.Radius,cyl.Color1,cyl.Color2);
+                }
             break;
         }
-//        glDisable(GL_BLEND);
     }
-//    glPopMatrix();
-
-
 }
 
 //------------------------------------------------------------------------------
 
-void CStandardModelObject::DrawBond(CBond* p_bond)
+void CStandardModelObject::InvalidateBatch(void)
 {
-    if( BondsSet->Radius == 0 ) return;
-
-    if( p_bond->IsInvalidBond() ) return;
-
-    CAtom* p_atom1 = p_bond->GetFirstAtom();
-    CAtom* p_atom2 = p_bond->GetSecondAtom();
-
-    if( IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HIDDEN) == false ){
-        if( p_bond->IsFlagSet(EPOF_VISIBLE) == false ) return;
-        if( p_atom1->GetResidue() && (p_atom1->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false)
-            && p_atom2->GetResidue() && (p_atom2->GetResidue()->IsFlagSet(EPOF_VISIBLE) == false) ) return;
-    }
-    if( (p_atom1->IsFlagSet(EPOF_VISIBLE) == false) && (p_atom2->IsFlagSet(EPOF_VISIBLE) == false) ) return;
-
-//    if(BondsSet->Type > 0 ) {
-//        glEnable(GL_LIGHTING);
-//    } else {
-//        glDisable(GL_LIGHTING);
-//    }
-
-    int Z1,Z2;
-    Z1 = p_atom1->GetZ();
-    Z2 = p_atom2->GetZ();
-
-    if( PeriodicTable.IsVirtual(Z1) || PeriodicTable.IsVirtual(Z2) ){
-        if( IsFlagSet<EStandardModelObjectFlag>(ESMOF_SHOW_HYDROGENS) == false ) return;
-    }
-
-    CElementColors*    color1;
-    CElementColors*    color2;
-    bool               selected;
-    float              VdW1;
-    float              VdW2;
-
-    selected = p_bond->IsFlagSet(EPOF_SELECTED);
-    if( p_bond->GetStructure() != NULL ) {
-        selected |= p_bond->GetStructure()->IsFlagSet(EPOF_SELECTED);
-    }
-    selected |= p_bond->IsSelectedByResidues();
-
-    color1 = ColorMode->GetElementColor(p_atom1);
-    color2 = ColorMode->GetElementColor(p_atom2);
-
-    VdW1   = PeriodicTable.GetVdWRadius(Z1);               // van der Waalsovy polomery
-    VdW2   = PeriodicTable.GetVdWRadius(Z2);
-
-    GLLoadObject(p_bond);
-
-    CSimplePoint<float> pos1;
-    CSimplePoint<float> posm;
-    CSimplePoint<float> pos2;
-    CSimplePoint<float> ordervect;
-    EBondOrder          order;
-
-    order = p_bond->GetBondOrder();
-    if( order > BO_SINGLE ){
-        ordervect = p_bond->GetMainVector();
-        ordervect *= BondsSet->Pitch;
-    }
-
-    if( IsFlagSet<EStandardModelObjectFlag>(ESMOF_PBC_BONDS) ){
-        pos1 = p_atom1->GetPos()+koffset;
-        pos2 = p_atom2->GetPos()+koffset;
-
-        double length = Size(pos1-pos2);
-        if( length > p_bond->GetStructure()->PBCInfo.GetLargestSphereRadius() ){
-            CPoint diff = pos1-pos2;
-            CPoint pos1_backup = pos1;
-            diff = p_bond->GetStructure()->PBCInfo.ImageVector(diff);
-
-            pos1 = pos2 + diff;
-            posm = pos1 + (pos2 - pos1)*(VdW1 / (VdW1 + VdW2));
-            DrawRawBond(pos1,pos2,posm,color1,color2,order,ordervect,selected);
-
-            pos1 = pos1_backup;
-            pos2 = pos1 - diff;
-            posm = pos1 + (pos2 - pos1)*(VdW1 / (VdW1 + VdW2));
-            DrawRawBond(pos1,pos2,posm,color1,color2,order,ordervect,selected);
-
-        } else {
-            posm = pos1 + (pos2 - pos1)*(VdW1 / (VdW1 + VdW2));
-            DrawRawBond(pos1,pos2,posm,color1,color2,order,ordervect,selected);
-        }
-
-    } else {
-        pos1 = p_atom1->GetPos()+koffset;
-        pos2 = p_atom2->GetPos()+koffset;
-
-        posm = pos1 + (pos2 - pos1)*(VdW1 / (VdW1 + VdW2));
-
-        DrawRawBond(pos1,pos2,posm,color1,color2,order,ordervect,selected);
-    }
+    BatchValid = false;
 }
 
 //------------------------------------------------------------------------------
 
-void CStandardModelObject::DrawRawBond(CSimplePoint<float>& pos1,
-                                       CSimplePoint<float>& pos2,
-                                       CSimplePoint<float>& posm,
-                                       CElementColors* color1,CElementColors* color2,
-                                       EBondOrder order,
-                                       const CSimplePoint<float>& ordervect,
-                                       bool selected)
+void CStandardModelObject::GeometryChangeTick(void)
 {
-    float radius = BondsSet->Radius;
+    if( BatchValid == false ) return;
 
-//    glPushMatrix();
-
-    switch( BondsSet->Type ){
-        // ----------------
-        case 0:
-//            glLineWidth(radius*100);
-            if( BondsSet->ShowOrder == true ){
-                if( BondsSet->Diffuse == true ) {
-                    DrawStick(pos1,pos2,color1,color2,order,ordervect);
-                } else {
-                    DrawStick(pos1,posm,pos2,color1,color2,order,ordervect);
-                }
-            } else {
-                if( BondsSet->Diffuse == true ) {
-                    DrawStick(pos1,pos2,color1,color2);
-                } else {
-                    DrawStick(pos1,posm,pos2,color1,color2);
-                }
-            }
-        break;
-        // ----------------
-        case 1:
-            if( BondsSet->ShowOrder == true ){
-                if( BondsSet->Diffuse == true ) {
-                    DrawTube(pos1,pos2,radius,color1,color2,order,ordervect);
-                } else {
-                    DrawTube(pos1,posm,pos2,radius,color1,color2,order,ordervect);
-                }
-            } else {
-                if( BondsSet->Diffuse == true ) {
-                    DrawTube(pos1,pos2,radius,color1,color2);
-                } else {
-                    DrawTube(pos1,posm,pos2,radius,color1,color2);
-                }
-            }
-        break;
+    CStructureList* p_sl = GetProject()->GetStructures();
+    if( Batch.UpdatePositions(p_sl->GetGeometryChanges()) == false ){
+        BatchValid = false;
     }
-
-    if( selected == true ) {
-//        glEnable(GL_BLEND);
-        CElementColors*    color1 = &ColorsList.SelectionMaterial;
-        DrawTube(pos1,pos2,radius+0.05,color1,color1);
-//        glDisable(GL_BLEND);
-    }
-
-//    glPopMatrix();
-
 }
 
 //==============================================================================
@@ -837,146 +678,6 @@ void CStandardModelObject::DrawTube(
 //    glPopMatrix();
 }
 
-//---------------------------------------------------------------------------
-
-void CStandardModelObject::DrawTube(
-                                    CSimplePoint<float>& p1,
-                                    CSimplePoint<float>& p2,
-                                    float  radius,
-                                    const CElementColors* color1,
-                                    const CElementColors* color2,
-                                    EBondOrder order,
-                                    const CSimplePoint<float> &ordervect
-                                    )
-{
-    CSimplePoint<float> pl1;
-    CSimplePoint<float> pl2;
-
-    switch(order) {
-        case BO_SINGLE:
-            DrawTube(p1,p2,radius,color1,color2);
-            return;
-
-        case BO_SINGLE_H:
-            pl1 = p1 + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            return;
-
-        case BO_DOUBLE:
-            pl1 = p1 + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            return;
-
-        case BO_DOUBLE_H:
-            DrawTube(p1,p2,radius,color1,color2);
-            pl1 = p1 + ordervect;
-            pl2 = p2 + ordervect;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect;
-            pl2 = p2 - ordervect;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            return;
-
-        case BO_TRIPLE:
-            DrawTube(p1,p2,radius,color1,color2);
-            pl1 = p1 + ordervect;
-            pl2 = p2 + ordervect;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect;
-            pl2 = p2 - ordervect;
-            DrawTube(pl1,pl2,radius,color1,color2);
-            return;
-
-        case BO_NONE:
-        case BO_WEAK:
-        default:
-            return;
-    }
-}
-
-//---------------------------------------------------------------------------
-
-void CStandardModelObject::DrawTube(
-                                    CSimplePoint<float>& p1,
-                                    CSimplePoint<float>& pm,
-                                    CSimplePoint<float>& p2,
-                                    float  radius,
-                                    const CElementColors* color1,
-                                    const CElementColors* color2,
-                                    EBondOrder order,
-                                    const CSimplePoint<float>& ordervect
-                                    )
-{
-    CSimplePoint<float> pl1;
-    CSimplePoint<float> plm;
-    CSimplePoint<float> pl2;
-
-    switch(order) {
-        case BO_SINGLE:
-            DrawTube(p1,pm,p2,radius,color1,color2);
-            return;
-
-        case BO_SINGLE_H:
-            pl1 = p1 + ordervect*0.5;
-            plm = pm + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            plm = pm - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            return;
-
-        case BO_DOUBLE:
-            pl1 = p1 + ordervect*0.5;
-            plm = pm + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            plm = pm - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            return;
-
-        case BO_DOUBLE_H:
-            DrawTube(p1,pm,p2,radius,color1,color2);
-            pl1 = p1 + ordervect;
-            plm = pm + ordervect;
-            pl2 = p2 + ordervect;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect;
-            plm = pm - ordervect;
-            pl2 = p2 - ordervect;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            return;
-
-        case BO_TRIPLE:
-            DrawTube(p1,pm,p2,radius,color1,color2);
-            pl1 = p1 + ordervect;
-            plm = pm + ordervect;
-            pl2 = p2 + ordervect;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            pl1 = p1 - ordervect;
-            plm = pm - ordervect;
-            pl2 = p2 - ordervect;
-            DrawTube(pl1,plm,pl2,radius,color1,color2);
-            return;
-
-        case BO_NONE:
-        case BO_WEAK:
-        default:
-            return;
-    }
-}
-
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -1016,144 +717,6 @@ void CStandardModelObject::DrawStick(
 //    glEnd();
 }
 
-//---------------------------------------------------------------------------
-
-void CStandardModelObject::DrawStick(
-                                    CSimplePoint<float>& p1,
-                                    CSimplePoint<float>& p2,
-                                    const CElementColors* color1,
-                                    const CElementColors* color2,
-                                    EBondOrder order,
-                                    const CSimplePoint<float> &ordervect
-                                    )
-{
-    CSimplePoint<float> pl1;
-    CSimplePoint<float> pl2;
-
-    switch(order) {
-        case BO_SINGLE:
-            DrawStick(p1,p2,color1,color2);
-            return;
-
-        case BO_SINGLE_H:
-            pl1 = p1 + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawStick(pl1,pl2,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawStick(pl1,pl2,color1,color2);
-            return;
-
-        case BO_DOUBLE:
-            pl1 = p1 + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawStick(pl1,pl2,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawStick(pl1,pl2,color1,color2);
-            return;
-
-        case BO_DOUBLE_H:
-            DrawStick(p1,p2,color1,color2);
-            pl1 = p1 + ordervect;
-            pl2 = p2 + ordervect;
-            DrawStick(pl1,pl2,color1,color2);
-            pl1 = p1 - ordervect;
-            pl2 = p2 - ordervect;
-            DrawStick(pl1,pl2,color1,color2);
-            return;
-
-        case BO_TRIPLE:
-            DrawStick(p1,p2,color1,color2);
-            pl1 = p1 + ordervect;
-            pl2 = p2 + ordervect;
-            DrawStick(pl1,pl2,color1,color2);
-            pl1 = p1 - ordervect;
-            pl2 = p2 - ordervect;
-            DrawStick(pl1,pl2,color1,color2);
-            return;
-
-        case BO_NONE:
-        case BO_WEAK:
-        default:
-            return;
-    }
-}
-
-//---------------------------------------------------------------------------
-
-void CStandardModelObject::DrawStick(
-                                CSimplePoint<float>& p1,
-                                CSimplePoint<float>& pm,
-                                CSimplePoint<float>& p2,
-                                const CElementColors* color1,
-                                const CElementColors* color2,
-                                EBondOrder order,
-                                const CSimplePoint<float>& ordervect
-                                )
-{
-    CSimplePoint<float> pl1;
-    CSimplePoint<float> plm;
-    CSimplePoint<float> pl2;
-
-    switch(order) {
-        case BO_SINGLE:
-            DrawStick(p1,pm,p2,color1,color2);
-            return;
-
-        case BO_SINGLE_H:
-            pl1 = p1 + ordervect*0.5;
-            plm = pm + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            plm = pm - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            return;
-
-        case BO_DOUBLE:
-            pl1 = p1 + ordervect*0.5;
-            plm = pm + ordervect*0.5;
-            pl2 = p2 + ordervect*0.5;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            pl1 = p1 - ordervect*0.5;
-            plm = pm - ordervect*0.5;
-            pl2 = p2 - ordervect*0.5;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            return;
-
-        case BO_DOUBLE_H:
-            DrawStick(p1,pm,p2,color1,color2);
-            pl1 = p1 + ordervect;
-            plm = pm + ordervect;
-            pl2 = p2 + ordervect;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            pl1 = p1 - ordervect;
-            plm = pm - ordervect;
-            pl2 = p2 - ordervect;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            return;
-
-        case BO_TRIPLE:
-            DrawStick(p1,pm,p2,color1,color2);
-            pl1 = p1 + ordervect;
-            plm = pm + ordervect;
-            pl2 = p2 + ordervect;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            pl1 = p1 - ordervect;
-            plm = pm - ordervect;
-            pl2 = p2 - ordervect;
-            DrawStick(pl1,plm,pl2,color1,color2);
-            return;
-
-        case BO_NONE:
-        case BO_WEAK:
-        default:
-            return;
-    }
-}
-
 //------------------------------------------------------------------------------
 
 void CStandardModelObject::DrawSphere(float radius,int slices,int stacks)
@@ -1186,6 +749,7 @@ void CStandardModelObject::LoadData(CXMLElement* p_ele)
     p_ele->GetAttribute("ka",KA);
     p_ele->GetAttribute("kb",KB);
     p_ele->GetAttribute("kc",KC);
+    BatchValid = false;
 
     CXMLElement* p_sele = p_ele->GetFirstChildElement("cmode");
     if( p_sele ) {
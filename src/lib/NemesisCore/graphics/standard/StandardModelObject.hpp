@@ -29,6 +29,8 @@
 #include <SimpleList.hpp>
 #include <Bond.hpp>
 #include <StandardModelSetup.hpp>
+#include <StandardModelBatch.hpp>
+#include <QVector>
 
 // -----------------------------------------------------------------------------
 
@@ -40,6 +42,7 @@ class CResidue;
 class CStandardModelSetup;
 class CHistoryItem;
 class CGOColorMode;
+class CPickPrimitive;
 
 //------------------------------------------------------------------------------
 
@@ -73,6 +76,10 @@ public:
     /// draw model
     virtual void Draw(void);
 
+    /// collect spheres of atoms and capsules of bonds for picking
+    /*! primitives are taken from the render batch */
+    virtual void GetPickPrimitives(QVector<CPickPrimitive>& prims);
+
     /// set used model setup
     void SetModel(EModel model,CHistoryNode* p_history=NULL);
 
@@ -123,20 +130,24 @@ private:
     //GLUquadricObj*              ExtQuad;
     CGOColorMode*               ColorMode;
 
+// render batch ---------------------------------
+    CStandardModelBatch         Batch;
+    bool                        BatchValid;
+
 // tmp data
-    CPoint          koffset; // PBCOffset
+    CPoint                      koffset; // PBCOffset
     void SetPBCOffset(CStructure* p_str);
 
     void UpdateSetup(void);
     virtual void SetupChanged(void);
     void SetInitialColorScheme(void);
 
-// draw individual objects ----------------------
-    void DrawStructureList(CStructureList* p_sl);
-    void DrawStructure(CStructure* p_str);
-    void DrawResidue(CResidue* p_res);
-    void DrawAtom(CAtom* p_atom);
-    void DrawBond(CBond* p_bond);   
+// render batch support -------------------------
+    /// rebuild instances and connect signals that invalidate them
+    void UpdateBatch(void);
+
+    /// submit instances of the batch
+    void DrawBatch(void);
 
 // metrics support ------------------------------
     void GetStructureListMetrics(CStructureList* p_sl,CObjMetrics& metrics);
@@ -146,13 +157,6 @@ private:
     void GetBondMetrics(CBond* p_bond,CObjMetrics& metrics);
 
 // helper methods -------------------------------
-
-    void DrawRawBond(CSimplePoint<float>& pos1,CSimplePoint<float>& pos2,
-                     CSimplePoint<float>& posm,
-                     CElementColors* color1,CElementColors* color2,
-                     EBondOrder order,const CSimplePoint<float>& ordervect,
-                     bool selected);
-    //-------------------------
     void DrawTube(CSimplePoint<float>& p1,
                        CSimplePoint<float>& p2,
                        float radius,
@@ -164,21 +168,6 @@ private:
                        float radius,
                        const CElementColors* color1,
                        const CElementColors* color2);
-    void DrawTube(CSimplePoint<float>& p1,
-                       CSimplePoint<float>& p2,
-                       float radius,
-                       const CElementColors* color1,
-                       const CElementColors* color2,
-                       EBondOrder order,
-                       const CSimplePoint<float> &ordervect);
-    void DrawTube(CSimplePoint<float>& p1,
-                       CSimplePoint<float>& pm,
-                       CSimplePoint<float>& p2,
-                       float radius,
-                       const CElementColors* color1,
-                       const CElementColors* color2,
-                       EBondOrder order,
-                       const CSimplePoint<float>& ordervect);
     //-------------------------
     void DrawStick(CSimplePoint<float>& p1,
                        CSimplePoint<float>& p2,
@@ -189,21 +178,15 @@ private:
                        CSimplePoint<float>& p2,
                        const CElementColors* color1,
                        const CElementColors* color2);
-    void DrawStick(CSimplePoint<float>& p1,
-                       CSimplePoint<float>& p2,
-                       const CElementColors* color1,
-                       const CElementColors* color2,
-                       EBondOrder order,
-                       const CSimplePoint<float> &ordervect);
-    void DrawStick(CSimplePoint<float>& p1,
-                       CSimplePoint<float>& pm,
-                       CSimplePoint<float>& p2,
-                       const CElementColors* color1,
-                       const CElementColors* color2,
-                       EBondOrder order,
-                       const CSimplePoint<float>& ordervect);
     //-------------------------
     void DrawSphere(float radius,int slices,int stacks);
+
+private slots:
+    /// topology, flags or colors were changed
+    void InvalidateBatch(void);
+
+    /// update coordinates of instances
+    void GeometryChangeTick(void);
 };
 
 //------------------------------------------------------------------------------
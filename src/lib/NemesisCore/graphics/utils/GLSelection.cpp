@@ -25,6 +25,7 @@
 #include <Transformation.hpp>
 #include <IndexCounter.hpp>
 #include <ProObject.hpp>
+#include <QHash>
 
 //------------------------------------------------------------------------------
 
@@ -79,6 +80,13 @@ bool CSelObject::operator == (const CSelObject& left) const
     return(true);
 }
 
+//------------------------------------------------------------------------------
+
+uint qHash(const CSelObject& obj)
+{
+    return( qHash(obj.GetObject()) ^ (uint)obj.GetSubID() );
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
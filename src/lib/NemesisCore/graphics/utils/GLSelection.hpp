@@ -80,6 +80,11 @@ private:
 
 // -----------------------------------------------------------------------------
 
+/// hash function for QSet and QHash
+uint NEMESIS_CORE_PACKAGE qHash(const CSelObject& obj);
+
+// -----------------------------------------------------------------------------
+
 /// load name into selection stack
 void   NEMESIS_CORE_PACKAGE GLLoadObject(CProObject* p_object,int subid = 0);
 
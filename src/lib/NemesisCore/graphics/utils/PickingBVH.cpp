@@ -0,0 +1,375 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <PickingBVH.hpp>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+//------------------------------------------------------------------------------
+
+// max number of primitives in leaf
+#define PICKING_BVH_LEAF_SIZE   4
+
+//------------------------------------------------------------------------------
+
+/// compare primitives by centres along given axis
+
+class CPickingBVHLessThan {
+public:
+    CPickingBVHLessThan(const QVector<CPoint>& centres,int axis)
+        : Centres(centres), Axis(axis) {}
+
+    bool operator()(int left,int right) const
+    {
+        return( GetCoord(Centres.at(left)) < GetCoord(Centres.at(right)) );
+    }
+
+private:
+    const QVector<CPoint>&  Centres;
+    int                     Axis;
+
+    double GetCoord(const CPoint& pos) const
+    {
+        if( Axis == 0 ) return(pos.x);
+        if( Axis == 1 ) return(pos.y);
+        return(pos.z);
+    }
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CPickPrimitive::CPickPrimitive(void)
+{
+    Radius = 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+CPickPrimitive::CPickPrimitive(CProObject* p_obj,const CPoint& pos,double radius)
+    : Object(p_obj,0)
+{
+    Pos1 = pos;
+    Pos2 = pos;
+    Radius = radius;
+}
+
+//------------------------------------------------------------------------------
+
+CPickPrimitive::CPickPrimitive(CProObject* p_obj,const CPoint& pos1,const CPoint& pos2,
+                               double radius)
+    : Object(p_obj,0)
+{
+    Pos1 = pos1;
+    Pos2 = pos2;
+    Radius = radius;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CPickingBVH::CPickingBVH(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CPickingBVH::Build(const QVector<CPickPrimitive>& prims)
+{
+    Clear();
+    if( prims.count() == 0 ) return;
+
+    QVector<CPoint> centres(prims.count());
+    Order.resize(prims.count());
+    for(int i=0; i < prims.count(); i++){
+        centres[i] = (prims.at(i).Pos1 + prims.at(i).Pos2)*0.5;
+        Order[i] = i;
+    }
+
+    Nodes.reserve(2*prims.count()/PICKING_BVH_LEAF_SIZE + 1);
+    BuildNode(prims,centres,0,prims.count());
+}
+
+//------------------------------------------------------------------------------
+
+void CPickingBVH::Refit(const QVector<CPickPrimitive>& prims)
+{
+    if( prims.count() != Order.count() ){
+        Build(prims);
+        return;
+    }
+
+    // children are stored after their parents
+    for(int i=Nodes.count()-1; i >= 0; i--){
+        CPickingBVHNode& node = Nodes[i];
+        if( node.Count > 0 ){
+            SetLeafBox(prims,node);
+            continue;
+        }
+        const CPickingBVHNode& left = Nodes.at(i+1);
+        const CPickingBVHNode& right = Nodes.at(node.First);
+        node.Min.x = qMin(left.Min.x,right.Min.x);
+        node.Min.y = qMin(left.Min.y,right.Min.y);
+        node.Min.z = qMin(left.Min.z,right.Min.z);
+        node.Max.x = qMax(left.Max.x,right.Max.x);
+        node.Max.y = qMax(left.Max.y,right.Max.y);
+        node.Max.z = qMax(left.Max.z,right.Max.z);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CPickingBVH::Clear(void)
+{
+    Nodes.clear();
+    Order.clear();
+}
+
+//------------------------------------------------------------------------------
+
+int CPickingBVH::BuildNode(const QVector<CPickPrimitive>& prims,const QVector<CPoint>& centres,
+                           int first,int count)
+{
+    int index = Nodes.count();
+    Nodes.append(CPickingBVHNode());
+    Nodes[index].First = first;
+    Nodes[index].Count = count;
+    SetLeafBox(prims,Nodes[index]);
+
+    if( count <= PICKING_BVH_LEAF_SIZE ) return(index);
+
+    // split along the longest extent of centres
+    CPoint cmin = centres.at(Order.at(first));
+    CPoint cmax = cmin;
+    for(int i=first+1; i < first+count; i++){
+        const CPoint& c = centres.at(Order.at(i));
+        cmin.x = qMin(cmin.x,c.x);
+        cmin.y = qMin(cmin.y,c.y);
+        cmin.z = qMin(cmin.z,c.z);
+        cmax.x = qMax(cmax.x,c.x);
+        cmax.y = qMax(cmax.y,c.y);
+        cmax.z = qMax(cmax.z,c.z);
+    }
+    CPoint ext = cmax - cmin;
+    int axis = 0;
+    if( ext.y > ext.x ) axis = 1;
+    if( (ext.z > ext.x) && (ext.z > ext.y) ) axis = 2;
+    if( Square(ext) == 0.0 ) return(index);  // all centres coincide
+
+    int mid = first + count/2;
+    int* p_order = Order.data();
+    std::nth_element(p_order+first,p_order+mid,p_order+first+count,
+                     CPickingBVHLessThan(centres,axis));
+
+    BuildNode(prims,centres,first,mid-first);
+    int right = BuildNode(prims,centres,mid,first+count-mid);
+
+    Nodes[index].First = right;
+    Nodes[index].Count = 0;
+    return(index);
+}
+
+//------------------------------------------------------------------------------
+
+void CPickingBVH::SetLeafBox(const QVector<CPickPrimitive>& prims,CPickingBVHNode& node) const
+{
+    node.Min = CPoint(DBL_MAX,DBL_MAX,DBL_MAX);
+    node.Max = CPoint(-DBL_MAX,-DBL_MAX,-DBL_MAX);
+
+    for(int i=node.First; i < node.First+node.Count; i++){
+        const CPickPrimitive& prim = prims.at(Order.at(i));
+        double r = prim.Radius;
+        node.Min.x = qMin(node.Min.x,qMin(prim.Pos1.x,prim.Pos2.x) - r);
+        node.Min.y = qMin(node.Min.y,qMin(prim.Pos1.y,prim.Pos2.y) - r);
+        node.Min.z = qMin(node.Min.z,qMin(prim.Pos1.z,prim.Pos2.z) - r);
+        node.Max.x = qMax(node.Max.x,qMax(prim.Pos1.x,prim.Pos2.x) + r);
+        node.Max.y = qMax(node.Max.y,qMax(prim.Pos1.y,prim.Pos2.y) + r);
+        node.Max.z = qMax(node.Max.z,qMax(prim.Pos1.z,prim.Pos2.z) + r);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CPickingBVH::Intersect(const QVector<CPickPrimitive>& prims,const CPoint& orig,
+                           const CPoint& dir,double& t) const
+{
+    t = -1.0;
+    if( (Nodes.count() == 0) || (prims.count() != Order.count()) ) return(-1);
+
+    double len = Size(dir);
+    if( len == 0.0 ) return(-1);
+    CPoint ndir = dir;
+    ndir /= len;
+
+    // avoid 0*inf in the slab test
+    CPoint invdir;
+    invdir.x = ndir.x != 0.0 ? 1.0/ndir.x : DBL_MAX;
+    invdir.y = ndir.y != 0.0 ? 1.0/ndir.y : DBL_MAX;
+    invdir.z = ndir.z != 0.0 ? 1.0/ndir.z : DBL_MAX;
+
+    int     best = -1;
+    double  tbest = DBL_MAX;
+
+    QVarLengthArray<int,64> stack;
+    stack.append(0);
+
+    while( stack.count() > 0 ){
+        int i = stack.last();
+        stack.removeLast();
+
+        const CPickingBVHNode& node = Nodes.at(i);
+        if( IntersectBox(node,orig,invdir,tbest) < 0.0 ) continue;
+
+        if( node.Count > 0 ){
+            for(int k=node.First; k < node.First+node.Count; k++){
+                int     p = Order.at(k);
+                double  pt = IntersectPrimitive(prims.at(p),orig,ndir);
+                if( (pt >= 0.0) && (pt < tbest) ){
+                    tbest = pt;
+                    best = p;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first
+        int     left = i + 1;
+        int     right = node.First;
+        double  tleft = IntersectBox(Nodes.at(left),orig,invdir,tbest);
+        double  tright = IntersectBox(Nodes.at(right),orig,invdir,tbest);
+        if( (tleft >= 0.0) && (tright >= 0.0) ){
+            if( tleft < tright ){
+                stack.append(right);
+                stack.append(left);
+            } else {
+                stack.append(left);
+                stack.append(right);
+            }
+        } else if( tleft >= 0.0 ){
+            stack.append(left);
+        } else if( tright >= 0.0 ){
+            stack.append(right);
+        }
+    }
+
+    if( best >= 0 ) t = tbest;
+    return(best);
+}
+
+//------------------------------------------------------------------------------
+
+int CPickingBVH::GetNumberOfPrimitives(void) const
+{
+    return(Order.count());
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+double CPickingBVH::IntersectBox(const CPickingBVHNode& node,const CPoint& orig,
+                                 const CPoint& invdir,double tmax)
+{
+    double t1 = (node.Min.x - orig.x)*invdir.x;
+    double t2 = (node.Max.x - orig.x)*invdir.x;
+    double tmin = qMin(t1,t2);
+    double tout = qMax(t1,t2);
+
+    t1 = (node.Min.y - orig.y)*invdir.y;
+    t2 = (node.Max.y - orig.y)*invdir.y;
+    tmin = qMax(tmin,qMin(t1,t2));
+    tout = qMin(tout,qMax(t1,t2));
+
+    t1 = (node.Min.z - orig.z)*invdir.z;
+    t2 = (node.Max.z - orig.z)*invdir.z;
+    tmin = qMax(tmin,qMin(t1,t2));
+    tout = qMin(tout,qMax(t1,t2));
+
+    if( tout < 0.0 ) return(-1.0);
+    if( tmin > tout ) return(-1.0);
+    if( tmin > tmax ) return(-1.0);
+    if( tmin < 0.0 ) tmin = 0.0;
+    return(tmin);
+}
+
+//------------------------------------------------------------------------------
+
+double CPickingBVH::IntersectPrimitive(const CPickPrimitive& prim,const CPoint& orig,
+                                       const CPoint& dir)
+{
+    CPoint ba = prim.Pos2 - prim.Pos1;
+    double baba = Square(ba);
+    double r = prim.Radius;
+
+    if( baba > 0.0 ){
+        // cylinder body
+        CPoint oa = orig - prim.Pos1;
+        double bard = VectDot(ba,dir);
+        double baoa = VectDot(ba,oa);
+        double rdoa = VectDot(dir,oa);
+        double oaoa = Square(oa);
+
+        double a = baba - bard*bard;
+        double b = baba*rdoa - baoa*bard;
+        double c = baba*oaoa - baoa*baoa - r*r*baba;
+        double h = b*b - a*c;
+        if( (a > 0.0) && (h >= 0.0) ){
+            double t = (-b - sqrt(h))/a;
+            double y = baoa + t*bard;
+            if( (t >= 0.0) && (y > 0.0) && (y < baba) ) return(t);
+        }
+    }
+
+    // end caps
+    double t1 = IntersectSphere(prim.Pos1,r,orig,dir);
+    if( baba == 0.0 ) return(t1);
+    double t2 = IntersectSphere(prim.Pos2,r,orig,dir);
+    if( t1 < 0.0 ) return(t2);
+    if( t2 < 0.0 ) return(t1);
+    return(qMin(t1,t2));
+}
+
+//------------------------------------------------------------------------------
+
+double CPickingBVH::IntersectSphere(const CPoint& pos,double radius,const CPoint& orig,
+                                    const CPoint& dir)
+{
+    CPoint oc = orig - pos;
+    double b = VectDot(oc,dir);
+    double c = Square(oc) - radius*radius;
+    double h = b*b - c;
+    if( h < 0.0 ) return(-1.0);
+    double t = -b - sqrt(h);
+    if( t < 0.0 ) return(-1.0);
+    return(t);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
@@ -0,0 +1,118 @@
+#ifndef PickingBVHH
+#define PickingBVHH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <GLSelection.hpp>
+#include <Point.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+/// pickable primitive - capsule between two points, sphere if points are equal
+
+class NEMESIS_CORE_PACKAGE CPickPrimitive {
+public:
+    CPickPrimitive(void);
+    CPickPrimitive(CProObject* p_obj,const CPoint& pos,double radius);
+    CPickPrimitive(CProObject* p_obj,const CPoint& pos1,const CPoint& pos2,double radius);
+
+// section of public data ------------------------------------------------------
+public:
+    CSelObject  Object;
+    CPoint      Pos1;
+    CPoint      Pos2;
+    double      Radius;
+};
+
+// -----------------------------------------------------------------------------
+
+/// node of bounding volume hierarchy
+
+class NEMESIS_CORE_PACKAGE CPickingBVHNode {
+public:
+    CPoint  Min;
+    CPoint  Max;
+    int     First;      // the first primitive in Order for leaves, right child otherwise
+    int     Count;      // number of primitives, zero for inner nodes
+};
+
+// -----------------------------------------------------------------------------
+
+///  bounding volume hierarchy over pickable primitives
+/*! nodes are stored in preorder, the left child follows its parent,
+    the tree can be refitted if only positions of primitives are changed
+*/
+
+class NEMESIS_CORE_PACKAGE CPickingBVH {
+public:
+// constructor -----------------------------------------------------------------
+    CPickingBVH(void);
+
+// executive methods -----------------------------------------------------------
+    /// build hierarchy
+    void Build(const QVector<CPickPrimitive>& prims);
+
+    /// update bounding boxes, primitives must be the same as during build
+    void Refit(const QVector<CPickPrimitive>& prims);
+
+    /// destroy hierarchy
+    void Clear(void);
+
+// queries ---------------------------------------------------------------------
+    /// get index of the nearest primitive hit by the ray or -1
+    /*! dir does not need to be normalized, t is distance along normalized dir
+    */
+    int Intersect(const QVector<CPickPrimitive>& prims,const CPoint& orig,const CPoint& dir,
+                  double& t) const;
+
+// information methods ---------------------------------------------------------
+    /// get number of primitives
+    int GetNumberOfPrimitives(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QVector<CPickingBVHNode>    Nodes;
+    QVector<int>                Order;      // primitive indexes sorted by leaves
+
+    /// build subtree, it returns node index
+    int BuildNode(const QVector<CPickPrimitive>& prims,const QVector<CPoint>& centres,
+                  int first,int count);
+
+    /// set node box from its primitives
+    void SetLeafBox(const QVector<CPickPrimitive>& prims,CPickingBVHNode& node) const;
+
+    /// get entry distance into the box or -1 if it is missed
+    static double IntersectBox(const CPickingBVHNode& node,const CPoint& orig,
+                               const CPoint& invdir,double tmax);
+
+    /// get distance to capsule or -1 if it is missed, dir must be normalized
+    static double IntersectPrimitive(const CPickPrimitive& prim,const CPoint& orig,
+                                     const CPoint& dir);
+
+    /// get distance to sphere or -1 if it is missed, dir must be normalized
+    static double IntersectSphere(const CPoint& pos,double radius,const CPoint& orig,
+                                  const CPoint& dir);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
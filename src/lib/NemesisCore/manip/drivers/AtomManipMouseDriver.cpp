@@ -398,12 +398,14 @@ bool CAtomManipMouseDriver::StartManipulation(void)
         return(false);
     }
 
-    // capture current coordinates
-    CAtomListCoordinatesHI* p_hitem = new CAtomListCoordinatesHI(p_mol,true);
+    // capture current coordinates, only moved atoms are kept at the end
+    CAtomListDeltaHI* p_hitem = new CAtomListDeltaHI(p_mol,true,true);
     p_history->Register(p_hitem);
 
     p_mol->EndChangeWH();
 
+    ManipTrans = CTransformation();
+
     // use delayed event notification
     StartEvent();
 
@@ -430,6 +432,7 @@ void CAtomManipMouseDriver::Move(const CPoint &dmov,CGraphicsView* p_view)
             p_atom->SetPos(p_atom->GetPos()+_dmov);
         }
     }
+    ManipTrans.Translate(_dmov);
 
     GetSelection()->GetProject()->GetStructures()->EndGeometryUpdate(false);
 
@@ -474,6 +477,7 @@ void CAtomManipMouseDriver::Rotate(const CPoint &drot,CGraphicsView* p_view)
             p_atom->SetPos(trans.GetTransform(p_atom->GetPos()));
         }
     }
+    ManipTrans *= trans;
 
     GetSelection()->GetProject()->GetStructures()->EndGeometryUpdate(false);
 
@@ -487,13 +491,23 @@ void CAtomManipMouseDriver::EndManipulation(void)
 {
     // end delayed event notification
     EndEvent();
+
+    if( (Completed == false) || (Allowed == false) ) return;
+
+    // keep only moved atoms, merge with the previous manipulation if possible
+    CAtom* p_atom = dynamic_cast<CAtom*>(GetSelection()->GetSelectedObject(0));
+    if( p_atom == NULL ) return;
+    CAtomListDeltaHI::CompactLastChange(p_atom->GetStructure(),&ManipTrans);
 }
 
 //------------------------------------------------------------------------------
 
 void CAtomManipMouseDriver::RespondToEvent(void)
 {
-    GetSelection()->GetProject()->GetStructures()->NotifyGeometryChangeTick();
+    // moved atoms are already recorded by CAtom::SetPos
+    CAtom* p_atom = dynamic_cast<CAtom*>(GetSelection()->GetSelectedObject(0));
+    if( p_atom == NULL ) return;
+    p_atom->GetStructure()->NotifyGeometryChangeTick();
 }
 
 //==============================================================================
@@ -22,6 +22,7 @@
 
 #include <NemesisCoreMainHeader.hpp>
 #include <Point.hpp>
+#include <Transformation.hpp>
 #include <MouseDriver.hpp>
 #include <ObjectManipulator.hpp>
 
@@ -68,6 +69,7 @@ private:
     CSelectionRequest*  SelRequest;
     bool                Completed;  // objects are ready
     bool                Allowed;    // history change is allowed
+    CTransformation     ManipTrans; // accumulated transformation of atoms
 
     // actions --------------------------
     EMouseAction        Action;
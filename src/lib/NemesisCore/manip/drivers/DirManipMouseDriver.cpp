@@ -363,12 +363,14 @@ bool CDirManipMouseDriver::StartManipulation(void)
         return(false);
     }
 
-    // capture current coordinates
-    CAtomListCoordinatesHI* p_hitem = new CAtomListCoordinatesHI(p_mol,true);
+    // capture current coordinates, only moved atoms are kept at the end
+    CAtomListDeltaHI* p_hitem = new CAtomListDeltaHI(p_mol,true,true);
     p_history->Register(p_hitem);
 
     p_mol->EndChangeWH();
 
+    ManipTrans = CTransformation();
+
     // use delayed event notification
     StartEvent();
 
@@ -418,6 +420,7 @@ void CDirManipMouseDriver::Move(const CPoint &dmov,CGraphicsView* p_view)
             p_atom->SetPos(trans.GetTransform(p_atom->GetPos()));
         }
     }
+    ManipTrans *= trans;
 
     GetSelection()->GetProject()->GetStructures()->EndGeometryUpdate(false);
 
@@ -466,6 +469,7 @@ void CDirManipMouseDriver::Rotate(const CPoint &drot,CGraphicsView* p_view)
             p_atom->SetPos(trans.GetTransform(p_atom->GetPos()));
         }
     }
+    ManipTrans *= trans;
 
     GetSelection()->GetProject()->GetStructures()->EndGeometryUpdate(false);
 
@@ -479,13 +483,23 @@ void CDirManipMouseDriver::EndManipulation(void)
 {
     // end delayed event notification
     EndEvent();
+
+    if( (Completed == false) || (Allowed == false) ) return;
+
+    // keep only moved atoms, merge with the previous manipulation if possible
+    CAtom* p_atom = dynamic_cast<CAtom*>(GetSelection()->GetSelectedObject(0));
+    if( p_atom == NULL ) return;
+    CAtomListDeltaHI::CompactLastChange(p_atom->GetStructure(),&ManipTrans);
 }
 
 //------------------------------------------------------------------------------
 
 void CDirManipMouseDriver::RespondToEvent(void)
 {
-    GetSelection()->GetProject()->GetStructures()->NotifyGeometryChangeTick();
+    // moved atoms are already recorded by CAtom::SetPos
+    CAtom* p_atom = dynamic_cast<CAtom*>(GetSelection()->GetSelectedObject(0));
+    if( p_atom == NULL ) return;
+    p_atom->GetStructure()->NotifyGeometryChangeTick();
 }
 
 //==============================================================================
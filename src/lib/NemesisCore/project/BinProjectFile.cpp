@@ -0,0 +1,244 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <BinProjectFile.hpp>
+#include <FileName.hpp>
+#include <ErrorSystem.hpp>
+#include <QFile>
+#include <QDataStream>
+#include <cstring>
+
+//------------------------------------------------------------------------------
+
+// small blocks are not compressed
+#define BIN_PROJECT_MIN_COMPRESSED  4096
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBinProjectBlock::CBinProjectBlock(void)
+{
+    Tag = 0;
+    Flags = 0;
+    Size = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBinProjectFile::CBinProjectFile(void)
+{
+    Compression = true;
+}
+
+//------------------------------------------------------------------------------
+
+void CBinProjectFile::SetCompression(bool set)
+{
+    Compression = set;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CBinProjectFile::AddBlock(quint32 tag,const QByteArray& data)
+{
+    CBinProjectBlock block;
+    block.Tag = tag;
+    block.Size = data.size();
+    block.Data = data;
+
+    if( Compression && (data.size() >= BIN_PROJECT_MIN_COMPRESSED) ){
+        QByteArray cdata = qCompress(data);
+        // keep uncompressed data if the compression does not help
+        if( cdata.size() < data.size() ){
+            block.Data = cdata;
+            block.Flags |= BIN_PROJECT_COMPRESSED;
+        }
+    }
+
+    Blocks.append(block);
+    return(Blocks.count() - 1);
+}
+
+//------------------------------------------------------------------------------
+
+void CBinProjectFile::Clear(void)
+{
+    Blocks.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CBinProjectFile::GetNumberOfBlocks(void) const
+{
+    return(Blocks.count());
+}
+
+//------------------------------------------------------------------------------
+
+quint32 CBinProjectFile::GetBlockTag(int index) const
+{
+    if( (index < 0) || (index >= Blocks.count()) ) return(0);
+    return(Blocks.at(index).Tag);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinProjectFile::GetBlockData(int index,QByteArray& data) const
+{
+    if( (index < 0) || (index >= Blocks.count()) ){
+        ES_ERROR("block index out of range");
+        return(false);
+    }
+
+    const CBinProjectBlock& block = Blocks.at(index);
+    if( block.Flags & BIN_PROJECT_COMPRESSED ){
+        data = qUncompress(block.Data);
+    } else {
+        data = block.Data;
+    }
+
+    if( (quint64)data.size() != block.Size ){
+        ES_ERROR("corrupted block data");
+        data.clear();
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int CBinProjectFile::FindBlock(quint32 tag) const
+{
+    for(int i=0; i < Blocks.count(); i++){
+        if( Blocks.at(i).Tag == tag ) return(i);
+    }
+    return(-1);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CBinProjectFile::Save(const CFileName& name)
+{
+    QFile file(QString(name));
+    if( file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false ){
+        CSmallString error;
+        error << "unable to create binary project file '" << name << "'";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    QDataStream str(&file);
+    str.setByteOrder(QDataStream::LittleEndian);
+
+    str.writeRawData(BIN_PROJECT_MAGIC,8);
+    str << (quint32)BIN_PROJECT_VERSION;
+    str << (quint32)Blocks.count();
+
+    foreach(CBinProjectBlock block, Blocks){
+        str << block.Tag << block.Flags << block.Size << (quint64)block.Data.size();
+        str.writeRawData(block.Data.constData(),block.Data.size());
+    }
+
+    if( str.status() != QDataStream::Ok ){
+        ES_ERROR("unable to write binary project file");
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinProjectFile::Load(const CFileName& name)
+{
+    Blocks.clear();
+
+    QFile file(QString(name));
+    if( file.open(QIODevice::ReadOnly) == false ){
+        CSmallString error;
+        error << "unable to open binary project file '" << name << "'";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    QDataStream str(&file);
+    str.setByteOrder(QDataStream::LittleEndian);
+
+    char    magic[8];
+    quint32 version = 0;
+    quint32 nblocks = 0;
+
+    if( (str.readRawData(magic,8) != 8) || (memcmp(magic,BIN_PROJECT_MAGIC,8) != 0) ){
+        ES_ERROR("not a binary project file");
+        return(false);
+    }
+
+    str >> version >> nblocks;
+    if( version != BIN_PROJECT_VERSION ){
+        ES_ERROR("unsupported version of binary project file");
+        return(false);
+    }
+
+    for(quint32 i=0; i < nblocks; i++){
+        CBinProjectBlock block;
+        quint64 stored = 0;
+        str >> block.Tag >> block.Flags >> block.Size >> stored;
+        if( (str.status() != QDataStream::Ok) || (stored > (quint64)(file.size() - file.pos())) ){
+            ES_ERROR("corrupted binary project file");
+            Blocks.clear();
+            return(false);
+        }
+        block.Data.resize(stored);
+        if( str.readRawData(block.Data.data(),stored) != (int)stored ){
+            ES_ERROR("premature end of binary project file");
+            Blocks.clear();
+            return(false);
+        }
+        Blocks.append(block);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinProjectFile::IsBinProjectFile(const CFileName& name)
+{
+    QFile file(QString(name));
+    if( file.open(QIODevice::ReadOnly) == false ) return(false);
+
+    char magic[8];
+    if( file.read(magic,8) != 8 ) return(false);
+    return(memcmp(magic,BIN_PROJECT_MAGIC,8) == 0);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,126 @@
+#ifndef BinProjectFileH
+#define BinProjectFileH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QList>
+#include <QByteArray>
+
+// -----------------------------------------------------------------------------
+
+class CFileName;
+
+// -----------------------------------------------------------------------------
+
+// binary project file (.npb)
+// header:
+//   char[8]    magic "NEMPRJB1"
+//   uint32     version
+//   uint32     number of blocks
+// block:
+//   uint32     tag
+//   uint32     flags
+//   uint64     size of uncompressed data
+//   uint64     size of stored data
+//   data
+// all numbers are little endian
+
+#define BIN_PROJECT_MAGIC           "NEMPRJB1"
+#define BIN_PROJECT_VERSION         1
+
+// block tags
+#define BIN_PROJECT_XML             1   // project XML document
+#define BIN_PROJECT_STRUCTURE       2   // residues, atoms, and bonds of one structure
+
+// block flags
+#define BIN_PROJECT_COMPRESSED      0x00000001
+
+// -----------------------------------------------------------------------------
+
+/// data block of binary project file
+
+class NEMESIS_CORE_PACKAGE CBinProjectBlock {
+public:
+    CBinProjectBlock(void);
+public:
+    quint32     Tag;
+    quint32     Flags;
+    quint64     Size;   // size of uncompressed data
+    QByteArray  Data;   // stored data
+};
+
+// -----------------------------------------------------------------------------
+
+///  container of binary project file
+/*! the project XML document is stored in one block, bulk data
+    (residues, atoms, bonds) are stored in blocks of packed columns,
+    blocks can be compressed by zlib
+*/
+
+class NEMESIS_CORE_PACKAGE CBinProjectFile {
+public:
+// constructor -----------------------------------------------------------------
+    CBinProjectFile(void);
+
+// setup methods ---------------------------------------------------------------
+    /// compress blocks added later
+    void SetCompression(bool set);
+
+// executive methods -----------------------------------------------------------
+    /// add block, it returns block index
+    int AddBlock(quint32 tag,const QByteArray& data);
+
+    /// remove all blocks
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get number of blocks
+    int GetNumberOfBlocks(void) const;
+
+    /// get block tag
+    quint32 GetBlockTag(int index) const;
+
+    /// get uncompressed block data
+    bool GetBlockData(int index,QByteArray& data) const;
+
+    /// find the first block with given tag, it returns -1 if not found
+    int FindBlock(quint32 tag) const;
+
+// input/output methods --------------------------------------------------------
+    /// write all blocks to the file
+    bool Save(const CFileName& name);
+
+    /// read all blocks from the file
+    bool Load(const CFileName& name);
+
+    /// is file binary project file?
+    static bool IsBinProjectFile(const CFileName& name);
+
+// section of private data -----------------------------------------------------
+private:
+    bool                        Compression;
+    QList<CBinProjectBlock>     Blocks;
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
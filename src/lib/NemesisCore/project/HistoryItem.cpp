@@ -89,6 +89,13 @@ void CHistoryItem::ReverseDirection(void)
 
 //------------------------------------------------------------------------------
 
+bool CHistoryItem::MergeWith(CHistoryItem* p_item)
+{
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
 EHistoryItemDirection CHistoryItem::GetCurrentDirection(void) const
 {
     return(CurrentDirection);
@@ -101,6 +108,13 @@ CProject* CHistoryItem::GetProject(void) const
     return(Project);
 }
 
+//------------------------------------------------------------------------------
+
+qint64 CHistoryItem::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -36,6 +36,14 @@ class CXMLElement;
 
 //------------------------------------------------------------------------------
 
+/// approximate size of item without bulk data (including QObject overhead)
+#define HISTORY_ITEM_SIZE           256
+
+/// approximate size of object stored in the item as XML element
+#define HISTORY_XML_ELEMENT_SIZE    1024
+
+//------------------------------------------------------------------------------
+
 /// direction of change
 enum EHistoryItemDirection {
     EHID_FORWARD,       // change is executed in forward direction
@@ -73,6 +81,10 @@ public:
     /// perform the change in the backward direction
     virtual void Backward(void)=0;
 
+    /// merge the following change into this item
+    /*! it returns true if p_item is merged and can be destroyed */
+    virtual bool MergeWith(CHistoryItem* p_item);
+
 // information methods ---------------------------------------------------------
     /// get current applied direction of the change
     EHistoryItemDirection GetCurrentDirection(void) const;
@@ -80,6 +92,9 @@ public:
     /// get project
     CProject* GetProject(void) const;
 
+    /// get approximate size of memory occupied by the item in bytes
+    virtual qint64 GetMemoryUsage(void);
+
 // input/output methods --------------------------------------------------------
     /// load data
     virtual void LoadData(CXMLElement* p_ele);
@@ -30,6 +30,8 @@
 #include <XMLElement.hpp>
 
 #include <HistoryList.hpp>
+#include <QTemporaryFile>
+#include <QDir>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -62,6 +64,9 @@ CHistoryList::CHistoryList(CProObject* p_parent,bool no_index)
     CurrentChangeLevel = EHCL_NONE;
     RedoStatus = false;
 
+    MemoryBudget = HISTORY_MEMORY_BUDGET;
+    SpillFile = NULL;
+
     EnableDebug = false;
     ProjectID = ProjectCounter.GetIndex();
     ActionID = 0;
@@ -71,6 +76,11 @@ CHistoryList::CHistoryList(CProObject* p_parent,bool no_index)
 
 CHistoryList::~CHistoryList(void)
 {
+    // nodes do not access the spill file during destruction
+    if( SpillFile != NULL ){
+        delete SpillFile;
+        SpillFile = NULL;
+    }
 }
 
 //==============================================================================
@@ -100,6 +110,14 @@ void CHistoryList::SetDepthOfBuffer(int depth)
 
 // -----------------------------------------------------------------------------
 
+void CHistoryList::SetMemoryBudget(qint64 size)
+{
+    MemoryBudget = size;
+    EnforceMemoryBudget();
+}
+
+// -----------------------------------------------------------------------------
+
 void CHistoryList::SetLockModeLevels(const CLockLevels& levels)
 {
     LockModeLevels = levels;
@@ -238,6 +256,25 @@ QString CHistoryList::GetRedoDescr(int i,bool short_ver)
     return(p_hist->GetShortDescription());
 }
 
+//---------------------------------------------------------------------------
+
+qint64 CHistoryList::GetMemoryBudget(void) const
+{
+    return(MemoryBudget);
+}
+
+//---------------------------------------------------------------------------
+
+qint64 CHistoryList::GetMemoryUsage(void)
+{
+    qint64 size = 0;
+    foreach(QObject* p_qobj,children()) {
+        CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(p_qobj);
+        if( p_node != NULL ) size += p_node->GetMemoryUsage();
+    }
+    return(size);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -294,6 +331,7 @@ void CHistoryList::EndChange(void)
     }
     if( RegHistories.NumOfMembers() == 0 ) {
         WriteDebugData();
+        EnforceMemoryBudget();
         emit OnHistoryChanged(EHCM_BUFFER);
     }
 }
@@ -339,12 +377,18 @@ bool CHistoryList::Undo(int i)
             if( changed ) emit OnHistoryChanged(EHCM_REDO);
             return(false);
         }
+        if( p_history->Unpack() == false ){
+            ES_ERROR("unable to restore change from history");
+            if( changed ) emit OnHistoryChanged(EHCM_UNDO);
+            return(false);
+        }
         if( p_history != NULL ) p_history->MakeChange();
 
         NumOfRedo++;
         changed = true;
     }
 
+    EnforceMemoryBudget();
     emit OnHistoryChanged(EHCM_UNDO);
 
     return(true);
@@ -377,6 +421,11 @@ bool CHistoryList::Redo(int i)
             if( changed ) emit OnHistoryChanged(EHCM_REDO);
             return(false);
         }
+        if( p_history->Unpack() == false ){
+            ES_ERROR("unable to restore change from history");
+            if( changed ) emit OnHistoryChanged(EHCM_REDO);
+            return(false);
+        }
 
         if( p_history != NULL ) p_history->MakeChange();
 
@@ -384,6 +433,7 @@ bool CHistoryList::Redo(int i)
         changed = true;
     }
 
+    EnforceMemoryBudget();
     emit OnHistoryChanged(EHCM_REDO);
     return(true);
 }
@@ -402,11 +452,63 @@ void CHistoryList::ClearHistory(void)
     NumOfRedo = 0;
     RedoStatus = false;
 
+    // nothing is spilled now
+    if( SpillFile != NULL ){
+        delete SpillFile;
+        SpillFile = NULL;
+    }
+
     emit OnHistoryChanged(EHCM_BUFFER);
 }
 
 //------------------------------------------------------------------------------
 
+CHistoryNode* CHistoryList::GetLastChange(void)
+{
+    if( RegHistories.NumOfMembers() > 0 ) return(NULL);
+    if( RedoStatus && (NumOfRedo > 0) ) return(NULL);
+    if( children().count() == 0 ) return(NULL);
+
+    CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(children().last());
+    if( (p_node == NULL) || p_node->IsPacked() ) return(NULL);
+    return(p_node);
+}
+
+//------------------------------------------------------------------------------
+
+bool CHistoryList::MergeLastChange(void)
+{
+    CHistoryNode* p_last = GetLastChange();
+    if( p_last == NULL ) return(false);
+
+    int count = children().count();
+    if( count < 2 ) return(false);
+    CHistoryNode* p_prev = dynamic_cast<CHistoryNode*>(children().at(count-2));
+    if( p_prev == NULL ) return(false);
+
+    if( p_last->GetShortDescription() != p_prev->GetShortDescription() ) return(false);
+    if( p_last->GetChangeLevel() != p_prev->GetChangeLevel() ) return(false);
+
+    // the previous change could be packed by EnforceMemoryBudget
+    // when the last change was ended
+    if( p_prev->Unpack() == false ) return(false);
+
+    if( (p_last->children().count() != 1) || (p_prev->children().count() != 1) ) return(false);
+
+    CHistoryItem* p_litem = static_cast<CHistoryItem*>(p_last->children().first());
+    CHistoryItem* p_pitem = static_cast<CHistoryItem*>(p_prev->children().first());
+    if( p_litem->GetCurrentDirection() != p_pitem->GetCurrentDirection() ) return(false);
+    if( p_pitem->MergeWith(p_litem) == false ) return(false);
+
+    delete p_last;
+    p_prev->ItemsChanged();
+
+    emit OnHistoryChanged(EHCM_BUFFER);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 void CHistoryList::LoadActionAndExecute(CXMLElement* p_ele)
 {
     if( p_ele == NULL ){
@@ -454,6 +556,50 @@ void CHistoryList::SaveLastAction(CXMLElement* p_ele)
 
 //------------------------------------------------------------------------------
 
+void CHistoryList::EnforceMemoryBudget(void)
+{
+    // changes next to the current position
+    int redotop = children().count();
+    if( RedoStatus ) redotop -= NumOfRedo;
+
+    // compress large older changes
+    qint64 total = 0;
+    for(int i=0; i < children().count(); i++){
+        CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(children().at(i));
+        if( p_node == NULL ) continue;
+        if( (i != redotop - 1) && (i != redotop) && (p_node->IsPacked() == false)
+            && (p_node->GetMemoryUsage() >= HISTORY_PACK_THRESHOLD) ){
+            p_node->Pack();
+        }
+        total += p_node->GetMemoryUsage();
+    }
+
+    if( total <= MemoryBudget ) return;
+
+    // spill the oldest compressed changes to disk
+    for(int i=0; (i < children().count()) && (total > MemoryBudget); i++){
+        CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(children().at(i));
+        if( p_node == NULL ) continue;
+        if( (p_node->IsPacked() == false) || p_node->IsSpilled() ) continue;
+
+        if( SpillFile == NULL ){
+            SpillFile = new QTemporaryFile(QDir::temp().filePath("nemesis-history-XXXXXX"));
+            if( SpillFile->open() == false ){
+                ES_ERROR("unable to create history spill file");
+                delete SpillFile;
+                SpillFile = NULL;
+                return;
+            }
+        }
+
+        qint64 size = p_node->GetMemoryUsage();
+        if( p_node->Spill(SpillFile) == false ) return;
+        total -= size - p_node->GetMemoryUsage();
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void CHistoryList::WriteDebugData(void)
 {
     if( ! EnableDebug ) return;
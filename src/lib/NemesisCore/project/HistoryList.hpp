@@ -29,6 +29,18 @@
 
 //------------------------------------------------------------------------------
 
+class QTemporaryFile;
+
+//------------------------------------------------------------------------------
+
+/// default memory budget of history in bytes
+#define HISTORY_MEMORY_BUDGET       (256*1024*1024)
+
+/// changes larger than this size are compressed when they become older
+#define HISTORY_PACK_THRESHOLD      (64*1024)
+
+//------------------------------------------------------------------------------
+
 enum EHistoryChangeMessage {
     EHCM_UNDO,          // undo executed
     EHCM_REDO,          // redo executed
@@ -51,6 +63,9 @@ public:
     /// setup the max number of registered changes
     void SetDepthOfBuffer(int depth);
 
+    /// setup memory budget in bytes, older changes are spilled to disk above it
+    void SetMemoryBudget(qint64 size);
+
     /// set lock levelw
     void SetLockModeLevels(const CLockLevels& levels);
 
@@ -91,6 +106,12 @@ public:
     /// return redo description
     QString GetRedoDescr(int i,bool short_ver=true);
 
+    /// return memory budget in bytes
+    qint64 GetMemoryBudget(void) const;
+
+    /// get approximate size of memory occupied by recorded changes
+    qint64 GetMemoryUsage(void);
+
 // executive methods ----------------------------------------------------------
     /// begin change recording
     bool BeginChange(EHistoryChangeLevel lockmodelevel);
@@ -110,6 +131,18 @@ public:
     /// remove all history nodes
     void ClearHistory(void);
 
+    /// get the last recorded change if it can be still modified
+    /*! NULL is returned if the change is being recorded, it was undone,
+        or it is packed
+    */
+    CHistoryNode* GetLastChange(void);
+
+    /// merge the last change into the previous one
+    /*! both changes must have the same description and only one item,
+        see CHistoryItem::MergeWith
+    */
+    bool MergeLastChange(void);
+
 // input/output methods --------------------------------------------------------
     /// load action and execute it
     void LoadActionAndExecute(CXMLElement* p_ele);
@@ -131,6 +164,15 @@ private:
     int                         NumOfMaxChanges;    // max number of allowed changes
     CSimpleList<CHistoryNode>   RegHistories;       // list of changes in BeginChange/EndChange
 
+// memory management ----------------------------
+    qint64                  MemoryBudget;       // max memory occupied by changes
+    QTemporaryFile*         SpillFile;          // changes spilled to disk
+
+    /// compress older changes and spill them to disk if budget is exceeded
+    /*! changes next to the undo/redo position are always kept unpacked
+    */
+    void EnforceMemoryBudget(void);
+
 // debug subsystem -------------------------------
     bool                    EnableDebug;
     int                     ProjectID;
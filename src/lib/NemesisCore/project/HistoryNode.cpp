@@ -29,6 +29,10 @@
 #include <PluginDatabase.hpp>
 #include <ErrorSystem.hpp>
 #include <XMLElement.hpp>
+#include <XMLDocument.hpp>
+#include <XMLPrinter.hpp>
+#include <XMLParser.hpp>
+#include <QFile>
 
 //------------------------------------------------------------------------------
 
@@ -58,6 +62,11 @@ CHistoryNode::CHistoryNode(CProject* p_project)
     : CHistoryItem(&HistoryNodeObject,p_project,EHID_FORWARD)
 {
     ChangeLevel = EHCL_CORE_NODE;
+    Packed = false;
+    SpillFile = NULL;
+    SpillOffset = -1;
+    SpillSize = 0;
+    MemoryUsage = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -66,6 +75,11 @@ CHistoryNode::CHistoryNode(CProject* p_project,const QString& short_descr,const
     : CHistoryItem(&HistoryNodeObject,p_project,EHID_FORWARD)
 {
     ChangeLevel = EHCL_CORE_NODE;
+    Packed = false;
+    SpillFile = NULL;
+    SpillOffset = -1;
+    SpillSize = 0;
+    MemoryUsage = -1;
     SetShortDescription(short_descr);
     SetLongDescription(long_descr);
 }
@@ -97,6 +111,7 @@ void CHistoryNode::SetLongDescription(const QString& desc)
 void CHistoryNode::Register(CHistoryItem* p_data)
 {
     p_data->setParent(this);
+    MemoryUsage = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -105,6 +120,9 @@ bool CHistoryNode::IsChangeAllowed(const CLockLevels& locks)
 {
     if( locks.testFlag(ChangeLevel) ) return(false);
 
+    // subnodes are not available
+    if( Packed ) return( (locks & PackedLevels) == 0 );
+
     foreach(QObject* p_qobj,children()){
         CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(p_qobj);
         if( p_node != NULL ){
@@ -145,12 +163,212 @@ void CHistoryNode::SetChangeLevel(EHistoryChangeLevel level)
     ChangeLevel = level;
 }
 
+//------------------------------------------------------------------------------
+
+void CHistoryNode::ItemsChanged(void)
+{
+    MemoryUsage = -1;
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CHistoryNode::GetMemoryUsage(void)
+{
+    if( MemoryUsage >= 0 ) return(MemoryUsage);
+
+    qint64 size = HISTORY_ITEM_SIZE;
+    size += (ShortDescription.size() + LongDescription.size())*sizeof(QChar);
+
+    if( Packed ){
+        size += PackedData.size();
+    } else {
+        foreach(QObject* p_qobj,children()){
+            CHistoryItem* p_item = static_cast<CHistoryItem*>(p_qobj);
+            size += p_item->GetMemoryUsage();
+        }
+    }
+
+    MemoryUsage = size;
+    return(MemoryUsage);
+}
+
+//------------------------------------------------------------------------------
+
+bool CHistoryNode::IsPacked(void) const
+{
+    return(Packed);
+}
+
+//------------------------------------------------------------------------------
+
+bool CHistoryNode::IsSpilled(void) const
+{
+    return(SpillOffset >= 0);
+}
+
+//------------------------------------------------------------------------------
+
+void CHistoryNode::GetChangeLevels(CLockLevels& levels)
+{
+    levels |= ChangeLevel;
+
+    if( Packed ){
+        levels |= PackedLevels;
+        return;
+    }
+
+    foreach(QObject* p_qobj,children()){
+        CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(p_qobj);
+        if( p_node != NULL ) p_node->GetChangeLevels(levels);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CHistoryNode::Pack(void)
+{
+    if( Packed ) return(true);
+
+    // save items
+    CXMLDocument xml_doc;
+    CXMLElement* p_ele = xml_doc.CreateChildElement("items");
+
+    try {
+        foreach(QObject* p_qobj,children()){
+            CHistoryItem* p_item = static_cast<CHistoryItem*>(p_qobj);
+            CXMLElement* p_sele = p_ele->CreateChildElement("item");
+            p_item->SaveData(p_sele);
+        }
+    } catch(std::exception& e) {
+        ES_ERROR_FROM_EXCEPTION("unable to save history items",e);
+        return(false);
+    }
+
+    CXMLPrinter xml_printer;
+    xml_printer.SetPrintedXMLNode(&xml_doc);
+
+    unsigned int length = 0;
+    unsigned char* p_data = xml_printer.Print(length);
+    if( p_data == NULL ){
+        ES_ERROR("unable to print history items");
+        return(false);
+    }
+    PackedData = qCompress(p_data,length);
+    delete[] p_data;
+
+    // lock levels of subnodes must be still available
+    PackedLevels = CLockLevels();
+    foreach(QObject* p_qobj,children()){
+        CHistoryNode* p_node = dynamic_cast<CHistoryNode*>(p_qobj);
+        if( p_node != NULL ) p_node->GetChangeLevels(PackedLevels);
+    }
+
+    // destroy items
+    foreach(QObject* p_qobj,children()){
+        delete p_qobj;
+    }
+
+    Packed = true;
+    MemoryUsage = -1;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CHistoryNode::Spill(QFile* p_file)
+{
+    if( (Packed == false) || (p_file == NULL) ) return(false);
+    if( SpillOffset >= 0 ) return(true);
+
+    qint64 pos = p_file->size();
+    if( (p_file->seek(pos) == false) || (p_file->write(PackedData) != PackedData.size()) ){
+        ES_ERROR("unable to write history spill file");
+        return(false);
+    }
+
+    SpillFile = p_file;
+    SpillOffset = pos;
+    SpillSize = PackedData.size();
+    PackedData.clear();
+    MemoryUsage = -1;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CHistoryNode::Unpack(void)
+{
+    if( Packed == false ) return(true);
+
+    // get compressed data
+    if( SpillOffset >= 0 ){
+        if( (SpillFile == NULL) || (SpillFile->seek(SpillOffset) == false) ){
+            ES_ERROR("unable to read history spill file");
+            return(false);
+        }
+        PackedData = SpillFile->read(SpillSize);
+        if( PackedData.size() != SpillSize ){
+            ES_ERROR("unable to read history spill file");
+            PackedData.clear();
+            return(false);
+        }
+    }
+
+    QByteArray data = qUncompress(PackedData);
+    if( data.isEmpty() ){
+        ES_ERROR("corrupted history data");
+        if( SpillOffset >= 0 ) PackedData.clear();
+        return(false);
+    }
+
+    // restore items
+    CXMLDocument xml_doc;
+    CXMLParser   xml_parser;
+    xml_parser.SetOutputXMLNode(&xml_doc);
+
+    if( xml_parser.Parse(data.data(),data.length()) == false ){
+        ES_ERROR("unable to parse history items");
+        if( SpillOffset >= 0 ) PackedData.clear();
+        return(false);
+    }
+
+    CXMLElement* p_ele = xml_doc.GetFirstChildElement("items");
+
+    try {
+        if( p_ele == NULL ){
+            LOGIC_ERROR("items element not found");
+        }
+        LoadItems(p_ele);
+    } catch(std::exception& e) {
+        ES_ERROR_FROM_EXCEPTION("unable to load history items",e);
+        foreach(QObject* p_qobj,children()){
+            delete p_qobj;
+        }
+        if( SpillOffset >= 0 ) PackedData.clear();
+        return(false);
+    }
+
+    // space in the spill file is not reused
+    Packed = false;
+    PackedData.clear();
+    PackedLevels = CLockLevels();
+    SpillFile = NULL;
+    SpillOffset = -1;
+    SpillSize = 0;
+    MemoryUsage = -1;
+    return(true);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
 void CHistoryNode::Backward(void)
 {
+    if( Unpack() == false ) return;
+
     QListIterator<QObject*> it(children());
     it.toBack();
     while( it.hasPrevious() ){
@@ -164,6 +382,8 @@ void CHistoryNode::Backward(void)
 
 void CHistoryNode::Forward(void)
 {
+    if( Unpack() == false ) return;
+
     foreach(QObject* p_qobj,children()){
         CHistoryItem* p_item = static_cast<CHistoryItem*>(p_qobj);
         p_item->MakeChange();
@@ -174,6 +394,10 @@ void CHistoryNode::Forward(void)
 
 void CHistoryNode::ReverseDirection(void)
 {
+    if( Unpack() == false ){
+        LOGIC_ERROR("unable to unpack history items");
+    }
+
     CHistoryItem::ReverseDirection();
 
     foreach(QObject* p_qobj,children()){
@@ -198,20 +422,29 @@ void CHistoryNode::LoadData(CXMLElement* p_ele)
     // header ------------------------------------
     p_ele->GetAttribute("sd",ShortDescription);
     p_ele->GetAttribute("ld",LongDescription);
+    p_ele->GetAttribute<EHistoryChangeLevel>("cl",ChangeLevel);
 
     // load individual items ---------------------
+    LoadItems(p_ele);
+}
+
+//------------------------------------------------------------------------------
+
+void CHistoryNode::LoadItems(CXMLElement* p_ele)
+{
     CXMLElement* p_sele;
     p_sele = p_ele->GetFirstChildElement("item");
 
     while( p_sele != NULL ) {
         CExtUUID ext_uuid;
-        if( ext_uuid.GetValue(p_sele,"uuid") ){
+        if( ext_uuid.GetValue(p_sele,"uuid") == false ){
             LOGIC_ERROR("uuid not defined");
         }
         CHistoryItem* p_item = static_cast<CHistoryItem*>(PluginDatabase.CreateObject(ext_uuid,GetProject()));
         if( p_item == NULL ){
             LOGIC_ERROR("unable to create object");
         }
+        Register(p_item);
         p_item->LoadData(p_sele);
         p_sele = p_sele->GetNextSiblingElement("item");
     }
@@ -225,12 +458,17 @@ void CHistoryNode::SaveData(CXMLElement* p_ele)
         INVALID_ARGUMENT("p_ele is NULL");
     }
 
+    if( Unpack() == false ){
+        LOGIC_ERROR("unable to unpack history items");
+    }
+
     // save core data ----------------------------
     CHistoryItem::SaveData(p_ele);
 
     // header ------------------------------------
     if( ! ShortDescription.isEmpty() ) p_ele->SetAttribute("sd",ShortDescription);
     if( ! LongDescription.isEmpty() ) p_ele->SetAttribute("ld",LongDescription);
+    p_ele->SetAttribute("cl",ChangeLevel);
 
     // save individual items ---------------------
     foreach(QObject* p_qobj,children()){
@@ -25,6 +25,11 @@
 #include <NemesisCoreMainHeader.hpp>
 #include <HistoryItem.hpp>
 #include <QFlags>
+#include <QByteArray>
+
+//------------------------------------------------------------------------------
+
+class QFile;
 
 //------------------------------------------------------------------------------
 
@@ -79,6 +84,9 @@ public:
     /// reverse the change direction
     virtual void ReverseDirection(void);
 
+    /// notify that registered items were modified
+    void ItemsChanged(void);
+
 // information methods ---------------------------------------------------------
     /// get current change level
     EHistoryChangeLevel GetChangeLevel(void);
@@ -92,12 +100,45 @@ public:
     /// get long description of change
     const QString& GetLongDescription(void) const;
 
+    /// get approximate size of memory occupied by the node and its items
+    virtual qint64 GetMemoryUsage(void);
+
+    /// are items packed?
+    bool IsPacked(void) const;
+
+    /// are packed items stored in the spill file?
+    bool IsSpilled(void) const;
+
 // section of private data -----------------------------------------------------
 private:
     EHistoryChangeLevel ChangeLevel;
     QString             ShortDescription;
     QString             LongDescription;
 
+    // memory management
+    bool                Packed;         // items are saved and compressed
+    QByteArray          PackedData;     // compressed items if they are not spilled
+    QFile*              SpillFile;      // file owned by CHistoryList
+    qint64              SpillOffset;    // position of compressed items in SpillFile
+    qint64              SpillSize;
+    CLockLevels         PackedLevels;   // change levels of packed subnodes
+    qint64              MemoryUsage;    // cached memory usage, -1 if not known
+
+    /// save and compress items, items are destroyed
+    bool Pack(void);
+
+    /// move packed items to the end of the spill file
+    bool Spill(QFile* p_file);
+
+    /// restore items from packed data or the spill file
+    bool Unpack(void);
+
+    /// collect change levels of the node and all subnodes
+    void GetChangeLevels(CLockLevels& levels);
+
+    /// create and register items from the XML element
+    void LoadItems(CXMLElement* p_ele);
+
 // executive methods -----------------------------------------------------------
     /// perform the change in the forward direction
     virtual void Forward(void);
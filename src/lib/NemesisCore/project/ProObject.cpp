@@ -441,6 +441,25 @@ void  CProObject::UnregisterAllRegisteredObjects(CHistoryNode* p_history)
 
 //------------------------------------------------------------------------------
 
+void  CProObject::RemoveChildren(const QSet<QObject*>& objects)
+{
+    if( objects.isEmpty() ) return;
+
+    // QObject looks up a removed child from the beginning of the list,
+    // thus all children are detached from the front and the remaining
+    // ones are attached again, both passes are linear
+    QObjectList kids = children();
+    foreach(QObject* p_obj, kids){
+        p_obj->setParent(NULL);
+    }
+    foreach(QObject* p_obj, kids){
+        if( objects.contains(p_obj) ) continue;
+        p_obj->setParent(this);
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void CProObject::RemoveFromRegistered(CProObject* p_object,
                                       CHistoryNode* p_history)
 {
@@ -29,6 +29,7 @@
 #include <XMLDocument.hpp>
 #include <ObjMetrics.hpp>
 #include <QFlags>
+#include <QSet>
 #include <HistoryNode.hpp>
 
 //------------------------------------------------------------------------------
@@ -198,6 +199,11 @@ public:
     /// unregister all registered objects - client side
     void  UnregisterAllRegisteredObjects(CHistoryNode* p_history=NULL);
 
+    /// detach children in one pass, they are not destroyed
+    /*! the order of remaining children is kept
+    */
+    void  RemoveChildren(const QSet<QObject*>& objects);
+
     /// remove object from registered objects - server side
     virtual void RemoveFromRegistered(CProObject* p_object,
                                       CHistoryNode* p_history);
@@ -251,6 +257,10 @@ private:
     CProObjectFlags     Flags;
 
     friend class CObjectDesigner;
+    friend class CStructureBulkData;
+    friend class CAtomList;
+    friend class CBondList;
+    friend class CSuperCellBuilder;
 };
 
 //------------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include <XMLDeclaration.hpp>
 #include <XMLComment.hpp>
 #include <XMLElement.hpp>
+#include <BinProjectFile.hpp>
 #include <SelectionList.hpp>
 #include <Graphics.hpp>
 #include <HistoryList.hpp>
@@ -69,6 +70,9 @@ CProject::CProject(CPluginObject* p_objectinfo,CExtComObject* p_parent)
     // generate unique ID - used for drag&drop
     ProjectID = QUuid::createUuid();
 
+    BinaryFormat = false;
+    BinProjectFile = NULL;
+
     // set default project flags
     SetFlag<EProjecFlag>(EPF_PERSISTENT_DESIGNERS,true);
     SetFlag<EProjecFlag>(EPF_PERSISTENT_DESKTOP,true);
@@ -170,21 +174,44 @@ bool CProject::SaveProject(void)
     // data
     CXMLElement* p_data = p_root->CreateChildElement("data");
 
+    // structures are saved into the binary file during SaveData
+    CBinProjectFile bin_file;
+    if( BinaryFormat ) BinProjectFile = &bin_file;
+
     try {
         SaveData(p_data);
     } catch(std::exception& e) {
+        BinProjectFile = NULL;
         ES_ERROR_FROM_EXCEPTION("unable to save",e);
         return(false);
     }
+    BinProjectFile = NULL;
 
     // save data to disk
     CXMLPrinter xml_printer;
 
     xml_printer.SetPrintedXMLNode(&xml_document);
 
-    if( xml_printer.Print(GetFullName()) == false ) {
-        ES_ERROR("unable to save XML file");
-        return(false);
+    if( BinaryFormat ){
+        // the rest of project is stored as embedded XML document
+        unsigned int length = 0;
+        unsigned char* p_xml = xml_printer.Print(length);
+        if( p_xml == NULL ){
+            ES_ERROR("unable to print XML document");
+            return(false);
+        }
+        bin_file.AddBlock(BIN_PROJECT_XML,QByteArray((const char*)p_xml,length));
+        delete[] p_xml;
+
+        if( bin_file.Save(GetFullName()) == false ) {
+            ES_ERROR("unable to save binary project file");
+            return(false);
+        }
+    } else {
+        if( xml_printer.Print(GetFullName()) == false ) {
+            ES_ERROR("unable to save XML file");
+            return(false);
+        }
     }
 
     SetFlag(EPOF_TMP_NAME,false);
@@ -199,6 +226,7 @@ bool CProject::SaveProjectAs(const CFileName& fullname)
 {
     ProjectPath = fullname.GetFileDirectory();
     SetName(QString(fullname.GetFileNameWithoutExt()));
+    BinaryFormat = fullname.GetFileNameExt() == ".npb";
     bool result  = SaveProject();
     Projects->EmitProjectNameChanged(this);
     return(result);
@@ -283,11 +311,26 @@ void CProject::ClearProject(void)
 
 const CFileName  CProject::GetFullName(void) const
 {
+    if( BinaryFormat ) return(ProjectPath / GetName() + ".npb");
     return(ProjectPath / GetName() + ".npr");
 }
 
 //---------------------------------------------------------------------------
 
+bool CProject::IsBinaryFormat(void) const
+{
+    return(BinaryFormat);
+}
+
+//---------------------------------------------------------------------------
+
+CBinProjectFile* CProject::GetBinProjectFile(void)
+{
+    return(BinProjectFile);
+}
+
+//---------------------------------------------------------------------------
+
 const CFileName& CProject::GetPath(void) const
 {
     return(ProjectPath);
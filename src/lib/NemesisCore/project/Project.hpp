@@ -37,6 +37,7 @@ class CProObject;
 class CStructure;
 class CGraph;
 class CXMLElement;
+class CBinProjectFile;
 class CHistoryList;
 class CSelectionList;
 class CGraphics;
@@ -134,7 +135,7 @@ public:
     /// save project
     bool SaveProject(void);
 
-    /// save project as
+    /// save project as, the format is determined by the extension (.npr or .npb)
     bool SaveProjectAs(const CFileName& fullname);
 
     /// close project
@@ -160,6 +161,12 @@ public:
     /// return full name of project including path
     const CFileName GetFullName(void) const;
 
+    /// is project saved in the binary format?
+    bool IsBinaryFormat(void) const;
+
+    /// binary project file which is being saved or loaded, NULL otherwise
+    CBinProjectFile* GetBinProjectFile(void);
+
     /// return name of project without path
     //this is inherited from CExtObject
     //const CSmallString& GetName(void) const;
@@ -294,6 +301,8 @@ public slots:
 private:
     CFileName               ProjectPath;
     QUuid                   ProjectID;      // unique project ID for drag&drop
+    bool                    BinaryFormat;   // .npb instead of .npr
+    CBinProjectFile*        BinProjectFile; // valid only during save or load
 // project subsystems ----------------------------
     CHistoryList*           History;
     CSelectionList*         Selection;
@@ -29,6 +29,7 @@
 #include <XMLDocument.hpp>
 #include <XMLParser.hpp>
 #include <XMLElement.hpp>
+#include <BinProjectFile.hpp>
 #include <CategoryUUID.hpp>
 #include <DesktopSystem.hpp>
 #include <NemesisOptions.hpp>
@@ -125,15 +126,34 @@ CProject* CProjectList::OpenProject(const CFileName& fullname)
     }
 
     // load project XML file
-    CXMLDocument xml_document;
-    CXMLParser   xml_parser;
+    CXMLDocument    xml_document;
+    CXMLParser      xml_parser;
+    CBinProjectFile bin_file;
 
     xml_parser.SetOutputXMLNode(&xml_document);
 
-    // parse XML document
-    if( xml_parser.Parse(fullname) == false ) {
-        ES_ERROR("unable to parse XML document");
-        return(NULL);
+    // binary project contains XML document as one of its blocks
+    bool binary = CBinProjectFile::IsBinProjectFile(fullname);
+    if( binary ){
+        QByteArray xml_data;
+        if( bin_file.Load(fullname) == false ) {
+            ES_ERROR("unable to load binary project file");
+            return(NULL);
+        }
+        if( bin_file.GetBlockData(bin_file.FindBlock(BIN_PROJECT_XML),xml_data) == false ) {
+            ES_ERROR("unable to get XML document from binary project file");
+            return(NULL);
+        }
+        if( xml_parser.Parse(xml_data.data(),xml_data.length()) == false ) {
+            ES_ERROR("unable to parse XML document");
+            return(NULL);
+        }
+    } else {
+        // parse XML document
+        if( xml_parser.Parse(fullname) == false ) {
+            ES_ERROR("unable to parse XML document");
+            return(NULL);
+        }
     }
 
     // open document comment
@@ -184,12 +204,14 @@ CProject* CProjectList::OpenProject(const CFileName& fullname)
 
     p_project->ProjectPath = fullname.GetFileDirectory();
     p_project->SetName(QString(fullname.GetFileNameWithoutExt()));
+    p_project->BinaryFormat = binary;
 
     // load default project desktop setup
     // it will be partially overwritten by p_project->LoadData(p_data);
     p_project->GetDesktop()->LoadDefaultDesktop();
 
     // load data
+    if( binary ) p_project->BinProjectFile = &bin_file;
     try {
         p_project->BeginLinkProcedure(0);
         p_project->LoadData(p_data);
@@ -199,6 +221,7 @@ CProject* CProjectList::OpenProject(const CFileName& fullname)
         delete p_project;
         return(NULL);
     }
+    p_project->BinProjectFile = NULL;
 
     p_project->SetFlag(EPOF_TMP_NAME,false);
     p_project->SetFlag(EPOF_PROJECT_CHANGED,false);
@@ -274,20 +297,26 @@ bool CProjectList::ProjectSaveAs(CProject* p_proj)
     if( p_proj == NULL ) return(false);
 
     QString title("Save Project - ");
+    QString filter;
     //TODO: title += p_proj->GetName().GetBuffer();
 
     QString filename = QFileDialog::getSaveFileName(NULL,
                        title,
                        (const char*)GlobalSetup->GetLastOpenFilePath(GenericProjectID),
-                       "Nemesis projects (*.npr)");
+                       "Nemesis projects (*.npr);;Nemesis binary projects (*.npb)",
+                       &filter);
 
     if( filename == NULL ) return(false); // no file was selected
 
     CFileName project_name(filename.toLatin1().constData());
 
-    // add extension if there is not ".npr"
-    if(project_name.GetFileNameExt() != ".npr") {
-        project_name += ".npr";
+    // add extension if there is not ".npr" or ".npb"
+    if( (project_name.GetFileNameExt() != ".npr") && (project_name.GetFileNameExt() != ".npb") ) {
+        if( filter.contains("*.npb") ){
+            project_name += ".npb";
+        } else {
+            project_name += ".npr";
+        }
     }
 
     // update last open path
@@ -26,6 +26,9 @@
 #include <TrajectoryList.hpp>
 #include <TrajectorySegment.hpp>
 #include <Snapshot.hpp>
+#include <PDBQTTrajSegmentModel.hpp>
+#include <PhysicalQuantities.hpp>
+#include <QHeaderView>
 
 #include "PODesignerDockingTabsResults.hpp"
 
@@ -61,6 +64,8 @@ CPODesignerDockingTabsResults::CPODesignerDockingTabsResults(QWidget* p_owner, C
             WidgetUI.posesOfResultsTV->resizeColumnToContents(i);
         }
     }
+    // poses are in the file order until the user sorts them
+    WidgetUI.posesOfResultsTV->header()->setSortIndicator(-1,Qt::AscendingOrder);
 
     OffsetOfSnapshots = 0;
     SliderUpdating = false;
@@ -76,6 +81,12 @@ CPODesignerDockingTabsResults::CPODesignerDockingTabsResults(QWidget* p_owner, C
     //------------------
     connect(WidgetUI.posesOfResultsTV,SIGNAL(clicked(const QModelIndex&)),
             this,SLOT(SnapshotsPosesClicked(const QModelIndex&)));
+    // pose filter - the score is shown and entered in energy units
+    WidgetUI.maxScoreSB->setPhysicalQuantity(PQ_ENERGY);
+    connect(WidgetUI.scoreFilterCB,SIGNAL(toggled(bool)),
+            this,SLOT(ScoreFilterChanged(void)));
+    connect(WidgetUI.maxScoreSB,SIGNAL(valueChanged(double)),
+            this,SLOT(ScoreFilterChanged(void)));
     // read and buttons activity response in snapshot view
     //------------------
     connect(DockingTrajectory,SIGNAL(OnSnapshotChanged(void)),
@@ -248,8 +259,13 @@ void CPODesignerDockingTabsResults::SnapshotsPosesClicked(const QModelIndex& ind
     long int p_snap_indx = 0;
     long int indx_curr_snap = 0;
 
-    // extract row form index
-    p_snap_indx = index.row() + 1;
+    // extract snapshot index, rows can be sorted and filtered
+    QVariant snap_indx = index.data(PDBQT_SNAPSHOT_INDEX_ROLE);
+    if( snap_indx.isValid() ){
+        p_snap_indx = snap_indx.toLongLong();
+    } else {
+        p_snap_indx = index.row() + 1;
+    }
 
     indx_curr_snap = DockingTrajectory->GetCurrentSnapshotIndex() + OffsetOfSnapshots;
 
@@ -260,6 +276,17 @@ void CPODesignerDockingTabsResults::SnapshotsPosesClicked(const QModelIndex& ind
 
 }
 
+//------------------------------------------------------------------------------
+
+void CPODesignerDockingTabsResults::ScoreFilterChanged(void)
+{
+    WidgetUI.maxScoreSB->setEnabled(WidgetUI.scoreFilterCB->isChecked());
+
+    CPDBQTTrajSegmentModel* p_model = dynamic_cast<CPDBQTTrajSegmentModel*>(PosesModel);
+    if( p_model == NULL ) return;
+    p_model->SetScoreFilter(WidgetUI.scoreFilterCB->isChecked(),WidgetUI.maxScoreSB->getInternalValue());
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
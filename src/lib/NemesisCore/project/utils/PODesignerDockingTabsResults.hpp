@@ -79,6 +79,7 @@ private slots:
     void UpdateResultsMenu(void);
 
     void SnapshotsPosesClicked(const QModelIndex& index);
+    void ScoreFilterChanged(void);
 
     void SliderValueChanged(int pos);
     void SpinBoxValueChanged(int pos);
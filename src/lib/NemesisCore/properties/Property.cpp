@@ -218,6 +218,13 @@ void CProperty::SetScalarValue(double value)
 
 //------------------------------------------------------------------------------
 
+bool CProperty::GetPropertyTerms(CPropertyTerms& terms)
+{
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
 double CProperty::GetGradient(QVector<CAtomGrad>& grads)
 {
     grads.resize(0);    // no gradients by default
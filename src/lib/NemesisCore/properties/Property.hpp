@@ -30,6 +30,7 @@
 class CPropertyList;
 class CPhysicalQuantity;
 class CStructure;
+class CPropertyTerms;
 
 // -----------------------------------------------------------------------------
 
@@ -112,6 +113,12 @@ public:
     /// set property value - scalar value (for trajectory update)
     virtual void SetScalarValue(double value);
 
+    /// get frame independent description of property
+    /*! it returns false if the property cannot be evaluated from snapshot
+        coordinates, see CTrajectoryAnalysis
+    */
+    virtual bool GetPropertyTerms(CPropertyTerms& terms);
+
 // input/output methods --------------------------------------------------------
     /// load atom data
     virtual void LoadData(CXMLElement* p_ele);
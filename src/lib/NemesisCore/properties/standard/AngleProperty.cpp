@@ -24,6 +24,7 @@
 #include <HistoryNode.hpp>
 #include <PropertyList.hpp>
 #include <PropertyAtomList.hpp>
+#include <PropertyTerms.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantity.hpp>
@@ -134,6 +135,13 @@ double CAngleProperty::GetScalarValue(void)
     CPoint coma = PointA->GetCOM();
     CPoint comb = PointB->GetCOM();
     CPoint comc = PointC->GetCOM();
+    return(GetAngleValue(coma,comb,comc));
+}
+
+//------------------------------------------------------------------------------
+
+double CAngleProperty::GetAngleValue(const CPoint& coma,const CPoint& comb,const CPoint& comc)
+{
     if( Square(coma-comb) == 0 ) return(0.0);
     if( Square(comc-comb) == 0 ) return(0.0);
     return(Angle(coma-comb,comc-comb));
@@ -141,6 +149,20 @@ double CAngleProperty::GetScalarValue(void)
 
 //------------------------------------------------------------------------------
 
+bool CAngleProperty::GetPropertyTerms(CPropertyTerms& terms)
+{
+    if( IsReady() == false ) return(false);
+
+    terms.SetType(EPTT_ANGLE);
+    terms.AddGroup(PointA);
+    terms.AddGroup(PointB);
+    terms.AddGroup(PointC);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 double CAngleProperty::GetGradient(QVector<CAtomGrad>& grads)
 {
     // point A
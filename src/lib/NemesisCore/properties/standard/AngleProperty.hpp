@@ -60,6 +60,12 @@ public:
     /// get property cartesian gradient
     virtual double GetGradient(QVector<CAtomGrad>& grads);
 
+    /// get frame independent description of property
+    virtual bool GetPropertyTerms(CPropertyTerms& terms);
+
+    /// get angle value for given COMs
+    static double GetAngleValue(const CPoint& coma,const CPoint& comb,const CPoint& comc);
+
     /// get point A
     CPropertyAtomList* GetPointA(void);
 
@@ -24,6 +24,7 @@
 #include <HistoryNode.hpp>
 #include <PropertyList.hpp>
 #include <PropertyAtomList.hpp>
+#include <PropertyTerms.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantity.hpp>
@@ -130,6 +131,19 @@ double CDistanceProperty::GetScalarValue(void)
 
 //------------------------------------------------------------------------------
 
+bool CDistanceProperty::GetPropertyTerms(CPropertyTerms& terms)
+{
+    if( IsReady() == false ) return(false);
+
+    terms.SetType(EPTT_DISTANCE);
+    terms.AddGroup(PointA);
+    terms.AddGroup(PointB);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 double CDistanceProperty::GetGradient(QVector<CAtomGrad>& grads)
 {
     // point A
@@ -24,6 +24,7 @@
 #include <HistoryNode.hpp>
 #include <PropertyList.hpp>
 #include <PropertyAtomList.hpp>
+#include <PropertyTerms.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantity.hpp>
@@ -134,6 +135,19 @@ double CDistanceToPositionProperty::GetScalarValue(void)
 
 //------------------------------------------------------------------------------
 
+bool CDistanceToPositionProperty::GetPropertyTerms(CPropertyTerms& terms)
+{
+    if( IsReady() == false ) return(false);
+
+    terms.SetType(EPTT_DISTANCE_TO_POSITION);
+    terms.AddGroup(PointA);
+    terms.Position = PointB;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 double CDistanceToPositionProperty::GetGradient(QVector<CAtomGrad>& grads)
 {
     // gradient of point A
@@ -62,6 +62,9 @@ public:
     /// get property cartesian gradient
     virtual double GetGradient(QVector<CAtomGrad>& grads);
 
+    /// get frame independent description of property
+    virtual bool GetPropertyTerms(CPropertyTerms& terms);
+
     /// get point A
     CPropertyAtomList* GetPointA(void);
 
@@ -24,6 +24,7 @@
 #include <HistoryNode.hpp>
 #include <PropertyList.hpp>
 #include <PropertyAtomList.hpp>
+#include <PropertyTerms.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantity.hpp>
@@ -165,6 +166,14 @@ double CTorsionProperty::GetScalarValue(void)
     CPoint dcom = PointD->GetCOM(dtotmass);
     if( dtotmass == 0.0 ) return(0.0);
 
+    return(GetTorsionValue(acom,bcom,ccom,dcom));
+}
+
+//------------------------------------------------------------------------------
+
+double CTorsionProperty::GetTorsionValue(const CPoint& acom,const CPoint& bcom,
+                                         const CPoint& ccom,const CPoint& dcom)
+{
     double rijx = acom.x - bcom.x;
     double rijy = acom.y - bcom.y;
     double rijz = acom.z - bcom.z;
@@ -222,6 +231,21 @@ double CTorsionProperty::GetScalarValue(void)
 
 //------------------------------------------------------------------------------
 
+bool CTorsionProperty::GetPropertyTerms(CPropertyTerms& terms)
+{
+    if( IsReady() == false ) return(false);
+
+    terms.SetType(EPTT_TORSION);
+    terms.AddGroup(PointA);
+    terms.AddGroup(PointB);
+    terms.AddGroup(PointC);
+    terms.AddGroup(PointD);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 double CTorsionProperty::GetGradient(QVector<CAtomGrad>& grads)
 {
     // point A
@@ -60,6 +60,13 @@ public:
     /// get property cartesian gradient
     virtual double GetGradient(QVector<CAtomGrad>& grads);
 
+    /// get frame independent description of property
+    virtual bool GetPropertyTerms(CPropertyTerms& terms);
+
+    /// get torsion value for given COMs
+    static double GetTorsionValue(const CPoint& acom,const CPoint& bcom,
+                                  const CPoint& ccom,const CPoint& dcom);
+
     /// get point A
     CPropertyAtomList* GetPointA(void);
 
@@ -0,0 +1,142 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <PropertyTerms.hpp>
+#include <PropertyAtomList.hpp>
+#include <Atom.hpp>
+#include <PeriodicTable.hpp>
+#include <ErrorSystem.hpp>
+#include <AngleProperty.hpp>
+#include <TorsionProperty.hpp>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CPropertyTerms::CPropertyTerms(void)
+{
+    Type = EPTT_NONE;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CPropertyTerms::SetType(EPropertyTermsType type)
+{
+    Type = type;
+    TrajIndexes.clear();
+    Masses.clear();
+    Positions.clear();
+    GroupEnds.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CPropertyTerms::AddGroup(CPropertyAtomList* p_list)
+{
+    if( p_list == NULL ){
+        INVALID_ARGUMENT("p_list is NULL");
+    }
+
+    foreach(CAtom* p_atom, p_list->GetAtoms()){
+        TrajIndexes.append(p_atom->GetTrajIndex());
+        Masses.append(PeriodicTable.GetMass(p_atom->GetZ()));
+        Positions.append(p_atom->GetPos());
+    }
+    GroupEnds.append(TrajIndexes.count());
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+double CPropertyTerms::GetValue(CSimpleVector<CPoint>& crds) const
+{
+    double  ma,mb,mc,md;
+
+    switch(Type){
+        case EPTT_DISTANCE:
+            if( GroupEnds.count() != 2 ) return(0.0);
+            return( Size(GetCOM(0,crds,ma) - GetCOM(1,crds,mb)) );
+
+        case EPTT_DISTANCE_TO_POSITION:
+            if( GroupEnds.count() != 1 ) return(0.0);
+            return( Size(GetCOM(0,crds,ma) - Position) );
+
+        case EPTT_ANGLE:
+            if( GroupEnds.count() != 3 ) return(0.0);
+            return( CAngleProperty::GetAngleValue(GetCOM(0,crds,ma),GetCOM(1,crds,mb),
+                                                  GetCOM(2,crds,mc)) );
+
+        case EPTT_TORSION: {
+            if( GroupEnds.count() != 4 ) return(0.0);
+            CPoint a = GetCOM(0,crds,ma);
+            CPoint b = GetCOM(1,crds,mb);
+            CPoint c = GetCOM(2,crds,mc);
+            CPoint d = GetCOM(3,crds,md);
+            if( (ma == 0.0) || (mb == 0.0) || (mc == 0.0) || (md == 0.0) ) return(0.0);
+            return( CTorsionProperty::GetTorsionValue(a,b,c,d) );
+        }
+
+        default:
+            return(0.0);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CPropertyTerms::GetNumberOfGroups(void) const
+{
+    return(GroupEnds.count());
+}
+
+//------------------------------------------------------------------------------
+
+CPoint CPropertyTerms::GetCOM(int group,CSimpleVector<CPoint>& crds,double& totmass) const
+{
+    CPoint com;
+    totmass = 0;
+
+    int first = group > 0 ? GroupEnds.at(group-1) : 0;
+    int last = GroupEnds.at(group);
+    int ncrds = crds.GetLength();
+
+    for(int i=first; i < last; i++){
+        double  mass = Masses.at(i);
+        int     ti = TrajIndexes.at(i);
+        totmass += mass;
+        if( (ti >= 0) && (ti < ncrds) ){
+            com += crds[ti]*mass;
+        } else {
+            com += Positions.at(i)*mass;
+        }
+    }
+    if( totmass > 0 ){
+        com /= totmass;
+    }
+    return(com);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
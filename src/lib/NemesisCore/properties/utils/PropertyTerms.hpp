@@ -0,0 +1,90 @@
+#ifndef PropertyTermsH
+#define PropertyTermsH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Point.hpp>
+#include <SimpleVector.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+class CPropertyAtomList;
+
+// -----------------------------------------------------------------------------
+
+enum EPropertyTermsType {
+    EPTT_NONE,
+    EPTT_DISTANCE,              // COM(A) - COM(B)
+    EPTT_DISTANCE_TO_POSITION,  // COM(A) - Position
+    EPTT_ANGLE,                 // COM(A) - COM(B) - COM(C)
+    EPTT_TORSION                // COM(A) - COM(B) - COM(C) - COM(D)
+};
+
+// -----------------------------------------------------------------------------
+
+///  frame independent description of geometric property
+/*! atoms of property points are stored as trajectory indexes with masses,
+    the description does not refer to any project object thus values can be
+    evaluated from snapshot coordinates in any thread,
+    positions of atoms that are not in snapshots are taken from the structure
+    at the time of description
+*/
+
+class NEMESIS_CORE_PACKAGE CPropertyTerms {
+public:
+// constructor -----------------------------------------------------------------
+    CPropertyTerms(void);
+
+// setup methods ---------------------------------------------------------------
+    /// set property type, groups are destroyed
+    void SetType(EPropertyTermsType type);
+
+    /// add atoms of property point as the next group
+    void AddGroup(CPropertyAtomList* p_list);
+
+// executive methods -----------------------------------------------------------
+    /// get property value for snapshot coordinates
+    double GetValue(CSimpleVector<CPoint>& crds) const;
+
+// information methods ---------------------------------------------------------
+    /// get number of groups
+    int GetNumberOfGroups(void) const;
+
+    /// get COM of group for snapshot coordinates
+    CPoint GetCOM(int group,CSimpleVector<CPoint>& crds,double& totmass) const;
+
+// section of public data ------------------------------------------------------
+public:
+    EPropertyTermsType  Type;
+    CPoint              Position;       // fixed point of EPTT_DISTANCE_TO_POSITION
+
+// section of private data -----------------------------------------------------
+private:
+    QVector<int>        TrajIndexes;    // atoms of all groups
+    QVector<double>     Masses;
+    QVector<CPoint>     Positions;      // structure positions
+    QVector<int>        GroupEnds;      // end of group in TrajIndexes
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -33,6 +33,7 @@
 #include <SelectionList.hpp>
 #include <Project.hpp>
 #include <Property.hpp>
+#include <QHash>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -61,6 +62,21 @@ ESelResult CSelectionHandler::RegisterObject(CSelectionList* p_sel,const CSelObj
 
 //------------------------------------------------------------------------------
 
+ESelResult CSelectionHandler::RegisterObjects(CSelectionList* p_sel,const QList<CSelObject>& objs)
+{
+    ESelResult result = ESR_NONE_SELECTED;
+
+    foreach(CSelObject obj, objs){
+        ESelResult selres = RegisterObject(p_sel,obj);
+        if( selres == ESR_SELECTED_OBJECTS_END ) return(selres);
+        if( selres == ESR_SELECTED_OBJECTS_CHANGED ) result = selres;
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
 const QString CSelectionHandler::GetHandlerDescription(void) const
 {
     return("not redefined");
@@ -130,6 +146,37 @@ bool CSelectionHandler::TestStrObjectSelMode(CSelectionList* p_sel,CProObject* p
 
 //------------------------------------------------------------------------------
 
+ESelResult CSelectionHandler::ToggleObjects(CSelectionList* p_sel,const QList<CSelObject>& objs)
+{
+    QHash<CStructure*,bool> allowed;
+    QList<CSelObject>       added;
+    QList<CSelObject>       removed;
+
+    foreach(CSelObject obj, objs){
+        CStructure* p_str = GetStructure(p_sel,obj.GetObject());
+        QHash<CStructure*,bool>::const_iterator it = allowed.constFind(p_str);
+        if( it == allowed.constEnd() ){
+            it = allowed.insert(p_str,TestStrObjectSelMode(p_sel,obj.GetObject()));
+        }
+        if( it.value() == false ) continue;
+
+        if( p_sel->IsInList(obj) ) {
+            removed.append(obj);
+        } else {
+            added.append(obj);
+        }
+    }
+
+    if( added.isEmpty() && removed.isEmpty() ) return(ESR_NONE_SELECTED);
+
+    p_sel->RemoveObjects(removed);
+    p_sel->AddObjects(added);
+
+    return(ESR_SELECTED_OBJECTS_CHANGED);
+}
+
+//------------------------------------------------------------------------------
+
 CRestraint* CSelectionHandler::GetRestraint(CSelectionList* p_sel,CProObject* p_obj)
 {
     if( p_obj == NULL ) return(NULL);
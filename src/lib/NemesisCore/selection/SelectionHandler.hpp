@@ -28,6 +28,7 @@
 #include <NemesisCoreMainHeader.hpp>
 #include <QString>
 #include <GLSelection.hpp>
+#include <QList>
 
 // -----------------------------------------------------------------------------
 
@@ -56,6 +57,9 @@ public:
 // handler main method -----------------------------------------------------
     virtual ESelResult RegisterObject(CSelectionList* p_sel,const CSelObject& obj);
 
+    /// register more objects at once, by default objects are registered one by one
+    virtual ESelResult RegisterObjects(CSelectionList* p_sel,const QList<CSelObject>& objs);
+
 // handler description
     virtual const QString GetHandlerDescription(void) const;
 
@@ -68,6 +72,11 @@ public:
 
     /// test if objects obeys structure object selection mode
     bool TestStrObjectSelMode(CSelectionList* p_sel,CProObject* p_obj);
+
+    /// select objects not in the list and unselect objects in the list
+    /*! structure object selection mode is tested only once per structure
+    */
+    ESelResult ToggleObjects(CSelectionList* p_sel,const QList<CSelObject>& objs);
 };
 
 // -----------------------------------------------------------------------------
@@ -64,6 +64,9 @@ CSelectionList::CSelectionList(CProject* p_project,bool no_index)
     Request = NULL;
     Status = ESS_LIST_INITIALIZED;
     StrSelMode = ESOSM_CONSIDER_ALL_STRUCTURES;
+    UpdateLevel = 0;
+    ObjectsChanged = false;
+    SelectionChanged = false;
 }
 
 //------------------------------------------------------------------------------
@@ -104,8 +107,38 @@ void CSelectionList::RegisterObject(const CSelObject& obj)
         ResetSelection();
     }
 
+    // single objects changed by the handler are reported one by one,
+    // OnSelectionChanged is emitted only once
+    BeginUpdate();
     ESelResult selres = Request->GetRequestType()->RegisterObject(this,obj);
+    EndUpdate();
 
+    ProcessResult(selres);
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionList::RegisterObjects(const QList<CSelObject>& objs)
+{
+    if( Request == NULL ) return;
+    if( Request->GetRequestType() == NULL ) return;
+    if( objs.isEmpty() ) return;
+
+    if( Status == ESS_SELECTED_OBJECTS_END ) {
+        ResetSelection();
+    }
+
+    BeginUpdate();
+    ESelResult selres = Request->GetRequestType()->RegisterObjects(this,objs);
+    EndUpdate();
+
+    ProcessResult(selres);
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionList::ProcessResult(ESelResult selres)
+{
     switch(selres) {
         case ESR_NONE_SELECTED:
             Status = ESS_NONE_SELECTED;
@@ -127,10 +160,8 @@ void CSelectionList::RegisterObject(const CSelObject& obj)
 
 void CSelectionList::ResetSelection(void)
 {
-    while( ! SelectedObjects.isEmpty() ) {
-        CSelObject obj = SelectedObjects.first();
-        RemoveObject(obj);
-    }
+    QList<CSelObject> objs = SelectedObjects;
+    RemoveObjects(objs);
 
     Status = ESS_LIST_INITIALIZED;
     if( Request != NULL ) Request->SelectionListStatusChanged(ESS_LIST_INITIALIZED);
@@ -170,14 +201,15 @@ void CSelectionList::SelectAtomsByZ(int z,CStructure* p_mol)
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) continue;
         if( (p_atom->GetZ() == z) || ( p_atom->IsVirtual() && (z == 1) ) ) {
-            CSelObject selobj(p_atom,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_atom,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //------------------------------------------------------------------------------
@@ -211,14 +243,15 @@ void CSelectionList::SelectAtomsByName(const QRegExp& regexp,CStructure* p_mol)
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) continue;
         if( regexp.exactMatch(p_atom->GetName()) ) {
-            CSelObject selobj(p_atom,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_atom,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //------------------------------------------------------------------------------
@@ -252,14 +285,15 @@ void CSelectionList::SelectAtomsByType(const QRegExp& regexp,CStructure* p_mol)
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) continue;
         if( regexp.exactMatch(p_atom->GetType()) ) {
-            CSelObject selobj(p_atom,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_atom,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //------------------------------------------------------------------------------
@@ -303,11 +337,12 @@ bool CSelectionList::SelectAtomsByMask(const QString& mask,EAtomMaskType type,CS
         return(false);
     }
 
+    QList<CSelObject> objs;
     foreach(CAtom* p_atom, aslmask.GetSelectedAtoms()){
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) continue;
-        CSelObject selobj(p_atom,0);
-        RegisterObject(selobj);
+        objs.append(CSelObject(p_atom,0));
     }
+    RegisterObjects(objs);
 
     return(true);
 }
@@ -343,22 +378,22 @@ void CSelectionList::SelectAtomsByPlane(double a,double b,double c, double d,boo
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) continue;
         CPoint pos = p_atom->GetPos();
         if( front ){
             if( pos.x*a + pos.y*b + pos.z*c + d > 0 ) {
-                CSelObject selobj(p_atom,0);
-                RegisterObject(selobj);
+                objs.append(CSelObject(p_atom,0));
             }
         } else {
             if( pos.x*a + pos.y*b + pos.z*c + d < 0 ) {
-                CSelObject selobj(p_atom,0);
-                RegisterObject(selobj);
+                objs.append(CSelObject(p_atom,0));
             }
         }
     }
+    RegisterObjects(objs);
 }
 
 //==============================================================================
@@ -394,6 +429,7 @@ void CSelectionList::SelectBondsByOrder(EBondOrder order,EComparisonOperator ope
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetBonds()->children()) {
         CBond* p_bond = static_cast<CBond*>(p_qobj);
         if( p_bond->IsFlagSet(EPOF_SELECTED) ) continue;
@@ -420,10 +456,10 @@ void CSelectionList::SelectBondsByOrder(EBondOrder order,EComparisonOperator ope
             break;
         }
         if( select ) {
-            CSelObject selobj(p_bond,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_bond,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //------------------------------------------------------------------------------
@@ -457,14 +493,15 @@ void CSelectionList::SelectBondsByName(const QRegExp& regexp,CStructure* p_mol)
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetBonds()->children()) {
         CBond* p_bond = static_cast<CBond*>(p_qobj);
         if( p_bond->IsFlagSet(EPOF_SELECTED) ) continue;
         if( regexp.exactMatch(p_bond->GetName()) ) {
-            CSelObject selobj(p_bond,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_bond,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //==============================================================================
@@ -500,14 +537,15 @@ void CSelectionList::SelectResiduesByName(const QRegExp& regexp,CStructure* p_mo
         INVALID_ARGUMENT("p_mol is NULL");
     }
 
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,p_mol->GetResidues()->children()) {
         CResidue* p_res = static_cast<CResidue*>(p_qobj);
         if( p_res->IsFlagSet(EPOF_SELECTED) ) continue;
         if( regexp.exactMatch(p_res->GetName()) ) {
-            CSelObject selobj(p_res,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_res,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //------------------------------------------------------------------------------
@@ -551,11 +589,12 @@ bool CSelectionList::SelectResiduesByMask(const QString& mask,EAtomMaskType type
         return(false);
     }
 
+    QList<CSelObject> objs;
     foreach(CResidue* p_res, aslmask.GetSelectedResidues()){
         if( p_res->IsFlagSet(EPOF_SELECTED) ) continue;
-        CSelObject selobj(p_res,0);
-        RegisterObject(selobj);
+        objs.append(CSelObject(p_res,0));
     }
+    RegisterObjects(objs);
 
     return(true);
 }
@@ -566,14 +605,15 @@ bool CSelectionList::SelectResiduesByMask(const QString& mask,EAtomMaskType type
 
 void CSelectionList::SelectGraphicsObjectsByType(const CUUID& type)
 {
+    QList<CSelObject> objs;
     foreach(QObject* p_qobj,GetProject()->GetGraphics()->GetObjects()->children()) {
         CGraphicsObject* p_gobj = static_cast<CGraphicsObject*>(p_qobj);
         if( p_gobj->IsFlagSet(EPOF_SELECTED) ) continue;
         if( p_gobj->GetType() == type ) {
-            CSelObject selobj(p_gobj,0);
-            RegisterObject(selobj);
+            objs.append(CSelObject(p_gobj,0));
         }
     }
+    RegisterObjects(objs);
 }
 
 //==============================================================================
@@ -669,11 +709,14 @@ CSelObject* CSelectionList::GetSelectedSelObject(int index)
 CSelObject CSelectionList::PopSelectedSelObject(void)
 {
     if( SelectedObjects.isEmpty() ) return(CSelObject());
+    emit OnObjectAboutToBeRemoved(0);
     CSelObject obj = SelectedObjects.takeFirst();
+    UnindexObject(obj);
     if( obj.GetObject() != NULL ) {
         obj.GetObject()->disconnect(this);
         obj.GetObject()->SetFlag(EPOF_SELECTED,false);
     }
+    emit OnObjectRemoved(obj);
     return(obj);
 }
 
@@ -690,7 +733,7 @@ CProObject* CSelectionList::GetSelectedObject(int index)
 CProObject* CSelectionList::PopSelectedObject(void)
 {
     if( SelectedObjects.isEmpty() ) return(NULL);
-    CSelObject obj = SelectedObjects.takeFirst();
+    CSelObject obj = SelectedObjects.first();
     RemoveObject(obj);
     return(obj.GetObject());
 }
@@ -701,60 +744,166 @@ CProObject* CSelectionList::PopSelectedObject(void)
 
 void CSelectionList::AddObject(const CSelObject& obj)
 {
+    if( SelectedSet.contains(obj) ) return;
+
     SelectedObjects.append(obj);
+    IndexObject(obj);
     if( obj.GetObject() != NULL ) {
         obj.GetObject()->disconnect(this); // try to avoid duplicit signals
         connect(obj.GetObject(),SIGNAL(destroyed(QObject *)),this,SLOT(ObjectDestroyed(QObject *)));
         obj.GetObject()->SetFlag(EPOF_SELECTED,true);
     }
+
+    // single objects are reported immediately, only OnSelectionChanged is postponed
     emit OnObjectAdded(obj);
+    if( UpdateLevel > 0 ){
+        SelectionChanged = true;
+        return;
+    }
     emit OnSelectionChanged();
 }
 
 //------------------------------------------------------------------------------
 
+void CSelectionList::AddObjects(const QList<CSelObject>& objs)
+{
+    if( objs.isEmpty() ) return;
+
+    BeginUpdate();
+    SelectedObjects.reserve(SelectedObjects.count() + objs.count());
+
+    foreach(CSelObject obj, objs){
+        if( SelectedSet.contains(obj) ) continue;
+        SelectedObjects.append(obj);
+        IndexObject(obj);
+        if( obj.GetObject() != NULL ) {
+            // objects not in the list are not connected
+            if( SelectedCounts.value(obj.GetObject()) == 1 ){
+                connect(obj.GetObject(),SIGNAL(destroyed(QObject *)),this,SLOT(ObjectDestroyed(QObject *)));
+            }
+            obj.GetObject()->SetFlag(EPOF_SELECTED,true);
+        }
+        ObjectsChanged = true;
+    }
+
+    EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
 void CSelectionList::RemoveObject(const CSelObject& obj)
 {
+    int index = SelectedObjects.indexOf(obj);
+    if( index >= 0 ) emit OnObjectAboutToBeRemoved(index);
+
     SelectedObjects.removeAll(obj);
+    UnindexObject(obj);
     if( obj.GetObject() != NULL ) {
         obj.GetObject()->disconnect(this);
         obj.GetObject()->SetFlag(EPOF_SELECTED,false);
     }
+
+    // single objects are reported immediately, only OnSelectionChanged is postponed
     emit OnObjectRemoved(obj);
+    if( UpdateLevel > 0 ){
+        SelectionChanged = true;
+        return;
+    }
     emit OnSelectionChanged();
 }
 
 //------------------------------------------------------------------------------
 
-bool CSelectionList::IsInList(const CSelObject& obj)
+void CSelectionList::RemoveObjects(const QList<CSelObject>& objs)
+{
+    if( objs.isEmpty() ) return;
+
+    BeginUpdate();
+
+    QSet<CSelObject> removed;
+    foreach(CSelObject obj, objs){
+        if( SelectedSet.contains(obj) == false ) continue;
+        removed.insert(obj);
+        UnindexObject(obj);
+        if( obj.GetObject() != NULL ) {
+            obj.GetObject()->disconnect(this);
+            obj.GetObject()->SetFlag(EPOF_SELECTED,false);
+        }
+    }
+
+    if( removed.count() > 0 ){
+        // compact the list in one pass
+        QList<CSelObject> objects;
+        objects.reserve(SelectedObjects.count() - removed.count());
+        foreach(CSelObject obj, SelectedObjects){
+            if( removed.contains(obj) ) continue;
+            objects.append(obj);
+        }
+        SelectedObjects = objects;
+        ObjectsChanged = true;
+    }
+
+    EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionList::BeginUpdate(void)
 {
-    return( SelectedObjects.contains(obj) );
+    UpdateLevel++;
 }
 
 //------------------------------------------------------------------------------
 
-bool CSelectionList::IsInList(CProObject* p_obj)
+void CSelectionList::EndUpdate(void)
 {
-    QList<CSelObject>::iterator it = SelectedObjects.begin();
-    QList<CSelObject>::iterator ie = SelectedObjects.end();
+    if( UpdateLevel <= 0 ) return;
+    UpdateLevel--;
+    if( UpdateLevel > 0 ) return;
 
-    while( it != ie ){
-        if((*it).GetObject() == p_obj) return(true);
-        it++;
+    if( ObjectsChanged ){
+        ObjectsChanged = false;
+        SelectionChanged = false;
+        NotifyObjectsChanged();
+    } else if( SelectionChanged ){
+        SelectionChanged = false;
+        emit OnSelectionChanged();
     }
+}
+
+//------------------------------------------------------------------------------
+
+bool CSelectionList::IsInList(const CSelObject& obj)
+{
+    return( SelectedSet.contains(obj) );
+}
 
-    return( false );
+//------------------------------------------------------------------------------
+
+bool CSelectionList::IsInList(CProObject* p_obj)
+{
+    return( SelectedCounts.contains(p_obj) );
 }
 
 //------------------------------------------------------------------------------
 
 void CSelectionList::ObjectDestroyed(QObject* p_obj)
 {
+    CProObject* p_pobj = static_cast<CProObject*>(p_obj);
+    if( SelectedCounts.contains(p_pobj) == false ) return;
+
     foreach(CSelObject obj,SelectedObjects) {
         if( obj.GetObject() == p_obj ) {
+            int index = SelectedObjects.indexOf(obj);
+            if( index >= 0 ) emit OnObjectAboutToBeRemoved(index);
             SelectedObjects.removeOne(obj);
+            UnindexObject(obj);
             //TODO: this is probably dangerous since object could be partially destroyed
             emit OnObjectRemoved(obj);
+            if( UpdateLevel > 0 ){
+                SelectionChanged = true;
+                continue;
+            }
             emit OnSelectionChanged();
         }
     }
@@ -763,3 +912,31 @@ void CSelectionList::ObjectDestroyed(QObject* p_obj)
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
+
+void CSelectionList::IndexObject(const CSelObject& obj)
+{
+    SelectedSet.insert(obj);
+    SelectedCounts[obj.GetObject()]++;
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionList::UnindexObject(const CSelObject& obj)
+{
+    if( SelectedSet.remove(obj) == false ) return;
+    QHash<CProObject*,int>::iterator it = SelectedCounts.find(obj.GetObject());
+    if( it == SelectedCounts.end() ) return;
+    if( --it.value() <= 0 ) SelectedCounts.erase(it);
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionList::NotifyObjectsChanged(void)
+{
+    emit OnObjectsChanged();
+    emit OnSelectionChanged();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
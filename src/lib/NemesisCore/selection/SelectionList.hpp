@@ -30,6 +30,10 @@
 #include <Bond.hpp>
 #include <GeoMeasurement.hpp>
 #include <AtomMask.hpp>
+#include <SelectionHandler.hpp>
+#include <QList>
+#include <QSet>
+#include <QHash>
 
 //------------------------------------------------------------------------------
 
@@ -72,6 +76,12 @@ public:
     /// register primitive object
     void RegisterObject(const CSelObject& obj);
 
+    /// register primitive objects at once
+    /*! objects are passed to the handler together and
+        the change of the selection is notified only once
+    */
+    void RegisterObjects(const QList<CSelObject>& objs);
+
     /// reset selection
     void ResetSelection(void);
 
@@ -185,9 +195,15 @@ signals:
     /// emmited when new object is added into the selection list
     void OnObjectAdded(const CSelObject& obj);
 
-    /// emmited when selected object is going to be removed from the selection list
+    /// emmited when selected object at index is going to be removed from the selection list
+    void OnObjectAboutToBeRemoved(int index);
+
+    /// emmited when selected object was removed from the selection list
     void OnObjectRemoved(const CSelObject& obj);
 
+    /// emmited when more objects were added or removed at once
+    void OnObjectsChanged(void);
+
     /// emmited when selection request is fullfilled
     void OnSelectionCompleted(void);
 
@@ -199,9 +215,21 @@ public:
     /// add object into the list and set all necessary connection for it
     void AddObject(const CSelObject& obj);
 
+    /// add objects into the list, objects already in the list are skipped
+    void AddObjects(const QList<CSelObject>& objs);
+
     /// remove object from the list and remove all connection for it
     void RemoveObject(const CSelObject& obj);
 
+    /// remove objects from the list
+    void RemoveObjects(const QList<CSelObject>& objs);
+
+    /// postpone notifications about added and removed objects
+    void BeginUpdate(void);
+
+    /// emit postponed notifications
+    void EndUpdate(void);
+
     /// is in list?
     bool IsInList(const CSelObject& obj);
 
@@ -212,8 +240,25 @@ public:
 private:
     CSelectionRequest*      Request;
     QList<CSelObject>       SelectedObjects;
+    QSet<CSelObject>        SelectedSet;        // for fast IsInList
+    QHash<CProObject*,int>  SelectedCounts;     // number of occurences of object
     ESelStatus              Status;
     EStrObjectSelMode       StrSelMode;
+    int                     UpdateLevel;
+    bool                    ObjectsChanged;     // objects changed at once during update
+    bool                    SelectionChanged;   // single objects changed during update
+
+    /// update status from handler result
+    void ProcessResult(ESelResult selres);
+
+    /// insert object into lookup tables
+    void IndexObject(const CSelObject& obj);
+
+    /// remove object from lookup tables
+    void UnindexObject(const CSelObject& obj);
+
+    /// notify change of objects
+    void NotifyObjectsChanged(void);
 
 private slots:
     void ObjectDestroyed(QObject* p_obj);
@@ -59,6 +59,8 @@ CSelectionModel::CSelectionModel(QObject* p_parent)
     : CContainerModel(&SelectionModelObject,p_parent)
 {
     RootObject = NULL;
+    NumOfRows = 0;
+    RemovingRow = false;
 }
 
 //------------------------------------------------------------------------------
@@ -69,12 +71,14 @@ void CSelectionModel::SetRootObject(CSelectionList* p_data)
     if( RootObject != NULL ) {
         connect(RootObject,SIGNAL(OnObjectAdded(const CSelObject&)),
                 this,SLOT(ObjectAdded(const CSelObject&)));
+        connect(RootObject,SIGNAL(OnObjectAboutToBeRemoved(int)),
+                this,SLOT(ObjectAboutToBeRemoved(int)));
         connect(RootObject,SIGNAL(OnObjectRemoved(const CSelObject&)),
                 this,SLOT(ObjectRemoved(const CSelObject&)));
+        connect(RootObject,SIGNAL(OnObjectsChanged(void)),
+                this,SLOT(ObjectsChanged(void)));
     }
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    ObjectsChanged();
 }
 
 //------------------------------------------------------------------------------
@@ -133,7 +137,8 @@ int CSelectionModel::columnCount(const QModelIndex &parent) const
 int CSelectionModel::rowCount(const QModelIndex &parent) const
 {
     if( RootObject == 0 ) return(0);
-    return( RootObject->NumOfSelectedObjects() );
+    // the list is changed before views are notified
+    return( NumOfRows );
 }
 
 
@@ -147,7 +152,10 @@ QModelIndex CSelectionModel::index(int row, int column,
     if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
     if( parent.isValid() )  return( QModelIndex() );
 
-    QModelIndex index = createIndex(row, column, RootObject->GetSelectedSelObject(row));
+    CSelObject* p_obj = RootObject->GetSelectedSelObject(row);
+    if( p_obj == NULL ) return( QModelIndex() );
+
+    QModelIndex index = createIndex(row, column, p_obj);
 
     return(index);
 }
@@ -227,17 +235,50 @@ Qt::ItemFlags CSelectionModel::flags(const QModelIndex &index) const
 
 void CSelectionModel::ObjectAdded(const CSelObject& obj)
 {
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    // the object is appended at the end of the list
+    if( RootObject->NumOfSelectedObjects() != NumOfRows + 1 ){
+        ObjectsChanged();
+        return;
+    }
+    beginInsertRows(QModelIndex(),NumOfRows,NumOfRows);
+    NumOfRows++;
+    endInsertRows();
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionModel::ObjectAboutToBeRemoved(int index)
+{
+    // the list is still unchanged
+    if( RemovingRow || (RootObject->NumOfSelectedObjects() != NumOfRows) ) return;
+    if( (index < 0) || (index >= NumOfRows) ) return;
+    beginRemoveRows(QModelIndex(),index,index);
+    RemovingRow = true;
 }
 
 //------------------------------------------------------------------------------
 
 void CSelectionModel::ObjectRemoved(const CSelObject& obj)
 {
-    // FIXME
+    if( RemovingRow ){
+        RemovingRow = false;
+        NumOfRows--;
+        endRemoveRows();
+        if( RootObject->NumOfSelectedObjects() == NumOfRows ) return;
+    }
+    // the object was not in the list or rows were not announced
+    if( RootObject->NumOfSelectedObjects() != NumOfRows ){
+        ObjectsChanged();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectionModel::ObjectsChanged(void)
+{
     beginResetModel();
+    NumOfRows = 0;
+    if( RootObject != NULL ) NumOfRows = RootObject->NumOfSelectedObjects();
     endResetModel();
 }
 
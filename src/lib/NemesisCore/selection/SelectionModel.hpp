@@ -49,6 +49,8 @@ public:
 // section of private data ----------------------------------------------------
 private:
     CSelectionList*    RootObject;
+    int                NumOfRows;          // rows known to views
+    bool               RemovingRow;        // beginRemoveRows was called
 
     QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const;
@@ -65,7 +67,9 @@ private:
 
 private slots:
     void ObjectAdded(const CSelObject& obj);
+    void ObjectAboutToBeRemoved(int index);
     void ObjectRemoved(const CSelObject& obj);
+    void ObjectsChanged(void);
 };
 
 // -----------------------------------------------------------------------------
@@ -100,6 +100,20 @@ ESelResult CAtomListSelection::RegisterObject(CSelectionList* p_sel,const CSelOb
     return(ESR_NONE_SELECTED);
 }
 
+//------------------------------------------------------------------------------
+
+ESelResult CAtomListSelection::RegisterObjects(CSelectionList* p_sel,const QList<CSelObject>& objs)
+{
+    // special keys and other objects are registered one by one
+    foreach(CSelObject obj, objs){
+        if( dynamic_cast<CAtom*>(obj.GetObject()) == NULL ){
+            return(CSelectionHandler::RegisterObjects(p_sel,objs));
+        }
+    }
+
+    return(ToggleObjects(p_sel,objs));
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -146,15 +160,21 @@ ESelResult CAtomListSelection::InvertSelection(CSelectionList* p_sel)
 
 void CAtomListSelection::InvertSelection(CSelectionList* p_sel,CStructure* p_str)
 {
+    QList<CSelObject> added;
+    QList<CSelObject> removed;
+
     foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         CSelObject obj(p_atom,0);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) {
-            p_sel->RemoveObject(obj);
+            removed.append(obj);
         } else {
-            p_sel->AddObject(obj);
+            added.append(obj);
         }
     }
+
+    p_sel->RemoveObjects(removed);
+    p_sel->AddObjects(added);
 }
 
 //==============================================================================
@@ -214,13 +234,16 @@ ESelResult CAtomListSelection::CompleteActiveStructure(CSelectionList* p_sel)
 
 void CAtomListSelection::CompleteStructure(CSelectionList* p_sel,CStructure* p_str)
 {
+    QList<CSelObject> added;
+
     foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        CSelObject obj(p_atom,0);
         if( ! p_atom->IsFlagSet(EPOF_SELECTED) ) {
-            p_sel->AddObject(obj);
+            added.append(CSelObject(p_atom,0));
         }
     }
+
+    p_sel->AddObjects(added);
 }
 
 //==============================================================================
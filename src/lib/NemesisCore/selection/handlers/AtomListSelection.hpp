@@ -37,6 +37,9 @@ public:
 // handler main method -----------------------------------------------------
     virtual ESelResult RegisterObject(CSelectionList* p_sel,const CSelObject& obj);
 
+    /// register atoms at once
+    virtual ESelResult RegisterObjects(CSelectionList* p_sel,const QList<CSelObject>& objs);
+
 // handler description
     virtual const QString GetHandlerDescription(void) const;
 
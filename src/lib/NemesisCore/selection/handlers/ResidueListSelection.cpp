@@ -143,21 +143,41 @@ ESelResult CResidueListSelection::RegisterObject(CSelectionList* p_sel,const CSe
 
 //------------------------------------------------------------------------------
 
+ESelResult CResidueListSelection::RegisterObjects(CSelectionList* p_sel,const QList<CSelObject>& objs)
+{
+    // special keys, atoms and bonds are registered one by one
+    foreach(CSelObject obj, objs){
+        if( dynamic_cast<CResidue*>(obj.GetObject()) == NULL ){
+            return(CSelectionHandler::RegisterObjects(p_sel,objs));
+        }
+    }
+
+    return(ToggleObjects(p_sel,objs));
+}
+
+//------------------------------------------------------------------------------
+
 ESelResult CResidueListSelection::InvertSelection(CSelectionList* p_sel)
 {
     CStructure* p_mol = p_sel->GetProject()->GetActiveStructure();
     if( p_mol == NULL ) return(ESR_NONE_SELECTED);
 
+    QList<CSelObject> added;
+    QList<CSelObject> removed;
+
     foreach(QObject* p_qobj,p_mol->GetResidues()->children()) {
         CResidue* p_res = static_cast<CResidue*>(p_qobj);
         CSelObject obj(p_res,0);
         if( p_res->IsFlagSet(EPOF_SELECTED) ) {
-            p_sel->RemoveObject(obj);
+            removed.append(obj);
         } else {
-            p_sel->AddObject(obj);
+            added.append(obj);
         }
     }
 
+    p_sel->RemoveObjects(removed);
+    p_sel->AddObjects(added);
+
     return(ESR_SELECTED_OBJECTS_CHANGED);
 }
 
@@ -0,0 +1,168 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLAtomTable.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <ResidueList.hpp>
+#include <Atom.hpp>
+#include <Residue.hpp>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CASLAtomTable::CASLAtomTable(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CASLAtomTable::Build(CStructure* p_str)
+{
+    Clear();
+    if( p_str == NULL ) return;
+
+    QHash<QString,int>      name_map;
+    QHash<QString,int>      type_map;
+    QHash<QString,int>      resname_map;
+    QHash<CResidue*,int>    res_map;
+
+    // residues
+    const QList<QObject*>& residues = p_str->GetResidues()->children();
+    Residues.reserve(residues.count());
+    SeqIndexes.reserve(residues.count());
+    ResNameIds.reserve(residues.count());
+
+    foreach(QObject* p_qobj, residues){
+        CResidue* p_res = static_cast<CResidue*>(p_qobj);
+        res_map.insert(p_res,Residues.count());
+        Residues.append(p_res);
+        SeqIndexes.append(p_res->GetSeqIndex());
+        ResNameIds.append(Intern(p_res->GetName(),resname_map,ResNames));
+    }
+
+    // atoms
+    const QList<QObject*>& atoms = p_str->GetAtoms()->children();
+    int natoms = atoms.count();
+    Atoms.reserve(natoms);
+    Positions.reserve(natoms);
+    SerIndexes.reserve(natoms);
+    NameIds.reserve(natoms);
+    TypeIds.reserve(natoms);
+    ResidueIds.reserve(natoms);
+
+    foreach(QObject* p_qobj, atoms){
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        Atoms.append(p_atom);
+        Positions.append(p_atom->GetPos());
+        SerIndexes.append(p_atom->GetSerIndex());
+        NameIds.append(Intern(p_atom->GetName(),name_map,Names));
+        TypeIds.append(Intern(p_atom->GetType(),type_map,Types));
+        ResidueIds.append(res_map.value(p_atom->GetResidue(),-1));
+    }
+
+    // atoms of residues
+    ResAtomStart.fill(0,Residues.count()+1);
+    for(int i=0; i < natoms; i++){
+        if( ResidueIds.at(i) >= 0 ) ResAtomStart[ResidueIds.at(i)+1]++;
+    }
+    for(int i=0; i < Residues.count(); i++){
+        ResAtomStart[i+1] += ResAtomStart.at(i);
+    }
+    ResAtoms.resize(ResAtomStart.last());
+    QVector<int> fill = ResAtomStart;
+    for(int i=0; i < natoms; i++){
+        int res = ResidueIds.at(i);
+        if( res < 0 ) continue;
+        ResAtoms[fill[res]++] = i;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CASLAtomTable::Clear(void)
+{
+    Atoms.clear();
+    Positions.clear();
+    SerIndexes.clear();
+    NameIds.clear();
+    TypeIds.clear();
+    ResidueIds.clear();
+    Residues.clear();
+    SeqIndexes.clear();
+    ResNameIds.clear();
+    ResAtomStart.clear();
+    ResAtoms.clear();
+    Names.clear();
+    Types.clear();
+    ResNames.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CASLAtomTable::GetNumberOfAtoms(void) const
+{
+    return(Atoms.count());
+}
+
+//------------------------------------------------------------------------------
+
+int CASLAtomTable::GetNumberOfResidues(void) const
+{
+    return(Residues.count());
+}
+
+//------------------------------------------------------------------------------
+
+quint32 CASLAtomTable::PackName(const char* p_name,int len)
+{
+    quint32 key = 0;
+    if( len > 4 ) len = 4;
+    for(int i=0; i < len; i++){
+        if( p_name[i] == '\0' ) break;
+        key |= (quint32)(unsigned char)p_name[i] << (8*i);
+    }
+    return(key);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CASLAtomTable::Intern(const QString& text,QHash<QString,int>& map,QVector<quint32>& table)
+{
+    QHash<QString,int>::const_iterator it = map.constFind(text);
+    if( it != map.constEnd() ) return(it.value());
+
+    QByteArray latin = text.toLatin1();
+    int id = table.count();
+    table.append(PackName(latin.constData(),latin.length()));
+    map.insert(text,id);
+    return(id);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,95 @@
+#ifndef ASLAtomTableH
+#define ASLAtomTableH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Point.hpp>
+#include <QVector>
+#include <QHash>
+#include <QString>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CAtom;
+class CResidue;
+
+// -----------------------------------------------------------------------------
+
+///  column snapshot of structure used by ASL mask evaluator
+/*! atoms are stored in the order of CAtomList children,
+    names, types and residue names are interned into tables of packed keys,
+    thus they are compared only once per distinct string
+*/
+
+class NEMESIS_CORE_PACKAGE CASLAtomTable {
+public:
+// constructor -----------------------------------------------------------------
+    CASLAtomTable(void);
+
+// executive methods -----------------------------------------------------------
+    /// build table from the structure
+    void Build(CStructure* p_str);
+
+    /// destroy table
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get number of atoms
+    int GetNumberOfAtoms(void) const;
+
+    /// get number of residues
+    int GetNumberOfResidues(void) const;
+
+    /// pack the first four characters into a key, characters after NUL are ignored
+    static quint32 PackName(const char* p_name,int len);
+
+// section of public data ------------------------------------------------------
+public:
+    // atoms
+    QVector<CAtom*>     Atoms;
+    QVector<CPoint>     Positions;
+    QVector<int>        SerIndexes;
+    QVector<int>        NameIds;        // index into Names
+    QVector<int>        TypeIds;        // index into Types
+    QVector<int>        ResidueIds;     // index into Residues or -1
+
+    // residues
+    QVector<CResidue*>  Residues;
+    QVector<int>        SeqIndexes;
+    QVector<int>        ResNameIds;     // index into ResNames
+    QVector<int>        ResAtomStart;   // the first atom of each residue in ResAtoms
+    QVector<int>        ResAtoms;       // atom indexes sorted by residues
+
+    // interned strings
+    QVector<quint32>    Names;
+    QVector<quint32>    Types;
+    QVector<quint32>    ResNames;
+
+// section of private data -----------------------------------------------------
+private:
+    /// get id of string, it is added into the table if it is not known yet
+    static int Intern(const QString& text,QHash<QString,int>& map,QVector<quint32>& table);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,182 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLBitSet.hpp>
+#include <ErrorSystem.hpp>
+#include <QtAlgorithms>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CASLBitSet::CASLBitSet(void)
+{
+    Size = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CASLBitSet::CASLBitSet(int size)
+{
+    Size = 0;
+    Resize(size);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CASLBitSet::Resize(int size)
+{
+    if( size < 0 ) size = 0;
+    Size = size;
+    Words.fill(0,(size + 63) >> 6);
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::Clear(void)
+{
+    Words.fill(0);
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::SetAll(void)
+{
+    Words.fill(~(quint64)0);
+    ClearTail();
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::SetRange(int first,int last)
+{
+    if( first < 0 ) first = 0;
+    if( last >= Size ) last = Size - 1;
+    if( first > last ) return;
+
+    int fw = first >> 6;
+    int lw = last >> 6;
+    quint64 fmask = ~(quint64)0 << (first & 63);
+    quint64 lmask = ~(quint64)0 >> (63 - (last & 63));
+
+    quint64* p_words = Words.data();
+    if( fw == lw ){
+        p_words[fw] |= fmask & lmask;
+        return;
+    }
+    p_words[fw] |= fmask;
+    for(int i=fw+1; i < lw; i++){
+        p_words[i] = ~(quint64)0;
+    }
+    p_words[lw] |= lmask;
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::And(const CASLBitSet& right)
+{
+    if( right.Size != Size ){
+        INVALID_ARGUMENT("sizes of sets differ");
+    }
+
+    quint64*        p_words = Words.data();
+    const quint64*  p_right = right.Words.constData();
+    int             nwords = Words.size();
+
+    for(int i=0; i < nwords; i++){
+        p_words[i] &= p_right[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::Or(const CASLBitSet& right)
+{
+    if( right.Size != Size ){
+        INVALID_ARGUMENT("sizes of sets differ");
+    }
+
+    quint64*        p_words = Words.data();
+    const quint64*  p_right = right.Words.constData();
+    int             nwords = Words.size();
+
+    for(int i=0; i < nwords; i++){
+        p_words[i] |= p_right[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CASLBitSet::Not(void)
+{
+    quint64*    p_words = Words.data();
+    int         nwords = Words.size();
+
+    for(int i=0; i < nwords; i++){
+        p_words[i] = ~p_words[i];
+    }
+    ClearTail();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CASLBitSet::GetSize(void) const
+{
+    return(Size);
+}
+
+//------------------------------------------------------------------------------
+
+int CASLBitSet::Count(void) const
+{
+    int count = 0;
+    for(int i=0; i < Words.size(); i++){
+        count += qPopulationCount(Words.at(i));
+    }
+    return(count);
+}
+
+//------------------------------------------------------------------------------
+
+bool CASLBitSet::IsEmpty(void) const
+{
+    for(int i=0; i < Words.size(); i++){
+        if( Words.at(i) != 0 ) return(false);
+    }
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CASLBitSet::ClearTail(void)
+{
+    if( (Size & 63) == 0 ) return;
+    Words.last() &= ~(quint64)0 >> (64 - (Size & 63));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
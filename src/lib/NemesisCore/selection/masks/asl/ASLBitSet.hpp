@@ -0,0 +1,102 @@
+#ifndef ASLBitSetH
+#define ASLBitSetH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+///  dense set of atom indexes used by ASL mask evaluator
+/*! bits are packed into 64-bit words, logical operations work on whole words,
+    bits beyond the size are always zero
+*/
+
+class NEMESIS_CORE_PACKAGE CASLBitSet {
+public:
+// constructor -----------------------------------------------------------------
+    CASLBitSet(void);
+    CASLBitSet(int size);
+
+// executive methods -----------------------------------------------------------
+    /// resize set, all bits are cleared
+    void Resize(int size);
+
+    /// clear all bits
+    void Clear(void);
+
+    /// set all bits
+    void SetAll(void);
+
+    /// set bit
+    void Set(int index);
+
+    /// set bits in range <first;last>
+    void SetRange(int first,int last);
+
+    /// this = this & right
+    void And(const CASLBitSet& right);
+
+    /// this = this | right
+    void Or(const CASLBitSet& right);
+
+    /// this = ~this
+    void Not(void);
+
+// information methods ---------------------------------------------------------
+    /// test bit
+    bool Test(int index) const;
+
+    /// get number of bits
+    int GetSize(void) const;
+
+    /// get number of set bits
+    int Count(void) const;
+
+    /// is any bit set?
+    bool IsEmpty(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QVector<quint64>    Words;
+    int                 Size;
+
+    /// clear bits beyond the size
+    void ClearTail(void);
+};
+
+// -----------------------------------------------------------------------------
+
+inline void CASLBitSet::Set(int index)
+{
+    Words[index >> 6] |= (quint64)1 << (index & 63);
+}
+
+// -----------------------------------------------------------------------------
+
+inline bool CASLBitSet::Test(int index) const
+{
+    return( (Words.at(index >> 6) & ((quint64)1 << (index & 63))) != 0 );
+}
+
+//------------------------------------------------------------------------------
+
+#endif
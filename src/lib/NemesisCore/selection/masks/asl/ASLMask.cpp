@@ -29,17 +29,14 @@
 #include <ASLMask.hpp>
 #include <ErrorSystem.hpp>
 #include <ASLSelection.hpp>
-#include "maskparser/ASLParser.hpp"
+#include <ASLProgram.hpp>
+#include <ASLMaskCache.hpp>
 #include <Structure.hpp>
-#include <AtomList.hpp>
 #include <Atom.hpp>
-#include <ResidueList.hpp>
 #include <Bond.hpp>
 #include <Residue.hpp>
 #include <QSet>
 
-#include "maskparser/ASLParser.hpp"
-
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -47,15 +44,16 @@
 CASLMask::CASLMask(CStructure* p_mol)
 {
     Structure = p_mol;
-    Selection = NULL;
+    Program = new CASLProgram;
+    Selected = false;
 }
 
 //------------------------------------------------------------------------------
 
 CASLMask::~CASLMask(void)
 {
-    if( Selection != NULL ) delete Selection;
-    Selection = NULL;
+    delete Program;
+    Program = NULL;
 }
 
 //==============================================================================
@@ -75,38 +73,28 @@ bool CASLMask::SetMask(const QString& mask)
 
     // remove previous selection -----------------------------
     Mask = mask;
-    if( Selection != NULL ) delete Selection;
-    Selection = NULL;
-
-    // init mask parser
-    init_asl_mask();
-
-    // parse mask
-    if( parse_asl_mask(Mask.toLatin1()) != 0 ) {
-        free_asl_mask_tree();
-        ES_ERROR("unable to parse mask");
-        return(false);
-    }
-
-    // get top mask expression
-    struct SExpression* p_top_expr = get_asl_expression_tree();
-    if( p_top_expr == NULL ) {
-        ES_ERROR("top expression is NULL");
+    Program->Clear();
+    Table.Clear();
+    Selection.Resize(0);
+    Selected = false;
+
+    // get compiled mask, it is parsed only if it was not used before
+    if( ASLMaskCache.GetProgram(Mask,*Program) == false ) {
+        ES_ERROR("unable to compile mask");
         return(false);
     }
 
-    // init selection tree
-    Selection = new CASLSelection(this,this);
+    // evaluate program
+    Table.Build(Structure);
+    CASLSelection evaluator(Structure,&Table);
 
-    if( Selection->ExpandAndReduceTree(p_top_expr) == false ) {
-        ES_ERROR("unable to expand and reduce expression tree");
-        free_asl_mask_tree();
+    if( evaluator.Evaluate(*Program,Selection) == false ) {
+        ES_ERROR("unable to evaluate mask");
+        Table.Clear();
         return(false);
     }
 
-    // free parser data
-    free_asl_mask_tree();
-
+    Selected = true;
     return(true);
 }
 
@@ -124,13 +112,10 @@ const QString& CASLMask::GetMask(void) const
 const QList<CAtom*> CASLMask::GetSelectedAtoms(void)
 {
     QList<CAtom*> list;
-    if( Selection == NULL ) return(list);
+    if( Selected == false ) return(list);
 
-    foreach(QObject* p_qobj, GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( Selection->Selection[p_atom] == true ){
-            list.append(p_atom);
-        }
+    for(int i=0; i < Selection.GetSize(); i++){
+        if( Selection.Test(i) ) list.append(Table.Atoms.at(i));
     }
 
     return(list);
@@ -141,15 +126,13 @@ const QList<CAtom*> CASLMask::GetSelectedAtoms(void)
 const QList<CBond*> CASLMask::GetSelectedBonds(void)
 {
     QList<CBond*> list;
-    if( Selection == NULL ) return(list);
+    if( Selected == false ) return(list);
 
     QSet<CBond*>  bm;
 
-    foreach(QObject* p_qobj, GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( Selection->Selection[p_atom] == false ) continue;
-
-        foreach(CBond* p_bond,p_atom->GetBonds()) {
+    for(int i=0; i < Selection.GetSize(); i++){
+        if( ! Selection.Test(i) ) continue;
+        foreach(CBond* p_bond,Table.Atoms.at(i)->GetBonds()) {
             bm.insert(p_bond);
         }
     }
@@ -162,38 +145,24 @@ const QList<CBond*> CASLMask::GetSelectedBonds(void)
 const QList<CResidue*> CASLMask::GetSelectedResidues(void)
 {
     QList<CResidue*> list;
-    if( Selection == NULL ) return(list);
+    if( Selected == false ) return(list);
 
-    QSet<CResidue*>  rset;
+    QVector<bool> used(Table.GetNumberOfResidues(),false);
 
-    foreach(QObject* p_qobj, GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( Selection->Selection[p_atom] == true ){
-            if( p_atom->GetResidue() ) rset.insert(p_atom->GetResidue());
-        }
+    for(int i=0; i < Selection.GetSize(); i++){
+        if( ! Selection.Test(i) ) continue;
+        int res = Table.ResidueIds.at(i);
+        if( res >= 0 ) used[res] = true;
     }
 
-    return(rset.toList());
-}
-
-//==============================================================================
-//------------------------------------------------------------------------------
-//==============================================================================
-
-const QList<QObject*> CASLMask::GetAtoms(void)
-{
-    return(Structure->GetAtoms()->children());
-}
-
-//------------------------------------------------------------------------------
+    for(int r=0; r < used.count(); r++){
+        if( used.at(r) ) list.append(Table.Residues.at(r));
+    }
 
-const QList<QObject*> CASLMask::GetResidues(void)
-{
-    return(Structure->GetResidues()->children());
+    return(list);
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-
@@ -23,13 +23,15 @@
 // =============================================================================
 
 #include <NemesisCoreMainHeader.hpp>
+#include <ASLBitSet.hpp>
+#include <ASLAtomTable.hpp>
 #include <QList>
 #include <QString>
 #include <QObject>
 
 //---------------------------------------------------------------------------
 
-class CASLSelection;
+class CASLProgram;
 class CStructure;
 class CAtom;
 class CBond;
@@ -39,7 +41,11 @@ class CResidue;
 
 /// mask support class
 /*!
- mask support is now fully compatible with AMBER 9.0
+ mask support is now fully compatible with AMBER 9.0,
+ the mask is compiled into CASLProgram and evaluated over CASLAtomTable,
+ results are valid until the structure is changed,
+ compiled masks are shared via ASLMaskCache, thus masks of different
+ structures can be evaluated in parallel threads
 */
 
 class NEMESIS_CORE_PACKAGE CASLMask : public QObject {
@@ -66,17 +72,12 @@ public:
 
 // section of private data ----------------------------------------------------
 private:
-    CStructure*      Structure;
+    CStructure*     Structure;
     QString         Mask;
-    CASLSelection*  Selection;
-
-    /// return list of atoms
-    const QList<QObject*> GetAtoms(void);
-
-    /// return list of residues
-    const QList<QObject*> GetResidues(void);
-
-    friend class CASLSelection;
+    CASLProgram*    Program;
+    CASLAtomTable   Table;
+    CASLBitSet      Selection;
+    bool            Selected;
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,167 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLBitSet.hpp>
+#include <ASLMaskCache.hpp>
+#include <ErrorSystem.hpp>
+#include <QMutexLocker>
+
+#include "maskparser/ASLParser.hpp"
+
+//------------------------------------------------------------------------------
+
+// default number of cached masks
+#define ASL_MASK_CACHE_CAPACITY 256
+
+//------------------------------------------------------------------------------
+
+CASLMaskCache ASLMaskCache;
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CASLMaskCache::CASLMaskCache(void)
+{
+    Capacity = ASL_MASK_CACHE_CAPACITY;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CASLMaskCache::GetProgram(const QString& mask,CASLProgram& program)
+{
+    QMutexLocker lock(&CacheMutex);
+
+    QHash<QString,CASLProgram>::const_iterator it = Programs.constFind(mask);
+    if( it != Programs.constEnd() ){
+        program = it.value();
+        Recent.removeOne(mask);
+        Recent.prepend(mask);
+        return(true);
+    }
+
+    lock.unlock();
+
+    if( Compile(mask,program) == false ) return(false);
+
+    lock.relock();
+
+    // the same mask can be compiled by another thread in the meantime
+    if( (Capacity > 0) && (Programs.contains(mask) == false) ){
+        Programs.insert(mask,program);
+        Recent.prepend(mask);
+        Shrink();
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CASLMaskCache::SetCapacity(int capacity)
+{
+    QMutexLocker lock(&CacheMutex);
+    if( capacity < 0 ) capacity = 0;
+    Capacity = capacity;
+    Shrink();
+}
+
+//------------------------------------------------------------------------------
+
+void CASLMaskCache::Clear(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    Programs.clear();
+    Recent.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CASLMaskCache::GetCapacity(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(Capacity);
+}
+
+//------------------------------------------------------------------------------
+
+int CASLMaskCache::GetNumberOfMasks(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(Programs.count());
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CASLMaskCache::Compile(const QString& mask,CASLProgram& program)
+{
+    program.Clear();
+
+    // init mask parser
+    struct SASLParserContext context;
+    init_asl_mask(&context);
+
+    // parse mask
+    if( parse_asl_mask(&context,mask.toLatin1()) != 0 ) {
+        free_asl_mask_tree(&context);
+        ES_ERROR("unable to parse mask");
+        return(false);
+    }
+
+    // get top mask expression
+    struct SExpression* p_top_expr = get_asl_expression_tree(&context);
+    if( p_top_expr == NULL ) {
+        free_asl_mask_tree(&context);
+        ES_ERROR("top expression is NULL");
+        return(false);
+    }
+
+    // compile expression tree
+    bool result = program.Compile(p_top_expr);
+
+    // free parser data
+    free_asl_mask_tree(&context);
+
+    if( result == false ) {
+        ES_ERROR("unable to compile expression tree");
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CASLMaskCache::Shrink(void)
+{
+    while( Recent.count() > Capacity ){
+        Programs.remove(Recent.takeLast());
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
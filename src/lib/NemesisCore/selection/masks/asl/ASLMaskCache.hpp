@@ -0,0 +1,80 @@
+#ifndef ASLMaskCacheH
+#define ASLMaskCacheH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <ASLProgram.hpp>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QMutex>
+
+// -----------------------------------------------------------------------------
+
+///  process-wide cache of compiled ASL masks
+/*! the mask parser is reentrant, thus masks are parsed outside the lock,
+    compiled programs do not depend on the parser and they can be evaluated
+    concurrently, the least recently used masks are released if the cache is full
+*/
+
+class NEMESIS_CORE_PACKAGE CASLMaskCache {
+public:
+// constructor -----------------------------------------------------------------
+    CASLMaskCache(void);
+
+// executive methods -----------------------------------------------------------
+    /// get compiled mask, the mask is parsed only if it is not in the cache
+    bool GetProgram(const QString& mask,CASLProgram& program);
+
+    /// set max number of cached masks
+    void SetCapacity(int capacity);
+
+    /// remove all cached masks
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get max number of cached masks
+    int GetCapacity(void);
+
+    /// get number of cached masks
+    int GetNumberOfMasks(void);
+
+// section of private data -----------------------------------------------------
+private:
+    QMutex                      CacheMutex;
+    QHash<QString,CASLProgram>  Programs;
+    QList<QString>              Recent;     // the most recently used is the first
+    int                         Capacity;
+
+    /// parse and compile mask - lock is not needed
+    bool Compile(const QString& mask,CASLProgram& program);
+
+    /// release masks over the capacity - lock must be held
+    void Shrink(void);
+};
+
+// -----------------------------------------------------------------------------
+
+extern NEMESIS_CORE_PACKAGE CASLMaskCache ASLMaskCache;
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,228 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLProgram.hpp>
+#include <ASLAtomTable.hpp>
+#include <ErrorSystem.hpp>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CASLItem::CASLItem(void)
+{
+    Index = -1;
+    Length = 0;
+    Name = 0;
+    NameMask = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CASLInstruction::CASLInstruction(void)
+{
+    Type = EASLI_SELECT;
+    Selector = T_ASELECTOR;
+    Operator = O_NONE;
+    Modificator = D_ORIGIN;
+    Distance = 0.0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CASLProgram::CASLProgram(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CASLProgram::Compile(struct SExpression* p_expr)
+{
+    Clear();
+
+    if( CompileExpression(p_expr) == false ){
+        ES_ERROR("unable to compile expression tree");
+        Clear();
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CASLProgram::Clear(void)
+{
+    Instructions.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+const QVector<CASLInstruction>& CASLProgram::GetInstructions(void) const
+{
+    return(Instructions);
+}
+
+//------------------------------------------------------------------------------
+
+bool CASLProgram::IsEmpty(void) const
+{
+    return(Instructions.isEmpty());
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CASLProgram::CompileExpression(struct SExpression* p_expr)
+{
+    if( p_expr == NULL ) {
+        INVALID_ARGUMENT("p_expr is NULL");
+    }
+
+    // is it selection?
+    if( p_expr->Selection != NULL ) {
+        return(CompileSelection(p_expr->Selection));
+    }
+
+    CASLInstruction instr;
+
+    switch(p_expr->Operator) {
+        case O_NOT:
+            if( CompileExpression(p_expr->RightExpression) == false ) return(false);
+            instr.Type = EASLI_NOT;
+            break;
+        case O_AND:
+        case O_OR:
+            if( CompileExpression(p_expr->LeftExpression) == false ) return(false);
+            if( CompileExpression(p_expr->RightExpression) == false ) return(false);
+            instr.Type = p_expr->Operator == O_AND ? EASLI_AND : EASLI_OR;
+            break;
+        case O_RLT:
+        case O_RGT:
+        case O_ALT:
+        case O_AGT:
+            switch(p_expr->Modificator) {
+                case D_ORIGIN:
+                case D_CBOX:
+                    // no reference selection
+                    break;
+                case D_LIST:
+                case D_COM:
+                case D_PLANE:
+                    if( CompileExpression(p_expr->LeftExpression) == false ) return(false);
+                    break;
+                default:
+                    ES_ERROR("not implemented distance modificator");
+                    return(false);
+            }
+            instr.Type = EASLI_DISTANCE;
+            instr.Operator = p_expr->Operator;
+            instr.Modificator = p_expr->Modificator;
+            instr.Distance = p_expr->Distance;
+            break;
+        default:
+            ES_ERROR("not implemented operator");
+            return(false);
+    }
+
+    Instructions.append(instr);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CASLProgram::CompileSelection(struct SSelection* p_sel)
+{
+    // get selection list
+    struct SList* p_list = p_sel->Items;
+    if( p_list == NULL ) {
+        ES_ERROR("p_list is NULL");
+        return(false);
+    }
+
+    switch(p_sel->Type) {
+        case T_RSELECTOR:
+        case T_ASELECTOR:
+        case T_TSELECTOR:
+            break;
+        default:
+            ES_ERROR("unknown selector");
+            return(false);
+    }
+
+    CASLInstruction instr;
+    instr.Type = EASLI_SELECT;
+    instr.Selector = p_sel->Type;
+
+    struct SListItem* p_item = p_list->FirstItem;
+
+    while( p_item != NULL ) {
+        CASLItem item;
+        item.Index = p_item->Index;
+        item.Length = p_item->Length;
+
+        if( p_item->Index > 0 ) {
+            if( p_item->Length < 1 ) {
+                ES_ERROR("illegal range");
+                return(false);
+            }
+            if( p_sel->Type == T_TSELECTOR ) {
+                ES_ERROR("index or range for type selector is meaningless");
+                return(false);
+            }
+        }
+
+        if( p_item->Index == 0 ) {
+            // wild card '*' is treated on parser level!
+            // here we need to manage only '=' wild card
+            // this wild card can be only at the end of name
+            int search_len = 4;
+            for(int i=3; i >= 0; i--) {
+                if( p_item->Name[i] == '=' ) {
+                    search_len = i;
+                    break;
+                }
+            }
+            item.Name = CASLAtomTable::PackName(p_item->Name,search_len);
+            if( search_len >= 4 ){
+                item.NameMask = 0xFFFFFFFF;
+            } else {
+                item.NameMask = ((quint32)1 << (8*search_len)) - 1;
+            }
+        }
+
+        instr.Items.append(item);
+        p_item = p_item->NextItem;
+    }
+
+    Instructions.append(instr);
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,107 @@
+#ifndef ASLProgramH
+#define ASLProgramH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include "maskparser/ASLParser.hpp"
+#include <QVector>
+
+//---------------------------------------------------------------------------
+
+/// item of selector list
+
+class NEMESIS_CORE_PACKAGE CASLItem {
+public:
+    CASLItem(void);
+public:
+    int         Index;      // <0 - all atoms, >0 - the first index of range, 0 - name
+    int         Length;     // length of range
+    quint32     Name;       // name packed by CASLAtomTable::PackName()
+    quint32     NameMask;   // compared bytes of name, '=' wild card shortens it
+};
+
+//------------------------------------------------------------------------------
+
+/// instruction types
+
+enum EASLInstruction {
+    EASLI_SELECT,       // push selection
+    EASLI_NOT,          // negate top of stack
+    EASLI_AND,          // pop two operands, push their intersection
+    EASLI_OR,           // pop two operands, push their union
+    EASLI_DISTANCE      // push distance selection, list, com and plane pop reference
+};
+
+//------------------------------------------------------------------------------
+
+/// one instruction of compiled mask
+
+class NEMESIS_CORE_PACKAGE CASLInstruction {
+public:
+    CASLInstruction(void);
+public:
+    EASLInstruction     Type;
+    // EASLI_SELECT
+    enum SType          Selector;
+    QVector<CASLItem>   Items;
+    // EASLI_DISTANCE
+    enum SOperator      Operator;
+    enum DModificator   Modificator;
+    double              Distance;
+};
+
+//------------------------------------------------------------------------------
+
+/// ASL mask compiled into postfix program
+/*! the program does not depend on parser data, it can be evaluated
+    by CASLSelection repeatedly
+*/
+
+class NEMESIS_CORE_PACKAGE CASLProgram {
+public:
+// constructor -----------------------------------------------------------------
+    CASLProgram(void);
+
+// executive methods -----------------------------------------------------------
+    /// compile expression tree
+    bool Compile(struct SExpression* p_expr);
+
+    /// remove all instructions
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get instructions
+    const QVector<CASLInstruction>& GetInstructions(void) const;
+
+    /// is program empty?
+    bool IsEmpty(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QVector<CASLInstruction>    Instructions;
+
+    bool CompileExpression(struct SExpression* p_expr);
+    bool CompileSelection(struct SSelection* p_sel);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
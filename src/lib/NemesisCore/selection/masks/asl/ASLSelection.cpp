@@ -20,206 +20,98 @@
 //     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 // =============================================================================
 
-#include <stdio.h>
-#include <string.h>
-#include <ctype.h>
-#include <stdlib.h>
 #include <ErrorSystem.hpp>
 #include <ASLSelection.hpp>
-#include <ASLMask.hpp>
+#include <ASLAtomTable.hpp>
 #include <Structure.hpp>
-#include <AtomList.hpp>
-#include <ResidueList.hpp>
 #include <Atom.hpp>
-#include <Residue.hpp>
 #include <PeriodicTable.hpp>
-
-#include "maskparser/AmberMaskParser.hpp"
+#include <SpatialIndex.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-CASLSelection::CASLSelection(CASLMask* p_mask,QObject* p_owner)
-    : QObject(p_owner)
+CASLSelection::CASLSelection(CStructure* p_str,const CASLAtomTable* p_table,
+                             const CSpatialIndex* p_index)
 {
-    Mask = p_mask;
-    foreach(QObject* p_qobj, Mask->Structure->GetAtoms()->children()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        Selection[p_atom] = false;
-    }
+    Structure = p_str;
+    Table = p_table;
+    Index = p_index;
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-bool CASLSelection::ExpandAndReduceTree(struct SExpression* p_expr)
+bool CASLSelection::Evaluate(const CASLProgram& program,CASLBitSet& result)
 {
-    if( p_expr == NULL ) {
-        INVALID_ARGUMENT("p_expr is NULL");
-    }
-
-    // is it selection?
-    if( p_expr->Selection != NULL ) {
-        if( Select(p_expr->Selection) == false ) {
-            ES_ERROR("unable to select");
-            return(false);
-        }
-        return(true);
-    }
-
-    CASLSelection* p_left  = NULL;
-    CASLSelection* p_right = NULL;
-
-    // it is operator - allocate left operand
-    switch(p_expr->Operator) {
-        case O_NOT:
-            // no left operand
-            break;
-        case O_AND:
-        case O_OR:
-            // alocate expression
-            p_left = new CASLSelection(Mask,this);
-            // expand and reduce
-            if( p_left->ExpandAndReduceTree(p_expr->LeftExpression) == false ) {
-                ES_ERROR("cannot expand and reduce left operand");
-                return(false);
+    int                 natoms = Table->GetNumberOfAtoms();
+    QVector<CASLBitSet> stack;
+
+    foreach(const CASLInstruction& instr, program.GetInstructions()){
+        switch(instr.Type) {
+            case EASLI_SELECT: {
+                CASLBitSet bits(natoms);
+                if( Select(instr,bits) == false ) {
+                    ES_ERROR("unable to select");
+                    return(false);
+                }
+                stack.append(bits);
             }
             break;
-        case O_RLT:
-        case O_RGT:
-        case O_ALT:
-        case O_AGT:
-            switch(p_expr->Modificator) {
-            case D_ORIGIN:
-            case D_CBOX:
-                // nothing to do
-                break;
-            case D_LIST:
-            case D_COM:
-            case D_PLANE:
-                // alocate expression
-                p_left = new CASLSelection(Mask,this);
-                // expand and reduce
-                if( p_left->ExpandAndReduceTree(p_expr->LeftExpression) == false ) {
-                    ES_ERROR("cannot expand and reduce left operand");
+            case EASLI_NOT:
+                if( stack.count() < 1 ) {
+                    ES_ERROR("missing operand");
                     return(false);
                 }
+                stack.last().Not();
                 break;
-            default:
-                ES_ERROR("not implemented distance modificator");
-                return(false);
-            }
-            break;
-        default:
-            ES_ERROR("not implemented operator");
-            return(false);
-    }
-
-    // it is operator - allocate right operand
-    switch(p_expr->Operator) {
-        case O_NOT:
-        case O_AND:
-        case O_OR:
-            p_right = new CASLSelection(Mask,this);
-            break;
-        case O_RLT:
-        case O_RGT:
-        case O_ALT:
-        case O_AGT:
-            // nothing to do
-            break;
-        default:
-            ES_ERROR("not implemented");
-            return(false);
-    }
-
-    // expand and reduce right operand
-    if( p_right != NULL ) {
-        if( p_right->ExpandAndReduceTree(p_expr->RightExpression) == false ) {
-            ES_ERROR("cannot expand and reduce right operand");
-            return(false);
-        }
-    }
-
-    // do arithemetic
-    switch(p_expr->Operator) {
-        case O_NOT:
-            foreach(QObject* p_qobj, Mask->GetAtoms()){
-                CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-                Selection[p_atom] = ! p_right->Selection[p_atom];
-            }
-            break;
-        case O_AND:
-            foreach(QObject* p_qobj, Mask->GetAtoms()){
-                CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-                Selection[p_atom] = p_left->Selection[p_atom] && p_right->Selection[p_atom];
+            case EASLI_AND:
+            case EASLI_OR: {
+                if( stack.count() < 2 ) {
+                    ES_ERROR("missing operand");
+                    return(false);
+                }
+                CASLBitSet right = stack.takeLast();
+                if( instr.Type == EASLI_AND ) {
+                    stack.last().And(right);
+                } else {
+                    stack.last().Or(right);
+                }
             }
             break;
-        case O_OR:
-            foreach(QObject* p_qobj, Mask->GetAtoms()){
-                CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-                Selection[p_atom] = p_left->Selection[p_atom] || p_right->Selection[p_atom];
+            case EASLI_DISTANCE: {
+                CASLBitSet  ref;
+                bool        has_ref = (instr.Modificator == D_LIST) || (instr.Modificator == D_COM)
+                                      || (instr.Modificator == D_PLANE);
+                if( has_ref ) {
+                    if( stack.count() < 1 ) {
+                        ES_ERROR("missing operand");
+                        return(false);
+                    }
+                    ref = stack.takeLast();
+                }
+                CASLBitSet bits(natoms);
+                if( SelectByDistance(instr,has_ref ? &ref : NULL,bits) == false ) {
+                    ES_ERROR("unable to select by distance");
+                    return(false);
+                }
+                stack.append(bits);
             }
             break;
-        case O_RLT:
-        case O_RGT: {
-            bool result = false;
-            switch(p_expr->Modificator) {
-            case D_ORIGIN:
-                result = SelectResidueByDistanceFromOrigin(p_expr->Operator,p_expr->Distance);
-                break;
-            case D_CBOX:
-                result = SelectResidueByDistanceFromCentreOfBox(p_expr->Operator,p_expr->Distance);
-                break;
-            case D_LIST:
-                result = SelectResidueByDistanceFromList(p_left,p_expr->Operator,p_expr->Distance);
-                break;
-            case D_COM:
-                result = SelectResidueByDistanceFromCOM(p_left,p_expr->Operator,p_expr->Distance);
-                break;
-            case D_PLANE:
-                result = SelectResidueByDistanceFromPlane(p_left,p_expr->Operator,p_expr->Distance);
-                break;
-            default:
-                ES_ERROR("not implemented");
-                return(false);
-            }
-            if( result == false ) return(false);
-        }
-        break;
-        case O_AGT:
-        case O_ALT: {
-            bool result = false;
-            switch(p_expr->Modificator) {
-            case D_ORIGIN:
-                result = SelectAtomByDistanceFromOrigin(p_expr->Operator,p_expr->Distance);
-                break;
-            case D_CBOX:
-                result = SelectAtomByDistanceFromCentreOfBox(p_expr->Operator,p_expr->Distance);
-                break;
-            case D_LIST:
-                result = SelectAtomByDistanceFromList(p_left,p_expr->Operator,p_expr->Distance);
-                break;
-            case D_COM:
-                result = SelectAtomByDistanceFromCOM(p_left,p_expr->Operator,p_expr->Distance);
-                break;
-            case D_PLANE:
-                result = SelectAtomByDistanceFromPlane(p_left,p_expr->Operator,p_expr->Distance);
-                break;
             default:
-                ES_ERROR("not implemented");
+                ES_ERROR("not implemented instruction");
                 return(false);
-            }
-            if( result == false ) return(false);
         }
-        break;
-        default:
-            ES_ERROR("not implemented");
-            return(false);
     }
 
+    if( stack.count() != 1 ) {
+        ES_ERROR("incomplete program");
+        return(false);
+    }
+
+    result = stack.last();
     return(true);
 }
 
@@ -227,69 +119,47 @@ bool CASLSelection::ExpandAndReduceTree(struct SExpression* p_expr)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-bool CASLSelection::Select(struct SSelection* p_sel)
+bool CASLSelection::Select(const CASLInstruction& instr,CASLBitSet& bits)
 {
-    if( p_sel == NULL ) {
-        INVALID_ARGUMENT("p_sel is NULL");
-    }
-
-    // get selection list
-    struct SList* p_list = p_sel->Items;
-    if( p_list == NULL ) {
-        ES_ERROR("p_list is NULL");
-        return(false);
-    }
-
-    struct SListItem* p_item = p_list->FirstItem;
-
-    while( p_item != NULL ) {
-        if( p_item->Index < 0 ) {
+    foreach(const CASLItem& item, instr.Items){
+        if( item.Index < 0 ) {
             // no matter of selector - this always means all atoms
-            foreach(QObject* p_qobj, Mask->GetAtoms()){
-                CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-                Selection[p_atom] = true;
-            }
-        }
-        if( p_item->Index > 0 ) {
-            if( p_item->Length >= 1 ) {
-                switch(p_sel->Type) {
-                    case T_RSELECTOR:
-                        SelectResidueByIndex(p_item->Index,p_item->Length);
-                        break;
-                    case T_ASELECTOR:
-                        SelectAtomByIndex(p_item->Index,p_item->Length);
-                        break;
-                    case T_TSELECTOR:
-                        ES_ERROR("index or range for type selector is meaningless");
-                        return(false);
-                    default:
-                        ES_ERROR("unknown selector");
-                        return(false);
-                }
-            } else {
-                ES_ERROR("illegal range");
-                return(false);
-            }
+            bits.SetAll();
+            continue;
         }
 
-        if( p_item->Index == 0 ) {
-            switch(p_sel->Type) {
+        if( item.Index > 0 ) {
+            switch(instr.Selector) {
                 case T_RSELECTOR:
-                    SelectResidueByName(p_item->Name);
+                    SelectResidueByIndex(item.Index,item.Length,bits);
                     break;
                 case T_ASELECTOR:
-                    SelectAtomByName(p_item->Name);
+                    SelectAtomByIndex(item.Index,item.Length,bits);
                     break;
                 case T_TSELECTOR:
-                    SelectAtomByType(p_item->Name);
-                    break;
+                    ES_ERROR("index or range for type selector is meaningless");
+                    return(false);
                 default:
                     ES_ERROR("unknown selector");
                     return(false);
             }
+            continue;
         }
 
-        p_item = p_item->NextItem;
+        switch(instr.Selector) {
+            case T_RSELECTOR:
+                SelectResidueByName(item,bits);
+                break;
+            case T_ASELECTOR:
+                SelectAtomByName(item,bits);
+                break;
+            case T_TSELECTOR:
+                SelectAtomByType(item,bits);
+                break;
+            default:
+                ES_ERROR("unknown selector");
+                return(false);
+        }
     }
 
     return(true);
@@ -297,272 +167,175 @@ bool CASLSelection::Select(struct SSelection* p_sel)
 
 //------------------------------------------------------------------------------
 
-void CASLSelection::SelectAtomByIndex(int index,int length)
+void CASLSelection::SelectAtomByIndex(int index,int length,CASLBitSet& bits)
 {
     int start = index;
     int end   = index + length - 1;
 
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( (p_atom->GetSerIndex() < start) || (p_atom->GetSerIndex() > end) ) continue;
-        Selection[p_atom] = true;
+    const int*  p_ser = Table->SerIndexes.constData();
+    int         natoms = Table->GetNumberOfAtoms();
+
+    for(int i=0; i < natoms; i++){
+        if( (p_ser[i] < start) || (p_ser[i] > end) ) continue;
+        bits.Set(i);
     }
 }
 
 //------------------------------------------------------------------------------
 
-void CASLSelection::SelectAtomByName(const char* p_name)
+void CASLSelection::SelectAtomByName(const CASLItem& item,CASLBitSet& bits)
 {
-    // wild card '*' is treated on parser level!
-    // see bool Select(struct SSelection* p_sel) method
+    QVector<bool> matches;
+    MatchNames(Table->Names,item,matches);
 
-    // here we need to manage only '=' wild card
-    // this wild card can be only at the end of p_name
+    const int*  p_ids = Table->NameIds.constData();
+    int         natoms = Table->GetNumberOfAtoms();
 
-    int search_len = 4;
-    // try to find wild card
-    for(int i=3; i >= 0; i--) {
-        if( p_name[i] == '=' ) {
-            search_len = i;
-            break;
-        }
-    }
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( strncmp(p_atom->GetName().toLatin1(),p_name,search_len) != 0 ) continue;
-        Selection[p_atom] = true;
+    for(int i=0; i < natoms; i++){
+        if( matches.at(p_ids[i]) ) bits.Set(i);
     }
 }
 
 //------------------------------------------------------------------------------
 
-void CASLSelection::SelectAtomByType(const char* p_name)
+void CASLSelection::SelectAtomByType(const CASLItem& item,CASLBitSet& bits)
 {
-    // wild card '*' is treated on parser level!
-    // see bool Select(struct SSelection* p_sel) method
+    QVector<bool> matches;
+    MatchNames(Table->Types,item,matches);
 
-    // here we need to manage only '=' wild card
-    // this wild card can be only at the end of p_name
+    const int*  p_ids = Table->TypeIds.constData();
+    int         natoms = Table->GetNumberOfAtoms();
 
-    int search_len = 4;
-    // try to find wild card
-    for(int i=3; i >= 0; i--) {
-        if( p_name[i] == '=' ) {
-            search_len = i;
-            break;
-        }
-    }
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( strncmp(p_atom->GetType().toLatin1(),p_name,search_len) != 0 ) continue;
-        Selection[p_atom] = true;
+    for(int i=0; i < natoms; i++){
+        if( matches.at(p_ids[i]) ) bits.Set(i);
     }
 }
 
 //------------------------------------------------------------------------------
 
-void CASLSelection::SelectResidueByIndex(int index,int length)
+void CASLSelection::SelectResidueByIndex(int index,int length,CASLBitSet& bits)
 {
     int start = index;
     int end   = index + length - 1;
 
-    foreach(QObject* p_qobj, Mask->GetResidues()){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-        if( (p_res->GetSeqIndex() < start) || (p_res->GetSeqIndex() > end) ) continue;
-
-        foreach(CAtom* p_atom, p_res->GetAtoms()){
-            Selection[p_atom] = true;
-        }
+    for(int r=0; r < Table->GetNumberOfResidues(); r++){
+        int seq = Table->SeqIndexes.at(r);
+        if( (seq < start) || (seq > end) ) continue;
+        SelectResidue(r,bits);
     }
 }
 
 //------------------------------------------------------------------------------
 
-void CASLSelection::SelectResidueByName(const char* p_name)
+void CASLSelection::SelectResidueByName(const CASLItem& item,CASLBitSet& bits)
 {
-    // wild card '*' is treated on parser level!
-    // see bool Select(struct SSelection* p_sel) method
-
-    // here we need to manage only '=' wild card
-    // this wild card can be only at the end
+    QVector<bool> matches;
+    MatchNames(Table->ResNames,item,matches);
 
-    int search_len = 4;
-    // try to find wild card
-    for(int i=3; i >= 0; i--) {
-        if( p_name[i] == '=' ) {
-            search_len = i;
-            break;
-        }
-    }
-
-    foreach(QObject* p_qobj, Mask->GetResidues()){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-        if( strncmp(p_res->GetName().toLatin1(),p_name,search_len) != 0 ) continue;
-
-        foreach(CAtom* p_atom, p_res->GetAtoms()){
-            Selection[p_atom] = true;
-        }
+    for(int r=0; r < Table->GetNumberOfResidues(); r++){
+        if( matches.at(Table->ResNameIds.at(r)) ) SelectResidue(r,bits);
     }
 }
 
-//==============================================================================
 //------------------------------------------------------------------------------
-//==============================================================================
 
-bool CASLSelection::SelectAtomByDistanceFromOrigin(SOperator dist_oper,double dist)
+void CASLSelection::SelectResidue(int res,CASLBitSet& bits)
 {
-    double dist2 = dist*dist;
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-
-        CPoint pos = p_atom->GetPos();
-        double ldist2 = Square(pos);
-
-        switch(dist_oper) {
-            case O_ALT:
-                if( ldist2 < dist2 ) Selection[p_atom] = true;
-                break;
-            case O_AGT:
-                if( ldist2 > dist2 ) Selection[p_atom] = true;
-                break;
-            case O_RLT:
-            case O_RGT:
-            default:
-                ES_ERROR("incorrect operator");
-                return(false);
-        }
+    for(int k=Table->ResAtomStart.at(res); k < Table->ResAtomStart.at(res+1); k++){
+        bits.Set(Table->ResAtoms.at(k));
     }
-
-    return(true);
 }
 
 //------------------------------------------------------------------------------
 
-bool CASLSelection::SelectAtomByDistanceFromCentreOfBox(SOperator dist_oper,double dist)
+void CASLSelection::MatchNames(const QVector<quint32>& names,const CASLItem& item,
+                               QVector<bool>& matches)
 {
-    if( ! Mask->Structure->PBCInfo.IsValid() ) {
-        ES_ERROR("cbox requires box");
-        return(false);
+    matches.resize(names.count());
+    for(int i=0; i < names.count(); i++){
+        matches[i] = ((names.at(i) ^ item.Name) & item.NameMask) == 0;
     }
-
-    double dist2 = dist*dist;
-    CPoint cbox = Mask->Structure->PBCInfo.GetBoxCenter();
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-
-        CPoint pos = p_atom->GetPos();
-        double ldist2 = Square(pos-cbox);
-
-        switch(dist_oper) {
-            case O_ALT:
-                if( ldist2 < dist2 ) Selection[p_atom] = true;
-                break;
-            case O_AGT:
-                if( ldist2 > dist2 ) Selection[p_atom] = true;
-                break;
-            case O_RLT:
-            case O_RGT:
-            default:
-                ES_ERROR("incorrect operator");
-                return(false);
-        }
-    }
-
-    return(true);
 }
 
+//==============================================================================
 //------------------------------------------------------------------------------
+//==============================================================================
 
-bool CASLSelection::SelectAtomByDistanceFromList(CASLSelection* p_left,
-                                                 SOperator dist_oper,double dist)
+bool CASLSelection::SelectByDistance(const CASLInstruction& instr,const CASLBitSet* p_ref,
+                                     CASLBitSet& bits)
 {
-    double dist2 = dist*dist;
+    bool less;
+    bool residues;
 
-    foreach(QObject* p_qobj1, Mask->GetAtoms()){
-        CAtom* p_atom1 = static_cast<CAtom*>(p_qobj1);
-
-        CPoint pos1 = p_atom1->GetPos();
-
-        foreach(QObject* p_qobj2, Mask->GetAtoms()){
-            CAtom* p_atom2 = static_cast<CAtom*>(p_qobj2);
-            if( p_left->Selection[p_atom2] == false ) continue;
+    switch(instr.Operator) {
+        case O_ALT:
+            less = true;
+            residues = false;
+            break;
+        case O_AGT:
+            less = false;
+            residues = false;
+            break;
+        case O_RLT:
+            less = true;
+            residues = true;
+            break;
+        case O_RGT:
+            less = false;
+            residues = true;
+            break;
+        default:
+            ES_ERROR("incorrect operator");
+            return(false);
+    }
 
-            CPoint pos2 = p_atom2->GetPos();
-            double ldist2 = Square(pos2-pos1);
+    // atoms satisfying distance criterion
+    CASLBitSet hits(Table->GetNumberOfAtoms());
 
-            bool set = false;
-            switch(dist_oper) {
-                case O_ALT:
-                    if( ldist2 < dist2 ) {
-                        Selection[p_atom1] = true;
-                        set = true;
-                    }
-                    break;
-                case O_AGT:
-                    if( ldist2 > dist2 ) {
-                        Selection[p_atom1] = true;
-                        set = true;
-                    }
-                    break;
-                case O_RLT:
-                case O_RGT:
-                default:
-                    ES_ERROR("incorrect operator");
-                    return(false);
+    switch(instr.Modificator) {
+        case D_ORIGIN:
+            SelectAtomByDistanceFromPoint(CPoint(),less,instr.Distance,hits);
+            break;
+        case D_CBOX:
+            if( ! Structure->PBCInfo.IsValid() ) {
+                ES_ERROR("cbox requires box");
+                return(false);
+            }
+            SelectAtomByDistanceFromPoint(Structure->PBCInfo.GetBoxCenter(),less,instr.Distance,hits);
+            break;
+        case D_LIST:
+            SelectAtomByDistanceFromList(*p_ref,less,instr.Distance,hits);
+            break;
+        case D_COM: {
+            // calculate centre of mass
+            CPoint     com;
+            double     tmass = 0.0;
+
+            for(int i=0; i < p_ref->GetSize(); i++){
+                if( ! p_ref->Test(i) ) continue;
+                double mass = PeriodicTable.GetMass(Table->Atoms.at(i)->GetZ());
+                com += Table->Positions.at(i)*mass;
+                tmass += mass;
             }
-            if( set == true ) break;
-        }
-    }
-
-    return(true);
-}
 
-//------------------------------------------------------------------------------
+            if( tmass <= 0.0 ) return(true);
+            com /= tmass;
 
-bool CASLSelection::SelectAtomByDistanceFromCOM(CASLSelection* p_left,
-                                                SOperator dist_oper,double dist)
-{
-    // calculate centre of mass
-    CPoint     com;
-    double     tmass = 0.0;
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( p_left->Selection[p_atom] == false ) continue;
-        double mass = PeriodicTable.GetMass(p_atom->GetZ());
-        com += p_atom->GetPos()*mass;
-        tmass += mass;
+            SelectAtomByDistanceFromPoint(com,less,instr.Distance,hits);
+        }
+        break;
+        case D_PLANE:
+            ES_ERROR("not implemented");
+            return(false);
+        default:
+            ES_ERROR("not implemented");
+            return(false);
     }
 
-    if( tmass <= 0.0 ) return(true);
-    com /= tmass;
-
-    double dist2 = dist*dist;
-
-    // select atoms
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-
-        CPoint pos = p_atom->GetPos();
-        double ldist2 = Square(pos-com);
-
-        switch(dist_oper) {
-            case O_ALT:
-                if( ldist2 < dist2 ) Selection[p_atom] = true;
-                break;
-            case O_AGT:
-                if( ldist2 > dist2 ) Selection[p_atom] = true;
-                break;
-            case O_RLT:
-            case O_RGT:
-            default:
-                ES_ERROR("incorrect operator");
-                return(false);
-        }
+    if( residues ) {
+        ExpandToResidues(hits,bits);
+    } else {
+        bits = hits;
     }
 
     return(true);
@@ -570,237 +343,87 @@ bool CASLSelection::SelectAtomByDistanceFromCOM(CASLSelection* p_left,
 
 //------------------------------------------------------------------------------
 
-bool CASLSelection::SelectAtomByDistanceFromPlane(CASLSelection* p_left,
-                                                  SOperator dist_oper,double dist)
-{
-    ES_ERROR("not implemented");
-    return(false);
-}
-
-//==============================================================================
-//------------------------------------------------------------------------------
-//==============================================================================
-
-bool CASLSelection::SelectResidueByDistanceFromOrigin(SOperator dist_oper,double dist)
+void CASLSelection::SelectAtomByDistanceFromPoint(const CPoint& point,bool less,double dist,
+                                                  CASLBitSet& bits)
 {
-    double dist2 = dist*dist;
-
-    foreach(QObject* p_qobj, Mask->GetResidues() ){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-
-        bool set = false;
-
-        // check any distance
-        foreach(CAtom* p_atom,p_res->GetAtoms()) {
-
-            CPoint pos = p_atom->GetPos();
-            double ldist2 = Square(pos);
+    double          dist2 = dist*dist;
+    const CPoint*   p_pos = Table->Positions.constData();
+    int             natoms = Table->GetNumberOfAtoms();
 
-            switch(dist_oper) {
-                case O_RLT:
-                    if( ldist2 < dist2 ) set = true;
-                    break;
-                case O_RGT:
-                    if( ldist2 > dist2 ) set = true;
-                    break;
-                case O_ALT:
-                case O_AGT:
-                default:
-                    ES_ERROR("incorrect operator");
-                    return(false);
-            }
-            if( set == true ) break;
-        }
-
-        // select residue
-        if( set ) {
-            foreach(CAtom* p_atom,p_res->GetAtoms()) {
-                Selection[p_atom] = true;
-            }
-        }
+    for(int i=0; i < natoms; i++){
+        double ldist2 = Square(p_pos[i]-point);
+        if( less ? (ldist2 < dist2) : (ldist2 > dist2) ) bits.Set(i);
     }
-
-    return(true);
 }
 
 //------------------------------------------------------------------------------
 
-bool CASLSelection::SelectResidueByDistanceFromCentreOfBox(SOperator dist_oper,double dist)
+void CASLSelection::SelectAtomByDistanceFromList(const CASLBitSet& ref,bool less,double dist,
+                                                 CASLBitSet& bits)
 {
-    if( ! Mask->Structure->PBCInfo.IsValid() ) {
-        ES_ERROR("cbox requires box");
-        return(false);
-    }
-
-    double dist2 = dist*dist;
-    CPoint cbox = Mask->Structure->PBCInfo.GetBoxCenter();
-
-    foreach(QObject* p_qobj, Mask->GetResidues() ){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-
-        bool set = false;
-
-        // check any distance
-        foreach(CAtom* p_atom,p_res->GetAtoms()) {
+    int             natoms = Table->GetNumberOfAtoms();
+    const CPoint*   p_pos = Table->Positions.constData();
 
-            CPoint pos = p_atom->GetPos();
-            double ldist2 = Square(pos-cbox);
-
-            switch(dist_oper) {
-                case O_RLT:
-                    if( ldist2 < dist2 ) set = true;
-                    break;
-                case O_RGT:
-                    if( ldist2 > dist2 ) set = true;
-                    break;
-                case O_ALT:
-                case O_AGT:
-                default:
-                    ES_ERROR("incorrect operator");
-                    return(false);
-            }
-            if( set == true ) break;
-        }
-
-        // select residue
-        if( set ) {
-            foreach(CAtom* p_atom,p_res->GetAtoms()) {
-                Selection[p_atom] = true;
-            }
-        }
+    QVector<int> ref_atoms;
+    for(int i=0; i < natoms; i++){
+        if( ref.Test(i) ) ref_atoms.append(i);
     }
 
-    return(true);
-}
-
-//------------------------------------------------------------------------------
-
-bool CASLSelection::SelectResidueByDistanceFromList(CASLSelection* p_left,
-                                                    SOperator dist_oper,double dist)
-{
-    double dist2 = dist*dist;
-
-    foreach(QObject* p_qobj, Mask->GetResidues() ){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-
-        bool set = false;
-
-        // check any distance
-        foreach(CAtom* p_atom1,p_res->GetAtoms()) {
-            CPoint pos1 = p_atom1->GetPos();
-
-            foreach(QObject* p_qobj2, Mask->GetAtoms()){
-                CAtom* p_atom2 = static_cast<CAtom*>(p_qobj2);
-                if( p_left->Selection[p_atom2] == false ) continue;
-
-                CPoint pos2 = p_atom2->GetPos();
-                double ldist2 = Square(pos2-pos1);
-
-                switch(dist_oper) {
-                    case O_RLT:
-                        if( ldist2 < dist2 ) {
-                            set = true;
-                        }
-                        break;
-                    case O_RGT:
-                        if( ldist2 > dist2 ) {
-                            set = true;
-                        }
-                        break;
-                    case O_ALT:
-                    case O_AGT:
-                    default:
-                        ES_ERROR("incorrect operator");
-                        return(false);
+    const CSpatialIndex* p_index = Index;
+    if( p_index == NULL ) p_index = Structure->GetSpatialIndex();
+
+    if( less ) {
+        // only atoms in the neighbourhood of reference atoms are tested
+        if( (p_index != NULL) && (p_index->GetNumberOfAtoms() == natoms) ) {
+            QVector<int> indexes;
+            foreach(int j, ref_atoms){
+                p_index->GetIndexesInSphere(p_pos[j],dist,indexes);
+                foreach(int i, indexes){
+                    bits.Set(i);
                 }
-                if( set == true ) break;
             }
-
-            if( set == true ) break;
+            return;
         }
+    }
 
-        // select residue
-        if( set ) {
-            foreach(CAtom* p_atom,p_res->GetAtoms()) {
-                Selection[p_atom] = true;
+    // distances are measured in the same way as by the index,
+    // i.e. by the minimum image convention if PBC is enabled
+    CPBCInfo    pbc = Structure->PBCInfo;
+    bool        image = pbc.IsPBCEnabled();
+    double      dist2 = dist*dist;
+
+    for(int i=0; i < natoms; i++){
+        foreach(int j, ref_atoms){
+            double ldist2;
+            if( p_index != NULL ){
+                ldist2 = p_index->GetDistance2(p_pos[j],p_pos[i]);
+            } else if( image ) {
+                ldist2 = Square(pbc.ImageVector(p_pos[i]-p_pos[j]));
+            } else {
+                ldist2 = Square(p_pos[j]-p_pos[i]);
+            }
+            if( less ? (ldist2 < dist2) : (ldist2 > dist2) ) {
+                bits.Set(i);
+                break;
             }
         }
     }
-
-    return(true);
 }
 
 //------------------------------------------------------------------------------
 
-bool CASLSelection::SelectResidueByDistanceFromCOM(CASLSelection* p_left,
-                                                   SOperator dist_oper,double dist)
+void CASLSelection::ExpandToResidues(const CASLBitSet& hits,CASLBitSet& bits)
 {
-    // calculate centre of mass
-    CPoint     com;
-    double     tmass = 0.0;
-
-    foreach(QObject* p_qobj, Mask->GetAtoms()){
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        if( p_left->Selection[p_atom] == false ) continue;
-        double mass = PeriodicTable.GetMass(p_atom->GetZ());
-        com += p_atom->GetPos()*mass;
-        tmass += mass;
-    }
-
-    if( tmass <= 0.0 ) return(true);
-    com /= tmass;
-
-    double dist2 = dist*dist;
-
-    foreach(QObject* p_qobj, Mask->GetResidues() ){
-        CResidue* p_res = static_cast<CResidue*>(p_qobj);
-
-        bool set = false;
-
-        // check any distance
-        foreach(CAtom* p_atom,p_res->GetAtoms()) {
-
-            CPoint pos = p_atom->GetPos();
-            double ldist2 = Square(pos-com);
-
-            switch(dist_oper) {
-                case O_RLT:
-                    if( ldist2 < dist2 ) set = true;
-                    break;
-                case O_RGT:
-                    if( ldist2 > dist2 ) set = true;
-                    break;
-                case O_ALT:
-                case O_AGT:
-                default:
-                    ES_ERROR("incorrect operator");
-                    return(false);
-            }
-            if( set == true ) break;
-        }
-
-        // select residue
-        if( set ) {
-            foreach(CAtom* p_atom,p_res->GetAtoms()) {
-                Selection[p_atom] = true;
+    for(int r=0; r < Table->GetNumberOfResidues(); r++){
+        for(int k=Table->ResAtomStart.at(r); k < Table->ResAtomStart.at(r+1); k++){
+            if( hits.Test(Table->ResAtoms.at(k)) ) {
+                SelectResidue(r,bits);
+                break;
             }
         }
     }
-
-    return(true);
-}
-
-//------------------------------------------------------------------------------
-
-bool CASLSelection::SelectResidueByDistanceFromPlane(CASLSelection* p_left,
-        SOperator dist_oper,double dist)
-{
-    ES_ERROR("not implemented");
-    return(false);
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
-
-
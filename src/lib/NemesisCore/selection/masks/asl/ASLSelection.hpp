@@ -23,62 +23,64 @@
 // =============================================================================
 
 #include "maskparser/ASLParser.hpp"
-#include <QMap>
-#include <QObject>
+#include <ASLBitSet.hpp>
+#include <ASLProgram.hpp>
+#include <Point.hpp>
+#include <QVector>
 
 //---------------------------------------------------------------------------
 
-class CASLMask;
-class CAtom;
+class CASLAtomTable;
+class CStructure;
+class CSpatialIndex;
 
 //------------------------------------------------------------------------------
 
-/// selection of atoms
+/// evaluator of compiled ASL mask
+/*! instructions are evaluated on a stack of bit sets over atoms of the table,
+    residue selections are expanded to all atoms of selected residues,
+    the spatial index of the structure is used for distance selections
+    unless an index built over positions of the table is provided
+*/
 
-class CASLSelection : public QObject {
+class CASLSelection {
 public:
-    CASLSelection(CASLMask* p_mask,QObject* p_owner);
+    CASLSelection(CStructure* p_str,const CASLAtomTable* p_table,
+                  const CSpatialIndex* p_index=NULL);
 
 // executive methods  ----------------------------------------------------------
-    bool ExpandAndReduceTree(struct SExpression* p_expr);
+    /// evaluate program, result contains selected atoms of the table
+    bool Evaluate(const CASLProgram& program,CASLBitSet& result);
 
 // section of private data -----------------------------------------------------
 private:
-    CASLMask*           Mask;
-    QMap<CAtom*,bool>   Selection;
+    CStructure*             Structure;
+    const CASLAtomTable*    Table;
+    const CSpatialIndex*    Index;
 
     // individual selections
-    bool Select(struct SSelection* p_sel);
-
-    void SelectAtomByIndex(int index,int length);
-    void SelectAtomByName(const char* p_name);
-    void SelectAtomByType(const char* p_name);
-
-    void SelectResidueByIndex(int index,int length);
-    void SelectResidueByName(const char* p_name);
-
-    bool SelectAtomByDistanceFromOrigin(SOperator dist_oper,double dist);
-    bool SelectAtomByDistanceFromCentreOfBox(SOperator dist_oper,double dist);
-    bool SelectAtomByDistanceFromList(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-    bool SelectAtomByDistanceFromCOM(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-    bool SelectAtomByDistanceFromPlane(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-
-    bool SelectResidueByDistanceFromOrigin(SOperator dist_oper,double dist);
-    bool SelectResidueByDistanceFromCentreOfBox(SOperator dist_oper,double dist);
-    bool SelectResidueByDistanceFromList(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-    bool SelectResidueByDistanceFromCOM(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-    bool SelectResidueByDistanceFromPlane(CASLSelection* p_left,
-            SOperator dist_oper,double dist);
-
-    int   strnlen(const char* p_s1,int len);
-    bool  firstmatch(const char* p_s1,const char* p_s2,int len);
-
-    friend class CASLMask;
+    bool Select(const CASLInstruction& instr,CASLBitSet& bits);
+
+    void SelectAtomByIndex(int index,int length,CASLBitSet& bits);
+    void SelectAtomByName(const CASLItem& item,CASLBitSet& bits);
+    void SelectAtomByType(const CASLItem& item,CASLBitSet& bits);
+
+    void SelectResidueByIndex(int index,int length,CASLBitSet& bits);
+    void SelectResidueByName(const CASLItem& item,CASLBitSet& bits);
+    void SelectResidue(int res,CASLBitSet& bits);
+
+    // distance selections
+    bool SelectByDistance(const CASLInstruction& instr,const CASLBitSet* p_ref,
+            CASLBitSet& bits);
+    void SelectAtomByDistanceFromPoint(const CPoint& point,bool less,double dist,
+            CASLBitSet& bits);
+    void SelectAtomByDistanceFromList(const CASLBitSet& ref,bool less,double dist,
+            CASLBitSet& bits);
+    void ExpandToResidues(const CASLBitSet& hits,CASLBitSet& bits);
+
+    /// evaluate name pattern for each interned name
+    static void MatchNames(const QVector<quint32>& names,const CASLItem& item,
+            QVector<bool>& matches);
 };
 
 //---------------------------------------------------------------------------
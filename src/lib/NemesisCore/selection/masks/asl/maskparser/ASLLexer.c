@@ -0,0 +1,192 @@
+/* =============================================================================
+AMBER Mask Lexical Analyzer
+      Copyright (c) 2008 Petr Kulhanek, kulhanek@enzim.hu
+============================================================================= */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ASLParser.hpp"
+#include "ASLMask.tab.h"
+
+/* the scanner is reentrant, it reads the mask from the parser context,
+   the longest token is matched, keywords take precedence over names
+   of the same length */
+
+/* max length of number */
+#define ASL_MAX_NUMBER_LEN 63
+
+/* ========================================================================== */
+
+static int is_digit(char c)
+{
+ return( (c >= '0') && (c <= '9') );
+}
+
+/* -------------------------------------------------------------------------- */
+
+static int is_name_first(char c)
+{
+ return( (c >= 'A') && (c <= 'z') );
+}
+
+/* -------------------------------------------------------------------------- */
+
+static int is_name_next(char c)
+{
+ if( c == '\0' ) return(0);
+ return( strchr(",&|!() \t@",c) == NULL );
+}
+
+/* -------------------------------------------------------------------------- */
+
+static int is_keyword(const char* p_beg,int len,const char* p_keyword)
+{
+ return( ((int)strlen(p_keyword) == len) && (strncmp(p_beg,p_keyword,len) == 0) );
+}
+
+/* ========================================================================== */
+
+int yylex(YYSTYPE* p_lval,struct SASLParserContext* p_ctx)
+{
+ const char* p = p_ctx->Current;
+
+ for(;;){
+    int position = p_ctx->LexPosition;
+
+    /* end of mask */
+    if( *p == '\0' ){
+        p_ctx->Current = p;
+        return(0);
+        }
+
+    /* whitespaces */
+    if( (*p == ' ') || (*p == '\t') ){
+        p++;
+        p_ctx->LexPosition++;
+        continue;
+        }
+
+    if( *p == '\n' ){
+        p_ctx->Current = p + 1;
+        pperror("new line character is not allowed in mask specification",position);
+        return(ERROR);
+        }
+
+    /* numbers */
+    if( is_digit(*p) ){
+        char        buffer[ASL_MAX_NUMBER_LEN+1];
+        const char* p_end = p;
+        int         ilen, len;
+
+        while( is_digit(*p_end) ) p_end++;
+        ilen = p_end - p;
+        if( *p_end == '.' ){
+            p_end++;
+            while( is_digit(*p_end) ) p_end++;
+            }
+        len = p_end - p;
+
+        if( len > ASL_MAX_NUMBER_LEN ){
+            pperror("number is too long",position);
+            len = ASL_MAX_NUMBER_LEN;
+            }
+        memcpy(buffer,p,len);
+        buffer[len] = '\0';
+
+        p_ctx->Current = p_end;
+        p_ctx->LexPosition += p_end - p;
+
+        if( len == ilen ){
+            p_lval->iValue.Position = position;
+            if( sscanf(buffer, "%d", &p_lval->iValue.Number) != 1 ){
+                pperror("unable to convert string to integer",position);
+                }
+            return(INUMBER);
+            }
+
+        p_lval->rValue.Position = position;
+        if( sscanf(buffer, "%lf", &p_lval->rValue.Number) != 1 ){
+            pperror("unable to convert string to real number",position);
+            }
+        return(RNUMBER);
+        }
+
+    /* keywords and names */
+    if( is_name_first(*p) ){
+        const char* p_end = p + 1;
+        int         len;
+
+        while( is_name_next(*p_end) ) p_end++;
+        len = p_end - p;
+
+        p_ctx->Current = p_end;
+        p_ctx->LexPosition += len;
+        p_lval->gValue.Position = position;
+
+        if( is_keyword(p,len,"origin") ) return(ORIGIN);
+        if( is_keyword(p,len,"cbox") ) return(CBOX);
+        if( is_keyword(p,len,"list") ) return(LIST);
+        if( is_keyword(p,len,"com") ) return(COM);
+        if( is_keyword(p,len,"plane") ) return(PLANE);
+
+        p_lval->sValue.Position = position;
+        if( len > 4 ){
+            pperror("name is too long (max 4 characters)",position);
+            len = 4;
+            }
+        memset(p_lval->sValue.String,0,4);
+        strncpy(p_lval->sValue.String,p,len);
+        return(STRING);
+        }
+
+    /* two character operators */
+    if( p[0] != '\0' ){
+        int token = 0;
+
+        if( (p[0] == '@') && (p[1] == '%') ) token = TSELECTOR;
+        if( (p[0] == '<') && (p[1] == ':') ) token = RLT;
+        if( (p[0] == '>') && (p[1] == ':') ) token = RGT;
+        if( (p[0] == '<') && (p[1] == '@') ) token = ALT;
+        if( (p[0] == '>') && (p[1] == '@') ) token = AGT;
+
+        if( token != 0 ){
+            p_lval->gValue.Position = position;
+            p_ctx->Current = p + 2;
+            p_ctx->LexPosition += 2;
+            return(token);
+            }
+        }
+
+    /* single character operators */
+    {
+        int token = 0;
+
+        switch(*p){
+            case '*': token = STAR; break;
+            case ',': token = COMMA; break;
+            case '-': token = RANGE; break;
+            case ':': token = RSELECTOR; break;
+            case '@': token = ASELECTOR; break;
+            case '&': token = AND; break;
+            case '|': token = OR; break;
+            case '!': token = NOT; break;
+            case '(': token = LBRA; break;
+            case ')': token = RBRA; break;
+            }
+
+        p++;
+        p_ctx->LexPosition++;
+
+        if( token != 0 ){
+            p_lval->gValue.Position = position;
+            p_ctx->Current = p;
+            return(token);
+            }
+        }
+
+    /* other characters are skipped */
+    }
+}
+
+/* ========================================================================== */
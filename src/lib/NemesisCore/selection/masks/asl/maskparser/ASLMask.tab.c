@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -60,14 +63,10 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
 
 
-/* Copy the first part of user declarations.  */
 
-/* Line 189 of yacc.c  */
+/* First part of user prologue.  */
 #line 6 "ASLMask.y"
 
 #include <malloc.h>
@@ -75,129 +74,160 @@
 #include <stdio.h>
 #include <stdio.h>
 #include <string.h>
-#include "ASLParser.hpp"
-#define YYERROR_VERBOSE
 
+#line 79 "ASLMask.tab.c"
 
-/* Line 189 of yacc.c  */
-#line 84 "ASLMask.tab.c"
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+#include "ASLMask.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_STRING = 3,                     /* STRING  */
+  YYSYMBOL_INUMBER = 4,                    /* INUMBER  */
+  YYSYMBOL_RNUMBER = 5,                    /* RNUMBER  */
+  YYSYMBOL_STAR = 6,                       /* STAR  */
+  YYSYMBOL_COMMA = 7,                      /* COMMA  */
+  YYSYMBOL_RANGE = 8,                      /* RANGE  */
+  YYSYMBOL_RSELECTOR = 9,                  /* RSELECTOR  */
+  YYSYMBOL_ASELECTOR = 10,                 /* ASELECTOR  */
+  YYSYMBOL_TSELECTOR = 11,                 /* TSELECTOR  */
+  YYSYMBOL_RLT = 12,                       /* RLT  */
+  YYSYMBOL_RGT = 13,                       /* RGT  */
+  YYSYMBOL_ALT = 14,                       /* ALT  */
+  YYSYMBOL_AGT = 15,                       /* AGT  */
+  YYSYMBOL_NOT = 16,                       /* NOT  */
+  YYSYMBOL_AND = 17,                       /* AND  */
+  YYSYMBOL_OR = 18,                        /* OR  */
+  YYSYMBOL_RBRA = 19,                      /* RBRA  */
+  YYSYMBOL_LBRA = 20,                      /* LBRA  */
+  YYSYMBOL_ERROR = 21,                     /* ERROR  */
+  YYSYMBOL_ORIGIN = 22,                    /* ORIGIN  */
+  YYSYMBOL_CBOX = 23,                      /* CBOX  */
+  YYSYMBOL_LIST = 24,                      /* LIST  */
+  YYSYMBOL_COM = 25,                       /* COM  */
+  YYSYMBOL_PLANE = 26,                     /* PLANE  */
+  YYSYMBOL_YYACCEPT = 27,                  /* $accept  */
+  YYSYMBOL_amber_mask = 28,                /* amber_mask  */
+  YYSYMBOL_expr = 29,                      /* expr  */
+  YYSYMBOL_selection = 30,                 /* selection  */
+  YYSYMBOL_sel_list = 31,                  /* sel_list  */
+  YYSYMBOL_list = 32,                      /* list  */
+  YYSYMBOL_item = 33                       /* item  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     STRING = 258,
-     INUMBER = 259,
-     RNUMBER = 260,
-     STAR = 261,
-     COMMA = 262,
-     RANGE = 263,
-     RSELECTOR = 264,
-     ASELECTOR = 265,
-     TSELECTOR = 266,
-     RLT = 267,
-     RGT = 268,
-     ALT = 269,
-     AGT = 270,
-     NOT = 271,
-     AND = 272,
-     OR = 273,
-     RBRA = 274,
-     LBRA = 275,
-     ERROR = 276,
-     ORIGIN = 277,
-     CBOX = 278,
-     LIST = 279,
-     COM = 280,
-     PLANE = 281
-   };
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-{
-
-/* Line 214 of yacc.c  */
-#line 16 "ASLMask.y"
-
-    SGrammar                gValue;
-    SInteger                iValue;
-    SReal                   rValue;
-    SString                 sValue;
-    struct SListItem*       itemValue;
-    struct SList*           listValue;
-    struct SSelection*      selValue;
-    struct SExpression*     exprValue;
-    
-
-
-/* Line 214 of yacc.c  */
-#line 159 "ASLMask.tab.c"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-/* Copy the second part of user declarations.  */
-
-
-/* Line 264 of yacc.c  */
-#line 171 "ASLMask.tab.c"
-
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -205,55 +235,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -270,11 +351,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -282,8 +363,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -297,88 +378,89 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  35
 /* YYLAST -- Last index in YYTABLE.  */
@@ -390,18 +472,23 @@ union yyalloc
 #define YYNNTS  7
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  43
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  95
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   281
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -435,123 +522,55 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     7,    11,    15,    18,    22,    26,
-      30,    34,    41,    48,    55,    59,    63,    67,    74,    81,
-      88,    92,    96,   100,   107,   114,   121,   125,   129,   133,
-     140,   147,   154,   159,   164,   167,   170,   173,   175,   177,
-     179,   183,   185,   189
+       0,    70,    70,    76,    88,    99,   110,   124,   129,   141,
+     153,   165,   177,   189,   202,   214,   226,   238,   250,   262,
+     275,   287,   299,   311,   323,   335,   348,   360,   372,   384,
+     396,   408,   423,   459,   497,   506,   515,   526,   529,   551,
+     563,   572,   582,   592
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      28,     0,    -1,    29,    -1,    30,    -1,    29,    17,    29,
-      -1,    29,    18,    29,    -1,    16,    29,    -1,    20,    29,
-      19,    -1,    22,    14,     5,    -1,    23,    14,     5,    -1,
-      29,    14,     5,    -1,    24,    20,    29,    19,    14,     5,
-      -1,    25,    20,    29,    19,    14,     5,    -1,    26,    20,
-      29,    19,    14,     5,    -1,    22,    15,     5,    -1,    23,
-      15,     5,    -1,    29,    15,     5,    -1,    24,    20,    29,
-      19,    15,     5,    -1,    25,    20,    29,    19,    15,     5,
-      -1,    26,    20,    29,    19,    15,     5,    -1,    22,    12,
-       5,    -1,    23,    12,     5,    -1,    29,    12,     5,    -1,
-      24,    20,    29,    19,    12,     5,    -1,    25,    20,    29,
-      19,    12,     5,    -1,    26,    20,    29,    19,    12,     5,
-      -1,    22,    13,     5,    -1,    23,    13,     5,    -1,    29,
-      13,     5,    -1,    24,    20,    29,    19,    13,     5,    -1,
-      25,    20,    29,    19,    13,     5,    -1,    26,    20,    29,
-      19,    13,     5,    -1,     9,    31,    10,    31,    -1,     9,
-      31,    11,    31,    -1,     9,    31,    -1,    10,    31,    -1,
-      11,    31,    -1,    32,    -1,     6,    -1,    33,    -1,    32,
-       7,    33,    -1,     4,    -1,     4,     8,     4,    -1,     3,
-      -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,    57,    57,    63,    75,    86,    97,   111,   116,   128,
-     140,   152,   164,   176,   189,   201,   213,   225,   237,   249,
-     262,   274,   286,   298,   310,   322,   335,   347,   359,   371,
-     383,   395,   410,   446,   484,   493,   502,   513,   516,   538,
-     550,   559,   569,   579
-};
-#endif
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "STRING", "INUMBER", "RNUMBER", "STAR",
-  "COMMA", "RANGE", "RSELECTOR", "ASELECTOR", "TSELECTOR", "RLT", "RGT",
-  "ALT", "AGT", "NOT", "AND", "OR", "RBRA", "LBRA", "ERROR", "ORIGIN",
-  "CBOX", "LIST", "COM", "PLANE", "$accept", "amber_mask", "expr",
-  "selection", "sel_list", "list", "item", 0
+  "\"end of file\"", "error", "\"invalid token\"", "STRING", "INUMBER",
+  "RNUMBER", "STAR", "COMMA", "RANGE", "RSELECTOR", "ASELECTOR",
+  "TSELECTOR", "RLT", "RGT", "ALT", "AGT", "NOT", "AND", "OR", "RBRA",
+  "LBRA", "ERROR", "ORIGIN", "CBOX", "LIST", "COM", "PLANE", "$accept",
+  "amber_mask", "expr", "selection", "sel_list", "list", "item", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    27,    28,    29,    29,    29,    29,    29,    29,    29,
-      29,    29,    29,    29,    29,    29,    29,    29,    29,    29,
-      29,    29,    29,    29,    29,    29,    29,    29,    29,    29,
-      29,    29,    29,    29,    30,    30,    30,    31,    31,    32,
-      32,    33,    33,    33
-};
+#define YYPACT_NINF (-19)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     1,     3,     3,     2,     3,     3,     3,
-       3,     6,     6,     6,     3,     3,     3,     6,     6,     6,
-       3,     3,     3,     6,     6,     6,     3,     3,     3,     6,
-       6,     6,     4,     4,     2,     2,     2,     1,     1,     1,
-       3,     1,     3,     1
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     2,     3,    43,    41,    38,    34,    37,    39,
-      35,    36,     6,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     1,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     7,    20,    26,     8,
-      14,    21,    27,     9,    15,     0,     0,     0,    22,    28,
-      10,    16,     4,     5,    42,    32,    33,    40,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    23,    29,    11,    17,    24,    30,    12,
-      18,    25,    31,    13,    19
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,    11,    12,    13,    17,    18,    19
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -19
 static const yytype_int8 yypact[] =
 {
       -4,     5,     5,     5,    -4,    -4,    22,    68,   -18,   -10,
@@ -566,18 +585,39 @@ static const yytype_int8 yypact[] =
      -19,   -19,   -19,   -19,   -19
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     2,     3,    43,    41,    38,    34,    37,    39,
+      35,    36,     6,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     1,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     7,    20,    26,     8,
+      14,    21,    27,     9,    15,     0,     0,     0,    22,    28,
+      10,    16,     4,     5,    42,    32,    33,    40,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    23,    29,    11,    17,    24,    30,    12,
+      18,    25,    31,    13,    19
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -19,   -19,    -1,   -19,    -2,   -19,    57
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,    11,    12,    13,    17,    18,    19
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       20,    21,    32,    22,    23,     1,     2,     3,    14,    15,
       33,    16,     4,    43,    44,    34,     5,    35,     6,     7,
@@ -611,9 +651,9 @@ static const yytype_int8 yycheck[] =
        5,     5,     5,     5
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     9,    10,    11,    16,    20,    22,    23,    24,    25,
       26,    28,    29,    30,     3,     4,     6,    31,    32,    33,
@@ -627,95 +667,61 @@ static const yytype_uint8 yystos[] =
        5,     5,     5,     5,     5
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    27,    28,    29,    29,    29,    29,    29,    29,    29,
+      29,    29,    29,    29,    29,    29,    29,    29,    29,    29,
+      29,    29,    29,    29,    29,    29,    29,    29,    29,    29,
+      29,    29,    29,    29,    30,    30,    30,    31,    31,    32,
+      32,    33,    33,    33
+};
 
-#define YYFAIL		goto yyerrlab
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     3,     3,     2,     3,     3,     3,
+       3,     6,     6,     6,     3,     3,     3,     6,     6,     6,
+       3,     3,     3,     6,     6,     6,     3,     3,     3,     6,
+       6,     6,     4,     4,     2,     2,     2,     1,     1,     1,
+       3,     1,     3,     1
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (p_ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -725,80 +731,59 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, p_ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct SASLParserContext* p_ctx)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (p_ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct SASLParserContext* p_ctx)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, p_ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -806,16 +791,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -826,63 +803,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, struct SASLParserContext* p_ctx)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], p_ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, p_ctx); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -897,49 +867,81 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static char *
 yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
 {
   char *yyd = yydest;
   const char *yys = yysrc;
@@ -949,10 +951,10 @@ yystpcpy (yydest, yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -960,279 +962,260 @@ yystpcpy (yydest, yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
 
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
 
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
 
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
 
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
     }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
 }
-#endif /* YYERROR_VERBOSE */
-
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, struct SASLParserContext* p_ctx)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
+  YY_USE (p_ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
+/*----------.
+| yyparse.  |
+`----------*/
 
-
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
-
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
-yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
+yyparse (struct SASLParserContext* p_ctx)
 {
+/* Lookahead token kind.  */
+int yychar;
 
 
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1240,133 +1223,140 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, p_ctx);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1381,8 +1371,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -1394,13 +1384,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1415,14 +1405,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1435,668 +1425,630 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
-#line 57 "ASLMask.y"
-    { TopExpression = (yyvsp[(1) - (1)].exprValue); (yyval.exprValue) = (yyvsp[(1) - (1)].exprValue); ;}
+  case 2: /* amber_mask: expr  */
+#line 70 "ASLMask.y"
+                        { p_ctx->TopExpression = (yyvsp[0].exprValue); (yyval.exprValue) = (yyvsp[0].exprValue); }
+#line 1432 "ASLMask.tab.c"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
-#line 63 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 3: /* expr: selection  */
+#line 76 "ASLMask.y"
+              {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
-        p_expr->Selection = (yyvsp[(1) - (1)].selValue);
+        p_expr->Selection = (yyvsp[0].selValue);
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1446 "ASLMask.tab.c"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
-#line 75 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 4: /* expr: expr AND expr  */
+#line 88 "ASLMask.y"
+                    {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND; 
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
-        p_expr->RightExpression = (yyvsp[(3) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
+        p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1462 "ASLMask.tab.c"
     break;
 
-  case 5:
-
-/* Line 1455 of yacc.c  */
-#line 86 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 5: /* expr: expr OR expr  */
+#line 99 "ASLMask.y"
+                   {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_OR;
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
-        p_expr->RightExpression = (yyvsp[(3) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
+        p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1478 "ASLMask.tab.c"
     break;
 
-  case 6:
-
-/* Line 1455 of yacc.c  */
-#line 97 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 6: /* expr: NOT expr  */
+#line 110 "ASLMask.y"
+               {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_NOT;
         p_expr->LeftExpression = NULL;
-        p_expr->RightExpression = (yyvsp[(2) - (2)].exprValue);
+        p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1494 "ASLMask.tab.c"
     break;
 
-  case 7:
-
-/* Line 1455 of yacc.c  */
-#line 111 "ASLMask.y"
-    {
-        (yyval.exprValue) = (yyvsp[(2) - (3)].exprValue);
-        ;}
+  case 7: /* expr: LBRA expr RBRA  */
+#line 124 "ASLMask.y"
+                     {
+        (yyval.exprValue) = (yyvsp[-1].exprValue);
+        }
+#line 1502 "ASLMask.tab.c"
     break;
 
-  case 8:
-
-/* Line 1455 of yacc.c  */
-#line 116 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 8: /* expr: ORIGIN ALT RNUMBER  */
+#line 129 "ASLMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_ORIGIN;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1519 "ASLMask.tab.c"
     break;
 
-  case 9:
-
-/* Line 1455 of yacc.c  */
-#line 128 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 9: /* expr: CBOX ALT RNUMBER  */
+#line 141 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_CBOX;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1536 "ASLMask.tab.c"
     break;
 
-  case 10:
-
-/* Line 1455 of yacc.c  */
-#line 140 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 10: /* expr: expr ALT RNUMBER  */
+#line 153 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1553 "ASLMask.tab.c"
     break;
 
-  case 11:
-
-/* Line 1455 of yacc.c  */
-#line 152 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 11: /* expr: LIST LBRA expr RBRA ALT RNUMBER  */
+#line 165 "ASLMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1570 "ASLMask.tab.c"
     break;
 
-  case 12:
-
-/* Line 1455 of yacc.c  */
-#line 164 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 12: /* expr: COM LBRA expr RBRA ALT RNUMBER  */
+#line 177 "ASLMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_COM;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1587 "ASLMask.tab.c"
     break;
 
-  case 13:
-
-/* Line 1455 of yacc.c  */
-#line 176 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 13: /* expr: PLANE LBRA expr RBRA ALT RNUMBER  */
+#line 189 "ASLMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_PLANE;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1604 "ASLMask.tab.c"
     break;
 
-  case 14:
-
-/* Line 1455 of yacc.c  */
-#line 189 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 14: /* expr: ORIGIN AGT RNUMBER  */
+#line 202 "ASLMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_ORIGIN;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1621 "ASLMask.tab.c"
     break;
 
-  case 15:
-
-/* Line 1455 of yacc.c  */
-#line 201 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 15: /* expr: CBOX AGT RNUMBER  */
+#line 214 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_CBOX;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1638 "ASLMask.tab.c"
     break;
 
-  case 16:
-
-/* Line 1455 of yacc.c  */
-#line 213 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 16: /* expr: expr AGT RNUMBER  */
+#line 226 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1655 "ASLMask.tab.c"
     break;
 
-  case 17:
-
-/* Line 1455 of yacc.c  */
-#line 225 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 17: /* expr: LIST LBRA expr RBRA AGT RNUMBER  */
+#line 238 "ASLMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1672 "ASLMask.tab.c"
     break;
 
-  case 18:
-
-/* Line 1455 of yacc.c  */
-#line 237 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 18: /* expr: COM LBRA expr RBRA AGT RNUMBER  */
+#line 250 "ASLMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_COM;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1689 "ASLMask.tab.c"
     break;
 
-  case 19:
-
-/* Line 1455 of yacc.c  */
-#line 249 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 19: /* expr: PLANE LBRA expr RBRA AGT RNUMBER  */
+#line 262 "ASLMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_PLANE;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1706 "ASLMask.tab.c"
     break;
 
-  case 20:
-
-/* Line 1455 of yacc.c  */
-#line 262 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 20: /* expr: ORIGIN RLT RNUMBER  */
+#line 275 "ASLMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_ORIGIN;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1723 "ASLMask.tab.c"
     break;
 
-  case 21:
-
-/* Line 1455 of yacc.c  */
-#line 274 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 21: /* expr: CBOX RLT RNUMBER  */
+#line 287 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_CBOX;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1740 "ASLMask.tab.c"
     break;
 
-  case 22:
-
-/* Line 1455 of yacc.c  */
-#line 286 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 22: /* expr: expr RLT RNUMBER  */
+#line 299 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1757 "ASLMask.tab.c"
     break;
 
-  case 23:
-
-/* Line 1455 of yacc.c  */
-#line 298 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 23: /* expr: LIST LBRA expr RBRA RLT RNUMBER  */
+#line 311 "ASLMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1774 "ASLMask.tab.c"
     break;
 
-  case 24:
-
-/* Line 1455 of yacc.c  */
-#line 310 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 24: /* expr: COM LBRA expr RBRA RLT RNUMBER  */
+#line 323 "ASLMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_COM;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1791 "ASLMask.tab.c"
     break;
 
-  case 25:
-
-/* Line 1455 of yacc.c  */
-#line 322 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 25: /* expr: PLANE LBRA expr RBRA RLT RNUMBER  */
+#line 335 "ASLMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_PLANE;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1808 "ASLMask.tab.c"
     break;
 
-  case 26:
-
-/* Line 1455 of yacc.c  */
-#line 335 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 26: /* expr: ORIGIN RGT RNUMBER  */
+#line 348 "ASLMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_ORIGIN;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1825 "ASLMask.tab.c"
     break;
 
-  case 27:
-
-/* Line 1455 of yacc.c  */
-#line 347 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 27: /* expr: CBOX RGT RNUMBER  */
+#line 360 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
         p_expr->LeftExpression = NULL;
         p_expr->Modificator = D_CBOX;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1842 "ASLMask.tab.c"
     break;
 
-  case 28:
-
-/* Line 1455 of yacc.c  */
-#line 359 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 28: /* expr: expr RGT RNUMBER  */
+#line 372 "ASLMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
-        p_expr->LeftExpression = (yyvsp[(1) - (3)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-2].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(3) - (3)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1859 "ASLMask.tab.c"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
-#line 371 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 29: /* expr: LIST LBRA expr RBRA RGT RNUMBER  */
+#line 384 "ASLMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_LIST;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1876 "ASLMask.tab.c"
     break;
 
-  case 30:
-
-/* Line 1455 of yacc.c  */
-#line 383 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 30: /* expr: COM LBRA expr RBRA RGT RNUMBER  */
+#line 396 "ASLMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_COM;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1893 "ASLMask.tab.c"
     break;
 
-  case 31:
-
-/* Line 1455 of yacc.c  */
-#line 395 "ASLMask.y"
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 31: /* expr: PLANE LBRA expr RBRA RGT RNUMBER  */
+#line 408 "ASLMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
-        p_expr->LeftExpression = (yyvsp[(3) - (6)].exprValue);
+        p_expr->LeftExpression = (yyvsp[-3].exprValue);
         p_expr->Modificator = D_PLANE;
-        p_expr->Distance = (yyvsp[(6) - (6)].rValue).Number;
+        p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1910 "ASLMask.tab.c"
     break;
 
-  case 32:
-
-/* Line 1455 of yacc.c  */
-#line 410 "ASLMask.y"
-    {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,(yyvsp[(2) - (4)].listValue));
+  case 32: /* expr: RSELECTOR sel_list ASELECTOR sel_list  */
+#line 423 "ASLMask.y"
+                                            {
+        struct SSelection* p_lsel = AllocateSelection(p_ctx,T_RSELECTOR,(yyvsp[-2].listValue));
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_ctx);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_ASELECTOR,(yyvsp[(4) - (4)].listValue));
+        struct SSelection* p_rsel = AllocateSelection(p_ctx,T_ASELECTOR,(yyvsp[0].listValue));
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_ctx);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
         p_expr->LeftExpression = p_lexpr;
         p_expr->RightExpression = p_rexpr;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1950 "ASLMask.tab.c"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
-#line 446 "ASLMask.y"
-    {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,(yyvsp[(2) - (4)].listValue));
+  case 33: /* expr: RSELECTOR sel_list TSELECTOR sel_list  */
+#line 459 "ASLMask.y"
+                                            {
+        struct SSelection* p_lsel = AllocateSelection(p_ctx,T_RSELECTOR,(yyvsp[-2].listValue));
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_ctx);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_TSELECTOR,(yyvsp[(4) - (4)].listValue));
+        struct SSelection* p_rsel = AllocateSelection(p_ctx,T_TSELECTOR,(yyvsp[0].listValue));
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_ctx);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
         p_expr->LeftExpression = p_lexpr;
         p_expr->RightExpression = p_rexpr;
         (yyval.exprValue) = p_expr;
-        ;}
+        }
+#line 1990 "ASLMask.tab.c"
     break;
 
-  case 34:
-
-/* Line 1455 of yacc.c  */
-#line 484 "ASLMask.y"
-    {
-        struct SSelection* p_selection = AllocateSelection(T_RSELECTOR,(yyvsp[(2) - (2)].listValue));
+  case 34: /* selection: RSELECTOR sel_list  */
+#line 497 "ASLMask.y"
+                       {
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_RSELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
-        ;}
+        }
+#line 2003 "ASLMask.tab.c"
     break;
 
-  case 35:
-
-/* Line 1455 of yacc.c  */
-#line 493 "ASLMask.y"
-    {
-        struct SSelection* p_selection = AllocateSelection(T_ASELECTOR,(yyvsp[(2) - (2)].listValue));
+  case 35: /* selection: ASELECTOR sel_list  */
+#line 506 "ASLMask.y"
+                         {
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_ASELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
-        ;}
+        }
+#line 2016 "ASLMask.tab.c"
     break;
 
-  case 36:
-
-/* Line 1455 of yacc.c  */
-#line 502 "ASLMask.y"
-    {
-        struct SSelection* p_selection = AllocateSelection(T_TSELECTOR,(yyvsp[(2) - (2)].listValue));
+  case 36: /* selection: TSELECTOR sel_list  */
+#line 515 "ASLMask.y"
+                        {
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_TSELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the type selection");
+            yyerror(p_ctx,"unable to allocate memory for the type selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
-        ;}
+        }
+#line 2029 "ASLMask.tab.c"
     break;
 
-  case 37:
-
-/* Line 1455 of yacc.c  */
-#line 513 "ASLMask.y"
-    {
-        (yyval.listValue) = (yyvsp[(1) - (1)].listValue)
-        ;}
+  case 37: /* sel_list: list  */
+#line 526 "ASLMask.y"
+         {
+        (yyval.listValue) = (yyvsp[0].listValue);
+        }
+#line 2037 "ASLMask.tab.c"
     break;
 
-  case 38:
-
-/* Line 1455 of yacc.c  */
-#line 516 "ASLMask.y"
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 38: /* sel_list: STAR  */
+#line 529 "ASLMask.y"
+           {
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = -1;
 
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_ctx);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_ctx,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add everything item to the list */
@@ -2104,179 +2056,180 @@ yyreduce:
         p_list->LastItem = p_item;
 
         (yyval.listValue) = p_list;
-        ;}
+        }
+#line 2061 "ASLMask.tab.c"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
-#line 538 "ASLMask.y"
-    {
+  case 39: /* list: item  */
+#line 551 "ASLMask.y"
+         {
         /* create list node */
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_ctx);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_ctx,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add item to the list */
-        p_list->FirstItem = (yyvsp[(1) - (1)].itemValue);
-        p_list->LastItem = (yyvsp[(1) - (1)].itemValue);
+        p_list->FirstItem = (yyvsp[0].itemValue);
+        p_list->LastItem = (yyvsp[0].itemValue);
         (yyval.listValue) = p_list;
-        ;}
+        }
+#line 2078 "ASLMask.tab.c"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
-#line 550 "ASLMask.y"
-    {
+  case 40: /* list: list COMMA item  */
+#line 563 "ASLMask.y"
+                      {
         /* add item to the list */
-        (yyvsp[(1) - (3)].listValue)->LastItem->NextItem = (yyvsp[(3) - (3)].itemValue);
-        (yyvsp[(1) - (3)].listValue)->LastItem = (yyvsp[(3) - (3)].itemValue);
-        (yyval.listValue) = (yyvsp[(1) - (3)].listValue);
-        ;}
+        (yyvsp[-2].listValue)->LastItem->NextItem = (yyvsp[0].itemValue);
+        (yyvsp[-2].listValue)->LastItem = (yyvsp[0].itemValue);
+        (yyval.listValue) = (yyvsp[-2].listValue);
+        }
+#line 2089 "ASLMask.tab.c"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
-#line 559 "ASLMask.y"
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 41: /* item: INUMBER  */
+#line 572 "ASLMask.y"
+            {
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
-        p_item->Index = (yyvsp[(1) - (1)].iValue).Number;
+        p_item->Index = (yyvsp[0].iValue).Number;
         p_item->Length = 1;
         (yyval.itemValue) = p_item;
-        ;}
+        }
+#line 2104 "ASLMask.tab.c"
     break;
 
-  case 42:
-
-/* Line 1455 of yacc.c  */
-#line 569 "ASLMask.y"
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 42: /* item: INUMBER RANGE INUMBER  */
+#line 582 "ASLMask.y"
+                            {
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
-        p_item->Index = (yyvsp[(1) - (3)].iValue).Number;
-        p_item->Length = (yyvsp[(3) - (3)].iValue).Number - (yyvsp[(1) - (3)].iValue).Number + 1;
+        p_item->Index = (yyvsp[-2].iValue).Number;
+        p_item->Length = (yyvsp[0].iValue).Number - (yyvsp[-2].iValue).Number + 1;
         (yyval.itemValue) = p_item;
-        ;}
+        }
+#line 2119 "ASLMask.tab.c"
     break;
 
-  case 43:
-
-/* Line 1455 of yacc.c  */
-#line 579 "ASLMask.y"
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 43: /* item: STRING  */
+#line 592 "ASLMask.y"
+             {
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
-        strncpy(p_item->Name,(yyvsp[(1) - (1)].sValue).String,4);
+        strncpy(p_item->Name,(yyvsp[0].sValue).String,4);
         (yyval.itemValue) = p_item;
-        ;}
+        }
+#line 2133 "ASLMask.tab.c"
     break;
 
 
+#line 2137 "ASLMask.tab.c"
 
-/* Line 1455 of yacc.c  */
-#line 2191 "ASLMask.tab.c"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
       {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (p_ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, p_ctx);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2288,14 +2241,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2308,39 +2260,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, p_ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2351,64 +2306,68 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (p_ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, p_ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, p_ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+  return yyresult;
 }
 
-
-
-/* Line 1675 of yacc.c  */
-#line 590 "ASLMask.y"
+#line 603 "ASLMask.y"
 
 /* ========================================================================== */
 
-int parse_asl_mask(const char* p_mask)
+int parse_asl_mask(struct SASLParserContext* p_ctx,const char* p_mask)
 {
- yy_scan_string(p_mask);
- int rvalue = yyparse();
- yylex_destroy();
+ p_ctx->Mask = p_mask;
+ p_ctx->Current = p_mask;
+ int rvalue = yyparse(p_ctx);
+ p_ctx->Mask = NULL;
+ p_ctx->Current = NULL;
  return(rvalue);
 }
 
-
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,52 +27,72 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     STRING = 258,
-     INUMBER = 259,
-     RNUMBER = 260,
-     STAR = 261,
-     COMMA = 262,
-     RANGE = 263,
-     RSELECTOR = 264,
-     ASELECTOR = 265,
-     TSELECTOR = 266,
-     RLT = 267,
-     RGT = 268,
-     ALT = 269,
-     AGT = 270,
-     NOT = 271,
-     AND = 272,
-     OR = 273,
-     RBRA = 274,
-     LBRA = 275,
-     ERROR = 276,
-     ORIGIN = 277,
-     CBOX = 278,
-     LIST = 279,
-     COM = 280,
-     PLANE = 281
-   };
+#ifndef YY_YY_ASLMASK_TAB_H_INCLUDED
+# define YY_YY_ASLMASK_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 14 "ASLMask.y"
 
+#include "ASLParser.hpp"
 
+#line 53 "ASLMask.tab.h"
 
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    STRING = 258,                  /* STRING  */
+    INUMBER = 259,                 /* INUMBER  */
+    RNUMBER = 260,                 /* RNUMBER  */
+    STAR = 261,                    /* STAR  */
+    COMMA = 262,                   /* COMMA  */
+    RANGE = 263,                   /* RANGE  */
+    RSELECTOR = 264,               /* RSELECTOR  */
+    ASELECTOR = 265,               /* ASELECTOR  */
+    TSELECTOR = 266,               /* TSELECTOR  */
+    RLT = 267,                     /* RLT  */
+    RGT = 268,                     /* RGT  */
+    ALT = 269,                     /* ALT  */
+    AGT = 270,                     /* AGT  */
+    NOT = 271,                     /* NOT  */
+    AND = 272,                     /* AND  */
+    OR = 273,                      /* OR  */
+    RBRA = 274,                    /* RBRA  */
+    LBRA = 275,                    /* LBRA  */
+    ERROR = 276,                   /* ERROR  */
+    ORIGIN = 277,                  /* ORIGIN  */
+    CBOX = 278,                    /* CBOX  */
+    LIST = 279,                    /* LIST  */
+    COM = 280,                     /* COM  */
+    PLANE = 281                    /* PLANE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 1676 of yacc.c  */
-#line 16 "ASLMask.y"
+#line 29 "ASLMask.y"
 
     SGrammar                gValue;
     SInteger                iValue;
@@ -85,15 +104,25 @@ typedef union YYSTYPE
     struct SExpression*     exprValue;
     
 
+#line 108 "ASLMask.tab.h"
 
-/* Line 1676 of yacc.c  */
-#line 91 "ASLMask.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
 
+
+int yyparse (struct SASLParserContext* p_ctx);
+
+/* "%code provides" blocks.  */
+#line 18 "ASLMask.y"
+
+/* scanner, see ASLLexer.c */
+int yylex(YYSTYPE* p_lval,struct SASLParserContext* p_ctx);
+
+#line 127 "ASLMask.tab.h"
+
+#endif /* !YY_YY_ASLMASK_TAB_H_INCLUDED  */
@@ -9,10 +9,23 @@ AMBER Mask Parser Analyzer
 #include <stdio.h>
 #include <stdio.h>
 #include <string.h>
-#include "ASLParser.hpp"
-#define YYERROR_VERBOSE
 %}
 
+%code requires {
+#include "ASLParser.hpp"
+}
+
+%code provides {
+/* scanner, see ASLLexer.c */
+int yylex(YYSTYPE* p_lval,struct SASLParserContext* p_ctx);
+}
+
+/* the parser is reentrant, its state is kept in the context */
+%define api.pure full
+%define parse.error verbose
+%parse-param {struct SASLParserContext* p_ctx}
+%lex-param {struct SASLParserContext* p_ctx}
+
 %union{
     SGrammar                gValue;
     SInteger                iValue;
@@ -54,16 +67,16 @@ AMBER Mask Parser Analyzer
 %%
 
 amber_mask:
-    expr                { TopExpression = $1; $$ = $1; }
+    expr                { p_ctx->TopExpression = $1; $$ = $1; }
     ;
 
 expr:
 /* SELECTION ---------------------------------------------------------------- */
 
     selection {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Selection = $1;
@@ -73,9 +86,9 @@ expr:
 /* LOGICAL OPERATORS -------------------------------------------------------- */
 
     | expr AND expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND; 
@@ -84,9 +97,9 @@ expr:
         $$ = p_expr;
         }
     | expr OR expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_OR;
@@ -95,9 +108,9 @@ expr:
         $$ = p_expr;
         }
     | NOT expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_NOT;
@@ -114,9 +127,9 @@ expr:
 
 /* DISTANCE OPERATORS ------------------------------------------------------- */
     | ORIGIN ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -126,9 +139,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -138,9 +151,9 @@ expr:
         $$ = p_expr;
         }
     | expr ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -150,9 +163,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -162,9 +175,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -174,9 +187,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -187,9 +200,9 @@ expr:
         }
 
     | ORIGIN AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -199,9 +212,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -211,9 +224,9 @@ expr:
         $$ = p_expr;
         }
     | expr AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -223,9 +236,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -235,9 +248,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -247,9 +260,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -260,9 +273,9 @@ expr:
         }
 
     | ORIGIN RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -272,9 +285,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -284,9 +297,9 @@ expr:
         $$ = p_expr;
         }
     | expr RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -296,9 +309,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -308,9 +321,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -320,9 +333,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -333,9 +346,9 @@ expr:
         }
 
     | ORIGIN RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -345,9 +358,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -357,9 +370,9 @@ expr:
         $$ = p_expr;
         }
     | expr RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -369,9 +382,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -381,9 +394,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -393,9 +406,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -408,33 +421,33 @@ expr:
 /* SELECTORS ---------------------------------------------------------------- */
 
     | RSELECTOR sel_list ASELECTOR sel_list {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_lsel = AllocateSelection(p_ctx,T_RSELECTOR,$2);
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_ctx);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_ASELECTOR,$4);
+        struct SSelection* p_rsel = AllocateSelection(p_ctx,T_ASELECTOR,$4);
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_ctx);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -444,33 +457,33 @@ expr:
         }
 
     | RSELECTOR sel_list TSELECTOR sel_list {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_lsel = AllocateSelection(p_ctx,T_RSELECTOR,$2);
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_ctx);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_TSELECTOR,$4);
+        struct SSelection* p_rsel = AllocateSelection(p_ctx,T_TSELECTOR,$4);
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_ctx);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_ctx);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_ctx,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -482,27 +495,27 @@ expr:
 
 selection:
     RSELECTOR sel_list {
-        struct SSelection* p_selection = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_RSELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_ctx,"unable to allocate memory for the residue selection");
             YYERROR;
             }
         $$ = p_selection;
         }
 
     | ASELECTOR sel_list {
-        struct SSelection* p_selection = AllocateSelection(T_ASELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_ASELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_ctx,"unable to allocate memory for the atom selection");
             YYERROR;
             }
         $$ = p_selection;
         }
 
     | TSELECTOR sel_list{
-        struct SSelection* p_selection = AllocateSelection(T_TSELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_ctx,T_TSELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the type selection");
+            yyerror(p_ctx,"unable to allocate memory for the type selection");
             YYERROR;
             }
         $$ = p_selection;
@@ -511,19 +524,19 @@ selection:
 
 sel_list:
     list {
-        $$ = $1
+        $$ = $1;
         }
     | STAR {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = -1;
 
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_ctx);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_ctx,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add everything item to the list */
@@ -537,9 +550,9 @@ sel_list:
 list:
     item {
         /* create list node */
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_ctx);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_ctx,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add item to the list */
@@ -557,9 +570,9 @@ list:
 
 item:
     INUMBER {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = $1.Number;
@@ -567,9 +580,9 @@ item:
         $$ = p_item;
         }
     | INUMBER RANGE INUMBER {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = $1.Number;
@@ -577,9 +590,9 @@ item:
         $$ = p_item;
         }
     | STRING {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_ctx);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_ctx,"unable to allocate memory for the item");
             YYERROR;
             }
         strncpy(p_item->Name,$1.String,4);
@@ -590,11 +603,13 @@ item:
 %%
 /* ========================================================================== */
 
-int parse_asl_mask(const char* p_mask)
+int parse_asl_mask(struct SASLParserContext* p_ctx,const char* p_mask)
 {
- yy_scan_string(p_mask);
- int rvalue = yyparse();
- yylex_destroy();
+ p_ctx->Mask = p_mask;
+ p_ctx->Current = p_mask;
+ int rvalue = yyparse(p_ctx);
+ p_ctx->Mask = NULL;
+ p_ctx->Current = NULL;
  return(rvalue);
 }
 
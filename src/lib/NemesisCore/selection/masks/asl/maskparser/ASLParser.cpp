@@ -29,17 +29,10 @@
 
 using namespace std;
 
-//------------------------------------------------------------------------------
-
-int                 LexPosition     = 0;
-struct SExpression* TopExpression   = NULL;
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 // track info about allocation
-// this class (instead of individual global objects) is used to prevent
-// double free corruption problem caused by
-// __cxa_finalize and C exit
+// each parser context owns one stack, thus masks can be parsed concurrently
 
 class CASLMaskStack{
 public:
@@ -53,8 +46,6 @@ public:
     vector<SExpression*>    ExpressionAllocations;
 };
 
-CASLMaskStack ASLMaskStack;
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 CASLMaskStack::~CASLMaskStack(void)
@@ -109,28 +100,31 @@ bool print_asl_list(FILE* p_fout,struct SList* p_list);
 //------------------------------------------------------------------------------
 //==============================================================================
 
-int init_asl_mask(void)
+int init_asl_mask(struct SASLParserContext* p_ctx)
 {
-    free_asl_mask_tree();
-    LexPosition = 1;
-    TopExpression = NULL;
+    p_ctx->Mask = NULL;
+    p_ctx->Current = NULL;
+    p_ctx->LexPosition = 1;
+    p_ctx->TopExpression = NULL;
+    p_ctx->Allocations = new CASLMaskStack;
     return(0);
 }
 
 //------------------------------------------------------------------------------
 
-struct SExpression* get_asl_expression_tree(void) {
-    return(TopExpression);
+struct SExpression* get_asl_expression_tree(struct SASLParserContext* p_ctx) {
+    return(p_ctx->TopExpression);
 }
 
 //------------------------------------------------------------------------------
 
-int free_asl_mask_tree(void)
+int free_asl_mask_tree(struct SASLParserContext* p_ctx)
 {
-    ASLMaskStack.Clear();
+    delete static_cast<CASLMaskStack*>(p_ctx->Allocations);
+    p_ctx->Allocations = NULL;
 
-    LexPosition = 0;
-    TopExpression = NULL;
+    p_ctx->LexPosition = 0;
+    p_ctx->TopExpression = NULL;
 
     return(0);
 }
@@ -259,7 +253,7 @@ bool print_asl_list(FILE* p_fout,struct SList* p_list)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-int yyerror(const char* p_error)
+int yyerror(struct SASLParserContext* p_ctx,const char* p_error)
 {
     ES_ERROR(p_error);
     return(0);
@@ -279,7 +273,7 @@ int pperror(const char* p_error,int position)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-struct SListItem* AllocateListItem(void) {
+struct SListItem* AllocateListItem(struct SASLParserContext* p_ctx) {
     struct SListItem* p_item = new struct SListItem;
 
     p_item->Index = 0;
@@ -287,37 +281,37 @@ struct SListItem* AllocateListItem(void) {
     memset(p_item->Name,0,4);
     p_item->NextItem = NULL;
 
-    ASLMaskStack.ListItemAllocations.push_back(p_item);
+    static_cast<CASLMaskStack*>(p_ctx->Allocations)->ListItemAllocations.push_back(p_item);
     return(p_item);
 }
 
 //------------------------------------------------------------------------------
 
-struct SList* AllocateList(void) {
+struct SList* AllocateList(struct SASLParserContext* p_ctx) {
     struct SList* p_list = new struct SList;
 
     p_list->FirstItem = NULL;
     p_list->LastItem = NULL;
 
-    ASLMaskStack.ListAllocations.push_back(p_list);
+    static_cast<CASLMaskStack*>(p_ctx->Allocations)->ListAllocations.push_back(p_list);
     return(p_list);
 }
 
 //------------------------------------------------------------------------------
 
-struct SSelection* AllocateSelection(enum SType type,struct SList* p_list) {
+struct SSelection* AllocateSelection(struct SASLParserContext* p_ctx,enum SType type,struct SList* p_list) {
     struct SSelection* p_sel = new struct SSelection;
 
     p_sel->Type = type;
     p_sel->Items = p_list;
 
-    ASLMaskStack.SelectionAllocations.push_back(p_sel);
+    static_cast<CASLMaskStack*>(p_ctx->Allocations)->SelectionAllocations.push_back(p_sel);
     return(p_sel);
 }
 
 //------------------------------------------------------------------------------
 
-struct SExpression* AllocateExpression(void) {
+struct SExpression* AllocateExpression(struct SASLParserContext* p_ctx) {
     struct SExpression* p_expr = new struct SExpression;
 
     p_expr->Operator = O_NONE;
@@ -326,7 +320,7 @@ struct SExpression* AllocateExpression(void) {
     p_expr->LeftExpression = NULL;
     p_expr->RightExpression = NULL;
 
-    ASLMaskStack.ExpressionAllocations.push_back(p_expr);
+    static_cast<CASLMaskStack*>(p_ctx->Allocations)->ExpressionAllocations.push_back(p_expr);
     return(p_expr);
 }
 
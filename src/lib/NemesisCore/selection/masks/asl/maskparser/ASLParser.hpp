@@ -100,41 +100,47 @@ struct SExpression {
     struct SExpression*     RightExpression;
 };
 
-/* global variables --------------------------------------------------------- */
-extern int                 LexPosition;        /* position in a mask during lexical analysis */
-extern struct SExpression* TopExpression;      /* top expression to be evaluated */
+/* parser context ----------------------------------------------------------- */
+
+struct SASLParserContext {
+    const char*         Mask;               /* parsed mask */
+    const char*         Current;            /* current position of the scanner */
+    int                 LexPosition;        /* position in a mask during lexical analysis */
+    struct SExpression* TopExpression;      /* top expression to be evaluated */
+    void*               Allocations;        /* nodes of the expression tree */
+};
 
 /* global functions --------------------------------------------------------- */
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-    /* init mask parser for new job */
-    extern int init_asl_mask(void);
+    /* init mask parser context for new job */
+    extern int init_asl_mask(struct SASLParserContext* p_ctx);
 
     /* parse mask */
-    extern int parse_asl_mask(const char* p_mask);
+    extern int parse_asl_mask(struct SASLParserContext* p_ctx,const char* p_mask);
 
     /* free data associated with parsed mask */
-    extern int free_asl_mask_tree(void);
+    extern int free_asl_mask_tree(struct SASLParserContext* p_ctx);
 
     /* get top node of mask expression */
-    extern struct SExpression* get_asl_expression_tree(void);
+    extern struct SExpression* get_asl_expression_tree(struct SASLParserContext* p_ctx);
 
     /* print mask expression */
     extern int print_asl_expression_tree(struct SExpression* p_expr);
 
     /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
-    extern int yyerror(const char* p_error);
+    extern int yyerror(struct SASLParserContext* p_ctx,const char* p_error);
     extern int pperror(const char* p_error,int position);
 
 
     /* helper functions */
-    extern struct SListItem*   AllocateListItem(void);
-    extern struct SList*       AllocateList(void);
-    extern struct SSelection*  AllocateSelection(enum SType type,struct SList* p_list);
-    extern struct SExpression* AllocateExpression(void);
+    extern struct SListItem*   AllocateListItem(struct SASLParserContext* p_ctx);
+    extern struct SList*       AllocateList(struct SASLParserContext* p_ctx);
+    extern struct SSelection*  AllocateSelection(struct SASLParserContext* p_ctx,enum SType type,struct SList* p_list);
+    extern struct SExpression* AllocateExpression(struct SASLParserContext* p_ctx);
 
     /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
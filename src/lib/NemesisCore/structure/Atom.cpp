@@ -29,6 +29,7 @@
 #include <ErrorSystem.hpp>
 #include <AtomHistory.hpp>
 #include <Structure.hpp>
+#include <StructureList.hpp>
 #include <BondList.hpp>
 #include <AtomBondsModel.hpp>
 #include <Residue.hpp>
@@ -584,6 +585,17 @@ void CAtom::SetDescription(const QString& descrip,CHistoryNode* p_history)
 
 //------------------------------------------------------------------------------
 
+void CAtom::SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history)
+{
+    if( GetFlags() == flags ) return;
+    CProObject::SetFlags(flags,p_history);
+    if( GetStructure() && GetStructure()->GetStructures() ){
+        GetStructure()->GetStructures()->EmitOnObjectFlagsChanged();
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void CAtom::SetSerIndex(int ser_idx,CHistoryNode* p_history)
 {
     if( SerIndex == ser_idx ) return;
@@ -697,7 +709,12 @@ void CAtom::SetPos(const CPoint& pos,CHistoryNode* p_history)
     }
 
     Pos = pos;
+    GetStructure()->InvalidateSpatialIndex();
     if( GetStructure()->GeometryUpdateLevel == 0 ){
+        // inside geometry updates the whole structure is recorded by EndGeometryUpdate
+        if( GetStructure()->GetStructures() ){
+            GetStructure()->GetStructures()->AddGeometryChange(this);
+        }
         emit OnStatusChanged(ESC_OTHER);
         GetAtoms()->EmitOnAtomListChanged();
         if( GetResidue() ){
@@ -722,6 +739,10 @@ void CAtom::SetVel(const CPoint& vel,CHistoryNode* p_history)
 
     Vel = vel;
     if( GetStructure()->GeometryUpdateLevel == 0 ){
+        // inside geometry updates the whole structure is recorded by EndGeometryUpdate
+        if( GetStructure()->GetStructures() ){
+            GetStructure()->GetStructures()->AddGeometryChange(this);
+        }
         emit OnStatusChanged(ESC_OTHER);
         GetAtoms()->EmitOnAtomListChanged();
         if( GetResidue() ){
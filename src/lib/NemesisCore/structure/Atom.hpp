@@ -198,6 +198,9 @@ public:
     /// set description
     virtual void SetDescription(const QString& descrip,CHistoryNode* p_history=NULL);
 
+    /// set flags
+    virtual void SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history=NULL);
+
     ///  set serial index
     void SetSerIndex(int atom_number,CHistoryNode* p_history=NULL);
 
@@ -281,6 +284,8 @@ private:
 
     friend class CResidue;
     friend class CAtomList;
+    friend class CStructureBulkData;
+    friend class CSuperCellBuilder;
 };
 
 // -----------------------------------------------------------------------------
@@ -38,6 +38,8 @@ CAtomData::CAtomData(void)
     LocIndex = -1;
     Z = 0;
     Charge = 0;
+    Flags = 0;
+    Residue = -1;
 }
 
 //------------------------------------------------------------------------------
@@ -111,6 +113,42 @@ void CAtomData::Save(CXMLElement* p_ele)
     }
 }
 
+//------------------------------------------------------------------------------
+
+void CAtomData::LoadAtom(CXMLElement* p_ele)
+{
+    // check input data -----------------------------
+    if( p_ele == NULL ) {
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    if( p_ele->GetName() != "atom" ) {
+        LOGIC_ERROR("element is not atom");
+    }
+
+    // see CProObject::LoadData and CAtom::LoadData
+    p_ele->GetAttribute("id",Index);
+    p_ele->GetAttribute("name",Name);
+    p_ele->GetAttribute("descr",Description);
+    p_ele->GetAttribute("flags",Flags);
+
+    p_ele->GetAttribute("ai",SerIndex);
+    p_ele->GetAttribute("li",LocIndex);
+    p_ele->GetAttribute("rid",Residue);
+
+    p_ele->GetAttribute("at",Type);
+    p_ele->GetAttribute("z",Z);
+    p_ele->GetAttribute("charge",Charge);
+
+    p_ele->GetAttribute("px",Pos.x);
+    p_ele->GetAttribute("py",Pos.y);
+    p_ele->GetAttribute("pz",Pos.z);
+
+    p_ele->GetAttribute("vx",Vel.x);
+    p_ele->GetAttribute("vy",Vel.y);
+    p_ele->GetAttribute("vz",Vel.z);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -45,6 +45,11 @@ public:
     void Load(CXMLElement* p_ele);
     void Save(CXMLElement* p_ele);
 
+    /// read data of the atom element saved by CAtom::SaveData
+    /*! residue and atom indexes are not shifted by the base object index
+    */
+    void LoadAtom(CXMLElement* p_ele);
+
 // section of public data ----------------------------------------------------
 public:
     int             Index;
@@ -57,6 +62,8 @@ public:
     QString         Type;
     CPoint          Pos;
     CPoint          Vel;
+    int             Flags;              // user flags (EPOF_SAVE_MASK)
+    int             Residue;            // residue index or -1, the same base as Index
 };
 
 //------------------------------------------------------------------------------
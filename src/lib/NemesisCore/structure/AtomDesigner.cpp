@@ -286,6 +286,9 @@ void CAtomDesigner::InitValues(void)
 
 void CAtomDesigner::GeometryChanged(void)
 {
+    CStructureList* p_sl = Object->GetProject()->GetStructures();
+    if( p_sl->GetGeometryChanges().IsChanged(Object) == false ) return;
+
     // set position values
     WidgetUI.xSB->setInternalValue(Object->GetPos().x);
     WidgetUI.ySB->setInternalValue(Object->GetPos().y);
@@ -66,6 +66,13 @@ CAtomHI::CAtomHI(CAtom* p_atom,EHistoryItemDirection change)
 
 //------------------------------------------------------------------------------
 
+qint64 CAtomHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + HISTORY_XML_ELEMENT_SIZE);
+}
+
+//------------------------------------------------------------------------------
+
 void CAtomHI::Forward(void)
 {
     CStructure* p_str = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
@@ -46,6 +46,10 @@ public:
     CAtomHI(CProject* p_object);
     CAtomHI(CAtom* p_atom,EHistoryItemDirection change);
 
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
 // section of private data -----------------------------------------------------
 private:
     int             MoleculeIndex;
@@ -153,16 +153,15 @@ bool CAtomList::RemoveHydrogensWH(void)
     CHistoryNode* p_history = BeginChangeWH(EHCL_TOPOLOGY,tr("delete all hydrogens"));
     if( p_history == NULL ) return (false);
 
-    BeginUpdate();
-
+    QVector<CAtom*> atoms;
     foreach(QObject* p_qobj,children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsVirtual() == true ) {
-            p_atom->RemoveFromBaseList(p_history);
+            atoms.append(p_atom);
         }
     }
 
-    EndUpdate();
+    GetStructure()->RemoveAtoms(atoms,QVector<CBond*>(),p_history);
 
     EndChangeWH();
     return(true);
@@ -175,17 +174,16 @@ bool CAtomList::RemoveSelectedAtomsWH(void)
     CHistoryNode* p_history = BeginChangeWH(EHCL_TOPOLOGY,tr("update serial indexes"));
     if( p_history == NULL ) return (false);
 
-    BeginUpdate();
-
+    QVector<CAtom*> atoms;
     foreach(QObject* p_qobj,children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ||
             (p_atom->GetResidue() && p_atom->GetResidue()->IsFlagSet(EPOF_SELECTED)) ){
-            p_atom->RemoveFromBaseList(p_history);
+            atoms.append(p_atom);
         }
     }
 
-    EndUpdate();
+    GetStructure()->RemoveAtoms(atoms,QVector<CBond*>(),p_history);
     EndChangeWH();
     return(true);
 }
@@ -908,6 +906,127 @@ CAtom* CAtomList::CreateAtom(const CAtomData& atom_data,CHistoryNode* p_history)
     return(p_at);
 }
 
+//------------------------------------------------------------------------------
+
+void CAtomList::CreateAtoms(const QVector<CAtomData>& atoms,QVector<CAtom*>& new_atoms)
+{
+    new_atoms.resize(atoms.count());
+
+    int base_index = 0;
+    if( GetProject() != NULL ){
+        base_index = GetProject()->GetBaseObjectIndex();
+    }
+
+    // it is O(N) thus it is evaluated only once
+    int top_ser_index = GetTopSerIndex();
+
+    for(int i=0; i < atoms.count(); i++){
+        const CAtomData& atom_data = atoms.at(i);
+
+        CAtom* p_at;
+        if( atom_data.Index > 0 ){
+            // we need explicit object index
+            p_at = new CAtom(this,true);
+            p_at->SetIndex(atom_data.Index + base_index);
+        } else {
+            p_at = new CAtom(this);
+        }
+
+        // members are set directly, setters would emit signals for each atom
+        if( atom_data.SerIndex == -1 ){
+            top_ser_index++;
+            p_at->SerIndex = top_ser_index;
+        } else {
+            p_at->SerIndex = atom_data.SerIndex;
+            if( p_at->SerIndex > top_ser_index ) top_ser_index = p_at->SerIndex;
+        }
+        p_at->LocIndex = atom_data.LocIndex;
+        p_at->AtomType = atom_data.Type;
+        p_at->Z = atom_data.Z;
+        p_at->Charge = atom_data.Charge;
+        p_at->Pos = atom_data.Pos;
+        p_at->Vel = atom_data.Vel;
+
+        if( atom_data.Name.isEmpty() ){
+            QString name = "%1%2";
+            name = name.arg(PeriodicTable.GetSymbol(p_at->Z));
+            name = name.arg(p_at->GetIndex());
+            p_at->SetName(name);
+        } else {
+            p_at->SetName(atom_data.Name);
+        }
+        if( ! atom_data.Description.isEmpty() ){
+            p_at->SetDescription(atom_data.Description);
+        }
+
+        // see CProObject::LoadData
+        CProObjectFlags mask = CProObjectFlags(QFlag(EPOF_SAVE_MASK));
+        p_at->Flags = (p_at->Flags & (~mask)) | (CProObjectFlags(QFlag(atom_data.Flags)) & mask);
+
+        if( atom_data.Residue > 0 ){
+            CResidue* p_res = NULL;
+            if( GetProject() != NULL ){
+                p_res = dynamic_cast<CResidue*>(GetProject()->FindObject(atom_data.Residue + base_index));
+            }
+            if( p_res ) p_res->AddAtom(p_at);
+        }
+
+        new_atoms[i] = p_at;
+    }
+
+    ListSizeChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomList::RemoveAtoms(const QVector<CAtom*>& atoms)
+{
+    QSet<QObject*>  removed;
+    QSet<CResidue*> residues;
+
+    // see CAtom::RemoveFromBaseList
+    foreach(CAtom* p_atom,atoms){
+        if( (p_atom == NULL) || (p_atom->GetAtoms() != this) ) continue;
+        if( removed.contains(p_atom) ) continue;
+        removed.insert(p_atom);
+
+        // residues are updated at once
+        if( p_atom->Residue ) residues.insert(p_atom->Residue);
+
+        CProObject* p_obj;
+        while( (p_obj = p_atom->RemoveBondFromBegin()) != NULL ) {
+            p_obj->RemoveFromRegistered(p_atom,NULL);
+        }
+        while( (p_obj = p_atom->RemoveFirstFromROList()) != NULL ) {
+            p_obj->RemoveFromRegistered(p_atom,NULL);
+        }
+    }
+
+    if( removed.isEmpty() ) return;
+
+    // the order of remaining atoms is kept, thus residues need not be sorted
+    foreach(CResidue* p_res,residues){
+        QList<CAtom*> res_atoms;
+        foreach(CAtom* p_atom,p_res->Atoms){
+            if( removed.contains(p_atom) ){
+                p_atom->Residue = NULL;
+            } else {
+                res_atoms.append(p_atom);
+            }
+        }
+        p_res->Atoms = res_atoms;
+        p_res->EmitOnAtomListChanged();
+    }
+
+    // detached atoms do not notify the list when destroyed
+    RemoveChildren(removed);
+    foreach(QObject* p_obj,removed){
+        delete p_obj;
+    }
+
+    ListSizeChanged();
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -1346,6 +1465,7 @@ void CAtomList::EmitOnAtomListChanged(void)
 
 void CAtomList::ListSizeChanged(bool do_not_sort)
 {
+    if( GetStructure() ) GetStructure()->InvalidateSpatialIndex();
     Changed = true;
     ForceSorting = ! do_not_sort;
     if( UpdateLevel > 0 ){
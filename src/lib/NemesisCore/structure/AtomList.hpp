@@ -29,6 +29,7 @@
 #include <AtomData.hpp>
 #include <IndexCounter.hpp>
 #include <Transformation.hpp>
+#include <QVector>
 
 // ----------------------------------------------------------------------------
 
@@ -142,6 +143,17 @@ public:
     /// create new atom
     CAtom* CreateAtom(const CAtomData& atom_data,CHistoryNode* p_history=NULL);
 
+    /// create atoms in one pass without history recording
+    /*! setup is the same as in CreateAtom(const CAtomData&), see CStructure::CreateAtomsAndBonds
+    */
+    void CreateAtoms(const QVector<CAtomData>& atoms,QVector<CAtom*>& new_atoms);
+
+    /// remove atoms in one pass without history recording
+    /*! atoms should not have any bonds, see CStructure::RemoveAtoms,
+        atoms not owned by the list are skipped
+    */
+    void RemoveAtoms(const QVector<CAtom*>& atoms);
+
     /// freeze all atoms
     void FreezeAllAtoms(CHistoryNode* p_history=NULL);
 
@@ -27,10 +27,17 @@
 #include <Structure.hpp>
 #include <XMLElement.hpp>
 #include <AtomList.hpp>
+#include <BondList.hpp>
 #include <ProObjectHistory.hpp>
 #include <Structure.hpp>
 #include <Atom.hpp>
+#include <Bond.hpp>
+#include <Residue.hpp>
+#include <StructureBulkData.hpp>
 #include <NemesisCoreModule.hpp>
+#include <ErrorSystem.hpp>
+#include <HistoryList.hpp>
+#include <cstring>
 
 //------------------------------------------------------------------------------
 
@@ -38,8 +45,14 @@ REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListTransHI,
                         "{ATOM_L_TRA:cd68649d-bad5-4821-a061-e9a891a4dfd3}")
 REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListCoordinatesHI,
                         "{ATOM_L_CRD:d41e853d-e363-4183-a0c3-34e68f15badc}")
+REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListDeltaHI,
+                        "{ATOM_L_DLT:3e7b9c14-58d2-4a6f-b1e0-92c4f6a8d375}")
 REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListChangeParentHI,
                         "{ATOM_L_CHP:b0313f21-b004-430d-8161-3a660006f0df}")
+REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListBatchHI,
+                        "{ATOM_L_BAT:5d0c2a7e-93b4-4f1d-8e62-c4a1f07b3d95}")
+REGISTER_HISTORY_OBJECT(NemesisCorePlugin,AtomListRemoveBatchHI,
+                        "{ATOM_L_RBT:8a4f1e2c-6d37-4b90-a5c8-1f9e3d7b2046}")
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -70,6 +83,13 @@ CAtomListTransHI::CAtomListTransHI(CStructure* p_mol,const CTransformation& tran
 
 //------------------------------------------------------------------------------
 
+qint64 CAtomListTransHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + (qint64)Indexes.GetLength()*sizeof(int));
+}
+
+//------------------------------------------------------------------------------
+
 void CAtomListTransHI::Forward(void)
 {
     CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
@@ -216,6 +236,13 @@ CAtomListCoordinatesHI::CAtomListCoordinatesHI(CStructure* p_mol,bool selected)
 
 //------------------------------------------------------------------------------
 
+qint64 CAtomListCoordinatesHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + (qint64)Coordinates.GetLength()*(sizeof(CPoint)+sizeof(int)));
+}
+
+//------------------------------------------------------------------------------
+
 void CAtomListCoordinatesHI::Forward(void)
 {
     CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
@@ -287,6 +314,257 @@ void CAtomListCoordinatesHI::SaveData(CXMLElement* p_ele)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+// maximum deviation of atom from the rigid transformation
+#define DELTA_RIGID_TOLERANCE   1.0e-6
+
+//------------------------------------------------------------------------------
+
+CAtomListDeltaHI::CAtomListDeltaHI(CStructure* p_mol,bool selected,bool mergeable)
+    : CHistoryItem(&AtomListDeltaHIObject,p_mol->GetProject(),EHID_FORWARD)
+{
+    MoleculeIndex = p_mol->GetIndex();
+    Mergeable = mergeable;
+    Rigid = false;
+
+    int num_of_atoms = 0;
+    foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        if( (selected == false) || p_atom->IsFlagSet(EPOF_SELECTED) ) num_of_atoms++;
+    }
+
+    Coordinates.CreateVector(num_of_atoms);
+    Indexes.CreateVector(num_of_atoms);
+
+    int i=0;
+    foreach(QObject* p_qobj,p_mol->GetAtoms()->children()) {
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        if( (selected == false) || p_atom->IsFlagSet(EPOF_SELECTED) ){
+            Coordinates[i] = p_atom->GetPos();
+            Indexes[i] = p_atom->GetIndex();
+            i++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::Compact(const CTransformation* p_trans)
+{
+    if( Rigid ) return;
+
+    // find moved atoms
+    QVector<int>    indexes;
+    QVector<CPoint> old_pos;
+    QVector<CPoint> new_pos;
+
+    for(int i=0; i < Indexes.GetLength(); i++) {
+        CAtom* p_atom = dynamic_cast<CAtom*>(GetProject()->FindObject(Indexes[i]));
+        if( p_atom == NULL ) continue;
+        CPoint pos = p_atom->GetPos();
+        if( (pos.x == Coordinates[i].x) && (pos.y == Coordinates[i].y)
+            && (pos.z == Coordinates[i].z) ) continue;
+        indexes.append(Indexes[i]);
+        old_pos.append(Coordinates[i]);
+        new_pos.append(pos);
+    }
+
+    // were atoms moved rigidly?
+    bool rigid = (p_trans != NULL) && (indexes.count() > 0);
+    for(int i=0; rigid && (i < indexes.count()); i++){
+        rigid = Size(p_trans->GetTransform(old_pos[i]) - new_pos[i]) <= DELTA_RIGID_TOLERANCE;
+    }
+
+    Indexes.CreateVector(indexes.count());
+    for(int i=0; i < indexes.count(); i++){
+        Indexes[i] = indexes[i];
+    }
+
+    if( rigid ){
+        Rigid = true;
+        Trans = *p_trans;
+        Coordinates.FreeVector();
+    } else {
+        Coordinates.CreateVector(old_pos.count());
+        for(int i=0; i < old_pos.count(); i++){
+            Coordinates[i] = old_pos[i];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::CompactLastChange(CStructure* p_mol,const CTransformation* p_trans)
+{
+    if( (p_mol == NULL) || (p_mol->GetProject() == NULL) ) return;
+
+    CHistoryList* p_list = p_mol->GetProject()->GetHistory();
+    CHistoryNode* p_node = p_list->GetLastChange();
+    if( p_node == NULL ) return;
+
+    foreach(QObject* p_qobj,p_node->children()) {
+        CAtomListDeltaHI* p_item = dynamic_cast<CAtomListDeltaHI*>(p_qobj);
+        if( (p_item == NULL) || (p_item->MoleculeIndex != p_mol->GetIndex()) ) continue;
+        p_item->Compact(p_trans);
+    }
+    p_node->ItemsChanged();
+
+    p_list->MergeLastChange();
+}
+
+//------------------------------------------------------------------------------
+
+bool CAtomListDeltaHI::MergeWith(CHistoryItem* p_item)
+{
+    CAtomListDeltaHI* p_next = dynamic_cast<CAtomListDeltaHI*>(p_item);
+    if( p_next == NULL ) return(false);
+    if( (Mergeable == false) || (p_next->Mergeable == false) ) return(false);
+    if( MoleculeIndex != p_next->MoleculeIndex ) return(false);
+
+    // nothing was changed by the next item
+    if( p_next->Indexes.GetLength() == 0 ) return(true);
+
+    if( Rigid != p_next->Rigid ) return(false);
+    if( Indexes.GetLength() != p_next->Indexes.GetLength() ) return(false);
+    for(int i=0; i < Indexes.GetLength(); i++){
+        if( Indexes[i] != p_next->Indexes[i] ) return(false);
+    }
+
+    // stored coordinates of this item are still the original ones
+    if( Rigid ){
+        Trans *= p_next->Trans;
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CAtomListDeltaHI::GetMemoryUsage(void)
+{
+    qint64 size = HISTORY_ITEM_SIZE + (qint64)Indexes.GetLength()*sizeof(int)
+                + (qint64)Coordinates.GetLength()*sizeof(CPoint);
+    if( Rigid ) size += sizeof(CTransformation);
+    return(size);
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::Forward(void)
+{
+    if( Rigid ){
+        Transform(Trans);
+    } else {
+        SwapCoordinates();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::Backward(void)
+{
+    if( Rigid ){
+        CTransformation trans = Trans;
+        trans.Invert();
+        Transform(trans);
+    } else {
+        SwapCoordinates();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::SwapCoordinates(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    for(int i=0; i < Coordinates.GetLength(); i++) {
+        CAtom* p_atom = dynamic_cast<CAtom*>(GetProject()->FindObject(Indexes[i]));
+        if( p_atom == NULL ) continue;
+        CPoint pos = p_atom->GetPos();
+        p_atom->SetPos(Coordinates[i]);
+        Coordinates[i] = pos;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::Transform(const CTransformation& trans)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    for(int i=0; i < Indexes.GetLength(); i++) {
+        CAtom* p_atom = dynamic_cast<CAtom*>(GetProject()->FindObject(Indexes[i]));
+        if( p_atom == NULL ) continue;
+        p_atom->SetPos(trans.GetTransform(p_atom->GetPos()));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::LoadData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // load core data ----------------------------
+    CHistoryItem::LoadData(p_ele);
+
+    // load local data ---------------------------
+    p_ele->GetAttribute("mi",MoleculeIndex);
+    p_ele->GetAttribute("mg",Mergeable);
+    p_ele->GetAttribute("rg",Rigid);
+
+    CXMLElement* p_sele = p_ele->GetFirstChildElement("tr");
+    if( p_sele ) Trans.Load(p_sele);
+
+    CXMLBinData* p_bele;
+    p_bele = p_ele->GetFirstChildBinData("ai");
+    if( p_bele ){
+        Indexes.Load(p_bele);
+    }
+    p_bele = p_ele->GetFirstChildBinData("po");
+    if( p_bele ){
+        Coordinates.Load(p_bele);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListDeltaHI::SaveData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // save core data ----------------------------
+    CHistoryItem::SaveData(p_ele);
+
+    // save local data ---------------------------
+    p_ele->SetAttribute("mi",MoleculeIndex);
+    p_ele->SetAttribute("mg",Mergeable);
+    p_ele->SetAttribute("rg",Rigid);
+
+    if( Rigid ){
+        CXMLElement* p_sele = p_ele->CreateChildElement("tr");
+        Trans.Save(p_sele);
+    }
+
+    CXMLBinData* p_bele;
+    p_bele = p_ele->CreateChildBinData("ai");
+    Indexes.Save(p_bele);
+    if( Rigid == false ){
+        p_bele = p_ele->CreateChildBinData("po");
+        Coordinates.Save(p_bele);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 CAtomListChangeParentHI::CAtomListChangeParentHI(CStructure* p_master,
                                                 CStructure* p_source,
                                                 const QVector<int>& indexes,
@@ -401,3 +679,533 @@ void CAtomListChangeParentHI::SaveData(CXMLElement* p_ele)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+CAtomListBatchHI::CAtomListBatchHI(CStructure* p_mol,
+                                   const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds,
+                                   const QVector<CAtom*>& new_atoms,const QVector<CBond*>& new_bonds)
+    : CHistoryItem(&AtomListBatchHIObject,p_mol->GetProject(),EHID_FORWARD)
+{
+    MoleculeIndex = p_mol->GetIndex();
+
+    // keep setup of created objects, so the redo creates identical objects
+    Atoms = atoms;
+    for(int i=0; i < Atoms.count(); i++){
+        CAtom* p_atom = new_atoms.at(i);
+        Atoms[i].Index = p_atom->GetIndex();
+        Atoms[i].Name = p_atom->GetName();
+        Atoms[i].SerIndex = p_atom->GetSerIndex();
+        Atoms[i].Flags = p_atom->GetFlags() & EPOF_SAVE_MASK;
+        Atoms[i].Residue = p_atom->GetResidue() ? p_atom->GetResidue()->GetIndex() : -1;
+    }
+
+    Bonds = bonds;
+    for(int i=0; i < Bonds.count(); i++){
+        Bonds[i].Index = new_bonds.at(i)->GetIndex();
+        Bonds[i].Flags = new_bonds.at(i)->GetFlags() & EPOF_SAVE_MASK;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CAtomListBatchHI::GetMemoryUsage(void)
+{
+    // strings of atoms are not counted
+    return(HISTORY_ITEM_SIZE + (qint64)Atoms.size()*sizeof(CAtomData)
+           + (qint64)Bonds.size()*sizeof(CBondData));
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListBatchHI::Forward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    QVector<CAtom*> new_atoms;
+    p_mol->CreateAtomsAndBonds(Atoms,Bonds,new_atoms);
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListBatchHI::Backward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    QVector<CBond*> bonds;
+    bonds.reserve(Bonds.count());
+    for(int i=0; i < Bonds.count(); i++) {
+        CBond* p_bond = dynamic_cast<CBond*>(GetProject()->FindObject(Bonds[i].Index));
+        if( p_bond == NULL ) continue;
+        bonds.append(p_bond);
+    }
+
+    QVector<CAtom*> atoms;
+    atoms.reserve(Atoms.count());
+    for(int i=0; i < Atoms.count(); i++) {
+        CAtom* p_atom = dynamic_cast<CAtom*>(GetProject()->FindObject(Atoms[i].Index));
+        if( p_atom == NULL ) continue;
+        atoms.append(p_atom);
+    }
+
+    p_mol->BeginUpdate();
+    p_mol->GetBonds()->RemoveBonds(bonds);
+    p_mol->GetAtoms()->RemoveAtoms(atoms);
+    p_mol->EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListBatchHI::LoadData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // load core data ----------------------------
+    CHistoryItem::LoadData(p_ele);
+
+    // load local data ---------------------------
+    p_ele->GetAttribute("mi",MoleculeIndex);
+
+    Atoms.clear();
+    Bonds.clear();
+    Strings.clear();
+    StringMap.clear();
+
+    CXMLElement* p_sele = p_ele->GetFirstChildElement("strings");
+    if( p_sele ){
+        CXMLElement* p_tele = p_sele->GetFirstChildElement("s");
+        while( p_tele != NULL ){
+            QString text;
+            p_tele->GetAttribute("t",text);
+            Strings.append(text);
+            p_tele = p_tele->GetNextSiblingElement("s");
+        }
+    }
+
+    CSimpleVector<int>      indexes;
+    CSimpleVector<int>      names;
+    CSimpleVector<int>      descrs;
+    CSimpleVector<int>      ser_indexes;
+    CSimpleVector<int>      loc_indexes;
+    CSimpleVector<int>      z;
+    CSimpleVector<double>   charges;
+    CSimpleVector<int>      types;
+    CSimpleVector<CPoint>   positions;
+    CSimpleVector<CPoint>   velocities;
+    CSimpleVector<int>      flags;
+    CSimpleVector<int>      residues;
+
+    CXMLBinData* p_bele;
+    if( (p_bele = p_ele->GetFirstChildBinData("ai")) != NULL ) indexes.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("an")) != NULL ) names.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("ad")) != NULL ) descrs.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("as")) != NULL ) ser_indexes.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("al")) != NULL ) loc_indexes.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("az")) != NULL ) z.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("ac")) != NULL ) charges.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("at")) != NULL ) types.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("ap")) != NULL ) positions.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("av")) != NULL ) velocities.Load(p_bele);
+    // flags and residues are optional
+    if( (p_bele = p_ele->GetFirstChildBinData("af")) != NULL ) flags.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("ar")) != NULL ) residues.Load(p_bele);
+
+    int natoms = indexes.GetLength();
+    if( (names.GetLength() != natoms) || (descrs.GetLength() != natoms)
+        || (ser_indexes.GetLength() != natoms) || (loc_indexes.GetLength() != natoms)
+        || (z.GetLength() != natoms) || (charges.GetLength() != natoms)
+        || (types.GetLength() != natoms) || (positions.GetLength() != natoms)
+        || (velocities.GetLength() != natoms)
+        || ((flags.GetLength() != 0) && (flags.GetLength() != natoms))
+        || ((residues.GetLength() != 0) && (residues.GetLength() != natoms)) ){
+        ES_ERROR("inconsistent atom data");
+        return;
+    }
+
+    Atoms.resize(natoms);
+    for(int i=0; i < natoms; i++){
+        CAtomData& atom_data = Atoms[i];
+        atom_data.Index = indexes[i];
+        atom_data.Name = GetString(names[i]);
+        atom_data.Description = GetString(descrs[i]);
+        atom_data.SerIndex = ser_indexes[i];
+        atom_data.LocIndex = loc_indexes[i];
+        atom_data.Z = z[i];
+        atom_data.Charge = charges[i];
+        atom_data.Type = GetString(types[i]);
+        atom_data.Pos = positions[i];
+        atom_data.Vel = velocities[i];
+        if( flags.GetLength() == natoms ) atom_data.Flags = flags[i];
+        if( residues.GetLength() == natoms ) atom_data.Residue = residues[i];
+    }
+
+    CSimpleVector<int>      bond_indexes;
+    CSimpleVector<int>      bond_names;
+    CSimpleVector<int>      bond_descrs;
+    CSimpleVector<int>      a1;
+    CSimpleVector<int>      a2;
+    CSimpleVector<int>      orders;
+    CSimpleVector<int>      bond_flags;
+
+    if( (p_bele = p_ele->GetFirstChildBinData("bi")) != NULL ) bond_indexes.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("bn")) != NULL ) bond_names.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("bd")) != NULL ) bond_descrs.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("b1")) != NULL ) a1.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("b2")) != NULL ) a2.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("bo")) != NULL ) orders.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("bf")) != NULL ) bond_flags.Load(p_bele);
+
+    int nbonds = bond_indexes.GetLength();
+    if( (bond_names.GetLength() != nbonds) || (bond_descrs.GetLength() != nbonds)
+        || (a1.GetLength() != nbonds) || (a2.GetLength() != nbonds)
+        || (orders.GetLength() != nbonds)
+        || ((bond_flags.GetLength() != 0) && (bond_flags.GetLength() != nbonds)) ){
+        ES_ERROR("inconsistent bond data");
+        Atoms.clear();
+        return;
+    }
+
+    Bonds.resize(nbonds);
+    for(int i=0; i < nbonds; i++){
+        CBondData& bond_data = Bonds[i];
+        bond_data.Index = bond_indexes[i];
+        bond_data.Name = GetString(bond_names[i]);
+        bond_data.Description = GetString(bond_descrs[i]);
+        bond_data.A1 = a1[i];
+        bond_data.A2 = a2[i];
+        bond_data.Order = static_cast<EBondOrder>(orders[i]);
+        if( bond_flags.GetLength() == nbonds ) bond_data.Flags = bond_flags[i];
+        if( (bond_data.A1 < 0) || (bond_data.A1 >= natoms)
+            || (bond_data.A2 < 0) || (bond_data.A2 >= natoms) ){
+            ES_ERROR("bond atom is out of range");
+            Atoms.clear();
+            Bonds.clear();
+            return;
+        }
+    }
+
+    Strings.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListBatchHI::SaveData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // save core data ----------------------------
+    CHistoryItem::SaveData(p_ele);
+
+    // save local data ---------------------------
+    p_ele->SetAttribute("mi",MoleculeIndex);
+
+    Strings.clear();
+    StringMap.clear();
+
+    int natoms = Atoms.count();
+
+    CSimpleVector<int>      indexes;
+    CSimpleVector<int>      names;
+    CSimpleVector<int>      descrs;
+    CSimpleVector<int>      ser_indexes;
+    CSimpleVector<int>      loc_indexes;
+    CSimpleVector<int>      z;
+    CSimpleVector<double>   charges;
+    CSimpleVector<int>      types;
+    CSimpleVector<CPoint>   positions;
+    CSimpleVector<CPoint>   velocities;
+    CSimpleVector<int>      flags;
+    CSimpleVector<int>      residues;
+
+    indexes.CreateVector(natoms);
+    names.CreateVector(natoms);
+    descrs.CreateVector(natoms);
+    ser_indexes.CreateVector(natoms);
+    loc_indexes.CreateVector(natoms);
+    z.CreateVector(natoms);
+    charges.CreateVector(natoms);
+    types.CreateVector(natoms);
+    positions.CreateVector(natoms);
+    velocities.CreateVector(natoms);
+    flags.CreateVector(natoms);
+    residues.CreateVector(natoms);
+
+    for(int i=0; i < natoms; i++){
+        const CAtomData& atom_data = Atoms.at(i);
+        indexes[i] = atom_data.Index;
+        names[i] = AddString(atom_data.Name);
+        descrs[i] = AddString(atom_data.Description);
+        ser_indexes[i] = atom_data.SerIndex;
+        loc_indexes[i] = atom_data.LocIndex;
+        z[i] = atom_data.Z;
+        charges[i] = atom_data.Charge;
+        types[i] = AddString(atom_data.Type);
+        positions[i] = atom_data.Pos;
+        velocities[i] = atom_data.Vel;
+        flags[i] = atom_data.Flags;
+        residues[i] = atom_data.Residue;
+    }
+
+    CXMLBinData* p_bele;
+    p_bele = p_ele->CreateChildBinData("ai");
+    indexes.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("an");
+    names.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("ad");
+    descrs.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("as");
+    ser_indexes.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("al");
+    loc_indexes.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("az");
+    z.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("ac");
+    charges.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("at");
+    types.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("ap");
+    positions.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("av");
+    velocities.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("af");
+    flags.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("ar");
+    residues.Save(p_bele);
+
+    int nbonds = Bonds.count();
+
+    CSimpleVector<int>      bond_indexes;
+    CSimpleVector<int>      bond_names;
+    CSimpleVector<int>      bond_descrs;
+    CSimpleVector<int>      a1;
+    CSimpleVector<int>      a2;
+    CSimpleVector<int>      orders;
+    CSimpleVector<int>      bond_flags;
+
+    bond_indexes.CreateVector(nbonds);
+    bond_names.CreateVector(nbonds);
+    bond_descrs.CreateVector(nbonds);
+    a1.CreateVector(nbonds);
+    a2.CreateVector(nbonds);
+    orders.CreateVector(nbonds);
+    bond_flags.CreateVector(nbonds);
+
+    for(int i=0; i < nbonds; i++){
+        const CBondData& bond_data = Bonds.at(i);
+        bond_indexes[i] = bond_data.Index;
+        bond_names[i] = AddString(bond_data.Name);
+        bond_descrs[i] = AddString(bond_data.Description);
+        a1[i] = bond_data.A1;
+        a2[i] = bond_data.A2;
+        orders[i] = bond_data.Order;
+        bond_flags[i] = bond_data.Flags;
+    }
+
+    p_bele = p_ele->CreateChildBinData("bi");
+    bond_indexes.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("bn");
+    bond_names.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("bd");
+    bond_descrs.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("b1");
+    a1.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("b2");
+    a2.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("bo");
+    orders.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("bf");
+    bond_flags.Save(p_bele);
+
+    // string table
+    CXMLElement* p_sele = p_ele->CreateChildElement("strings");
+    foreach(QString text, Strings){
+        CXMLElement* p_tele = p_sele->CreateChildElement("s");
+        p_tele->SetAttribute("t",text);
+    }
+
+    Strings.clear();
+    StringMap.clear();
+}
+
+//------------------------------------------------------------------------------
+
+int CAtomListBatchHI::AddString(const QString& text)
+{
+    if( text.isEmpty() ) return(-1);
+
+    QHash<QString,int>::const_iterator it = StringMap.constFind(text);
+    if( it != StringMap.constEnd() ) return(it.value());
+
+    int index = Strings.count();
+    Strings.append(text);
+    StringMap.insert(text,index);
+    return(index);
+}
+
+//------------------------------------------------------------------------------
+
+const QString CAtomListBatchHI::GetString(int index) const
+{
+    if( (index < 0) || (index >= Strings.count()) ) return(QString());
+    return(Strings.at(index));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAtomListRemoveBatchHI::CAtomListRemoveBatchHI(CStructure* p_mol,
+                                               const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                                               EHistoryItemDirection change)
+    : CHistoryItem(&AtomListRemoveBatchHIObject,p_mol->GetProject(),change)
+{
+    MoleculeIndex = p_mol->GetIndex();
+
+    AtomIndexes.CreateVector(atoms.count());
+    for(int i=0; i < atoms.count(); i++){
+        AtomIndexes[i] = atoms.at(i)->GetIndex();
+    }
+
+    BondIndexes.CreateVector(bonds.count());
+    for(int i=0; i < bonds.count(); i++){
+        BondIndexes[i] = bonds.at(i)->GetIndex();
+    }
+
+    // pack objects
+    CStructureBulkData bulk_data;
+    CXMLElement* p_ele = ObjectData.CreateChildElement("objects");
+    bulk_data.SaveObjects(atoms,bonds,p_ele);
+    bulk_data.Serialize(Data);
+
+    NumOfXMLObjects = atoms.count() + bonds.count()
+                    - bulk_data.GetNumberOfAtoms() - bulk_data.GetNumberOfBonds();
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CAtomListRemoveBatchHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + Data.size()
+           + (qint64)(AtomIndexes.GetLength() + BondIndexes.GetLength())*sizeof(int)
+           + (qint64)NumOfXMLObjects*HISTORY_XML_ELEMENT_SIZE);
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListRemoveBatchHI::Forward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    CXMLElement* p_ele = ObjectData.GetFirstChildElement("objects");
+    if( p_ele == NULL ) return;
+
+    CStructureBulkData bulk_data;
+    if( bulk_data.Deserialize(Data) == false ) return;
+
+    p_mol->BeginUpdate();
+    bulk_data.LoadObjects(p_mol,p_ele);
+    p_mol->EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListRemoveBatchHI::Backward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    QVector<CBond*> bonds;
+    bonds.reserve(BondIndexes.GetLength());
+    for(int i=0; i < BondIndexes.GetLength(); i++) {
+        CBond* p_bond = dynamic_cast<CBond*>(GetProject()->FindObject(BondIndexes[i]));
+        if( p_bond == NULL ) continue;
+        bonds.append(p_bond);
+    }
+
+    QVector<CAtom*> atoms;
+    atoms.reserve(AtomIndexes.GetLength());
+    for(int i=0; i < AtomIndexes.GetLength(); i++) {
+        CAtom* p_atom = dynamic_cast<CAtom*>(GetProject()->FindObject(AtomIndexes[i]));
+        if( p_atom == NULL ) continue;
+        atoms.append(p_atom);
+    }
+
+    // bonds first, then atoms do not have any bond
+    p_mol->BeginUpdate();
+    p_mol->GetBonds()->RemoveBonds(bonds);
+    p_mol->GetAtoms()->RemoveAtoms(atoms);
+    p_mol->EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListRemoveBatchHI::LoadData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // load core data ----------------------------
+    CHistoryItem::LoadData(p_ele);
+
+    // load local data ---------------------------
+    p_ele->GetAttribute("mi",MoleculeIndex);
+    p_ele->GetAttribute("nx",NumOfXMLObjects);
+
+    CXMLBinData* p_bele;
+    if( (p_bele = p_ele->GetFirstChildBinData("ai")) != NULL ) AtomIndexes.Load(p_bele);
+    if( (p_bele = p_ele->GetFirstChildBinData("bi")) != NULL ) BondIndexes.Load(p_bele);
+
+    Data.clear();
+    if( (p_bele = p_ele->GetFirstChildBinData("data")) != NULL ){
+        CSimpleVector<char> bytes;
+        bytes.Load(p_bele);
+        if( bytes.GetLength() > 0 ) Data = QByteArray(&bytes[0],bytes.GetLength());
+    }
+
+    ObjectData.RemoveAllChildNodes();
+    CXMLElement* p_dele = ObjectData.CreateChildElement("objects");
+    CXMLElement* p_sele = p_ele->GetFirstChildElement("objects");
+    if( p_sele != NULL ) p_dele->CopyContentsFrom(p_sele);
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListRemoveBatchHI::SaveData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // save core data ----------------------------
+    CHistoryItem::SaveData(p_ele);
+
+    // save local data ---------------------------
+    p_ele->SetAttribute("mi",MoleculeIndex);
+    p_ele->SetAttribute("nx",NumOfXMLObjects);
+
+    CXMLBinData* p_bele;
+    p_bele = p_ele->CreateChildBinData("ai");
+    AtomIndexes.Save(p_bele);
+    p_bele = p_ele->CreateChildBinData("bi");
+    BondIndexes.Save(p_bele);
+
+    CSimpleVector<char> bytes;
+    bytes.CreateVector(Data.size());
+    if( Data.size() > 0 ) memcpy(&bytes[0],Data.constData(),Data.size());
+    p_bele = p_ele->CreateChildBinData("data");
+    bytes.Save(p_bele);
+
+    CXMLElement* p_sele = ObjectData.GetFirstChildElement("objects");
+    if( p_sele == NULL ) return;
+    CXMLElement* p_dele = p_ele->CreateChildElement("objects");
+    p_dele->CopyContentsFrom(p_sele);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -29,6 +29,13 @@
 #include <SmallString.hpp>
 #include <Transformation.hpp>
 #include <Point.hpp>
+#include <AtomData.hpp>
+#include <BondData.hpp>
+#include <XMLDocument.hpp>
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QByteArray>
 
 //------------------------------------------------------------------------------
 
@@ -37,6 +44,8 @@ class CProject;
 class CAtomList;
 class CXMLElement;
 class CStructure;
+class CAtom;
+class CBond;
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -49,6 +58,10 @@ public:
     CAtomListTransHI(CStructure* p_mol,
                               const CTransformation& trans);
 
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
 // section of private data -----------------------------------------------------
 private:
     int                 MoleculeIndex;
@@ -82,6 +95,10 @@ public:
     CAtomListCoordinatesHI(CStructure* p_mol);
     CAtomListCoordinatesHI(CStructure* p_mol,bool selected);
 
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
 // section of private data -----------------------------------------------------
 private:
     int                     MoleculeIndex;
@@ -107,6 +124,70 @@ private:
 //------------------------------------------------------------------------------
 //==============================================================================
 
+/// coordinates changed by interactive manipulation or optimization
+/*! coordinates of all candidate atoms are captured when the change starts,
+    Compact must be called when the change is finished, it keeps only moved
+    atoms and replaces their coordinates by the transformation if they
+    were moved rigidly
+*/
+
+class NEMESIS_CORE_PACKAGE CAtomListDeltaHI : public CHistoryItem {
+public:
+// constructors and destructors ------------------------------------------------
+    CAtomListDeltaHI(CProject* p_object);
+    CAtomListDeltaHI(CStructure* p_mol,bool selected,bool mergeable);
+
+// executive methods -----------------------------------------------------------
+    /// keep only moved atoms
+    /*! if p_trans is provided and all moved atoms are transformed by it,
+        only the transformation is kept
+    */
+    void Compact(const CTransformation* p_trans=NULL);
+
+    /// compact delta items of the last change and merge it with the previous change
+    static void CompactLastChange(CStructure* p_mol,const CTransformation* p_trans=NULL);
+
+    /// merge the following change of the same atoms
+    virtual bool MergeWith(CHistoryItem* p_item);
+
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
+// section of private data -----------------------------------------------------
+private:
+    int                     MoleculeIndex;
+    bool                    Mergeable;
+    bool                    Rigid;
+    CTransformation         Trans;          // used only for rigid change
+    CSimpleVector<CPoint>   Coordinates;    // empty for rigid change
+    CSimpleVector<int>      Indexes;
+
+// executive methods -----------------------------------------------------------
+    /// perform the change in the forward direction
+    virtual void Forward(void);
+
+    /// perform the change in the backward direction
+    virtual void Backward(void);
+
+    /// exchange stored and current coordinates
+    void SwapCoordinates(void);
+
+    /// transform atoms
+    void Transform(const CTransformation& trans);
+
+// input/output methods --------------------------------------------------------
+    /// load data
+    virtual void LoadData(CXMLElement* p_ele);
+
+    /// save data
+    virtual void SaveData(CXMLElement* p_ele);
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 class CAtomListChangeParentHI : public CHistoryItem {
 public:
 // constructors and destructors ------------------------------------------------
@@ -141,4 +222,100 @@ private:
 //------------------------------------------------------------------------------
 //==============================================================================
 
+/// atoms and bonds created by CStructure::CreateAtomsAndBonds
+/*! the whole batch is kept in one item, data are saved in binary columns,
+    strings are stored in the string table
+*/
+
+class CAtomListBatchHI : public CHistoryItem {
+public:
+// constructors and destructors ------------------------------------------------
+    CAtomListBatchHI(CProject* p_object);
+    CAtomListBatchHI(CStructure* p_mol,
+                     const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds,
+                     const QVector<CAtom*>& new_atoms,const QVector<CBond*>& new_bonds);
+
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
+// section of private data -----------------------------------------------------
+private:
+    int                 MoleculeIndex;
+    QVector<CAtomData>  Atoms;
+    QVector<CBondData>  Bonds;          // A1 and A2 are positions in Atoms
+    QStringList         Strings;        // used only by SaveData and LoadData
+    QHash<QString,int>  StringMap;
+
+// executive methods -----------------------------------------------------------
+    /// perform the change in the forward direction
+    virtual void Forward(void);
+
+    /// perform the change in the backward direction
+    virtual void Backward(void);
+
+// input/output methods --------------------------------------------------------
+    /// load data
+    virtual void LoadData(CXMLElement* p_ele);
+
+    /// save data
+    virtual void SaveData(CXMLElement* p_ele);
+
+    /// add string to the string table
+    int AddString(const QString& text);
+
+    /// get string from the string table
+    const QString GetString(int index) const;
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+/// atoms and bonds removed by CStructure::RemoveAtoms or created in one batch
+/*! the whole batch is kept in one item, objects are packed in columns
+    of CStructureBulkData, only objects with description or designer data
+    are kept as XML elements
+*/
+
+class CAtomListRemoveBatchHI : public CHistoryItem {
+public:
+// constructors and destructors ------------------------------------------------
+    CAtomListRemoveBatchHI(CProject* p_object);
+    CAtomListRemoveBatchHI(CStructure* p_mol,
+                           const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                           EHistoryItemDirection change=EHID_BACKWARD);
+
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
+// section of private data -----------------------------------------------------
+private:
+    int                 MoleculeIndex;
+    QByteArray          Data;           // serialized CStructureBulkData
+    CXMLDocument        ObjectData;     // objects that are not in columns
+    int                 NumOfXMLObjects;
+    CSimpleVector<int>  AtomIndexes;
+    CSimpleVector<int>  BondIndexes;
+
+// executive methods -----------------------------------------------------------
+    /// perform the change in the forward direction
+    virtual void Forward(void);
+
+    /// perform the change in the backward direction
+    virtual void Backward(void);
+
+// input/output methods --------------------------------------------------------
+    /// load data
+    virtual void LoadData(CXMLElement* p_ele);
+
+    /// save data
+    virtual void SaveData(CXMLElement* p_ele);
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 #endif
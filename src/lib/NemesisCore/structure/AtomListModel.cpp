@@ -69,15 +69,15 @@ QObject* AtomListModelCB(void* p_data)
 //==============================================================================
 
 CAtomListModel::CAtomListModel(QObject* p_parent)
-    : CContainerModel(&AtomListModelObject,p_parent)
+    : CObjectListModel(&AtomListModelObject,p_parent)
 {
     RootObject = NULL;
 
     connect(PQ_DISTANCE,SIGNAL(OnUnitChanged(void)),
-            this,SLOT(ListChanged(void)));
+            this,SLOT(UnitChanged(void)));
 
     connect(PQ_CHARGE,SIGNAL(OnUnitChanged(void)),
-            this,SLOT(ListChanged(void)));
+            this,SLOT(UnitChanged(void)));
 }
 
 //------------------------------------------------------------------------------
@@ -101,21 +101,15 @@ void CAtomListModel::SetRootObject(CAtomList* p_data)
 
         if( RootObject->GetProject()->GetStructures() ){
             connect(RootObject->GetProject()->GetStructures(),SIGNAL(OnGeometryChangeTick(void)),
-                    this,SLOT(ListChanged(void)));
+                    this,SLOT(GeometryChanged(void)));
         }
     }
-    // FIXME
-    beginResetModel();
-    endResetModel();
-}
-
-//------------------------------------------------------------------------------
 
-QObject*  CAtomListModel::GetItem(const QModelIndex& index) const
-{
-    if( ! index.isValid() ) return(NULL);
-    CAtom* p_obj = static_cast<CAtom*>(index.internalPointer());
-    return(p_obj);
+    if( RootObject != NULL ) {
+        ResetRows(RootObject->children());
+    } else {
+        ClearRows();
+    }
 }
 
 //==============================================================================
@@ -130,45 +124,45 @@ QVariant CAtomListModel::headerData(int section, Qt::Orientation orientation,
     if( role != Qt::DisplayRole ) return( QVariant() );
 
     switch(section) {
-        case 0:
+        case EALMC_SER_INDEX:
             return(tr("SerIndx"));
-        case 1:
+        case EALMC_LOC_INDEX:
             return(tr("LocIndx"));
-        case 2:
+        case EALMC_NAME:
             return(tr("Name"));
-        case 3:
+        case EALMC_SEQ_INDEX:
             return(tr("SeqIndx"));
-        case 4:
+        case EALMC_RES_NAME:
             return(tr("ResName"));
-        case 5:
+        case EALMC_CHAIN:
             return(tr("Chain"));
-        case 6:
+        case EALMC_SYMBOL:
             return(tr("Symbol"));
-        case 7:
+        case EALMC_TYPE:
             return(tr("Type"));
-        case 8: {
+        case EALMC_POS_X: {
             QString col = tr("X [%1]");
             col = col.arg(PQ_DISTANCE->GetUnitName());
             return(col);
         }
-        case 9: {
+        case EALMC_POS_Y: {
             QString col = tr("Y [%1]");
             col = col.arg(PQ_DISTANCE->GetUnitName());
             return(col);
         }
-        case 10: {
+        case EALMC_POS_Z: {
             QString col = tr("Z [%1]");
             col = col.arg(PQ_DISTANCE->GetUnitName());
             return(col);
         }
-        case 11: {
+        case EALMC_CHARGE: {
             QString col = tr("Charge [%1]");
             col = col.arg(PQ_CHARGE->GetUnitName());
             return(col);
         }
-        case 12:
+        case EALMC_ID:
             return(tr("ID"));
-        case 13:
+        case EALMC_DESCRIPTION:
             return(tr("Description"));
         default:
             return("");
@@ -179,38 +173,7 @@ QVariant CAtomListModel::headerData(int section, Qt::Orientation orientation,
 
 int CAtomListModel::columnCount(const QModelIndex &parent) const
 {
-    return(14);
-}
-
-//------------------------------------------------------------------------------
-
-int CAtomListModel::rowCount(const QModelIndex &parent) const
-{
-    if( RootObject == 0 ) return(0);
-    return( RootObject->children().count() );
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CAtomListModel::index(int row, int column,
-                                  const QModelIndex &parent) const
-{
-    if( RootObject == NULL ) return( QModelIndex() );
-
-    if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
-    if( parent.isValid() )  return( QModelIndex() );
-
-    QModelIndex index = createIndex(row, column, RootObject->children()[row]);
-
-    return(index);
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CAtomListModel::parent(const QModelIndex &index) const
-{
-    // parent is always invalid
-    return( QModelIndex() );
+    return(EALMC_NUM_OF_COLUMNS);
 }
 
 //------------------------------------------------------------------------------
@@ -225,48 +188,48 @@ QVariant CAtomListModel::data(const QModelIndex &index, int role) const
     switch(role) {
     case Qt::DisplayRole: {
         switch( index.column() ) {
-        case 0:
+        case EALMC_SER_INDEX:
             return(p_obj->GetSerIndex());
-        case 1:
+        case EALMC_LOC_INDEX:
             return(p_obj->GetLocIndex());
-        case 2:
+        case EALMC_NAME:
             return(p_obj->GetName());
-        case 3:{
+        case EALMC_SEQ_INDEX:{
             CResidue* p_res = p_obj->GetResidue();
             if( p_res != NULL ){
                 return(p_res->GetSeqIndex());
             }
             }
             return( QVariant() );
-        case 4:{
+        case EALMC_RES_NAME:{
             CResidue* p_res = p_obj->GetResidue();
             if( p_res != NULL ){
                 return(p_res->GetName());
             }
             }
             return( QVariant() );
-        case 5:{
+        case EALMC_CHAIN:{
             CResidue* p_res = p_obj->GetResidue();
             if( p_res != NULL ){
                 return(p_res->GetChain());
             }
             }
             return( QVariant() );
-        case 6:
+        case EALMC_SYMBOL:
             return(PeriodicTable.GetSymbol(p_obj->GetZ()));
-        case 7:
+        case EALMC_TYPE:
             return(p_obj->GetType());
-        case 8:
+        case EALMC_POS_X:
             return(PQ_DISTANCE->GetRealValueText(p_obj->GetPos().x));
-        case 9:
+        case EALMC_POS_Y:
             return(PQ_DISTANCE->GetRealValueText(p_obj->GetPos().y));
-        case 10:
+        case EALMC_POS_Z:
             return(PQ_DISTANCE->GetRealValueText(p_obj->GetPos().z));
-        case 11:
+        case EALMC_CHARGE:
             return(PQ_CHARGE->GetRealValueText(p_obj->GetCharge()));
-        case 12:
+        case EALMC_ID:
             return(p_obj->GetIndex());
-        case 13:
+        case EALMC_DESCRIPTION:
             return(p_obj->GetDescription());
         default:
             return( QVariant() );
@@ -276,25 +239,25 @@ QVariant CAtomListModel::data(const QModelIndex &index, int role) const
 
     case Qt::TextAlignmentRole:
         switch( index.column() ) {
-            case 0:
-            case 1:
+            case EALMC_SER_INDEX:
+            case EALMC_LOC_INDEX:
                 return(Qt::AlignRight);
-            case 2:
+            case EALMC_NAME:
                 return(Qt::AlignLeft);
-            case 3:
+            case EALMC_SEQ_INDEX:
                 return(Qt::AlignRight);
-            case 4:
-            case 5:
-            case 6:
-            case 7:
+            case EALMC_RES_NAME:
+            case EALMC_CHAIN:
+            case EALMC_SYMBOL:
+            case EALMC_TYPE:
                 return(Qt::AlignLeft);
-            case 8:
-            case 9:
-            case 10:
-            case 11:
-            case 12:
+            case EALMC_POS_X:
+            case EALMC_POS_Y:
+            case EALMC_POS_Z:
+            case EALMC_CHARGE:
+            case EALMC_ID:
                 return(Qt::AlignRight);
-            case 13:
+            case EALMC_DESCRIPTION:
                 return(Qt::AlignLeft);
             default:
                 return( QVariant() );
@@ -332,7 +295,7 @@ QMimeData* CAtomListModel::mimeData(const QModelIndexList &indexes) const
     QDataStream stream(&encodedData, QIODevice::WriteOnly);
 
     foreach(const QModelIndex &index, indexes) {
-        if( index.column() != 0 ) continue;
+        if( index.column() != EALMC_SER_INDEX ) continue;
         CProObject* p_object = dynamic_cast<CProObject*>(GetItem(index));
         if( p_object ){
              stream << p_object->GetIndex();
@@ -350,18 +313,53 @@ QMimeData* CAtomListModel::mimeData(const QModelIndexList &indexes) const
 void CAtomListModel::RootObjectDeleted(void)
 {
     RootObject = NULL;
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    ClearRows();
 }
 
 //------------------------------------------------------------------------------
 
 void CAtomListModel::ListChanged(void)
 {
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    if( RootObject == NULL ) return;
+    UpdateRows(RootObject->children());
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListModel::GeometryChanged(void)
+{
+    if( RootObject == NULL ) return;
+
+    CStructure*               p_str = RootObject->GetStructure();
+    const CGeometryChangeSet& changes = RootObject->GetProject()->GetStructures()->GetGeometryChanges();
+    if( changes.IsChanged(p_str) == false ) return;
+
+    // only coordinates are changed
+    if( changes.AreAllAtomsChanged(p_str) ){
+        EmitRowsChanged(EALMC_POS_X,EALMC_POS_Z);
+        return;
+    }
+
+    int first = -1;
+    int last = -1;
+    const QVector<int> ranges = changes.GetAtomRanges(p_str);
+    for(int i=0; i+1 < ranges.count(); i += 2){
+        for(int idx = ranges[i]; idx <= ranges[i+1]; idx++){
+            int row = GetRowOfObject(idx);
+            if( row < 0 ) continue;
+            if( (first < 0) || (row < first) ) first = row;
+            if( row > last ) last = row;
+        }
+    }
+    EmitRowsChanged(first,last,EALMC_POS_X,EALMC_POS_Z);
+}
+
+//------------------------------------------------------------------------------
+
+void CAtomListModel::UnitChanged(void)
+{
+    emit headerDataChanged(Qt::Horizontal,0,columnCount(QModelIndex())-1);
+    EmitRowsChanged(0,columnCount(QModelIndex())-1);
 }
 
 //==============================================================================
@@ -24,7 +24,7 @@
 // =============================================================================
 
 #include <NemesisCoreMainHeader.hpp>
-#include <ContainerModel.hpp>
+#include <ObjectListModel.hpp>
 
 // -----------------------------------------------------------------------------
 
@@ -34,7 +34,28 @@ class CAtom;
 
 // -----------------------------------------------------------------------------
 
-class NEMESIS_CORE_PACKAGE CAtomListModel : public CContainerModel {
+/// columns of the atom list model
+enum EAtomListModelColumn {
+    EALMC_SER_INDEX       = 0,
+    EALMC_LOC_INDEX       = 1,
+    EALMC_NAME            = 2,
+    EALMC_SEQ_INDEX       = 3,
+    EALMC_RES_NAME        = 4,
+    EALMC_CHAIN           = 5,
+    EALMC_SYMBOL          = 6,
+    EALMC_TYPE            = 7,
+    EALMC_POS_X           = 8,
+    EALMC_POS_Y           = 9,
+    EALMC_POS_Z           = 10,
+    EALMC_CHARGE          = 11,
+    EALMC_ID              = 12,
+    EALMC_DESCRIPTION     = 13,
+    EALMC_NUM_OF_COLUMNS  = 14
+};
+
+// -----------------------------------------------------------------------------
+
+class NEMESIS_CORE_PACKAGE CAtomListModel : public CObjectListModel {
     Q_OBJECT
 public:
 // constructors and destructors -----------------------------------------------
@@ -43,9 +64,6 @@ public:
     /// set root object
     void SetRootObject(CAtomList* p_data);
 
-    /// return object item from model index
-    virtual QObject* GetItem(const QModelIndex& index) const;
-
 // section of private data ----------------------------------------------------
 private:
     CAtomList*    RootObject;
@@ -54,11 +72,6 @@ private:
                         int role = Qt::DisplayRole) const;
 
     int columnCount(const QModelIndex &parent) const;
-    int rowCount(const QModelIndex &parent) const;
-
-    QModelIndex index(int row, int column,
-                      const QModelIndex &parent) const;
-    QModelIndex parent(const QModelIndex &index) const;
 
     QVariant data(const QModelIndex &index, int role) const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
@@ -72,6 +85,8 @@ private:
 private slots:
     void RootObjectDeleted(void);
     void ListChanged(void);
+    void GeometryChanged(void);
+    void UnitChanged(void);
 };
 
 // -----------------------------------------------------------------------------
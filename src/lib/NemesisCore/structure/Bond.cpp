@@ -29,6 +29,7 @@
 #include <ErrorSystem.hpp>
 #include <XMLElement.hpp>
 #include <Structure.hpp>
+#include <StructureList.hpp>
 #include <BondHistory.hpp>
 #include <AtomList.hpp>
 #include <Residue.hpp>
@@ -534,6 +535,17 @@ void CBond::SetDescription(const QString& descrip,CHistoryNode* p_history)
 
 //------------------------------------------------------------------------------
 
+void CBond::SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history)
+{
+    if( GetFlags() == flags ) return;
+    CProObject::SetFlags(flags,p_history);
+    if( GetStructure() && GetStructure()->GetStructures() ){
+        GetStructure()->GetStructures()->EmitOnObjectFlagsChanged();
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void CBond::SetBondOrder(EBondOrder order,CHistoryNode* p_history)
 {
     if( Order == order ) return;
@@ -145,6 +145,9 @@ public:
     /// set description
     virtual void SetDescription(const QString& descrip,CHistoryNode* p_history=NULL);
 
+    /// set flags
+    virtual void SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history=NULL);
+
     /// break bond
     void Break(CHistoryNode* p_history = NULL);
 
@@ -185,6 +188,10 @@ private:
     // PBC bond index, 0 - no PBC bond
     // it is used to connect PBC bonds among cells during supercell building
     int             PBCIndex;
+
+    friend class CStructureBulkData;
+    friend class CSuperCellBuilder;
+    friend class CBondList;
 };
 
 // -----------------------------------------------------------------------------
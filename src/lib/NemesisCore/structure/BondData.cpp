@@ -37,6 +37,7 @@ CBondData::CBondData(void)
     A1 = -1;             // first atom
     A2 = -1;             // second atom
     Order = BO_NONE;          // bond order
+    Flags = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -98,6 +99,28 @@ bool CBondData::Save(CXMLElement* p_ele)
     return(result);
 }
 
+//------------------------------------------------------------------------------
+
+void CBondData::LoadBond(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ) {
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    if( p_ele->GetName() != "bond" ) {
+        LOGIC_ERROR("element is not bond");
+    }
+
+    // see CProObject::LoadData and CBond::LoadData
+    p_ele->GetAttribute("id",Index);
+    p_ele->GetAttribute("name",Name);
+    p_ele->GetAttribute("descr",Description);
+    p_ele->GetAttribute("flags",Flags);
+    p_ele->GetAttribute<EBondOrder>("ord",Order);
+    p_ele->GetAttribute("a1",A1);
+    p_ele->GetAttribute("a2",A2);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
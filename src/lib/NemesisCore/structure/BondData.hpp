@@ -44,6 +44,11 @@ public:
     bool Load(CXMLElement* p_ele);
     bool Save(CXMLElement* p_ele);
 
+    /// read data of the bond element saved by CBond::SaveData
+    /*! A1 and A2 are object indexes of atoms not shifted by the base object index
+    */
+    void LoadBond(CXMLElement* p_ele);
+
 // section of private data ----------------------------------------------------
 public:
     int         Index;          // bond index
@@ -52,6 +57,7 @@ public:
     int         A1;             // first atom
     int         A2;             // second atom
     EBondOrder  Order;          // bond order
+    int         Flags;          // user flags (EPOF_SAVE_MASK)
 };
 
 //------------------------------------------------------------------------------
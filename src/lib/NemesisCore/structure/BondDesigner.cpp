@@ -266,6 +266,10 @@ void CBondDesigner::InitValues(void)
 
 void CBondDesigner::GeometryChanged(void)
 {
+    const CGeometryChangeSet& changes = Object->GetProject()->GetStructures()->GetGeometryChanges();
+    if( (changes.IsChanged(Object->GetFirstAtom()) == false)
+        && (changes.IsChanged(Object->GetSecondAtom()) == false) ) return;
+
     WidgetUI.lengthLE->setInternalValue(Object->GetLength());
 }
 
@@ -60,6 +60,13 @@ CBondHI::CBondHI(CBond* p_bond,EHistoryItemDirection change)
 
 //------------------------------------------------------------------------------
 
+qint64 CBondHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + HISTORY_XML_ELEMENT_SIZE);
+}
+
+//------------------------------------------------------------------------------
+
 void CBondHI::Forward(void)
 {
     CStructure* p_str = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
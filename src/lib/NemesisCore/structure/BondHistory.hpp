@@ -44,6 +44,10 @@ public:
     CBondHI(CProject* p_object);
     CBondHI(CBond* p_bond,EHistoryItemDirection change);
 
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
 // section of private data -----------------------------------------------------
 private:
     int             MoleculeIndex;
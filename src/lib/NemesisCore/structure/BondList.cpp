@@ -35,6 +35,9 @@
 #include <AtomList.hpp>
 #include <HistoryNode.hpp>
 #include <BondListHistory.hpp>
+#include <AtomListHistory.hpp>
+#include <BondPerception.hpp>
+#include <BondData.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -78,37 +81,17 @@ CBond* CBondList::CreateBondWH(CAtom *p_a1,CAtom *p_a2,EBondOrder order)
 
 //------------------------------------------------------------------------------
 
-bool CBondList::AddBondsWH(void)
+bool CBondList::AddBondsWH(bool selected_only,bool perceive_orders)
 {
     CHistoryNode*    p_history;
-    p_history = BeginChangeWH(EHCL_TOPOLOGY,"add single bonds");
+    if( perceive_orders ){
+        p_history = BeginChangeWH(EHCL_TOPOLOGY,"add bonds");
+    } else {
+        p_history = BeginChangeWH(EHCL_TOPOLOGY,"add single bonds");
+    }
     if( p_history == NULL ) return (false);
 
-    // protonate structure by openbabel
-    OpenBabel::OBMol obmol;
-    COpenBabelUtils::Nemesis2OpenBabel(GetStructure(),obmol,true);
-
-    unsigned int top_bond = obmol.NumBonds();
-
-    // newly added atoms are added to the end of molecule
-    obmol.ConnectTheDots();
-    obmol.PerceiveBondOrders();
-
-    // add added hydrogens new hydrogens
-    for(unsigned int i= top_bond ; i < obmol.NumBonds(); i++) {
-        OpenBabel::OBBond* p_obbond = obmol.GetBond(i);
-
-        // atom 1
-        OpenBabel::OBAtom* p_obatom1 = p_obbond->GetBeginAtom();
-        CAtom* p_atom1 = static_cast<CAtom*>(GetStructure()->GetAtoms()->children()[p_obatom1->GetIdx()-1]);
-
-        // atom 2
-        OpenBabel::OBAtom* p_obatom2 = p_obbond->GetEndAtom();
-        CAtom* p_atom2 = static_cast<CAtom*>(GetStructure()->GetAtoms()->children()[p_obatom2->GetIdx()-1]);
-
-        // bond
-        CreateBond(p_atom1,p_atom2,COpenBabelUtils::OBToNemesisBondOrder(p_obbond->GetBondOrder()),p_history);
-    }
+    AddBonds(selected_only,perceive_orders,p_history);
 
     EndChangeWH();
     return(true);
@@ -116,39 +99,59 @@ bool CBondList::AddBondsWH(void)
 
 //------------------------------------------------------------------------------
 
-void CBondList::RecreateBonds(void)
+void CBondList::RecreateBonds(bool perceive_orders)
 {
+    BeginUpdate();
+
     // delete old bonds
     foreach(QObject* p_qobj,children()) {
         CBond* p_bond = static_cast<CBond*>(p_qobj);
         p_bond->RemoveFromBaseList(NULL);
     }
 
-    // protonate structure by openbabel
-    OpenBabel::OBMol obmol;
-    COpenBabelUtils::Nemesis2OpenBabel(GetStructure(),obmol,true);
+    AddBonds(false,perceive_orders);
 
-    unsigned int top_bond = obmol.NumBonds();
+    EndUpdate();
+}
 
-    // newly added atoms are added to the end of molecule
-    obmol.ConnectTheDots();
-    obmol.PerceiveBondOrders();
+//------------------------------------------------------------------------------
 
-    // add added hydrogens new hydrogens
-    for(unsigned int i= top_bond ; i < obmol.NumBonds(); i++) {
-        OpenBabel::OBBond* p_obbond = obmol.GetBond(i);
+void CBondList::AddBonds(bool selected_only,bool perceive_orders,CHistoryNode* p_history)
+{
+    CBondPerception perception;
+    perception.SetSelectedOnly(selected_only);
+    perception.Perceive(GetStructure());
+
+    int nbonds = perception.GetNumberOfBonds();
+    if( nbonds == 0 ) return;
+
+    QVector<CAtom*>     atoms(2*nbonds);
+    QVector<CBondData>  bonds(nbonds);
+    for(int i=0; i < nbonds; i++){
+        atoms[2*i+0] = perception.GetFirstAtom(i);
+        atoms[2*i+1] = perception.GetSecondAtom(i);
+        bonds[i].A1 = 2*i+0;
+        bonds[i].A2 = 2*i+1;
+        bonds[i].Order = BO_SINGLE;
+    }
 
-        // atom 1
-        OpenBabel::OBAtom* p_obatom1 = p_obbond->GetBeginAtom();
-        CAtom* p_atom1 = static_cast<CAtom*>(GetStructure()->GetAtoms()->children()[p_obatom1->GetIdx()-1]);
+    BeginUpdate();
 
-        // atom 2
-        OpenBabel::OBAtom* p_obatom2 = p_obbond->GetEndAtom();
-        CAtom* p_atom2 = static_cast<CAtom*>(GetStructure()->GetAtoms()->children()[p_obatom2->GetIdx()-1]);
+    QVector<CBond*> new_bonds;
+    CreateBonds(bonds,atoms,new_bonds);
 
-        // bond
-        CreateBond(p_atom1,p_atom2,COpenBabelUtils::OBToNemesisBondOrder(p_obbond->GetBondOrder()));
+    if( perceive_orders ){
+        COpenBabelUtils::PerceiveBondOrders(GetStructure(),new_bonds);
     }
+
+    // one record for the whole batch with final bond orders
+    if( p_history != NULL ){
+        CAtomListRemoveBatchHI* p_hi = new CAtomListRemoveBatchHI(GetStructure(),QVector<CAtom*>(),
+                                                                  new_bonds,EHID_FORWARD);
+        p_history->Register(p_hi);
+    }
+
+    EndUpdate();
 }
 
 //------------------------------------------------------------------------------
@@ -291,6 +294,80 @@ CBond* CBondList::CreateBond(const CBondData& bond_data, CHistoryNode* p_history
 
 //------------------------------------------------------------------------------
 
+void CBondList::CreateBonds(const QVector<CBondData>& bonds,const QVector<CAtom*>& atoms,
+                            QVector<CBond*>& new_bonds)
+{
+    new_bonds.resize(bonds.count());
+
+    int base_index = 0;
+    if( GetProject() != NULL ){
+        base_index = GetProject()->GetBaseObjectIndex();
+    }
+
+    for(int i=0; i < bonds.count(); i++){
+        const CBondData& bond_data = bonds.at(i);
+
+        CBond* p_bond;
+        if( bond_data.Index > 0 ){
+            // we need explicit object index
+            p_bond = new CBond(this,true);
+            p_bond->SetIndex(bond_data.Index + base_index);
+        } else {
+            p_bond = new CBond(this);
+        }
+
+        if( ! bond_data.Name.isEmpty() ){
+            p_bond->SetName(bond_data.Name);
+        }
+        if( ! bond_data.Description.isEmpty() ){
+            p_bond->SetDescription(bond_data.Description);
+        }
+
+        // members are set directly, setters would emit signals for each bond
+        CProObjectFlags mask = CProObjectFlags(QFlag(EPOF_SAVE_MASK));
+        p_bond->Flags = (p_bond->Flags & (~mask)) | (CProObjectFlags(QFlag(bond_data.Flags)) & mask);
+        p_bond->Order = bond_data.Order;
+        p_bond->A1 = atoms.at(bond_data.A1);
+        p_bond->A1->RegisterBond(p_bond);
+        p_bond->A2 = atoms.at(bond_data.A2);
+        p_bond->A2->RegisterBond(p_bond);
+
+        new_bonds[i] = p_bond;
+    }
+
+    ListSizeChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CBondList::RemoveBonds(const QVector<CBond*>& bonds)
+{
+    QSet<QObject*> removed;
+
+    // see CBond::RemoveFromBaseList
+    foreach(CBond* p_bond,bonds){
+        if( (p_bond == NULL) || (p_bond->GetBonds() != this) ) continue;
+        if( removed.contains(p_bond) ) continue;
+        removed.insert(p_bond);
+
+        p_bond->UnregisterAllRegisteredObjects();
+        if( p_bond->A1 != NULL ) p_bond->A1->UnregisterBond(p_bond);
+        if( p_bond->A2 != NULL ) p_bond->A2->UnregisterBond(p_bond);
+    }
+
+    if( removed.isEmpty() ) return;
+
+    // detached bonds do not notify the list when destroyed
+    RemoveChildren(removed);
+    foreach(QObject* p_obj,removed){
+        delete p_obj;
+    }
+
+    ListSizeChanged();
+}
+
+//------------------------------------------------------------------------------
+
 void CBondList::UnregisterAllRegisteredBonds(CHistoryNode* p_history)
 {
     foreach(QObject* p_qobj,children()) {
@@ -26,6 +26,7 @@
 #include <NemesisCoreMainHeader.hpp>
 #include <Bond.hpp>
 #include <BondData.hpp>
+#include <QVector>
 
 // -----------------------------------------------------------------------------
 
@@ -49,7 +50,10 @@ public:
     CBond* CreateBondWH(CAtom *p_a1,CAtom *p_a2,EBondOrder order);
 
     /// add missing bonds
-    bool AddBondsWH(void);
+    /*! bonds are perceived from atom distances, bond orders by openbabel
+        unless perceive_orders is false, then all new bonds are single
+    */
+    bool AddBondsWH(bool selected_only=false,bool perceive_orders=true);
 
     /// remove all bonds
     bool RemoveBondsWH(void);
@@ -71,18 +75,37 @@ public:
     /// create bond
     CBond* CreateBond(const CBondData& bond_data,CHistoryNode* p_history=NULL);
 
+    /// create bonds in one pass without history recording
+    /*! A1 and A2 of bonds are positions of atoms in the atoms vector (counted from zero),
+        they must be valid, see CStructure::CreateAtomsAndBonds
+    */
+    void CreateBonds(const QVector<CBondData>& bonds,const QVector<CAtom*>& atoms,
+                     QVector<CBond*>& new_bonds);
+
+    /// remove bonds in one pass without history recording
+    /*! bonds not owned by the list are skipped
+    */
+    void RemoveBonds(const QVector<CBond*>& bonds);
+
     /// remove registrations for all bonds
     void UnregisterAllRegisteredBonds(CHistoryNode* p_history=NULL);
 
-    /// assign new PBC bond indexes - used by BuildSuperCellWH
+    /// assign new PBC bond indexes
     // return number of assigned indexes
     int AssignPBCBondIndexes(void);
 
     /// change parentship of all bonds
     void MoveAllBondsFrom(CBondList* p_source,CHistoryNode* p_history=NULL);
 
+    /// add missing bonds perceived from atom distances
+    /*! new bonds are single unless perceive_orders is true,
+        they are recorded as one history item, see CBondPerception
+    */
+    void AddBonds(bool selected_only,bool perceive_orders,CHistoryNode* p_history=NULL);
+
     /// recreate bonds
-    void RecreateBonds(void);
+    /*! bond orders are perceived only on request */
+    void RecreateBonds(bool perceive_orders=false);
 
 // informational methods -------------------------------------------------------
     /// get structure pointer
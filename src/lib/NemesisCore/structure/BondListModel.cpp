@@ -26,6 +26,7 @@
 #include <CategoryUUID.hpp>
 #include <BondList.hpp>
 #include <Bond.hpp>
+#include <Atom.hpp>
 #include <PeriodicTable.hpp>
 #include <PhysicalQuantities.hpp>
 #include <PhysicalQuantity.hpp>
@@ -68,12 +69,12 @@ QObject* BondListModelCB(void* p_data)
 //==============================================================================
 
 CBondListModel::CBondListModel(QObject* p_parent)
-    : CContainerModel(&BondListModelObject,p_parent)
+    : CObjectListModel(&BondListModelObject,p_parent)
 {
     RootObject = NULL;
 
     connect(PQ_DISTANCE,SIGNAL(OnUnitChanged(void)),
-            this,SLOT(ListChanged(void)));
+            this,SLOT(UnitChanged(void)));
 }
 
 //------------------------------------------------------------------------------
@@ -97,21 +98,15 @@ void CBondListModel::SetRootObject(CBondList* p_data)
 
         if( RootObject->GetProject()->GetStructures() ){
             connect(RootObject->GetProject()->GetStructures(),SIGNAL(OnGeometryChangeTick(void)),
-                    this,SLOT(ListChanged(void)));
+                    this,SLOT(GeometryChanged(void)));
         }
     }
-    // FIXME
-    beginResetModel();
-    endResetModel();
-}
-
-//------------------------------------------------------------------------------
 
-QObject*  CBondListModel::GetItem(const QModelIndex& index) const
-{
-    if( ! index.isValid() ) return(NULL);
-    CBond* p_obj = static_cast<CBond*>(index.internalPointer());
-    return(p_obj);
+    if( RootObject != NULL ) {
+        ResetRows(RootObject->children());
+    } else {
+        ClearRows();
+    }
 }
 
 //==============================================================================
@@ -155,37 +150,6 @@ int CBondListModel::columnCount(const QModelIndex &parent) const
 
 //------------------------------------------------------------------------------
 
-int CBondListModel::rowCount(const QModelIndex &parent) const
-{
-    if( RootObject == 0 ) return(0);
-    return( RootObject->children().count() );
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CBondListModel::index(int row, int column,
-                                  const QModelIndex &parent) const
-{
-    if( RootObject == NULL ) return( QModelIndex() );
-
-    if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
-    if( parent.isValid() )  return( QModelIndex() );
-
-    QModelIndex index = createIndex(row, column, RootObject->children()[row]);
-
-    return(index);
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CBondListModel::parent(const QModelIndex &index) const
-{
-    // parent is always invalid
-    return( QModelIndex() );
-}
-
-//------------------------------------------------------------------------------
-
 QVariant CBondListModel::data(const QModelIndex &index, int role) const
 {
     if( RootObject == NULL ) return( QVariant() );
@@ -279,18 +243,57 @@ QMimeData* CBondListModel::mimeData(const QModelIndexList &indexes) const
 void CBondListModel::RootObjectDeleted(void)
 {
     RootObject = NULL;
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    ClearRows();
 }
 
 //------------------------------------------------------------------------------
 
 void CBondListModel::ListChanged(void)
 {
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    if( RootObject == NULL ) return;
+    UpdateRows(RootObject->children());
+}
+
+//------------------------------------------------------------------------------
+
+void CBondListModel::GeometryChanged(void)
+{
+    if( RootObject == NULL ) return;
+
+    CStructure*               p_str = RootObject->GetStructure();
+    const CGeometryChangeSet& changes = RootObject->GetProject()->GetStructures()->GetGeometryChanges();
+    if( changes.IsChanged(p_str) == false ) return;
+
+    // only bond lengths are changed
+    if( changes.AreAllAtomsChanged(p_str) ){
+        EmitRowsChanged(3,3);
+        return;
+    }
+
+    int first = -1;
+    int last = -1;
+    const QVector<int> ranges = changes.GetAtomRanges(p_str);
+    for(int i=0; i+1 < ranges.count(); i += 2){
+        for(int idx = ranges[i]; idx <= ranges[i+1]; idx++){
+            CAtom* p_atom = RootObject->GetProject()->FindObject<CAtom*>(idx);
+            if( p_atom == NULL ) continue;
+            foreach(CBond* p_bond, p_atom->GetBonds()){
+                int row = GetRowOfObject(p_bond->GetIndex());
+                if( row < 0 ) continue;
+                if( (first < 0) || (row < first) ) first = row;
+                if( row > last ) last = row;
+            }
+        }
+    }
+    EmitRowsChanged(first,last,3,3);
+}
+
+//------------------------------------------------------------------------------
+
+void CBondListModel::UnitChanged(void)
+{
+    emit headerDataChanged(Qt::Horizontal,0,columnCount(QModelIndex())-1);
+    EmitRowsChanged(0,columnCount(QModelIndex())-1);
 }
 
 //==============================================================================
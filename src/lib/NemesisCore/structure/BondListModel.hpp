@@ -24,7 +24,7 @@
 // =============================================================================
 
 #include <NemesisCoreMainHeader.hpp>
-#include <ContainerModel.hpp>
+#include <ObjectListModel.hpp>
 
 // -----------------------------------------------------------------------------
 
@@ -34,7 +34,7 @@ class CBond;
 
 // -----------------------------------------------------------------------------
 
-class NEMESIS_CORE_PACKAGE CBondListModel : public CContainerModel {
+class NEMESIS_CORE_PACKAGE CBondListModel : public CObjectListModel {
     Q_OBJECT
 public:
 // constructors and destructors -----------------------------------------------
@@ -43,9 +43,6 @@ public:
     /// set root object
     void SetRootObject(CBondList* p_data);
 
-    /// return object item from model index
-    virtual QObject* GetItem(const QModelIndex& index) const;
-
 // section of private data ----------------------------------------------------
 private:
     CBondList*    RootObject;
@@ -54,11 +51,6 @@ private:
                         int role = Qt::DisplayRole) const;
 
     int columnCount(const QModelIndex &parent) const;
-    int rowCount(const QModelIndex &parent) const;
-
-    QModelIndex index(int row, int column,
-                      const QModelIndex &parent) const;
-    QModelIndex parent(const QModelIndex &index) const;
 
     QVariant data(const QModelIndex &index, int role) const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
@@ -72,6 +64,8 @@ private:
 private slots:
     void RootObjectDeleted(void);
     void ListChanged(void);
+    void GeometryChanged(void);
+    void UnitChanged(void);
 };
 
 // -----------------------------------------------------------------------------
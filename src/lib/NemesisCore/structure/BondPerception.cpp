@@ -0,0 +1,283 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <ErrorSystem.hpp>
+#include <BondPerception.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <PBCInfo.hpp>
+#include <PeriodicTable.hpp>
+#include <QThreadPool>
+#include <QHash>
+
+//------------------------------------------------------------------------------
+
+// minimum distance between bonded atoms in A
+#define BOND_PERCEPTION_MIN_DISTANCE    0.4
+
+// default tolerance added to the sum of covalent radii in A
+#define BOND_PERCEPTION_TOLERANCE       0.45
+
+// number of cell blocks per thread
+#define BOND_PERCEPTION_JOBS_PER_THREAD 8
+
+// smaller structures are processed only by the calling thread
+#define BOND_PERCEPTION_MIN_PARALLEL    5000
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBondPerceptionWorker::CBondPerceptionWorker(CBondPerception* p_owner)
+{
+    Owner = p_owner;
+}
+
+//------------------------------------------------------------------------------
+
+void CBondPerceptionWorker::run(void)
+{
+    Owner->RunWorker();
+    Owner->WorkerFinished();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBondPerception::CBondPerception(void)
+{
+    SelectedOnly = false;
+    Tolerance = BOND_PERCEPTION_TOLERANCE;
+    NumOfTypes = 0;
+    Cutoff = 0.0;
+    NumOfJobs = 0;
+    NextJob = 0;
+    NumOfWorkers = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBondPerception::SetSelectedOnly(bool set)
+{
+    SelectedOnly = set;
+}
+
+//------------------------------------------------------------------------------
+
+void CBondPerception::SetTolerance(double tolerance)
+{
+    Tolerance = tolerance;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBondPerception::Perceive(CStructure* p_str)
+{
+    if( p_str == NULL ){
+        INVALID_ARGUMENT("p_str is NULL");
+    }
+
+    Bonds.clear();
+    Atoms.clear();
+    Types.clear();
+    Selected.clear();
+
+    // atoms and their elements ---------------------
+    QVector<CPoint>     positions;
+    QVector<int>        zs;
+    QHash<int,int>      slots;
+
+    foreach(QObject* p_qobj,p_str->GetAtoms()->children()){
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        if( p_atom->GetZ() <= 0 ) continue;
+
+        int slot = slots.value(p_atom->GetZ(),-1);
+        if( slot < 0 ){
+            slot = zs.count();
+            slots.insert(p_atom->GetZ(),slot);
+            zs.append(p_atom->GetZ());
+        }
+        Atoms.append(p_atom);
+        positions.append(p_atom->GetPos());
+        Types.append(slot);
+        // unselected atoms stay in the index, they can be bonded with selected ones
+        Selected.append(p_atom->IsFlagSet(EPOF_SELECTED));
+    }
+    if( Atoms.count() < 2 ) return;
+    if( SelectedOnly && (Selected.contains(true) == false) ) return;
+
+    // the longest bonds between elements -----------
+    NumOfTypes = zs.count();
+    MaxDist2.resize(NumOfTypes*NumOfTypes);
+    Cutoff = 0.0;
+    for(int i=0; i < NumOfTypes; i++){
+        for(int j=i; j < NumOfTypes; j++){
+            double dist = PeriodicTable.GetBondDistance(zs[i],zs[j]) + Tolerance;
+            if( dist > Cutoff ) Cutoff = dist;
+            MaxDist2[i*NumOfTypes+j] = dist*dist;
+            MaxDist2[j*NumOfTypes+i] = dist*dist;
+        }
+    }
+
+    Index.Build(Atoms,positions,p_str->PBCInfo);
+
+    // search cells in parallel ---------------------
+    int nworkers = 0;
+    if( Atoms.count() >= BOND_PERCEPTION_MIN_PARALLEL ){
+        nworkers = QThreadPool::globalInstance()->maxThreadCount();
+    }
+
+    JobMutex.lock();
+    NumOfJobs = (nworkers + 1)*BOND_PERCEPTION_JOBS_PER_THREAD;
+    if( NumOfJobs > Index.GetNumberOfCells() ) NumOfJobs = Index.GetNumberOfCells();
+    NextJob = 0;
+    NumOfWorkers = 0;
+    JobPairs.clear();
+    JobPairs.resize(NumOfJobs);
+    JobMutex.unlock();
+
+    // only idle threads are used, the calling thread does the rest
+    for(int i=0; i < nworkers; i++){
+        CBondPerceptionWorker* p_worker = new CBondPerceptionWorker(this);
+        JobMutex.lock();
+        NumOfWorkers++;
+        JobMutex.unlock();
+        if( QThreadPool::globalInstance()->tryStart(p_worker) == false ){
+            delete p_worker;
+            JobMutex.lock();
+            NumOfWorkers--;
+            JobMutex.unlock();
+            break;
+        }
+    }
+
+    RunWorker();
+
+    JobMutex.lock();
+    while( NumOfWorkers > 0 ){
+        WorkersDone.wait(&JobMutex);
+    }
+    JobMutex.unlock();
+
+    // collect results in the job order -------------
+    for(int job=0; job < JobPairs.count(); job++){
+        const QVector<int>& pairs = JobPairs[job];
+        for(int i=0; i+1 < pairs.count(); i += 2){
+            CAtom* p_a1 = Atoms[pairs[i]];
+            CAtom* p_a2 = Atoms[pairs[i+1]];
+            if( p_a1->IsBondedWith(p_a2) != NULL ) continue;
+            Bonds.append(p_a1);
+            Bonds.append(p_a2);
+        }
+    }
+
+    JobPairs.clear();
+    Selected.clear();
+    Index.Clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CBondPerception::RunWorker(void)
+{
+    for(;;){
+        JobMutex.lock();
+        int job = NextJob;
+        if( job < NumOfJobs ) NextJob++;
+        JobMutex.unlock();
+
+        if( job >= NumOfJobs ) break;
+        RunJob(job);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CBondPerception::RunJob(int job)
+{
+    int ncells = Index.GetNumberOfCells();
+    int first_cell = (qint64)ncells*job/NumOfJobs;
+    int last_cell = (qint64)ncells*(job+1)/NumOfJobs;
+
+    QVector<int>    pairs;
+    QVector<double> dist2;
+    Index.GetPairsInCells(first_cell,last_cell,Cutoff,pairs,dist2);
+
+    // keep only bonded atoms
+    double      min2 = BOND_PERCEPTION_MIN_DISTANCE*BOND_PERCEPTION_MIN_DISTANCE;
+    QVector<int> bonded;
+    for(int i=0; i < dist2.count(); i++){
+        int ia = pairs[2*i+0];
+        int ib = pairs[2*i+1];
+        if( SelectedOnly && (Selected[ia] == false) && (Selected[ib] == false) ) continue;
+        if( dist2[i] <= min2 ) continue;
+        if( dist2[i] > MaxDist2[Types[ia]*NumOfTypes+Types[ib]] ) continue;
+        bonded.append(ia);
+        bonded.append(ib);
+    }
+
+    JobMutex.lock();
+    JobPairs[job] = bonded;
+    JobMutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+
+void CBondPerception::WorkerFinished(void)
+{
+    JobMutex.lock();
+    NumOfWorkers--;
+    WorkersDone.wakeAll();
+    JobMutex.unlock();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CBondPerception::GetNumberOfBonds(void) const
+{
+    return(Bonds.count()/2);
+}
+
+//------------------------------------------------------------------------------
+
+CAtom* CBondPerception::GetFirstAtom(int bond) const
+{
+    return(Bonds[2*bond+0]);
+}
+
+//------------------------------------------------------------------------------
+
+CAtom* CBondPerception::GetSecondAtom(int bond) const
+{
+    return(Bonds[2*bond+1]);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,132 @@
+#ifndef BondPerceptionH
+#define BondPerceptionH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <SpatialIndex.hpp>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CAtom;
+class CBondPerception;
+
+// -----------------------------------------------------------------------------
+
+/// background worker of bond perception
+
+class NEMESIS_CORE_PACKAGE CBondPerceptionWorker : public QRunnable {
+public:
+// constructor -----------------------------------------------------------------
+    CBondPerceptionWorker(CBondPerception* p_owner);
+
+// section of private data -----------------------------------------------------
+private:
+    CBondPerception*    Owner;
+
+    /// executed from the thread pool
+    virtual void run(void);
+};
+
+// -----------------------------------------------------------------------------
+
+///  distance based perception of bond connectivity
+/*! two atoms are bonded if their distance is longer than the minimum distance
+    and not longer than the sum of covalent radii plus tolerance,
+    atoms are sorted into the cell list, blocks of cells are searched
+    in parallel by the global thread pool and the calling thread,
+    distances follow the minimum image convention if PBC is enabled,
+    bond orders are not perceived
+*/
+
+class NEMESIS_CORE_PACKAGE CBondPerception {
+public:
+// constructor -----------------------------------------------------------------
+    CBondPerception(void);
+
+// setup methods ---------------------------------------------------------------
+    /// consider only bonds with at least one selected atom
+    void SetSelectedOnly(bool set);
+
+    /// set tolerance added to the sum of covalent radii
+    void SetTolerance(double tolerance);
+
+// executive methods -----------------------------------------------------------
+    /// find bonded atoms of the structure
+    /*! atom positions are taken by GetPos, so the current snapshot is used,
+        pairs that are already bonded are skipped
+    */
+    void Perceive(CStructure* p_str);
+
+// information methods ---------------------------------------------------------
+    /// get number of perceived bonds
+    int GetNumberOfBonds(void) const;
+
+    /// get the first atom of the bond
+    CAtom* GetFirstAtom(int bond) const;
+
+    /// get the second atom of the bond
+    CAtom* GetSecondAtom(int bond) const;
+
+// section of private data -----------------------------------------------------
+private:
+    bool                SelectedOnly;
+    double              Tolerance;
+
+    // input data
+    CSpatialIndex       Index;
+    QVector<CAtom*>     Atoms;
+    QVector<int>        Types;          // element slot of each atom
+    QVector<bool>       Selected;       // selection status of each atom
+    int                 NumOfTypes;
+    QVector<double>     MaxDist2;       // square of the longest bond for slot pairs
+    double              Cutoff;
+
+    // results
+    QVector<CAtom*>     Bonds;          // pairs of bonded atoms
+
+    // parallel search
+    QMutex                  JobMutex;
+    QWaitCondition          WorkersDone;
+    int                     NumOfJobs;
+    int                     NextJob;
+    int                     NumOfWorkers;
+    QVector< QVector<int> > JobPairs;   // bonded atom indexes found in each job
+
+    /// worker main loop, it is also executed by the calling thread
+    void RunWorker(void);
+
+    /// search pairs in the block of cells
+    void RunJob(int job);
+
+    /// worker finished
+    void WorkerFinished(void);
+
+    friend class CBondPerceptionWorker;
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,207 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ErrorSystem.hpp>
+#include <SpatialIndex.hpp>
+#include <GeometryChangeSet.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <QPair>
+#include <algorithm>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CGeometryChangeSet::CStructureChanges::CStructureChanges(void)
+{
+    AllAtoms = false;
+    Sorted = true;
+}
+
+//------------------------------------------------------------------------------
+
+CGeometryChangeSet::CGeometryChangeSet(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CGeometryChangeSet::AddStructure(CStructure* p_str)
+{
+    if( p_str == NULL ) return;
+    CStructureChanges& changes = Structures[p_str->GetIndex()];
+    changes.AllAtoms = true;
+    changes.Sorted = true;
+    changes.Atoms.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CGeometryChangeSet::AddAtom(CAtom* p_atom)
+{
+    if( (p_atom == NULL) || (p_atom->GetStructure() == NULL) ) return;
+    CStructure* p_str = p_atom->GetStructure();
+    CStructureChanges& changes = Structures[p_str->GetIndex()];
+    if( changes.AllAtoms ) return;
+
+    int index = p_atom->GetIndex();
+    if( changes.Atoms.isEmpty() == false ){
+        // extend the last range if possible
+        int  first = changes.Atoms[changes.Atoms.count()-2];
+        int& last = changes.Atoms.last();
+        if( (index >= first) && (index <= last + 1) ){
+            if( index == last + 1 ) last++;
+            return;
+        }
+        if( index < first ) changes.Sorted = false;
+    }
+    changes.Atoms.append(index);
+    changes.Atoms.append(index);
+
+    // too many records - it is cheaper to update everything
+    if( changes.Atoms.count() > 2*p_str->GetAtoms()->GetNumberOfAtoms() ){
+        changes.AllAtoms = true;
+        changes.Sorted = true;
+        changes.Atoms.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CGeometryChangeSet::Finalize(void)
+{
+    QHash<int,CStructureChanges>::iterator it = Structures.begin();
+    QHash<int,CStructureChanges>::iterator ie = Structures.end();
+
+    while( it != ie ){
+        CStructureChanges& changes = it.value();
+        it++;
+        if( changes.Sorted ) continue;
+
+        // sort ranges by their first index and merge overlapping ones
+        QVector< QPair<int,int> > ranges;
+        ranges.reserve(changes.Atoms.count()/2);
+        for(int i=0; i+1 < changes.Atoms.count(); i+=2){
+            ranges.append(QPair<int,int>(changes.Atoms[i],changes.Atoms[i+1]));
+        }
+        std::sort(ranges.begin(),ranges.end());
+
+        changes.Atoms.clear();
+        for(int i=0; i < ranges.count(); i++){
+            if( (changes.Atoms.isEmpty() == false) && (ranges[i].first <= changes.Atoms.last() + 1) ){
+                changes.Atoms.last() = qMax(changes.Atoms.last(),ranges[i].second);
+                continue;
+            }
+            changes.Atoms.append(ranges[i].first);
+            changes.Atoms.append(ranges[i].second);
+        }
+        changes.Sorted = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CGeometryChangeSet::Clear(void)
+{
+    Structures.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CGeometryChangeSet::IsEmpty(void) const
+{
+    return(Structures.isEmpty());
+}
+
+//------------------------------------------------------------------------------
+
+bool CGeometryChangeSet::IsChanged(CStructure* p_str) const
+{
+    if( p_str == NULL ) return(false);
+    return(Structures.contains(p_str->GetIndex()));
+}
+
+//------------------------------------------------------------------------------
+
+bool CGeometryChangeSet::IsChanged(CAtom* p_atom) const
+{
+    if( (p_atom == NULL) || (p_atom->GetStructure() == NULL) ) return(false);
+
+    QHash<int,CStructureChanges>::const_iterator it = Structures.constFind(p_atom->GetStructure()->GetIndex());
+    if( it == Structures.constEnd() ) return(false);
+
+    const CStructureChanges& changes = it.value();
+    if( changes.AllAtoms ) return(true);
+
+    int index = p_atom->GetIndex();
+    if( changes.Sorted ){
+        // binary search over the sorted ranges
+        int left = 0;
+        int right = changes.Atoms.count()/2 - 1;
+        while( left <= right ){
+            int mid = (left + right)/2;
+            if( index < changes.Atoms[2*mid] ){
+                right = mid - 1;
+            } else if( index > changes.Atoms[2*mid+1] ){
+                left = mid + 1;
+            } else {
+                return(true);
+            }
+        }
+        return(false);
+    }
+
+    for(int i=0; i+1 < changes.Atoms.count(); i+=2){
+        if( (index >= changes.Atoms[i]) && (index <= changes.Atoms[i+1]) ) return(true);
+    }
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+bool CGeometryChangeSet::AreAllAtomsChanged(CStructure* p_str) const
+{
+    if( p_str == NULL ) return(false);
+
+    QHash<int,CStructureChanges>::const_iterator it = Structures.constFind(p_str->GetIndex());
+    if( it == Structures.constEnd() ) return(false);
+    return(it.value().AllAtoms);
+}
+
+//------------------------------------------------------------------------------
+
+const QVector<int> CGeometryChangeSet::GetAtomRanges(CStructure* p_str) const
+{
+    if( p_str == NULL ) return(QVector<int>());
+
+    QHash<int,CStructureChanges>::const_iterator it = Structures.constFind(p_str->GetIndex());
+    if( it == Structures.constEnd() ) return(QVector<int>());
+    return(it.value().Atoms);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
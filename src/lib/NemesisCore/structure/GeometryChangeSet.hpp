@@ -0,0 +1,90 @@
+#ifndef GeometryChangeSetH
+#define GeometryChangeSetH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QVector>
+#include <QHash>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CAtom;
+
+// -----------------------------------------------------------------------------
+
+///  structures and atoms with changed geometry
+/*! objects are identified by their indexes, so the set remains valid
+    if they are destroyed before the change is delivered, atoms are
+    described by ranges of atom indexes, see CStructureList::GetGeometryChanges
+*/
+
+class NEMESIS_CORE_PACKAGE CGeometryChangeSet {
+public:
+// constructor -----------------------------------------------------------------
+    CGeometryChangeSet(void);
+
+// executive methods -----------------------------------------------------------
+    /// mark all atoms of the structure as changed
+    void AddStructure(CStructure* p_str);
+
+    /// mark the atom as changed
+    void AddAtom(CAtom* p_atom);
+
+    /// merge atom indexes into sorted ranges
+    void Finalize(void);
+
+    /// remove all changes
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// is the set empty?
+    bool IsEmpty(void) const;
+
+    /// is any atom of the structure changed?
+    bool IsChanged(CStructure* p_str) const;
+
+    /// is the atom changed?
+    bool IsChanged(CAtom* p_atom) const;
+
+    /// are all atoms of the structure changed?
+    bool AreAllAtomsChanged(CStructure* p_str) const;
+
+    /// get ranges of changed atom indexes as [first,last] pairs
+    /*! the set must be finalized, ranges are empty if all atoms are changed */
+    const QVector<int> GetAtomRanges(CStructure* p_str) const;
+
+// section of private data -----------------------------------------------------
+private:
+    class CStructureChanges {
+    public:
+        CStructureChanges(void);
+        bool            AllAtoms;
+        bool            Sorted;
+        QVector<int>    Atoms;      // atom indexes, [first,last] pairs when sorted
+    };
+
+    QHash<int,CStructureChanges>    Structures;
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -515,6 +515,18 @@ const CPoint CPBCInfo::ImageVector(const CPoint& vec)
     return(ipos);
 }
 
+//------------------------------------------------------------------------------
+
+const CPoint CPBCInfo::FractionalVector(const CPoint& vec) const
+{
+    CPoint fvec;
+    if( ! IsPBCEnabled() ) return(fvec);
+    fvec.x = vec.x*RECIP[0][0] + vec.y*RECIP[0][1] + vec.z*RECIP[0][2];
+    fvec.y = vec.x*RECIP[1][0] + vec.y*RECIP[1][1] + vec.z*RECIP[1][2];
+    fvec.z = vec.x*RECIP[2][0] + vec.y*RECIP[2][1] + vec.z*RECIP[2][2];
+    return(fvec);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
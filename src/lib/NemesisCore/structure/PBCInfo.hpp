@@ -122,6 +122,9 @@ public:
     /// image vector
     const CPoint ImageVector(const CPoint& vec);
 
+    /// convert vector to fractional coordinates
+    const CPoint FractionalVector(const CPoint& vec) const;
+
 // input/output methods -------------------------------------------------------
     /// load box setup
     void LoadData(CXMLElement* p_ele);
@@ -26,6 +26,7 @@
 #include <ErrorSystem.hpp>
 #include <XMLElement.hpp>
 #include <Structure.hpp>
+#include <StructureList.hpp>
 #include <ResidueHistory.hpp>
 #include <OpenBabelUtils.hpp>
 #include <AtomList.hpp>
@@ -764,6 +765,17 @@ void CResidue::SetDescription(const QString& descrip,CHistoryNode* p_history)
 
 //------------------------------------------------------------------------------
 
+void CResidue::SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history)
+{
+    if( GetFlags() == flags ) return;
+    CProObject::SetFlags(flags,p_history);
+    if( GetStructure() && GetStructure()->GetStructures() ){
+        GetStructure()->GetStructures()->EmitOnObjectFlagsChanged();
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void CResidue::SetSeqIndex(int seqidx,CHistoryNode* p_history)
 {
     if( SeqIndex == seqidx ) return;
@@ -152,6 +152,9 @@ public:
     /// set description
     virtual void SetDescription(const QString& descrip,CHistoryNode* p_history=NULL);
 
+    /// set flags
+    virtual void SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history=NULL);
+
     /// set sequential index
     void SetSeqIndex(int seqidx,CHistoryNode* p_history=NULL);
 
@@ -225,6 +228,9 @@ private:
 
     friend class CResidueModel;
     friend class CResidueAtomOrderHistoryNode;
+    friend class CStructureBulkData;
+    friend class CSuperCellBuilder;
+    friend class CAtomList;
 };
 
 // -----------------------------------------------------------------------------
@@ -63,7 +63,7 @@ QObject* ResidueListModelCB(void* p_data)
 //==============================================================================
 
 CResidueListModel::CResidueListModel(QObject* p_parent)
-    : CContainerModel(&ResidueListModelObject,p_parent)
+    : CObjectListModel(&ResidueListModelObject,p_parent)
 {
     RootObject = NULL;
 }
@@ -85,18 +85,12 @@ void CResidueListModel::SetRootObject(CResidueList* p_data)
                 this,SLOT(ResidueListChanged(void)));
 
     }
-    // FIXME
-    beginResetModel();
-    endResetModel();
-}
-
-//------------------------------------------------------------------------------
 
-QObject*  CResidueListModel::GetItem(const QModelIndex& index) const
-{
-    if( ! index.isValid() ) return(NULL);
-    CResidue* p_obj = static_cast<CResidue*>(index.internalPointer());
-    return(p_obj);
+    if( RootObject != NULL ) {
+        ResetRows(RootObject->children());
+    } else {
+        ClearRows();
+    }
 }
 
 //==============================================================================
@@ -137,37 +131,6 @@ int CResidueListModel::columnCount(const QModelIndex &parent) const
 
 //------------------------------------------------------------------------------
 
-int CResidueListModel::rowCount(const QModelIndex &parent) const
-{
-    if( RootObject == 0 ) return(0);
-    return( RootObject->children().count() );
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CResidueListModel::index(int row, int column,
-                                  const QModelIndex &parent) const
-{
-    if( RootObject == NULL ) return( QModelIndex() );
-
-    if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
-    if( parent.isValid() )  return( QModelIndex() );
-
-    QModelIndex index = createIndex(row, column, RootObject->children()[row]);
-
-    return(index);
-}
-
-//------------------------------------------------------------------------------
-
-QModelIndex CResidueListModel::parent(const QModelIndex &index) const
-{
-    // parent is always invalid
-    return( QModelIndex() );
-}
-
-//------------------------------------------------------------------------------
-
 QVariant CResidueListModel::data(const QModelIndex &index, int role) const
 {
     if( RootObject == NULL ) return( QVariant() );
@@ -262,18 +225,15 @@ QMimeData* CResidueListModel::mimeData(const QModelIndexList &indexes) const
 void CResidueListModel::RootObjectDeleted(void)
 {
     RootObject = NULL;
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    ClearRows();
 }
 
 //------------------------------------------------------------------------------
 
 void CResidueListModel::ResidueListChanged(void)
 {
-    // FIXME
-    beginResetModel();
-    endResetModel();
+    if( RootObject == NULL ) return;
+    UpdateRows(RootObject->children());
 }
 
 //==============================================================================
@@ -21,7 +21,7 @@
 // =============================================================================
 
 #include <NemesisCoreMainHeader.hpp>
-#include <ContainerModel.hpp>
+#include <ObjectListModel.hpp>
 
 // -----------------------------------------------------------------------------
 
@@ -31,7 +31,7 @@ class CResidue;
 
 // -----------------------------------------------------------------------------
 
-class NEMESIS_CORE_PACKAGE CResidueListModel : public CContainerModel {
+class NEMESIS_CORE_PACKAGE CResidueListModel : public CObjectListModel {
     Q_OBJECT
 public:
 // constructors and destructors -----------------------------------------------
@@ -40,9 +40,6 @@ public:
     /// set root object
     void SetRootObject(CResidueList* p_data);
 
-    /// return object item from model index
-    virtual QObject* GetItem(const QModelIndex& index) const;
-
 // section of private data ----------------------------------------------------
 private:
     CResidueList*    RootObject;
@@ -51,11 +48,6 @@ private:
                         int role = Qt::DisplayRole) const;
 
     int columnCount(const QModelIndex &parent) const;
-    int rowCount(const QModelIndex &parent) const;
-
-    QModelIndex index(int row, int column,
-                      const QModelIndex &parent) const;
-    QModelIndex parent(const QModelIndex &index) const;
 
     QVariant data(const QModelIndex &index, int role) const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
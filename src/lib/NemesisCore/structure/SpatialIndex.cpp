@@ -0,0 +1,514 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ErrorSystem.hpp>
+#include <SpatialIndex.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <PBCInfo.hpp>
+#include <QPair>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//------------------------------------------------------------------------------
+
+// average number of atoms in one cell
+#define SPATIAL_INDEX_ATOMS_PER_CELL    4
+
+// minimum cell size in A
+#define SPATIAL_INDEX_MIN_CELL_SIZE     2.0
+
+// maximum number of cells along one direction
+#define SPATIAL_INDEX_MAX_CELLS         256
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSpatialIndex::CSpatialIndex(void)
+{
+    Clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSpatialIndex::Build(CStructure* p_str)
+{
+    Clear();
+    if( (p_str == NULL) || (p_str->GetAtoms() == NULL) ) return;
+
+    int natoms = p_str->GetAtoms()->GetNumberOfAtoms();
+
+    QVector<CAtom*> atoms;
+    QVector<CPoint> positions;
+    atoms.reserve(natoms);
+    positions.reserve(natoms);
+
+    // get position via GetPos - it also consider trajectory if it is attached
+    foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        atoms.append(p_atom);
+        positions.append(p_atom->GetPos());
+    }
+
+    Build(atoms,positions,p_str->PBCInfo);
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::Build(const QVector<CAtom*>& atoms,const QVector<CPoint>& positions,
+                          const CPBCInfo& pbc)
+{
+    Clear();
+    if( atoms.count() != positions.count() ){
+        INVALID_ARGUMENT("atoms and positions differ in size");
+    }
+
+    int natoms = atoms.count();
+    Atoms = atoms;
+
+    // box ------------------------------------------
+    PBCEnabled = pbc.IsPBCEnabled();
+    PBCSizes = pbc.GetSizes();
+    PBCAngles = pbc.GetAngles();
+
+    if( PBCEnabled ){
+        CPoint vec[3];
+        vec[0] = pbc.GetAVector();
+        vec[1] = pbc.GetBVector();
+        vec[2] = pbc.GetCVector();
+        for(int k=0; k < 3; k++){
+            Box[0][k] = vec[k].x;
+            Box[1][k] = vec[k].y;
+            Box[2][k] = vec[k].z;
+        }
+        Periodic[0] = pbc.IsPeriodicAlongA();
+        Periodic[1] = pbc.IsPeriodicAlongB();
+        Periodic[2] = pbc.IsPeriodicAlongC();
+        Origin = CPoint();
+    } else {
+        // bounding box of atoms
+        CPoint min_pos, max_pos;
+        if( natoms > 0 ){
+            min_pos = positions[0];
+            max_pos = positions[0];
+        }
+        for(int i=1; i < natoms; i++){
+            const CPoint& pos = positions[i];
+            if( pos.x < min_pos.x ) min_pos.x = pos.x;
+            if( pos.y < min_pos.y ) min_pos.y = pos.y;
+            if( pos.z < min_pos.z ) min_pos.z = pos.z;
+            if( pos.x > max_pos.x ) max_pos.x = pos.x;
+            if( pos.y > max_pos.y ) max_pos.y = pos.y;
+            if( pos.z > max_pos.z ) max_pos.z = pos.z;
+        }
+        CPoint sizes = max_pos - min_pos;
+        memset(Box,0,sizeof(Box));
+        Box[0][0] = sizes.x > 1.0 ? sizes.x : 1.0;
+        Box[1][1] = sizes.y > 1.0 ? sizes.y : 1.0;
+        Box[2][2] = sizes.z > 1.0 ? sizes.z : 1.0;
+        Origin = min_pos;
+    }
+
+    // inverse box
+    double det = Box[0][0]*(Box[1][1]*Box[2][2] - Box[1][2]*Box[2][1])
+               - Box[0][1]*(Box[1][0]*Box[2][2] - Box[1][2]*Box[2][0])
+               + Box[0][2]*(Box[1][0]*Box[2][1] - Box[1][1]*Box[2][0]);
+
+    InvBox[0][0] =  (Box[1][1]*Box[2][2] - Box[1][2]*Box[2][1])/det;
+    InvBox[0][1] = -(Box[0][1]*Box[2][2] - Box[0][2]*Box[2][1])/det;
+    InvBox[0][2] =  (Box[0][1]*Box[1][2] - Box[0][2]*Box[1][1])/det;
+    InvBox[1][0] = -(Box[1][0]*Box[2][2] - Box[1][2]*Box[2][0])/det;
+    InvBox[1][1] =  (Box[0][0]*Box[2][2] - Box[0][2]*Box[2][0])/det;
+    InvBox[1][2] = -(Box[0][0]*Box[1][2] - Box[0][2]*Box[1][0])/det;
+    InvBox[2][0] =  (Box[1][0]*Box[2][1] - Box[1][1]*Box[2][0])/det;
+    InvBox[2][1] = -(Box[0][0]*Box[2][1] - Box[0][1]*Box[2][0])/det;
+    InvBox[2][2] =  (Box[0][0]*Box[1][1] - Box[0][1]*Box[1][0])/det;
+
+    // cells ----------------------------------------
+    double cell_size = SPATIAL_INDEX_MIN_CELL_SIZE;
+    if( natoms > 0 ){
+        double size = pow(fabs(det)*SPATIAL_INDEX_ATOMS_PER_CELL/natoms,1.0/3.0);
+        if( size > cell_size ) cell_size = size;
+    }
+
+    int ncells = 1;
+    for(int k=0; k < 3; k++){
+        // distance between box faces
+        double width = 1.0/sqrt(InvBox[k][0]*InvBox[k][0] + InvBox[k][1]*InvBox[k][1]
+                                + InvBox[k][2]*InvBox[k][2]);
+        int n = (int)(width/cell_size);
+        if( n < 1 ) n = 1;
+        if( n > SPATIAL_INDEX_MAX_CELLS ) n = SPATIAL_INDEX_MAX_CELLS;
+        NumOfCells[k] = n;
+        CellWidth[k] = width / n;
+        ncells *= n;
+    }
+
+    // sort atoms into cells
+    Frac.resize(natoms);
+    QVector<int> cells(natoms);
+    CellStart.fill(0,ncells+1);
+
+    for(int i=0; i < natoms; i++){
+        Frac[i] = GetFractional(positions[i]);
+        int cell = (GetCellIndex(Frac[i].x,0)*NumOfCells[1]
+                    + GetCellIndex(Frac[i].y,1))*NumOfCells[2] + GetCellIndex(Frac[i].z,2);
+        cells[i] = cell;
+        CellStart[cell+1]++;
+    }
+    for(int i=0; i < ncells; i++){
+        CellStart[i+1] += CellStart[i];
+    }
+
+    CellAtoms.resize(natoms);
+    QVector<int> fill = CellStart;
+    for(int i=0; i < natoms; i++){
+        CellAtoms[fill[cells[i]]++] = i;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::Clear(void)
+{
+    Atoms.clear();
+    Frac.clear();
+    CellStart.clear();
+    CellAtoms.clear();
+
+    PBCEnabled = false;
+    PBCSizes = CPoint();
+    PBCAngles = CPoint();
+    Origin = CPoint();
+    for(int k=0; k < 3; k++){
+        Periodic[k] = false;
+        NumOfCells[k] = 1;
+        CellWidth[k] = 1.0;
+        for(int l=0; l < 3; l++){
+            Box[k][l] = k == l ? 1.0 : 0.0;
+            InvBox[k][l] = k == l ? 1.0 : 0.0;
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSpatialIndex::GetAtomsInSphere(const CPoint& pos,double radius,QVector<CAtom*>& atoms) const
+{
+    atoms.clear();
+    if( radius < 0 ) return;
+
+    QVector<int>    indexes;
+    QVector<double> dist2;
+    ScanSphere(pos,radius,false,indexes,dist2);
+
+    atoms.reserve(indexes.count());
+    foreach(int index, indexes){
+        atoms.append(Atoms[index]);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::GetIndexesInSphere(const CPoint& pos,double radius,QVector<int>& indexes) const
+{
+    indexes.clear();
+    if( radius < 0 ) return;
+
+    QVector<double> dist2;
+    ScanSphere(pos,radius,false,indexes,dist2);
+}
+
+//------------------------------------------------------------------------------
+
+bool CSpatialIndex::IsAnyAtomInSphere(const CPoint& pos,double radius) const
+{
+    if( radius < 0 ) return(false);
+
+    QVector<int>    indexes;
+    QVector<double> dist2;
+    ScanSphere(pos,radius,true,indexes,dist2);
+
+    return(indexes.count() > 0);
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::GetNearestAtoms(const CPoint& pos,int k,QVector<CAtom*>& atoms) const
+{
+    atoms.clear();
+    if( (k <= 0) || Atoms.isEmpty() ) return;
+    if( k > Atoms.count() ) k = Atoms.count();
+
+    QVector<int>    indexes;
+    QVector<double> dist2;
+
+    // enlarge the sphere until it contains enough atoms
+    double radius = std::min(CellWidth[0],std::min(CellWidth[1],CellWidth[2]));
+    for(;;){
+        bool all_cells = ScanSphere(pos,radius,false,indexes,dist2);
+        if( indexes.count() >= k ) break;
+        if( all_cells ){
+            // atoms are out of the sphere, take them all
+            ScanSphere(pos,-1.0,false,indexes,dist2);
+            break;
+        }
+        radius *= 2.0;
+    }
+
+    QVector< QPair<double,int> > sorted;
+    sorted.reserve(indexes.count());
+    for(int i=0; i < indexes.count(); i++){
+        sorted.append(QPair<double,int>(dist2[i],indexes[i]));
+    }
+    std::partial_sort(sorted.begin(),sorted.begin()+k,sorted.end());
+
+    atoms.reserve(k);
+    for(int i=0; i < k; i++){
+        atoms.append(Atoms[sorted[i].second]);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+double CSpatialIndex::GetDistance2(const CPoint& pos1,const CPoint& pos2) const
+{
+    return(GetFracDistance2(GetFractional(pos1),GetFractional(pos2)));
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::GetPairsInCells(int first_cell,int last_cell,double cutoff,
+                                    QVector<int>& pairs,QVector<double>& dist2) const
+{
+    if( Atoms.isEmpty() || (cutoff < 0) ) return;
+    if( first_cell < 0 ) first_cell = 0;
+    if( last_cell > CellStart.count() - 1 ) last_cell = CellStart.count() - 1;
+
+    double r2 = cutoff*cutoff;
+
+    for(int cell=first_cell; cell < last_cell; cell++){
+        if( CellStart[cell] == CellStart[cell+1] ) continue;
+
+        // neighbouring cells
+        int cc[3];
+        cc[2] = cell % NumOfCells[2];
+        cc[1] = (cell / NumOfCells[2]) % NumOfCells[1];
+        cc[0] = cell / (NumOfCells[2]*NumOfCells[1]);
+
+        int first[3], last[3];
+        for(int k=0; k < 3; k++){
+            GetCellRange(cc[k],cutoff,k,first[k],last[k]);
+        }
+
+        for(int i=first[0]; i <= last[0]; i++){
+            int ci = ((i % NumOfCells[0]) + NumOfCells[0]) % NumOfCells[0];
+            for(int j=first[1]; j <= last[1]; j++){
+                int cj = ((j % NumOfCells[1]) + NumOfCells[1]) % NumOfCells[1];
+                for(int l=first[2]; l <= last[2]; l++){
+                    int cl = ((l % NumOfCells[2]) + NumOfCells[2]) % NumOfCells[2];
+                    int ncell = (ci*NumOfCells[1] + cj)*NumOfCells[2] + cl;
+
+                    for(int a=CellStart[cell]; a < CellStart[cell+1]; a++){
+                        int ia = CellAtoms[a];
+                        for(int b=CellStart[ncell]; b < CellStart[ncell+1]; b++){
+                            int ib = CellAtoms[b];
+                            if( ib <= ia ) continue;
+                            double d2 = GetFracDistance2(Frac[ia],Frac[ib]);
+                            if( d2 >= r2 ) continue;
+                            pairs.append(ia);
+                            pairs.append(ib);
+                            dist2.append(d2);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CSpatialIndex::GetNumberOfAtoms(void) const
+{
+    return(Atoms.count());
+}
+
+//------------------------------------------------------------------------------
+
+int CSpatialIndex::GetNumberOfCells(void) const
+{
+    return(NumOfCells[0]*NumOfCells[1]*NumOfCells[2]);
+}
+
+//------------------------------------------------------------------------------
+
+bool CSpatialIndex::IsBuiltFor(const CPBCInfo& pbc) const
+{
+    if( PBCEnabled != pbc.IsPBCEnabled() ) return(false);
+    if( PBCEnabled == false ) return(true);
+
+    if( Periodic[0] != pbc.IsPeriodicAlongA() ) return(false);
+    if( Periodic[1] != pbc.IsPeriodicAlongB() ) return(false);
+    if( Periodic[2] != pbc.IsPeriodicAlongC() ) return(false);
+
+    return( (PBCSizes == pbc.GetSizes()) && (PBCAngles == pbc.GetAngles()) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+const CPoint CSpatialIndex::GetFractional(const CPoint& pos) const
+{
+    CPoint d = pos - Origin;
+    CPoint f;
+    f.x = InvBox[0][0]*d.x + InvBox[0][1]*d.y + InvBox[0][2]*d.z;
+    f.y = InvBox[1][0]*d.x + InvBox[1][1]*d.y + InvBox[1][2]*d.z;
+    f.z = InvBox[2][0]*d.x + InvBox[2][1]*d.y + InvBox[2][2]*d.z;
+
+    if( Periodic[0] ) f.x -= floor(f.x);
+    if( Periodic[1] ) f.y -= floor(f.y);
+    if( Periodic[2] ) f.z -= floor(f.z);
+
+    return(f);
+}
+
+//------------------------------------------------------------------------------
+
+int CSpatialIndex::GetCellIndex(double f,int dir) const
+{
+    // atoms out of the box are in the border cells
+    int n = NumOfCells[dir];
+    double c = floor(f*n);
+    if( c < 0 ) return(0);
+    if( c >= n ) return(n-1);
+    return((int)c);
+}
+
+//------------------------------------------------------------------------------
+
+double CSpatialIndex::GetFracDistance2(const CPoint& f1,const CPoint& f2) const
+{
+    double d[3];
+    d[0] = f2.x - f1.x;
+    d[1] = f2.y - f1.y;
+    d[2] = f2.z - f1.z;
+
+    // minimum image
+    for(int k=0; k < 3; k++){
+        if( Periodic[k] ) d[k] -= floor(d[k] + 0.5);
+    }
+
+    double v[3];
+    for(int k=0; k < 3; k++){
+        v[k] = Box[k][0]*d[0] + Box[k][1]*d[1] + Box[k][2]*d[2];
+    }
+
+    return(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+}
+
+//------------------------------------------------------------------------------
+
+bool CSpatialIndex::ScanSphere(const CPoint& pos,double radius,bool first_only,
+                               QVector<int>& indexes,QVector<double>& dist2) const
+{
+    indexes.clear();
+    dist2.clear();
+    if( Atoms.isEmpty() ) return(true);
+
+    CPoint  fpos = GetFractional(pos);
+    int     first[3], last[3];
+    bool    all_cells = true;
+
+    GetCellRange(GetCellIndex(fpos.x,0),radius,0,first[0],last[0]);
+    GetCellRange(GetCellIndex(fpos.y,1),radius,1,first[1],last[1]);
+    GetCellRange(GetCellIndex(fpos.z,2),radius,2,first[2],last[2]);
+    for(int k=0; k < 3; k++){
+        if( last[k] - first[k] + 1 < NumOfCells[k] ) all_cells = false;
+    }
+
+    double r2 = radius*radius;
+
+    for(int i=first[0]; i <= last[0]; i++){
+        int ci = ((i % NumOfCells[0]) + NumOfCells[0]) % NumOfCells[0];
+        for(int j=first[1]; j <= last[1]; j++){
+            int cj = ((j % NumOfCells[1]) + NumOfCells[1]) % NumOfCells[1];
+            for(int l=first[2]; l <= last[2]; l++){
+                int cl = ((l % NumOfCells[2]) + NumOfCells[2]) % NumOfCells[2];
+                int cell = (ci*NumOfCells[1] + cj)*NumOfCells[2] + cl;
+
+                for(int a=CellStart[cell]; a < CellStart[cell+1]; a++){
+                    int     index = CellAtoms[a];
+                    double  d2 = GetFracDistance2(fpos,Frac[index]);
+                    if( (radius >= 0) && (d2 >= r2) ) continue;
+                    indexes.append(index);
+                    dist2.append(d2);
+                    if( first_only ) return(all_cells);
+                }
+            }
+        }
+    }
+
+    return(all_cells);
+}
+
+//------------------------------------------------------------------------------
+
+void CSpatialIndex::GetCellRange(int cell,double radius,int dir,int& first,int& last) const
+{
+    int n = NumOfCells[dir];
+
+    if( radius < 0 ){
+        first = 0;
+        last = n-1;
+        return;
+    }
+
+    int m = (int)ceil(radius/CellWidth[dir]);
+    if( Periodic[dir] ){
+        // do not visit cells twice
+        if( 2*m+1 >= n ){
+            first = 0;
+            last = n-1;
+        } else {
+            first = cell - m;
+            last = cell + m;
+        }
+    } else {
+        first = cell - m;
+        if( first < 0 ) first = 0;
+        last = cell + m;
+        if( last >= n ) last = n-1;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
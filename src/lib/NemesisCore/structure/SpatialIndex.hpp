@@ -0,0 +1,135 @@
+#ifndef SpatialIndexH
+#define SpatialIndexH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Point.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CAtom;
+class CPBCInfo;
+
+// -----------------------------------------------------------------------------
+
+///  uniform cell list of structure atoms
+/*! atoms are sorted into cells in fractional coordinates of the box,
+    distances are evaluated by the minimum image convention along periodic
+    directions, the bounding box of atoms is used if PBC is not enabled,
+    use CStructure::GetSpatialIndex() to get the up-to-date index
+*/
+
+class NEMESIS_CORE_PACKAGE CSpatialIndex {
+public:
+// constructor -----------------------------------------------------------------
+    CSpatialIndex(void);
+
+// executive methods -----------------------------------------------------------
+    /// build index from all atoms of the structure
+    void Build(CStructure* p_str);
+
+    /// build index from atoms and their positions, e.g. taken from a snapshot
+    void Build(const QVector<CAtom*>& atoms,const QVector<CPoint>& positions,
+               const CPBCInfo& pbc);
+
+    /// destroy index
+    void Clear(void);
+
+// queries ---------------------------------------------------------------------
+    /// get atoms closer than radius to the point
+    void GetAtomsInSphere(const CPoint& pos,double radius,QVector<CAtom*>& atoms) const;
+
+    /// get indexes of atoms closer than radius to the point
+    /*! indexes refer to the order of CAtomList children at the time of build
+    */
+    void GetIndexesInSphere(const CPoint& pos,double radius,QVector<int>& indexes) const;
+
+    /// is any atom closer than radius to the point?
+    bool IsAnyAtomInSphere(const CPoint& pos,double radius) const;
+
+    /// get k nearest atoms, atoms are sorted by distance
+    void GetNearestAtoms(const CPoint& pos,int k,QVector<CAtom*>& atoms) const;
+
+    /// get square of distance between two points
+    double GetDistance2(const CPoint& pos1,const CPoint& pos2) const;
+
+    /// get pairs of atoms closer than cutoff
+    /*! the first atom of each pair is from cells in the range [first_cell,last_cell),
+        each pair is reported only once as indexes i < j, see GetIndexesInSphere,
+        pairs of indexes and their square distances are appended to vectors,
+        the index is not changed, thus cell ranges can be processed in parallel
+    */
+    void GetPairsInCells(int first_cell,int last_cell,double cutoff,
+                         QVector<int>& pairs,QVector<double>& dist2) const;
+
+// information methods ---------------------------------------------------------
+    /// get number of indexed atoms
+    int GetNumberOfAtoms(void) const;
+
+    /// get number of cells
+    int GetNumberOfCells(void) const;
+
+    /// was index built for this box?
+    bool IsBuiltFor(const CPBCInfo& pbc) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QVector<CAtom*> Atoms;
+    QVector<CPoint> Frac;           // fractional coordinates of atoms
+    QVector<int>    CellStart;      // the first atom of each cell in CellAtoms
+    QVector<int>    CellAtoms;      // atom indexes sorted by cells
+    bool            PBCEnabled;
+    bool            Periodic[3];
+    CPoint          PBCSizes;       // box setup used to build the index
+    CPoint          PBCAngles;
+    CPoint          Origin;
+    double          Box[3][3];      // box vectors in columns
+    double          InvBox[3][3];
+    int             NumOfCells[3];
+    double          CellWidth[3];   // distances between cell faces
+
+    /// convert point into fractional coordinates
+    const CPoint GetFractional(const CPoint& pos) const;
+
+    /// get cell index along direction
+    int GetCellIndex(double f,int dir) const;
+
+    /// get square of distance between fractional points
+    double GetFracDistance2(const CPoint& f1,const CPoint& f2) const;
+
+    /// visit atoms in cells overlapping the sphere
+    /*! atoms closer than radius are returned with their distances,
+        all atoms are returned if radius is negative,
+        the search is stopped after the first atom found if first_only is true,
+        it returns true if all cells were visited
+    */
+    bool ScanSphere(const CPoint& pos,double radius,bool first_only,
+                    QVector<int>& indexes,QVector<double>& dist2) const;
+
+    /// get range of cells along direction
+    void GetCellRange(int cell,double radius,int dir,int& first,int& last) const;
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
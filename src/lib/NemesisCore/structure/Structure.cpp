@@ -40,6 +40,17 @@
 #include <HistoryNode.hpp>
 #include <vector>
 #include <Trajectory.hpp>
+#include <BinProjectFile.hpp>
+#include <StructureBulkData.hpp>
+#include <SuperCellBuilder.hpp>
+#include <AtomListHistory.hpp>
+#include <SpatialIndex.hpp>
+#include <Bond.hpp>
+#include <QSet>
+#include <QHash>
+#include <QMutexLocker>
+#include <AtomData.hpp>
+#include <BondData.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -71,6 +82,9 @@ CStructure::CStructure(CStructureList* p_list)
 
     GeometryUpdateLevel=0;
     SeqIndex = 1;
+
+    SpatialIndex = NULL;
+    SpatialIndexValid.storeRelease(0);
 }
 
 //------------------------------------------------------------------------------
@@ -88,6 +102,9 @@ CStructure::CStructure(CProject* p_project)
 
     GeometryUpdateLevel=0;
     SeqIndex = 1;
+
+    SpatialIndex = NULL;
+    SpatialIndexValid.storeRelease(0);
 }
 
 //------------------------------------------------------------------------------
@@ -131,6 +148,9 @@ CStructure::~CStructure(void)
         delete Atoms;
         Atoms = NULL;
     EndUpdate();
+
+    if( SpatialIndex ) delete SpatialIndex;
+    SpatialIndex = NULL;
 }
 
 // ----------------------------------------------------------------------------
@@ -330,99 +350,13 @@ bool CStructure::BuildSuperCellWH(int ka,int kb,int kc)
     CHistoryNode* p_history = BeginChangeWH(EHCL_GEOMETRY,tr("build super cell"));
     if( p_history == NULL ) return (false);
 
-    // assign PBC bond indexes
-    int pbcbonds = GetBonds()->AssignPBCBondIndexes();
-
-    // save current structure
-    CXMLDocument xml_doc;
-    CXMLElement* p_str = xml_doc.CreateChildElement("structure");
-    SaveData(p_str);
-
-    BeginUpdate();
-
     // duplicate structure
-    for(int i=0; i < ka; i++){
-        for(int j=0; j < kb; j++){
-            for(int k=0; k < kc; k++){
-                if( (i == 0) && (j == 0) && (k == 0) ) continue;
-                CPoint offset = PBCInfo.GetAVector()*i + PBCInfo.GetBVector()*j + PBCInfo.GetCVector()*k;
-                Paste(p_str,true,offset,p_history);
-            }
-        }
-    }
-
-    double minlen = PBCInfo.GetLargestSphereRadius();
-    // solve PBC bonds
-    for(int pbcbtype = 1; pbcbtype <= pbcbonds; pbcbtype++ ){
-        // find all bonds of given type
-        CSimpleList<CBond> pbc_bonds;
-        foreach(QObject* p_qobj,GetBonds()->children()){
-            CBond* p_bond = static_cast<CBond*>(p_qobj);
-            if( p_bond->GetPBCIndex() == pbcbtype ){
-                pbc_bonds.InsertToEnd(p_bond,0,false);
-            }
-        }
-
-        bool changed;
-        do{
-            changed = false;
-            // interconnect those PBC bonds that are close to each other
-            CSimpleIterator<CBond>  I1(pbc_bonds);
-            while( I1.Current() != NULL ){
-                CBond* p_b1 = I1.Current();
-                CAtom* p_b1a1 = p_b1->GetFirstAtom();
-                CAtom* p_b1a2 = p_b1->GetSecondAtom();
-                I1++;
-                CSimpleIterator<CBond>  I2 = I1;
-                while(  I2.Current() != NULL ){
-                    CBond* p_b2 = I2.Current();
-                    CAtom* p_b2a1 = p_b2->GetFirstAtom();
-                    CAtom* p_b2a2 = p_b2->GetSecondAtom();
-                    bool found = false;
-                    CBond* p_nbond = NULL;
-                    if( (p_b1a1->IsBondedWith(p_b2a1) == NULL) &&
-                        (Size(p_b1a1->GetPos()-p_b2a1->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a1,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a2,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a1->IsBondedWith(p_b2a2) == NULL) &&
-                        (Size(p_b1a1->GetPos()-p_b2a2->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a1,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a2,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a2->IsBondedWith(p_b2a1) == NULL) &&
-                        (Size(p_b1a2->GetPos()-p_b2a1->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a2,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a1,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a2->IsBondedWith(p_b2a2) == NULL) &&
-                        (Size(p_b1a2->GetPos()-p_b2a2->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a2,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a1,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    I2++;
-                    if( found ){
-                        changed = true;
-                        pbc_bonds.InsertToEnd(p_nbond,0,false);
-                        pbc_bonds.Remove(p_b1);
-                        pbc_bonds.Remove(p_b2);
-                        p_b1->RemoveFromBaseList(p_history);
-                        p_b2->RemoveFromBaseList(p_history);
-                        break;
-                    }
-                }
-                // we must quit the loop as object in I1 can be invalid
-                // I1 points to I2 which is destroyed
-                if( changed == true ) break;
-            }
-        } while( changed );
-    }
+    CSuperCellBuilder builder;
+    builder.SetSuperCell(ka,kb,kc);
+    builder.Build(this);
 
-    EndUpdate(false);
+    CStructureSuperCellHI* p_hi = new CStructureSuperCellHI(this,builder);
+    p_history->Register(p_hi);
 
     // fix box sizes
     CPoint sizes = PBCInfo.GetSizes();
@@ -451,94 +385,13 @@ bool CStructure::BuildSuperCellWH(int va,int vb,int vc,int n)
     CHistoryNode* p_history = BeginChangeWH(EHCL_GEOMETRY,tr("build super cell"));
     if( p_history == NULL ) return (false);
 
-    // assign PBC bond indexes
-    int pbcbonds = GetBonds()->AssignPBCBondIndexes();
-
-    // save current structure
-    CXMLDocument xml_doc;
-    CXMLElement* p_str = xml_doc.CreateChildElement("structure");
-    SaveData(p_str);
-
-    BeginUpdate();
-
     // duplicate structure
-    for(int i=1; i < n; i++){
-        CPoint offset = PBCInfo.GetAVector()*va*i + PBCInfo.GetBVector()*vb*i + PBCInfo.GetCVector()*vc*i;
-        Paste(p_str,true,offset,p_history);
-    }
-
-    double minlen = PBCInfo.GetLargestSphereRadius();
-    // solve PBC bonds
-    for(int pbcbtype = 1; pbcbtype <= pbcbonds; pbcbtype++ ){
-        // find all bonds of given type
-        CSimpleList<CBond> pbc_bonds;
-        foreach(QObject* p_qobj,GetBonds()->children()){
-            CBond* p_bond = static_cast<CBond*>(p_qobj);
-            if( p_bond->GetPBCIndex() == pbcbtype ){
-                pbc_bonds.InsertToEnd(p_bond,0,false);
-            }
-        }
+    CSuperCellBuilder builder;
+    builder.SetTranslation(va,vb,vc,n);
+    builder.Build(this);
 
-        bool changed;
-        do{
-            changed = false;
-            // interconnect those PBC bonds that are close to each other
-            CSimpleIterator<CBond>  I1(pbc_bonds);
-            while( I1.Current() != NULL ){
-                CBond* p_b1 = I1.Current();
-                CAtom* p_b1a1 = p_b1->GetFirstAtom();
-                CAtom* p_b1a2 = p_b1->GetSecondAtom();
-                I1++;
-                CSimpleIterator<CBond>  I2 = I1;
-                while(  I2.Current() != NULL ){
-                    CBond* p_b2 = I2.Current();
-                    CAtom* p_b2a1 = p_b2->GetFirstAtom();
-                    CAtom* p_b2a2 = p_b2->GetSecondAtom();
-                    bool found = false;
-                    CBond* p_nbond = NULL;
-                    if( (p_b1a1->IsBondedWith(p_b2a1) == NULL) &&
-                        (Size(p_b1a1->GetPos()-p_b2a1->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a1,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a2,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a1->IsBondedWith(p_b2a2) == NULL) &&
-                        (Size(p_b1a1->GetPos()-p_b2a2->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a1,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a2,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a2->IsBondedWith(p_b2a1) == NULL) &&
-                        (Size(p_b1a2->GetPos()-p_b2a1->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a2,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a1,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    if( (p_b1a2->IsBondedWith(p_b2a2) == NULL) &&
-                        (Size(p_b1a2->GetPos()-p_b2a2->GetPos()) <= minlen) ){
-                        GetBonds()->CreateBond(p_b1a2,p_b2a2,p_b1->GetBondOrder(),p_history);
-                        p_nbond = GetBonds()->CreateBond(p_b1a1,p_b2a1,p_b1->GetBondOrder(),p_history);
-                        found = true;
-                    }
-                    I2++;
-                    if( found ){
-                        changed = true;
-                        pbc_bonds.InsertToEnd(p_nbond,0,false);
-                        pbc_bonds.Remove(p_b1);
-                        pbc_bonds.Remove(p_b2);
-                        p_b1->RemoveFromBaseList(p_history);
-                        p_b2->RemoveFromBaseList(p_history);
-                        break;
-                    }
-                }
-                // we must quit the loop as object in I1 can be invalid
-                // I1 points to I2 which is destroyed
-                if( changed == true ) break;
-            }
-        } while( changed );
-    }
-
-    EndUpdate(false);
+    CStructureSuperCellHI* p_hi = new CStructureSuperCellHI(this,builder);
+    p_history->Register(p_hi);
 
 //    // fix box sizes
 //    CPoint sizes = PBCInfo.GetSizes();
@@ -571,6 +424,22 @@ bool CStructure::SetSeqIndexWH(int seqidx)
     return(true);
 }
 
+//------------------------------------------------------------------------------
+
+bool CStructure::CreateAtomsAndBondsWH(const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds)
+{
+    if( atoms.isEmpty() ) return(false);
+
+    CHistoryNode* p_history = BeginChangeWH(EHCL_TOPOLOGY,tr("create atoms"));
+    if( p_history == NULL ) return (false);
+
+    QVector<CAtom*> new_atoms;
+    CreateAtomsAndBonds(atoms,bonds,new_atoms,p_history);
+
+    EndChangeWH();
+    return(true);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -631,10 +500,12 @@ void CStructure::DeleteAllContents(CHistoryNode* p_history)
     BeginUpdate();
 
     // remove all atoms
+    QVector<CAtom*> atoms;
+    atoms.reserve(Atoms->children().count());
     foreach(QObject* p_qobj,Atoms->children()) {
-        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
-        p_atom->RemoveFromBaseList(p_history);
+        atoms.append(static_cast<CAtom*>(p_qobj));
     }
+    RemoveAtoms(atoms,QVector<CBond*>(),p_history);
 
     // remove remaining bonds - should be automatically deleted with atoms
 
@@ -655,28 +526,84 @@ void CStructure::DeleteSelectedContents(CHistoryNode* p_history)
     // lock lists
     BeginUpdate();
 
-    // remove selected atoms
+    // remove selected atoms and bonds
+    QVector<CAtom*> atoms;
     foreach(QObject* p_qobj,Atoms->children()) {
         CAtom* p_atom = static_cast<CAtom*>(p_qobj);
         if( p_atom->IsFlagSet(EPOF_SELECTED) ) {
-            p_atom->RemoveFromBaseList(p_history);
+            atoms.append(p_atom);
         }
     }
 
-    // remove selected bonds
+    QVector<CBond*> bonds;
     foreach(QObject* p_qobj,Bonds->children()) {
         CBond* p_bond = static_cast<CBond*>(p_qobj);
         if( p_bond->IsFlagSet(EPOF_SELECTED) ) {
-            p_bond->RemoveFromBaseList(p_history);
+            bonds.append(p_bond);
         }
     }
 
+    RemoveAtoms(atoms,bonds,p_history);
+
     // unlock lists
     EndUpdate();
 }
 
 //------------------------------------------------------------------------------
 
+void CStructure::RemoveAtoms(const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                             CHistoryNode* p_history)
+{
+    if( atoms.isEmpty() && bonds.isEmpty() ) return;
+
+    BeginUpdate();
+
+    // collect bonds - each bond only once
+    QVector<CBond*> all_bonds;
+    QSet<CBond*>    bond_set;
+    foreach(CBond* p_bond,bonds) {
+        if( bond_set.contains(p_bond) ) continue;
+        bond_set.insert(p_bond);
+        all_bonds.append(p_bond);
+    }
+    foreach(CAtom* p_atom,atoms) {
+        foreach(CBond* p_bond,p_atom->GetBonds()) {
+            if( bond_set.contains(p_bond) ) continue;
+            bond_set.insert(p_bond);
+            all_bonds.append(p_bond);
+        }
+    }
+
+    CAtomListRemoveBatchHI* p_item = NULL;
+    if( p_history != NULL ){
+        // unregister other objects, they record their own history
+        foreach(CBond* p_bond,all_bonds) {
+            p_bond->UnregisterAllRegisteredObjects(p_history);
+        }
+        foreach(CAtom* p_atom,atoms) {
+            CProObject* p_obj;
+            while( (p_obj = p_atom->RemoveFirstFromROList()) != NULL ) {
+                p_obj->RemoveFromRegistered(p_atom,p_history);
+            }
+        }
+        // record objects before they are destroyed
+        p_item = new CAtomListRemoveBatchHI(this,atoms,all_bonds);
+    }
+
+    // bonds first, then atoms do not have any bond
+    Bonds->RemoveBonds(all_bonds);
+    Atoms->RemoveAtoms(atoms);
+
+    // undo must recreate objects before items of unregistered objects are undone
+    if( p_item != NULL ){
+        p_history->Register(p_item);
+    }
+
+    EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
 void CStructure::SetSeqIndex(int seqidx,CHistoryNode* p_history)
 {
     if( SeqIndex == seqidx ) return;
@@ -696,6 +623,34 @@ void CStructure::SetSeqIndex(int seqidx,CHistoryNode* p_history)
 
 //------------------------------------------------------------------------------
 
+void CStructure::CreateAtomsAndBonds(const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds,
+                                     QVector<CAtom*>& new_atoms,CHistoryNode* p_history)
+{
+    for(int i=0; i < bonds.count(); i++){
+        const CBondData& bond_data = bonds.at(i);
+        if( (bond_data.A1 < 0) || (bond_data.A1 >= atoms.count())
+            || (bond_data.A2 < 0) || (bond_data.A2 >= atoms.count()) ){
+            INVALID_ARGUMENT("bond atom is out of range");
+        }
+    }
+
+    BeginUpdate();
+
+    QVector<CBond*> new_bonds;
+    GetAtoms()->CreateAtoms(atoms,new_atoms);
+    GetBonds()->CreateBonds(bonds,new_atoms,new_bonds);
+
+    // one record for the whole batch
+    if( p_history != NULL ){
+        CAtomListBatchHI* p_hi = new CAtomListBatchHI(this,atoms,bonds,new_atoms,new_bonds);
+        p_history->Register(p_hi);
+    }
+
+    EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
 void CStructure::InsertSMILES(const QString& smiles)
 {
     COpenBabelUtils::FromSMILES(smiles,this);
@@ -1017,6 +972,15 @@ void CStructure::SetDescription(const QString& descrip,CHistoryNode* p_history)
     if( GetStructures() ) GetStructures()->EmitOnStructureListChanged();
 }
 
+//------------------------------------------------------------------------------
+
+void CStructure::SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history)
+{
+    if( GetFlags() == flags ) return;
+    CProObject::SetFlags(flags,p_history);
+    if( GetStructures() ) GetStructures()->EmitOnObjectFlagsChanged();
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -1042,17 +1006,30 @@ void CStructure::LoadData(CXMLElement* p_ele)
 
     CXMLElement* p_sele;
     // load data ------------------------------------
-    p_sele = p_ele->GetFirstChildElement("residues");
-    if( p_sele != NULL ) {
-        Residues->LoadData(p_sele);
-    }
-    p_sele = p_ele->GetFirstChildElement("atoms");
-    if( p_sele != NULL ) {
-        Atoms->LoadData(p_sele);
-    }
-    p_sele = p_ele->GetFirstChildElement("bonds");
-    if( p_sele != NULL ) {
-        Bonds->LoadData(p_sele);
+    CBinProjectFile* p_bin = GetProject() ? GetProject()->GetBinProjectFile() : NULL;
+    int bulk = -1;
+    if( (p_bin != NULL) && p_ele->GetAttribute("bulk",bulk) ){
+        // residues, atoms, and bonds are stored in columns of binary project
+        QByteArray          data;
+        CStructureBulkData  bulk_data;
+        if( (p_bin->GetBlockData(bulk,data) == false) || (bulk_data.Deserialize(data) == false) ){
+            EndUpdate();
+            RUNTIME_ERROR("unable to read structure bulk data");
+        }
+        bulk_data.LoadStructure(this,p_ele);
+    } else {
+        p_sele = p_ele->GetFirstChildElement("residues");
+        if( p_sele != NULL ) {
+            Residues->LoadData(p_sele);
+        }
+        p_sele = p_ele->GetFirstChildElement("atoms");
+        if( p_sele != NULL ) {
+            Atoms->LoadData(p_sele);
+        }
+        p_sele = p_ele->GetFirstChildElement("bonds");
+        if( p_sele != NULL ) {
+            Bonds->LoadData(p_sele);
+        }
     }
     p_sele = p_ele->GetFirstChildElement("restraints");
     if( p_sele != NULL ) {
@@ -1088,14 +1065,24 @@ void CStructure::SaveData(CXMLElement* p_ele)
     CXMLElement* p_sele;
 
     // save data ------------------------------------     
-    p_sele = p_ele->CreateChildElement("residues");
-    Residues->SaveData(p_sele,false) ;
+    CBinProjectFile* p_bin = GetProject() ? GetProject()->GetBinProjectFile() : NULL;
+    if( p_bin != NULL ){
+        // residues, atoms, and bonds are stored in columns of binary project
+        QByteArray          data;
+        CStructureBulkData  bulk_data;
+        bulk_data.SaveStructure(this,p_ele);
+        bulk_data.Serialize(data);
+        p_ele->SetAttribute("bulk",p_bin->AddBlock(BIN_PROJECT_STRUCTURE,data));
+    } else {
+        p_sele = p_ele->CreateChildElement("residues");
+        Residues->SaveData(p_sele,false) ;
 
-    p_sele = p_ele->CreateChildElement("atoms");
-    Atoms->SaveData(p_sele,false);
+        p_sele = p_ele->CreateChildElement("atoms");
+        Atoms->SaveData(p_sele,false);
 
-    p_sele = p_ele->CreateChildElement("bonds");
-    Bonds->SaveData(p_sele,false);
+        p_sele = p_ele->CreateChildElement("bonds");
+        Bonds->SaveData(p_sele,false);
+    }
 
     p_sele = p_ele->CreateChildElement("restraints");
     Restraints->SaveData(p_sele);
@@ -1133,16 +1120,79 @@ void CStructure::LoadStructureData(CXMLElement* p_ele,CHistoryNode* p_history)
     if( p_sele != NULL ) {
         Residues->LoadData(p_sele,p_history);
     }
-    p_sele = p_ele->GetFirstChildElement("atoms");
-    if( p_sele != NULL ) {
-        Atoms->LoadData(p_sele,p_history);
+    // atoms and bonds are created in one batch
+    LoadAtomsAndBonds(p_ele->GetFirstChildElement("atoms"),
+                      p_ele->GetFirstChildElement("bonds"),p_history);
+
+    EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CStructure::LoadAtomsAndBonds(CXMLElement* p_aele,CXMLElement* p_bele,CHistoryNode* p_history)
+{
+    QVector<CAtomData>      atoms;
+    QVector<CBondData>      bonds;
+    QList<CXMLElement*>     other_atoms;
+    QList<CXMLElement*>     other_bonds;
+    QHash<int,int>          atom_map;   // atom id -> position in atoms
+
+    if( p_aele != NULL ){
+        // load object info of the list
+        Atoms->CProObject::LoadData(p_aele);
+
+        CXMLElement* p_ael = p_aele->GetFirstChildElement("atom");
+        while( p_ael != NULL ) {
+            if( p_ael->GetFirstChildElement("designer") != NULL ){
+                other_atoms.append(p_ael);
+            } else {
+                CAtomData atom_data;
+                atom_data.LoadAtom(p_ael);
+                if( atom_data.Index > 0 ) atom_map[atom_data.Index] = atoms.count();
+                atoms.append(atom_data);
+            }
+            p_ael = p_ael->GetNextSiblingElement("atom");
+        }
     }
-    p_sele = p_ele->GetFirstChildElement("bonds");
-    if( p_sele != NULL ) {
-        Bonds->LoadData(p_sele,p_history);
+
+    if( p_bele != NULL ){
+        // load object info of the list
+        Bonds->CProObject::LoadData(p_bele);
+
+        CXMLElement* p_bel = p_bele->GetFirstChildElement("bond");
+        while( p_bel != NULL ) {
+            CBondData bond_data;
+            bond_data.LoadBond(p_bel);
+
+            QString type;
+            int     pbc = 0;
+            p_bel->GetAttribute("type",type);
+            p_bel->GetAttribute("pbc",pbc);
+
+            if( (p_bel->GetFirstChildElement("designer") != NULL) || (! type.isEmpty()) || (pbc != 0)
+                || (atom_map.contains(bond_data.A1) == false) || (atom_map.contains(bond_data.A2) == false) ){
+                other_bonds.append(p_bel);
+            } else {
+                bond_data.A1 = atom_map[bond_data.A1];
+                bond_data.A2 = atom_map[bond_data.A2];
+                bonds.append(bond_data);
+            }
+            p_bel = p_bel->GetNextSiblingElement("bond");
+        }
     }
 
-    EndUpdate();
+    if( ! atoms.isEmpty() ){
+        QVector<CAtom*> new_atoms;
+        CreateAtomsAndBonds(atoms,bonds,new_atoms,p_history);
+    }
+
+    // the rest is created as usual
+    foreach(CXMLElement* p_ael,other_atoms){
+        Atoms->CreateAtom(p_ael,p_history);
+    }
+    foreach(CXMLElement* p_bel,other_bonds){
+        Bonds->CreateBond(p_bel,p_history);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -1295,11 +1345,42 @@ void CStructure::EndGeometryUpdate(void)
 
 void CStructure::NotifyGeometryChangeTick(void)
 {
+    InvalidateSpatialIndex();
     if( GetStructures() ){
-        GetStructures()->NotifyGeometryChangeTick();
+        GetStructures()->NotifyGeometryChangeTick(this);
     }
 }
 
+//------------------------------------------------------------------------------
+
+void CStructure::InvalidateSpatialIndex(void)
+{
+    // no lock, GetSpatialIndex rebuilds the index if it was invalidated during its build
+    SpatialIndexValid.storeRelease(0);
+}
+
+//------------------------------------------------------------------------------
+
+CSpatialIndex* CStructure::GetSpatialIndex(void)
+{
+    // concurrent mask evaluations share the index
+    QMutexLocker lock(&SpatialIndexMutex);
+
+    if( SpatialIndex == NULL ){
+        SpatialIndex = new CSpatialIndex;
+        SpatialIndexValid.storeRelease(0);
+    }
+
+    // the box can be changed directly via PBCInfo
+    if( (SpatialIndexValid.loadAcquire() == 0) || (SpatialIndex->IsBuiltFor(PBCInfo) == false) ){
+        // the flag is set before the build, so the concurrent invalidation is not lost
+        SpatialIndexValid.storeRelease(1);
+        SpatialIndex->Build(this);
+    }
+
+    return(SpatialIndex);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -28,6 +28,9 @@
 #include <ProObject.hpp>
 #include <PBCInfo.hpp>
 #include <QMap>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
 
 //------------------------------------------------------------------------------
 
@@ -40,6 +43,10 @@ class CResidueList;
 class CRestraintList;
 class CTrajectory;
 class CAtom;
+class CBond;
+class CAtomData;
+class CBondData;
+class CSpatialIndex;
 
 /// \defgroup structure Describe the structure
 
@@ -95,6 +102,9 @@ public:
     /// set sequence index
     bool SetSeqIndexWH(int seqidx);
 
+    /// create atoms and bonds in one pass, see CreateAtomsAndBonds
+    bool CreateAtomsAndBondsWH(const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds);
+
 // informational methods -------------------------------------------------------
     /// get base list
     CStructureList* GetStructures(void) const;
@@ -123,6 +133,12 @@ public:
     /// get sequence index
     int GetSeqIndex(void) const;
 
+    /// get spatial index of atoms
+    /*! the index is rebuilt if geometry, topology, or box was changed,
+        the method can be called from several threads evaluating masks
+    */
+    CSpatialIndex*  GetSpatialIndex(void);
+
 // executive methods  ----------------------------------------------------------
     /// delete entire molecule contents
     void DeleteAllContents(CHistoryNode* p_history=NULL);
@@ -147,6 +163,22 @@ public:
     */
     void Paste(CXMLElement* p_ele,bool donotoverride,const CPoint& offset,CHistoryNode* p_history=NULL);
 
+    /// create atoms and bonds in one pass
+    /*! A1 and A2 of bonds are positions of atoms in the atoms vector (counted from zero),
+        created atoms are returned in new_atoms, signals are emitted and atoms are sorted
+        only once, the whole batch is recorded as a single history item,
+        atoms are added to existing residues given by CAtomData::Residue
+    */
+    void CreateAtomsAndBonds(const QVector<CAtomData>& atoms,const QVector<CBondData>& bonds,
+                             QVector<CAtom*>& new_atoms,CHistoryNode* p_history=NULL);
+
+    /// remove atoms with their bonds and other bonds in one pass
+    /*! the whole batch is recorded as a single history item, objects
+        registered to removed atoms and bonds are unregistered as usual
+    */
+    void RemoveAtoms(const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                     CHistoryNode* p_history=NULL);
+
     /// insert structure from SMILES
     void InsertSMILES(const QString& smiles);
 
@@ -159,6 +191,9 @@ public:
     /// set description
     virtual void SetDescription(const QString& descrip,CHistoryNode* p_history=NULL);
 
+    /// set flags
+    virtual void SetFlags(const CProObjectFlags& flags,CHistoryNode* p_history=NULL);
+
     /// set sequential index
     void SetSeqIndex(int seqidx,CHistoryNode* p_history=NULL);
 
@@ -199,6 +234,9 @@ public:
     /// emit OnGeometryChangeTick in StructureList
     void NotifyGeometryChangeTick(void);
 
+    /// spatial index must be rebuilt
+    void InvalidateSpatialIndex(void);
+
 // trajectory support ----------------------------------------------------------
     /// get associated trajectory
     CTrajectory*    GetTrajectory(void);
@@ -229,6 +267,15 @@ private:
     int                 SeqIndex;
     int                 GeometryUpdateLevel;
     QMap<int,CAtom*>    TrajIndexMap;
+    CSpatialIndex*      SpatialIndex;
+    QAtomicInt          SpatialIndexValid;  // cleared without the lock for each atom move
+    QMutex              SpatialIndexMutex;
+
+    /// create atoms and bonds from XML elements in one batch
+    /*! objects with designer data, typed or periodic bonds, and bonds
+        to atoms outside the batch are created one by one
+    */
+    void LoadAtomsAndBonds(CXMLElement* p_aele,CXMLElement* p_bele,CHistoryNode* p_history);
 
     friend class CAtom;
 };
@@ -0,0 +1,578 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <StructureBulkData.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <BondList.hpp>
+#include <Bond.hpp>
+#include <ResidueList.hpp>
+#include <Residue.hpp>
+#include <Project.hpp>
+#include <XMLElement.hpp>
+#include <ErrorSystem.hpp>
+#include <QDataStream>
+
+//------------------------------------------------------------------------------
+
+#define STRUCTURE_BULK_VERSION  1
+
+//------------------------------------------------------------------------------
+
+template<class T>
+static void WriteColumn(QDataStream& str,const QVector<T>& column)
+{
+    str << (quint32)column.count();
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    str.writeRawData(reinterpret_cast<const char*>(column.constData()),column.count()*sizeof(T));
+#else
+    for(int i=0; i < column.count(); i++) str << column[i];
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+template<class T>
+static bool ReadColumn(QDataStream& str,QVector<T>& column)
+{
+    quint32 count = 0;
+    str >> count;
+    if( str.status() != QDataStream::Ok ) return(false);
+    if( str.device() && ((qint64)count*(qint64)sizeof(T) > str.device()->bytesAvailable()) ) return(false);
+    column.resize(count);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    int size = count*sizeof(T);
+    if( str.readRawData(reinterpret_cast<char*>(column.data()),size) != size ) return(false);
+#else
+    for(quint32 i=0; i < count; i++) str >> column[i];
+#endif
+    return(str.status() == QDataStream::Ok);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CStructureBulkData::CStructureBulkData(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStructureBulkData::SaveStructure(CStructure* p_str,CXMLElement* p_ele)
+{
+    if( (p_str == NULL) || (p_ele == NULL) ) {
+        INVALID_ARGUMENT("p_str or p_ele is NULL");
+    }
+
+    Clear();
+
+    CXMLElement* p_sele;
+
+    // residues -------------------------------------
+    p_sele = p_ele->CreateChildElement("residues");
+    p_str->GetResidues()->CProObject::SaveData(p_sele);
+
+    foreach(QObject* p_qobj,p_str->GetResidues()->children()) {
+        CResidue* p_res = static_cast<CResidue*>(p_qobj);
+        if( IsBulkObject(p_res) == false ){
+            CXMLElement* p_rel = p_sele->CreateChildElement("residue");
+            p_res->SaveData(p_rel);
+            continue;
+        }
+        ResIndex.append(p_res->GetIndex());
+        ResName.append(AddString(p_res->CExtComObject::GetName()));
+        ResFlags.append(p_res->GetFlags() & EPOF_SAVE_MASK);
+        ResSeqIndex.append(p_res->GetSeqIndex());
+        ResChain.append(AddString(p_res->GetChain()));
+        ResType.append(AddString(p_res->GetType()));
+    }
+
+    // atoms ----------------------------------------
+    p_sele = p_ele->CreateChildElement("atoms");
+    p_str->GetAtoms()->CProObject::SaveData(p_sele);
+
+    bool with_vel = false;
+    foreach(QObject* p_qobj,p_str->GetAtoms()->children()) {
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        if( IsBulkObject(p_atom) == false ){
+            CXMLElement* p_ael = p_sele->CreateChildElement("atom");
+            p_atom->SaveData(p_ael);
+            continue;
+        }
+        SaveAtom(p_atom,with_vel);
+    }
+    if( with_vel == false ) AtomVel.clear();
+
+    // bonds ----------------------------------------
+    p_sele = p_ele->CreateChildElement("bonds");
+    p_str->GetBonds()->CProObject::SaveData(p_sele);
+
+    foreach(QObject* p_qobj,p_str->GetBonds()->children()) {
+        CBond* p_bond = static_cast<CBond*>(p_qobj);
+        if( IsBulkObject(p_bond) == false ){
+            CXMLElement* p_bel = p_sele->CreateChildElement("bond");
+            p_bond->SaveData(p_bel);
+            continue;
+        }
+        SaveBond(p_bond);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::LoadStructure(CStructure* p_str,CXMLElement* p_ele)
+{
+    if( (p_str == NULL) || (p_ele == NULL) ) {
+        INVALID_ARGUMENT("p_str or p_ele is NULL");
+    }
+
+    CProject* p_project = p_str->GetProject();
+    if( p_project == NULL ) {
+        LOGIC_ERROR("GetProject() == NULL");
+    }
+
+    CXMLElement* p_sele;
+
+    // residues - objects stored in XML first -------
+    p_sele = p_ele->GetFirstChildElement("residues");
+    if( p_sele != NULL ) {
+        p_str->GetResidues()->LoadData(p_sele);
+    }
+
+    CResidueList* p_residues = p_str->GetResidues();
+    for(int i=0; i < ResIndex.count(); i++){
+        CResidue* p_res = new CResidue(p_residues,true);
+        LoadObjectData(p_res,ResIndex[i],ResName[i],ResFlags[i]);
+        p_res->SeqIndex = ResSeqIndex[i];
+        p_res->Chain = GetString(ResChain[i]);
+        p_res->Type = GetString(ResType[i]);
+    }
+    p_residues->ListSizeChanged();
+
+    // atoms ----------------------------------------
+    p_sele = p_ele->GetFirstChildElement("atoms");
+    if( p_sele != NULL ) {
+        p_str->GetAtoms()->LoadData(p_sele);
+    }
+
+    LoadAtoms(p_str);
+
+    // bonds ----------------------------------------
+    p_sele = p_ele->GetFirstChildElement("bonds");
+    if( p_sele != NULL ) {
+        p_str->GetBonds()->LoadData(p_sele);
+    }
+
+    LoadBonds(p_str);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::SaveObjects(const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                                     CXMLElement* p_ele)
+{
+    if( p_ele == NULL ) {
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    Clear();
+
+    bool with_vel = false;
+    foreach(CAtom* p_atom,atoms) {
+        if( IsBulkObject(p_atom) == false ){
+            CXMLElement* p_ael = p_ele->CreateChildElement("atom");
+            p_atom->SaveData(p_ael);
+            continue;
+        }
+        SaveAtom(p_atom,with_vel);
+    }
+    if( with_vel == false ) AtomVel.clear();
+
+    foreach(CBond* p_bond,bonds) {
+        if( IsBulkObject(p_bond) == false ){
+            CXMLElement* p_bel = p_ele->CreateChildElement("bond");
+            p_bond->SaveData(p_bel);
+            continue;
+        }
+        SaveBond(p_bond);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::LoadObjects(CStructure* p_str,CXMLElement* p_ele)
+{
+    if( (p_str == NULL) || (p_ele == NULL) ) {
+        INVALID_ARGUMENT("p_str or p_ele is NULL");
+    }
+
+    if( p_str->GetProject() == NULL ) {
+        LOGIC_ERROR("GetProject() == NULL");
+    }
+
+    // atoms ----------------------------------------
+    CXMLElement* p_ael = p_ele->GetFirstChildElement("atom");
+    while( p_ael != NULL ){
+        p_str->GetAtoms()->CreateAtom(p_ael);
+        p_ael = p_ael->GetNextSiblingElement("atom");
+    }
+
+    LoadAtoms(p_str);
+
+    // bonds - all atoms must already exist ---------
+    CXMLElement* p_bel = p_ele->GetFirstChildElement("bond");
+    while( p_bel != NULL ){
+        p_str->GetBonds()->CreateBond(p_bel);
+        p_bel = p_bel->GetNextSiblingElement("bond");
+    }
+
+    LoadBonds(p_str);
+}
+
+//------------------------------------------------------------------------------
+
+int CStructureBulkData::GetNumberOfAtoms(void) const
+{
+    return(AtomIndex.count());
+}
+
+//------------------------------------------------------------------------------
+
+int CStructureBulkData::GetNumberOfBonds(void) const
+{
+    return(BondIndex.count());
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::SaveAtom(CAtom* p_atom,bool& with_vel)
+{
+    AtomIndex.append(p_atom->GetIndex());
+    AtomName.append(AddString(p_atom->CExtComObject::GetName()));
+    AtomFlags.append(p_atom->GetFlags() & EPOF_SAVE_MASK);
+    AtomSerIndex.append(p_atom->GetSerIndex());
+    AtomLocIndex.append(p_atom->GetLocIndex());
+    AtomResidue.append(p_atom->GetResidue() ? p_atom->GetResidue()->GetIndex() : 0);
+    AtomType.append(AddString(p_atom->GetType()));
+    AtomZ.append(p_atom->GetZ());
+    AtomCharge.append(p_atom->GetCharge());
+
+    // get position via GetPos - it also consider trajectory if it is attached
+    CPoint pos = p_atom->GetPos();
+    AtomPos.append(pos.x);
+    AtomPos.append(pos.y);
+    AtomPos.append(pos.z);
+
+    CPoint vel = p_atom->GetVel();
+    AtomVel.append(vel.x);
+    AtomVel.append(vel.y);
+    AtomVel.append(vel.z);
+    if( (vel.x != 0) || (vel.y != 0) || (vel.z != 0) ) with_vel = true;
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::SaveBond(CBond* p_bond)
+{
+    BondIndex.append(p_bond->GetIndex());
+    BondName.append(AddString(p_bond->CExtComObject::GetName()));
+    BondFlags.append(p_bond->GetFlags() & EPOF_SAVE_MASK);
+    BondA1.append(p_bond->A1 ? p_bond->A1->GetIndex() : 0);
+    BondA2.append(p_bond->A2 ? p_bond->A2->GetIndex() : 0);
+    BondOrder.append(p_bond->Order);
+    BondType.append(AddString(p_bond->Type));
+    BondPBCIndex.append(p_bond->PBCIndex);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::LoadAtoms(CStructure* p_str)
+{
+    CProject* p_project = p_str->GetProject();
+    int base = p_project->GetBaseObjectIndex();
+
+    CAtomList* p_atoms = p_str->GetAtoms();
+    bool with_vel = AtomVel.count() == AtomPos.count();
+    for(int i=0; i < AtomIndex.count(); i++){
+        CAtom* p_atom = new CAtom(p_atoms,true);
+        LoadObjectData(p_atom,AtomIndex[i],AtomName[i],AtomFlags[i]);
+        p_atom->SerIndex = AtomSerIndex[i];
+        p_atom->LocIndex = AtomLocIndex[i];
+        p_atom->AtomType = GetString(AtomType[i]);
+        p_atom->Z = AtomZ[i];
+        p_atom->Charge = AtomCharge[i];
+        p_atom->Pos.x = AtomPos[3*i+0];
+        p_atom->Pos.y = AtomPos[3*i+1];
+        p_atom->Pos.z = AtomPos[3*i+2];
+        if( with_vel ){
+            p_atom->Vel.x = AtomVel[3*i+0];
+            p_atom->Vel.y = AtomVel[3*i+1];
+            p_atom->Vel.z = AtomVel[3*i+2];
+        }
+        if( AtomResidue[i] > 0 ){
+            CResidue* p_res = static_cast<CResidue*>(p_project->FindObject(AtomResidue[i] + base));
+            if( p_res ) p_res->AddAtom(p_atom);
+        }
+    }
+    p_atoms->ListSizeChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::LoadBonds(CStructure* p_str)
+{
+    CProject* p_project = p_str->GetProject();
+    int base = p_project->GetBaseObjectIndex();
+
+    CBondList* p_bonds = p_str->GetBonds();
+    for(int i=0; i < BondIndex.count(); i++){
+        CBond* p_bond = new CBond(p_bonds,true);
+        LoadObjectData(p_bond,BondIndex[i],BondName[i],BondFlags[i]);
+        p_bond->Order = static_cast<EBondOrder>(BondOrder[i]);
+        p_bond->Type = GetString(BondType[i]);
+        p_bond->PBCIndex = BondPBCIndex[i];
+        if( BondA1[i] > 0 ){
+            p_bond->A1 = static_cast<CAtom*>(p_project->FindObject(BondA1[i] + base));
+            if( p_bond->A1 ) p_bond->A1->RegisterBond(p_bond);
+        }
+        if( BondA2[i] > 0 ){
+            p_bond->A2 = static_cast<CAtom*>(p_project->FindObject(BondA2[i] + base));
+            if( p_bond->A2 ) p_bond->A2->RegisterBond(p_bond);
+        }
+    }
+    p_bonds->ListSizeChanged();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStructureBulkData::Serialize(QByteArray& data) const
+{
+    data.clear();
+
+    QDataStream str(&data,QIODevice::WriteOnly);
+    str.setByteOrder(QDataStream::LittleEndian);
+
+    str << (quint32)STRUCTURE_BULK_VERSION;
+    str << Strings;
+
+    WriteColumn(str,ResIndex);
+    WriteColumn(str,ResName);
+    WriteColumn(str,ResFlags);
+    WriteColumn(str,ResSeqIndex);
+    WriteColumn(str,ResChain);
+    WriteColumn(str,ResType);
+
+    WriteColumn(str,AtomIndex);
+    WriteColumn(str,AtomName);
+    WriteColumn(str,AtomFlags);
+    WriteColumn(str,AtomSerIndex);
+    WriteColumn(str,AtomLocIndex);
+    WriteColumn(str,AtomResidue);
+    WriteColumn(str,AtomType);
+    WriteColumn(str,AtomZ);
+    WriteColumn(str,AtomCharge);
+    WriteColumn(str,AtomPos);
+    WriteColumn(str,AtomVel);
+
+    WriteColumn(str,BondIndex);
+    WriteColumn(str,BondName);
+    WriteColumn(str,BondFlags);
+    WriteColumn(str,BondA1);
+    WriteColumn(str,BondA2);
+    WriteColumn(str,BondOrder);
+    WriteColumn(str,BondType);
+    WriteColumn(str,BondPBCIndex);
+}
+
+//------------------------------------------------------------------------------
+
+bool CStructureBulkData::Deserialize(const QByteArray& data)
+{
+    Clear();
+
+    QDataStream str(data);
+    str.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 version = 0;
+    str >> version;
+    if( version != STRUCTURE_BULK_VERSION ){
+        ES_ERROR("unsupported version of structure bulk data");
+        return(false);
+    }
+    str >> Strings;
+
+    bool result = true;
+
+    result &= ReadColumn(str,ResIndex);
+    result &= ReadColumn(str,ResName);
+    result &= ReadColumn(str,ResFlags);
+    result &= ReadColumn(str,ResSeqIndex);
+    result &= ReadColumn(str,ResChain);
+    result &= ReadColumn(str,ResType);
+
+    result &= ReadColumn(str,AtomIndex);
+    result &= ReadColumn(str,AtomName);
+    result &= ReadColumn(str,AtomFlags);
+    result &= ReadColumn(str,AtomSerIndex);
+    result &= ReadColumn(str,AtomLocIndex);
+    result &= ReadColumn(str,AtomResidue);
+    result &= ReadColumn(str,AtomType);
+    result &= ReadColumn(str,AtomZ);
+    result &= ReadColumn(str,AtomCharge);
+    result &= ReadColumn(str,AtomPos);
+    result &= ReadColumn(str,AtomVel);
+
+    result &= ReadColumn(str,BondIndex);
+    result &= ReadColumn(str,BondName);
+    result &= ReadColumn(str,BondFlags);
+    result &= ReadColumn(str,BondA1);
+    result &= ReadColumn(str,BondA2);
+    result &= ReadColumn(str,BondOrder);
+    result &= ReadColumn(str,BondType);
+    result &= ReadColumn(str,BondPBCIndex);
+
+    // check column lengths
+    int nres = ResIndex.count();
+    result &= (ResName.count() == nres) && (ResFlags.count() == nres) && (ResSeqIndex.count() == nres)
+              && (ResChain.count() == nres) && (ResType.count() == nres);
+
+    int natoms = AtomIndex.count();
+    result &= (AtomName.count() == natoms) && (AtomFlags.count() == natoms) && (AtomSerIndex.count() == natoms)
+              && (AtomLocIndex.count() == natoms) && (AtomResidue.count() == natoms)
+              && (AtomType.count() == natoms) && (AtomZ.count() == natoms)
+              && (AtomCharge.count() == natoms) && (AtomPos.count() == 3*natoms)
+              && ((AtomVel.count() == 0) || (AtomVel.count() == 3*natoms));
+
+    int nbonds = BondIndex.count();
+    result &= (BondName.count() == nbonds) && (BondFlags.count() == nbonds) && (BondA1.count() == nbonds)
+              && (BondA2.count() == nbonds) && (BondOrder.count() == nbonds)
+              && (BondType.count() == nbonds) && (BondPBCIndex.count() == nbonds);
+
+    if( result == false ){
+        ES_ERROR("corrupted structure bulk data");
+        Clear();
+    }
+
+    return(result);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CStructureBulkData::Clear(void)
+{
+    Strings.clear();
+    StringMap.clear();
+
+    ResIndex.clear();
+    ResName.clear();
+    ResFlags.clear();
+    ResSeqIndex.clear();
+    ResChain.clear();
+    ResType.clear();
+
+    AtomIndex.clear();
+    AtomName.clear();
+    AtomFlags.clear();
+    AtomSerIndex.clear();
+    AtomLocIndex.clear();
+    AtomResidue.clear();
+    AtomType.clear();
+    AtomZ.clear();
+    AtomCharge.clear();
+    AtomPos.clear();
+    AtomVel.clear();
+
+    BondIndex.clear();
+    BondName.clear();
+    BondFlags.clear();
+    BondA1.clear();
+    BondA2.clear();
+    BondOrder.clear();
+    BondType.clear();
+    BondPBCIndex.clear();
+}
+
+//------------------------------------------------------------------------------
+
+int CStructureBulkData::AddString(const QString& text)
+{
+    if( text.isEmpty() ) return(-1);
+
+    QHash<QString,int>::const_iterator it = StringMap.constFind(text);
+    if( it != StringMap.constEnd() ) return(it.value());
+
+    int index = Strings.count();
+    Strings.append(text);
+    StringMap.insert(text,index);
+    return(index);
+}
+
+//------------------------------------------------------------------------------
+
+const QString CStructureBulkData::GetString(int index) const
+{
+    if( (index < 0) || (index >= Strings.count()) ) return(QString());
+    return(Strings.at(index));
+}
+
+//------------------------------------------------------------------------------
+
+bool CStructureBulkData::IsBulkObject(CProObject* p_obj)
+{
+    if( ! p_obj->GetDescription().isEmpty() ) return(false);
+
+    if( p_obj->GetProject() && p_obj->GetProject()->IsFlagSet<EProjecFlag>(EPF_PERSISTENT_DESIGNERS) ){
+        p_obj->SaveObjectDesignerSetup();
+        if( p_obj->GetDesignerData() != NULL ) return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureBulkData::LoadObjectData(CProObject* p_obj,int index,int name,int flags)
+{
+    // see CProObject::LoadData
+    if( (index > 0) && (p_obj->GetProject() != NULL) ){
+        p_obj->SetIndex(index + p_obj->GetProject()->GetBaseObjectIndex());
+    }
+
+    if( (name >= 0) && (p_obj->IsFlagSet(EPOF_RO_NAME) == false) ){
+        p_obj->SetName(GetString(name));
+    }
+
+    CProObjectFlags mask = CProObjectFlags(QFlag(EPOF_SAVE_MASK));
+    CProObjectFlags tech = p_obj->Flags & (~mask);
+    CProObjectFlags user = CProObjectFlags(QFlag(flags)) & mask;
+    p_obj->Flags = tech | user;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
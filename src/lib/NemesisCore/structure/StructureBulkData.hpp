@@ -0,0 +1,150 @@
+#ifndef StructureBulkDataH
+#define StructureBulkDataH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QByteArray>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CProObject;
+class CAtom;
+class CBond;
+class CXMLElement;
+
+// -----------------------------------------------------------------------------
+
+///  residues, atoms, and bonds of one structure stored in packed columns
+/*! it is used by binary project files, strings are stored in the string
+    table and referenced by indexes, objects with description or designer
+    data are saved into XML elements as usual
+*/
+
+class NEMESIS_CORE_PACKAGE CStructureBulkData {
+public:
+// constructor -----------------------------------------------------------------
+    CStructureBulkData(void);
+
+// input/output methods --------------------------------------------------------
+    /// save residues, atoms, and bonds of the structure
+    /*! residues, atoms, and bonds elements are created in p_ele */
+    void SaveStructure(CStructure* p_str,CXMLElement* p_ele);
+
+    /// load residues, atoms, and bonds into the structure
+    void LoadStructure(CStructure* p_str,CXMLElement* p_ele);
+
+    /// save atoms and bonds, residues are only referenced by atoms
+    /*! bonds can be connected to atoms that are not in the list,
+        objects that cannot be saved in columns are stored in atom and bond
+        elements created in p_ele
+    */
+    void SaveObjects(const QVector<CAtom*>& atoms,const QVector<CBond*>& bonds,
+                     CXMLElement* p_ele);
+
+    /// recreate atoms and bonds saved by SaveObjects
+    /*! residues and atoms referenced by objects must already exist */
+    void LoadObjects(CStructure* p_str,CXMLElement* p_ele);
+
+    /// pack columns into binary data
+    void Serialize(QByteArray& data) const;
+
+    /// unpack columns from binary data
+    bool Deserialize(const QByteArray& data);
+
+// information methods ---------------------------------------------------------
+    /// get number of atoms stored in columns
+    int GetNumberOfAtoms(void) const;
+
+    /// get number of bonds stored in columns
+    int GetNumberOfBonds(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QStringList         Strings;
+    QHash<QString,int>  StringMap;
+
+    // residues
+    QVector<qint32>     ResIndex;
+    QVector<qint32>     ResName;
+    QVector<qint32>     ResFlags;
+    QVector<qint32>     ResSeqIndex;
+    QVector<qint32>     ResChain;
+    QVector<qint32>     ResType;
+
+    // atoms
+    QVector<qint32>     AtomIndex;
+    QVector<qint32>     AtomName;
+    QVector<qint32>     AtomFlags;
+    QVector<qint32>     AtomSerIndex;
+    QVector<qint32>     AtomLocIndex;
+    QVector<qint32>     AtomResidue;
+    QVector<qint32>     AtomType;
+    QVector<qint32>     AtomZ;
+    QVector<double>     AtomCharge;
+    QVector<double>     AtomPos;        // x, y, z
+    QVector<double>     AtomVel;        // x, y, z, empty if no atom has velocity
+
+    // bonds
+    QVector<qint32>     BondIndex;
+    QVector<qint32>     BondName;
+    QVector<qint32>     BondFlags;
+    QVector<qint32>     BondA1;
+    QVector<qint32>     BondA2;
+    QVector<qint32>     BondOrder;
+    QVector<qint32>     BondType;
+    QVector<qint32>     BondPBCIndex;
+
+    /// clear all columns
+    void Clear(void);
+
+    /// add string to the string table
+    int AddString(const QString& text);
+
+    /// get string from the string table
+    const QString GetString(int index) const;
+
+    /// can be the object saved in columns?
+    bool IsBulkObject(CProObject* p_obj);
+
+    /// load core object data
+    void LoadObjectData(CProObject* p_obj,int index,int name,int flags);
+
+    /// add atom to columns
+    void SaveAtom(CAtom* p_atom,bool& with_vel);
+
+    /// add bond to columns
+    void SaveBond(CBond* p_bond);
+
+    /// create atoms from columns
+    void LoadAtoms(CStructure* p_str);
+
+    /// create bonds from columns
+    void LoadBonds(CStructure* p_str);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
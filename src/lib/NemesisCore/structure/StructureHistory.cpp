@@ -23,6 +23,9 @@
 #include <ProObjectHistory.hpp>
 #include <Project.hpp>
 #include <StructureList.hpp>
+#include <AtomList.hpp>
+#include <BondList.hpp>
+#include <ResidueList.hpp>
 #include <ErrorSystem.hpp>
 #include <XMLElement.hpp>
 #include <NemesisCoreModule.hpp>
@@ -38,6 +41,8 @@ REGISTER_HISTORY_OBJECT(NemesisCorePlugin,StructureUpdateHI,
                         "{STRU:31a676a2-1737-4fc1-baa3-65f3fad242b1}")
 REGISTER_HISTORY_OBJECT(NemesisCorePlugin,StructureSeqIndexHI,
                         "{STRSI:1881c6cc-1dc8-4c47-8176-c1ad165f78c4}")
+REGISTER_HISTORY_OBJECT(NemesisCorePlugin,StructureSuperCellHI,
+                        "{STRSC:5c0e93d2-7a41-4f6b-9e28-b3d17a64c8f5}")
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -49,6 +54,17 @@ CStructureHI::CStructureHI(CStructure* p_str,EHistoryItemDirection change)
     MoleculeIndex = p_str->GetIndex();
     CXMLElement* p_ele = StructureData.CreateChildElement("structure");
     p_str->SaveData(p_ele);
+
+    NumOfObjects = p_str->GetResidues()->GetNumberOfResidues()
+                 + p_str->GetAtoms()->GetNumberOfAtoms()
+                 + p_str->GetBonds()->GetNumberOfBonds();
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CStructureHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + (qint64)(NumOfObjects + 1)*HISTORY_XML_ELEMENT_SIZE);
 }
 
 //------------------------------------------------------------------------------
@@ -96,6 +112,9 @@ void CStructureHI::LoadData(CXMLElement* p_ele)
     CHistoryItem::LoadData(p_ele);
 
     // load local data ---------------------------
+    NumOfObjects = 0;
+    p_ele->GetAttribute("no",NumOfObjects);
+
     CXMLElement* p_sele = p_ele->GetFirstChildElement("structure");
     if( p_sele == NULL ) return;
     StructureData.RemoveAllChildNodes();
@@ -115,6 +134,8 @@ void CStructureHI::SaveData(CXMLElement* p_ele)
     CHistoryItem::SaveData(p_ele);
 
     // save local data ---------------------------
+    p_ele->SetAttribute("no",NumOfObjects);
+
     CXMLElement* p_sele = StructureData.GetFirstChildElement("structure");
     if( p_sele == NULL ) return;
     CXMLElement* p_dele = p_ele->CreateChildElement("structure");
@@ -366,3 +387,73 @@ void CStructureSeqIndexHI::SaveData(CXMLElement* p_ele)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+CStructureSuperCellHI::CStructureSuperCellHI(CStructure* p_mol,const CSuperCellBuilder& builder)
+    : CHistoryItem(&StructureSuperCellHIObject,p_mol->GetProject(),EHID_FORWARD)
+{
+    MoleculeIndex = p_mol->GetIndex();
+    Builder = builder;
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CStructureSuperCellHI::GetMemoryUsage(void)
+{
+    return(HISTORY_ITEM_SIZE + Builder.GetMemoryUsage());
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureSuperCellHI::Forward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    Builder.Build(p_mol);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureSuperCellHI::Backward(void)
+{
+    CStructure* p_mol = dynamic_cast<CStructure*>(GetProject()->FindObject(MoleculeIndex));
+    if(p_mol == NULL) return;
+
+    Builder.Revert(p_mol);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureSuperCellHI::LoadData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // load core data ----------------------------
+    CHistoryItem::LoadData(p_ele);
+
+    // load local data ---------------------------
+    p_ele->GetAttribute("mi",MoleculeIndex);
+    Builder.Load(p_ele);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureSuperCellHI::SaveData(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    // save core data ----------------------------
+    CHistoryItem::SaveData(p_ele);
+
+    // save local data ---------------------------
+    p_ele->SetAttribute("mi",MoleculeIndex);
+    Builder.Save(p_ele);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
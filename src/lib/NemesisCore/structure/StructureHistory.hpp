@@ -24,6 +24,7 @@
 #include <HistoryItem.hpp>
 #include <Point.hpp>
 #include <XMLDocument.hpp>
+#include <SuperCellBuilder.hpp>
 
 //------------------------------------------------------------------------------
 
@@ -39,10 +40,15 @@ public:
     CStructureHI(CProject* p_object);
     CStructureHI(CStructure* p_atom,EHistoryItemDirection change);
 
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
 // section of private data -----------------------------------------------------
 private:
     int             MoleculeIndex;
     CXMLDocument    StructureData;
+    int             NumOfObjects;   // number of residues, atoms, and bonds in StructureData
 
 // executive methods -----------------------------------------------------------
     /// perform the change in the forward direction
@@ -160,4 +166,43 @@ private:
 //------------------------------------------------------------------------------
 //==============================================================================
 
+/// residues, atoms, and bonds created by CStructure::BuildSuperCellWH
+/*! only the builder setup and indexes of created objects are kept,
+    the redo builds identical objects from the original cell
+*/
+
+class CStructureSuperCellHI : public CHistoryItem {
+public:
+// constructors and destructors ------------------------------------------------
+    CStructureSuperCellHI(CProject* p_object);
+    CStructureSuperCellHI(CStructure* p_mol,const CSuperCellBuilder& builder);
+
+// information methods ---------------------------------------------------------
+    /// get approximate size of memory occupied by the item
+    virtual qint64 GetMemoryUsage(void);
+
+// section of private data -----------------------------------------------------
+private:
+    int                 MoleculeIndex;
+    CSuperCellBuilder   Builder;
+
+// executive methods -----------------------------------------------------------
+    /// perform the change in the forward direction
+    virtual void Forward(void);
+
+    /// perform the change in the backward direction
+    virtual void Backward(void);
+
+// input/output methods --------------------------------------------------------
+    /// load data
+    virtual void LoadData(CXMLElement* p_ele);
+
+    /// save data
+    virtual void SaveData(CXMLElement* p_ele);
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 #endif
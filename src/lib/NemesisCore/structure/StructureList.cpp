@@ -33,6 +33,7 @@
 #include <BondList.hpp>
 #include <ResidueList.hpp>
 #include <RestraintList.hpp>
+#include <QTimer>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -59,8 +60,15 @@ CStructureList::CStructureList(CProject* p_project)
     ActiveStructure = NULL;
     GeometryUpdateLevel = 0;
     Changed = false;
+    FlagsChanged = false;
     UpdateLevel = 0;
     ForceSorting = false;
+
+    GeometryTimer = new QTimer(this);
+    GeometryTimer->setSingleShot(true);
+    connect(GeometryTimer,SIGNAL(timeout(void)),
+            this,SLOT(EmitGeometryChangeTick(void)));
+    LastGeometryTick.start();
 }
 
 //------------------------------------------------------------------------------
@@ -73,8 +81,15 @@ CStructureList::CStructureList(CProject* p_project,bool no_index)
     ActiveStructure = NULL;
     GeometryUpdateLevel = 0;
     Changed = false;
+    FlagsChanged = false;
     UpdateLevel = 0;
     ForceSorting = false;
+
+    GeometryTimer = new QTimer(this);
+    GeometryTimer->setSingleShot(true);
+    connect(GeometryTimer,SIGNAL(timeout(void)),
+            this,SLOT(EmitGeometryChangeTick(void)));
+    LastGeometryTick.start();
 }
 
 //------------------------------------------------------------------------------
@@ -709,7 +724,8 @@ void CStructureList::EndGeometryUpdate(bool no_event)
     }
     GeometryUpdateLevel--;
     if( GeometryUpdateLevel == 0 ){
-        if( ! no_event ) NotifyGeometryChangeTick();
+        // changed structures were already recorded by their EndGeometryUpdate
+        if( ! no_event ) ScheduleGeometryChangeTick();
     }
 }
 
@@ -717,10 +733,73 @@ void CStructureList::EndGeometryUpdate(bool no_event)
 
 void CStructureList::NotifyGeometryChangeTick(void)
 {
-    if( GeometryUpdateLevel > 0 ){
-        return;
+    // positions can be changed by trajectory or manipulators
+    foreach(QObject* p_qobj,children()) {
+        CStructure* p_str = static_cast<CStructure*>(p_qobj);
+        p_str->InvalidateSpatialIndex();
+        PendingGeometryChanges.AddStructure(p_str);
+    }
+
+    ScheduleGeometryChangeTick();
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureList::NotifyGeometryChangeTick(CStructure* p_str)
+{
+    if( p_str == NULL ) return;
+
+    p_str->InvalidateSpatialIndex();
+    if( PendingGeometryChanges.IsChanged(p_str) == false ){
+        PendingGeometryChanges.AddStructure(p_str);
     }
+
+    ScheduleGeometryChangeTick();
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureList::AddGeometryChange(CAtom* p_atom)
+{
+    PendingGeometryChanges.AddAtom(p_atom);
+}
+
+//------------------------------------------------------------------------------
+
+const CGeometryChangeSet& CStructureList::GetGeometryChanges(void) const
+{
+    return(GeometryChanges);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureList::ScheduleGeometryChangeTick(void)
+{
+    // EndGeometryUpdate schedules the tick again
+    if( GeometryUpdateLevel > 0 ) return;
+    if( GeometryTimer->isActive() ) return;
+
+    qint64 delay = GEOMETRY_TICK_INTERVAL - LastGeometryTick.elapsed();
+    if( delay < 0 ) delay = 0;
+    GeometryTimer->start(delay);
+}
+
+//------------------------------------------------------------------------------
+
+void CStructureList::EmitGeometryChangeTick(void)
+{
+    if( GeometryUpdateLevel > 0 ) return;
+    if( PendingGeometryChanges.IsEmpty() ) return;
+
+    // changes recorded by listeners are delivered with the next tick
+    GeometryChanges = PendingGeometryChanges;
+    PendingGeometryChanges.Clear();
+    GeometryChanges.Finalize();
+
+    LastGeometryTick.start();
     emit OnGeometryChangeTick();
+
+    GeometryChanges.Clear();
 }
 
 //==============================================================================
@@ -751,6 +830,10 @@ void CStructureList::EndUpdate(bool do_not_sort)
             emit OnStructureListChanged();
             Changed = false;
         }
+        if( FlagsChanged ){
+            emit OnObjectFlagsChanged();
+            FlagsChanged = false;
+        }
     }
 }
 
@@ -764,6 +847,14 @@ void CStructureList::EmitOnStructureListChanged(void)
 
 //------------------------------------------------------------------------------
 
+void CStructureList::EmitOnObjectFlagsChanged(void)
+{
+    if( UpdateLevel > 0 ) FlagsChanged = true;
+    emit OnObjectFlagsChanged();
+}
+
+//------------------------------------------------------------------------------
+
 void CStructureList::ListSizeChanged(bool do_not_sort)
 {
     ForceSorting = ! do_not_sort;
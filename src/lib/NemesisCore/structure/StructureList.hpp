@@ -22,6 +22,17 @@
 
 #include <NemesisCoreMainHeader.hpp>
 #include <Structure.hpp>
+#include <GeometryChangeSet.hpp>
+#include <QElapsedTimer>
+
+// -----------------------------------------------------------------------------
+
+class QTimer;
+
+// -----------------------------------------------------------------------------
+
+/// minimum interval between two OnGeometryChangeTick signals in ms
+#define GEOMETRY_TICK_INTERVAL  16
 
 // -----------------------------------------------------------------------------
 
@@ -142,9 +153,22 @@ public:
     /// end geometry update
     void EndGeometryUpdate(bool no_event=false);
 
-    /// emit OnGeometryChangeTick signal
+    /// schedule OnGeometryChangeTick signal, all atoms were changed
     void NotifyGeometryChangeTick(void);
 
+    /// schedule OnGeometryChangeTick signal, atoms of the structure were changed
+    /*! the whole structure is marked as changed only if none of its atoms
+        was recorded by AddGeometryChange
+    */
+    void NotifyGeometryChangeTick(CStructure* p_str);
+
+    /// record atom with changed position or velocity
+    /*! atoms are recorded only outside of geometry updates of their structure */
+    void AddGeometryChange(CAtom* p_atom);
+
+    /// get changes delivered by the current OnGeometryChangeTick signal
+    const CGeometryChangeSet& GetGeometryChanges(void) const;
+
 // external notification -------------------------------------------------------
     /// block signals for massive update, only structures
     void BeginUpdate(void);
@@ -155,6 +179,9 @@ public:
     /// emit OnStructureListChanged signal
     void EmitOnStructureListChanged(void);
 
+    /// emit OnObjectFlagsChanged signal
+    void EmitOnObjectFlagsChanged(void);
+
     /// list size changed
     void ListSizeChanged(bool do_not_sort=false);
 
@@ -163,7 +190,13 @@ signals:
     /// emmited when structure list is changed
     void OnStructureListChanged(void);
 
+    /// emmited when flags of a structure or of its atoms, residues or bonds are changed
+    void OnObjectFlagsChanged(void);
+
     /// extra signal when geometry was changed
+    /*! ticks are coalesced, at most one signal is emitted per
+        GEOMETRY_TICK_INTERVAL, see GetGeometryChanges
+    */
     void OnGeometryChangeTick(void);
 
 // section of private data -----------------------------------------------------
@@ -171,12 +204,26 @@ private:
     CStructure*     ActiveStructure;
     int             GeometryUpdateLevel;
     bool            Changed;
+    bool            FlagsChanged;
     int             UpdateLevel;
     bool            ForceSorting;
 
+    // geometry change notification
+    CGeometryChangeSet  PendingGeometryChanges;
+    CGeometryChangeSet  GeometryChanges;
+    QTimer*             GeometryTimer;
+    QElapsedTimer       LastGeometryTick;
+
     static bool LessThanBySeqIndex(CStructure* p_left,CStructure* p_right);
 
+    /// start timer for the next OnGeometryChangeTick
+    void ScheduleGeometryChangeTick(void);
+
     friend class CStructure;
+
+private slots:
+    /// emit pending geometry changes
+    void EmitGeometryChangeTick(void);
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,476 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <SuperCellBuilder.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <BondList.hpp>
+#include <Bond.hpp>
+#include <ResidueList.hpp>
+#include <Residue.hpp>
+#include <Project.hpp>
+#include <XMLElement.hpp>
+#include <ErrorSystem.hpp>
+#include <SimpleVector.hpp>
+#include <QHash>
+#include <math.h>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSuperCellBuilder::CSuperCellBuilder(void)
+{
+    Translation = false;
+    KA = KB = KC = 1;
+    VA = VB = VC = 0;
+    N = 1;
+    SetupImages();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSuperCellBuilder::SetSuperCell(int ka,int kb,int kc)
+{
+    if( (ka < 1) || (kb < 1) || (kc < 1) ){
+        INVALID_ARGUMENT("ka, kb, and kc must be positive");
+    }
+
+    Translation = false;
+    KA = ka;
+    KB = kb;
+    KC = kc;
+    SetupImages();
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::SetTranslation(int va,int vb,int vc,int n)
+{
+    if( n < 1 ){
+        INVALID_ARGUMENT("n must be positive");
+    }
+
+    Translation = true;
+    VA = va;
+    VB = vb;
+    VC = vc;
+    N = n;
+    SetupImages();
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::SetupImages(void)
+{
+    Images.clear();
+    if( Translation ){
+        for(int i=0; i < N; i++){
+            Images << VA*i << VB*i << VC*i;
+        }
+    } else {
+        // the order must be the same as in GetShiftedImage
+        for(int i=0; i < KA; i++){
+            for(int j=0; j < KB; j++){
+                for(int k=0; k < KC; k++){
+                    Images << i << j << k;
+                }
+            }
+        }
+    }
+
+    // recorded data are not valid for the new setup
+    ResidueIndexes.clear();
+    AtomIndexes.clear();
+    BondIndexes.clear();
+    RewiredBonds.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSuperCellBuilder::Build(CStructure* p_str)
+{
+    if( p_str == NULL ){
+        INVALID_ARGUMENT("p_str is NULL");
+    }
+
+    int nimages = GetNumberOfImages();
+    if( nimages <= 1 ) return;
+
+    // source objects -------------------------------
+    QList<CResidue*>        residues;
+    QHash<CResidue*,int>    residue_pos;
+    foreach(QObject* p_qobj,p_str->GetResidues()->children()){
+        CResidue* p_res = static_cast<CResidue*>(p_qobj);
+        residue_pos.insert(p_res,residues.count());
+        residues.append(p_res);
+    }
+
+    QVector<CAtom*>         atoms;
+    QHash<CAtom*,int>       atom_pos;
+    atoms.reserve(p_str->GetAtoms()->children().count()*nimages);
+    foreach(QObject* p_qobj,p_str->GetAtoms()->children()){
+        CAtom* p_atom = static_cast<CAtom*>(p_qobj);
+        atom_pos.insert(p_atom,atoms.count());
+        atoms.append(p_atom);
+    }
+
+    QList<CBond*>           bonds;
+    foreach(QObject* p_qobj,p_str->GetBonds()->children()){
+        CBond* p_bond = static_cast<CBond*>(p_qobj);
+        if( p_bond->IsInvalidBond() ) continue;
+        bonds.append(p_bond);
+    }
+
+    int nres = residues.count();
+    int natoms = atoms.count();
+    int nbonds = bonds.count();
+
+    // objects created by the previous build get the same indexes
+    bool reuse = (ResidueIndexes.count() == nres*(nimages-1))
+              && (AtomIndexes.count() == natoms*(nimages-1))
+              && (BondIndexes.count() == nbonds*(nimages-1));
+    if( reuse == false ){
+        ResidueIndexes.resize(nres*(nimages-1));
+        AtomIndexes.resize(natoms*(nimages-1));
+        BondIndexes.resize(nbonds*(nimages-1));
+    }
+
+    // lattice offsets of bonds ---------------------
+    // the second atom is bonded with the image of the first atom shifted by the offset
+    QVector<int> shifts(3*nbonds);
+    for(int b=0; b < nbonds; b++){
+        CBond* p_bond = bonds[b];
+        CPoint fvec = p_str->PBCInfo.FractionalVector(p_bond->A2->Pos - p_bond->A1->Pos);
+        shifts[3*b+0] = p_str->PBCInfo.IsPeriodicAlongA() ? -(int)floor(fvec.x + 0.5) : 0;
+        shifts[3*b+1] = p_str->PBCInfo.IsPeriodicAlongB() ? -(int)floor(fvec.y + 0.5) : 0;
+        shifts[3*b+2] = p_str->PBCInfo.IsPeriodicAlongC() ? -(int)floor(fvec.z + 0.5) : 0;
+    }
+
+    p_str->BeginUpdate();
+
+    CResidueList*   p_residues = p_str->GetResidues();
+    CAtomList*      p_atoms = p_str->GetAtoms();
+    CBondList*      p_bonds = p_str->GetBonds();
+
+    int top_seq_index = p_residues->GetTopSeqIndex();
+    int top_ser_index = p_atoms->GetTopSerIndex();
+
+    // replicate residues and atoms -----------------
+    QVector<CResidue*> new_residues(nres);
+    for(int img=1; img < nimages; img++){
+        CPoint offset = p_str->PBCInfo.GetAVector()*Images[3*img+0]
+                      + p_str->PBCInfo.GetBVector()*Images[3*img+1]
+                      + p_str->PBCInfo.GetCVector()*Images[3*img+2];
+
+        for(int r=0; r < nres; r++){
+            CResidue* p_src = residues[r];
+            CResidue* p_res = new CResidue(p_residues,true);
+            SetObjectIndex(p_res,ResidueIndexes,(img-1)*nres+r,reuse);
+            p_res->SetName(p_src->GetName());
+            if( ! p_src->GetDescription().isEmpty() ){
+                p_res->SetDescription(p_src->GetDescription());
+            }
+            CopyObjectData(p_src,p_res);
+            top_seq_index++;
+            p_res->SeqIndex = top_seq_index;
+            p_res->Chain = p_src->Chain;
+            p_res->Type = p_src->Type;
+            new_residues[r] = p_res;
+        }
+
+        for(int a=0; a < natoms; a++){
+            CAtom* p_src = atoms[a];
+            CAtom* p_atom = new CAtom(p_atoms,true);
+            SetObjectIndex(p_atom,AtomIndexes,(img-1)*natoms+a,reuse);
+            p_atom->SetName(p_src->GetName());
+            if( ! p_src->GetDescription().isEmpty() ){
+                p_atom->SetDescription(p_src->GetDescription());
+            }
+            CopyObjectData(p_src,p_atom);
+            top_ser_index++;
+            p_atom->SerIndex = top_ser_index;
+            p_atom->LocIndex = p_src->LocIndex;
+            p_atom->Z = p_src->Z;
+            p_atom->AtomType = p_src->AtomType;
+            p_atom->Charge = p_src->Charge;
+            p_atom->Pos = p_src->Pos + offset;
+            p_atom->Vel = p_src->Vel;
+            if( p_src->Residue != NULL ){
+                new_residues[residue_pos.value(p_src->Residue)]->AddAtom(p_atom);
+            }
+            atoms.append(p_atom);
+        }
+    }
+    p_residues->ListSizeChanged();
+    p_atoms->ListSizeChanged();
+
+    // replicate bonds ------------------------------
+    for(int img=1; img < nimages; img++){
+        for(int b=0; b < nbonds; b++){
+            CBond* p_src = bonds[b];
+            int timg = GetShiftedImage(img,shifts[3*b+0],shifts[3*b+1],shifts[3*b+2]);
+            if( timg < 0 ) timg = img;  // the bond remains periodic
+
+            CBond* p_bond = new CBond(p_bonds,true);
+            SetObjectIndex(p_bond,BondIndexes,(img-1)*nbonds+b,reuse);
+            p_bond->SetName(p_src->GetName());
+            if( ! p_src->GetDescription().isEmpty() ){
+                p_bond->SetDescription(p_src->GetDescription());
+            }
+            CopyObjectData(p_src,p_bond);
+            p_bond->Order = p_src->Order;
+            p_bond->Type = p_src->Type;
+            p_bond->A1 = atoms[img*natoms + atom_pos.value(p_src->A1)];
+            p_bond->A1->RegisterBond(p_bond);
+            p_bond->A2 = atoms[timg*natoms + atom_pos.value(p_src->A2)];
+            p_bond->A2->RegisterBond(p_bond);
+        }
+    }
+
+    // connect bonds of the original cell -----------
+    RewiredBonds.clear();
+    for(int b=0; b < nbonds; b++){
+        CBond* p_bond = bonds[b];
+        int timg = GetShiftedImage(0,shifts[3*b+0],shifts[3*b+1],shifts[3*b+2]);
+        if( timg <= 0 ) continue;
+        RewiredBonds << p_bond->GetIndex() << p_bond->A2->GetIndex();
+        p_bond->A2->UnregisterBond(p_bond);
+        p_bond->A2 = atoms[timg*natoms + atom_pos.value(p_bond->A2)];
+        p_bond->A2->RegisterBond(p_bond);
+    }
+    p_bonds->ListSizeChanged();
+
+    p_str->EndUpdate();
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::Revert(CStructure* p_str)
+{
+    if( p_str == NULL ){
+        INVALID_ARGUMENT("p_str is NULL");
+    }
+
+    CProject* p_project = p_str->GetProject();
+
+    p_str->BeginUpdate();
+
+    // reconnect bonds of the original cell
+    for(int i=0; i+1 < RewiredBonds.count(); i += 2){
+        CBond* p_bond = dynamic_cast<CBond*>(p_project->FindObject(RewiredBonds[i]));
+        CAtom* p_atom = dynamic_cast<CAtom*>(p_project->FindObject(RewiredBonds[i+1]));
+        if( (p_bond == NULL) || (p_atom == NULL) ) continue;
+        if( p_bond->A2 != NULL ) p_bond->A2->UnregisterBond(p_bond);
+        p_bond->A2 = p_atom;
+        p_bond->A2->RegisterBond(p_bond);
+    }
+
+    // remove images
+    for(int i=BondIndexes.count()-1; i >= 0; i--){
+        CBond* p_bond = dynamic_cast<CBond*>(p_project->FindObject(BondIndexes[i]));
+        if( p_bond == NULL ) continue;
+        p_bond->RemoveFromBaseList();
+    }
+    for(int i=AtomIndexes.count()-1; i >= 0; i--){
+        CAtom* p_atom = dynamic_cast<CAtom*>(p_project->FindObject(AtomIndexes[i]));
+        if( p_atom == NULL ) continue;
+        p_atom->RemoveFromBaseList();
+    }
+    for(int i=ResidueIndexes.count()-1; i >= 0; i--){
+        CResidue* p_res = dynamic_cast<CResidue*>(p_project->FindObject(ResidueIndexes[i]));
+        if( p_res == NULL ) continue;
+        p_res->RemoveFromBaseList();
+    }
+
+    p_str->EndUpdate();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CSuperCellBuilder::GetNumberOfImages(void) const
+{
+    return(Images.count()/3);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CSuperCellBuilder::GetMemoryUsage(void) const
+{
+    return( (qint64)(ResidueIndexes.count() + AtomIndexes.count()
+                     + BondIndexes.count() + RewiredBonds.count())*sizeof(int) );
+}
+
+//------------------------------------------------------------------------------
+
+int CSuperCellBuilder::GetShiftedImage(int image,int sa,int sb,int sc) const
+{
+    if( (sa == 0) && (sb == 0) && (sc == 0) ) return(image);
+
+    if( Translation == false ){
+        // images are wrapped into the super cell
+        int ia = ((Images[3*image+0] + sa) % KA + KA) % KA;
+        int ib = ((Images[3*image+1] + sb) % KB + KB) % KB;
+        int ic = ((Images[3*image+2] + sc) % KC + KC) % KC;
+        return( (ia*KB + ib)*KC + ic );
+    }
+
+    // the offset must be a multiple of the transformation vector
+    int  m = 0;
+    bool set = false;
+    int  v[3] = { VA, VB, VC };
+    int  s[3] = { sa, sb, sc };
+    for(int i=0; i < 3; i++){
+        if( v[i] == 0 ){
+            if( s[i] != 0 ) return(-1);
+            continue;
+        }
+        if( s[i] % v[i] != 0 ) return(-1);
+        if( set && (m != s[i] / v[i]) ) return(-1);
+        m = s[i] / v[i];
+        set = true;
+    }
+    if( set == false ) return(-1);
+
+    int timage = image + m;
+    if( (timage < 0) || (timage >= N) ) return(-1);
+    return(timage);
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::SetObjectIndex(CProObject* p_obj,QVector<int>& indexes,
+                                       int pos,bool reuse)
+{
+    if( reuse ){
+        p_obj->SetIndex(indexes[pos]);
+    } else {
+        p_obj->SetIndex(p_obj->GetProject()->GetFreeObjectIndex());
+        indexes[pos] = p_obj->GetIndex();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::CopyObjectData(CProObject* p_src,CProObject* p_img)
+{
+    // the same data as in CProObject::LoadData, flags are set directly
+    // because SetFlags would emit signals for each object
+    CProObjectFlags mask = CProObjectFlags(QFlag(EPOF_SAVE_MASK));
+    p_img->Flags = (p_img->Flags & (~mask)) | (p_src->Flags & mask);
+
+    CXMLElement* p_sdata = p_src->GetDesignerData();
+    if( p_sdata == NULL ) return;
+
+    CXMLElement* p_idata = p_img->GetDesignerData(true);
+    p_idata->RemoveAllChildNodes();
+    p_idata->RemoveAllAttributes();
+    p_idata->CopyContentsFrom(p_sdata);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSuperCellBuilder::Load(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    p_ele->GetAttribute("tr",Translation);
+    p_ele->GetAttribute("ka",KA);
+    p_ele->GetAttribute("kb",KB);
+    p_ele->GetAttribute("kc",KC);
+    p_ele->GetAttribute("va",VA);
+    p_ele->GetAttribute("vb",VB);
+    p_ele->GetAttribute("vc",VC);
+    p_ele->GetAttribute("n",N);
+    SetupImages();
+
+    LoadIndexes(p_ele,"ri",ResidueIndexes);
+    LoadIndexes(p_ele,"ai",AtomIndexes);
+    LoadIndexes(p_ele,"bi",BondIndexes);
+    LoadIndexes(p_ele,"rw",RewiredBonds);
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::Save(CXMLElement* p_ele)
+{
+    if( p_ele == NULL ){
+        INVALID_ARGUMENT("p_ele is NULL");
+    }
+
+    p_ele->SetAttribute("tr",Translation);
+    p_ele->SetAttribute("ka",KA);
+    p_ele->SetAttribute("kb",KB);
+    p_ele->SetAttribute("kc",KC);
+    p_ele->SetAttribute("va",VA);
+    p_ele->SetAttribute("vb",VB);
+    p_ele->SetAttribute("vc",VC);
+    p_ele->SetAttribute("n",N);
+
+    SaveIndexes(p_ele,"ri",ResidueIndexes);
+    SaveIndexes(p_ele,"ai",AtomIndexes);
+    SaveIndexes(p_ele,"bi",BondIndexes);
+    SaveIndexes(p_ele,"rw",RewiredBonds);
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::LoadIndexes(CXMLElement* p_ele,const QString& name,QVector<int>& indexes)
+{
+    indexes.clear();
+    CXMLBinData* p_bele = p_ele->GetFirstChildBinData(name);
+    if( p_bele == NULL ) return;
+
+    CSimpleVector<int> data;
+    data.Load(p_bele);
+    indexes.resize(data.GetLength());
+    for(int i=0; i < data.GetLength(); i++){
+        indexes[i] = data[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSuperCellBuilder::SaveIndexes(CXMLElement* p_ele,const QString& name,const QVector<int>& indexes)
+{
+    CSimpleVector<int> data;
+    data.CreateVector(indexes.count());
+    for(int i=0; i < indexes.count(); i++){
+        data[i] = indexes[i];
+    }
+    CXMLBinData* p_bele = p_ele->CreateChildBinData(name);
+    data.Save(p_bele);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
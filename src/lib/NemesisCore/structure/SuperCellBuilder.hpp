@@ -0,0 +1,111 @@
+#ifndef SuperCellBuilderH
+#define SuperCellBuilderH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+class CStructure;
+class CProObject;
+class CXMLElement;
+
+// -----------------------------------------------------------------------------
+
+///  replicate residues, atoms, and bonds of a periodic structure
+/*! images are created directly from the structure objects, bonds crossing
+    the cell boundary are connected to atoms of the neighbouring image by their
+    lattice offset, which is determined only once for each bond,
+    indexes of created objects are recorded, so the next build creates identical
+    objects, see CStructureSuperCellHI
+*/
+
+class NEMESIS_CORE_PACKAGE CSuperCellBuilder {
+public:
+// constructor -----------------------------------------------------------------
+    CSuperCellBuilder(void);
+
+// setup methods ---------------------------------------------------------------
+    /// ka,kb,kc - dimensions of super cell, bonds are wrapped into the new cell
+    void SetSuperCell(int ka,int kb,int kc);
+
+    /// va,vb,vc - transformation vector, n - number of repeats
+    void SetTranslation(int va,int vb,int vc,int n);
+
+// executive methods -----------------------------------------------------------
+    /// replicate the structure
+    /*! the box is not changed */
+    void Build(CStructure* p_str);
+
+    /// revert the build
+    void Revert(CStructure* p_str);
+
+// information methods ---------------------------------------------------------
+    /// get number of images including the original cell
+    int GetNumberOfImages(void) const;
+
+    /// get approximate size of memory occupied by recorded data
+    qint64 GetMemoryUsage(void) const;
+
+// input/output methods --------------------------------------------------------
+    /// load setup and recorded indexes
+    void Load(CXMLElement* p_ele);
+
+    /// save setup and recorded indexes
+    void Save(CXMLElement* p_ele);
+
+// section of private data -----------------------------------------------------
+private:
+    bool                Translation;
+    int                 KA,KB,KC;
+    int                 VA,VB,VC,N;
+    QVector<int>        Images;             // lattice offsets of images as triplets
+
+    // recorded data
+    QVector<int>        ResidueIndexes;     // created objects
+    QVector<int>        AtomIndexes;
+    QVector<int>        BondIndexes;
+    QVector<int>        RewiredBonds;       // bond and its original second atom
+
+    /// set lattice offsets of images
+    void SetupImages(void);
+
+    /// get image which is shifted by the lattice offset from the image or -1
+    int GetShiftedImage(int image,int sa,int sb,int sc) const;
+
+    /// set index of created object
+    static void SetObjectIndex(CProObject* p_obj,QVector<int>& indexes,
+                               int pos,bool reuse);
+
+    /// copy persistent flags and designer data of the source object to its image
+    static void CopyObjectData(CProObject* p_src,CProObject* p_img);
+
+    /// load indexes from binary data
+    static void LoadIndexes(CXMLElement* p_ele,const QString& name,QVector<int>& indexes);
+
+    /// save indexes into binary data
+    static void SaveIndexes(CXMLElement* p_ele,const QString& name,const QVector<int>& indexes);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -121,6 +121,33 @@ void CSnapshot::SetProperty(int key,double value)
     ScalarProperties[key] = value;
 }
 
+//------------------------------------------------------------------------------
+
+void CSnapshot::CopyFrom(CSnapshot* p_src)
+{
+    if( p_src == NULL ) return;
+
+    if( Coordinates.GetLength() != p_src->Coordinates.GetLength() ){
+        Coordinates.CreateVector(p_src->Coordinates.GetLength());
+    }
+    for(int i=0; i < Coordinates.GetLength(); i++){
+        Coordinates[i] = p_src->Coordinates[i];
+    }
+
+    if( p_src->Velocities.GetLength() == 0 ){
+        Velocities.FreeVector();
+    } else {
+        if( Velocities.GetLength() != p_src->Velocities.GetLength() ){
+            Velocities.CreateVector(p_src->Velocities.GetLength());
+        }
+        for(int i=0; i < Velocities.GetLength(); i++){
+            Velocities[i] = p_src->Velocities[i];
+        }
+    }
+
+    ScalarProperties = p_src->ScalarProperties;
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -61,6 +61,9 @@ public:
     /// get property
     void SetProperty(int key,double value);
 
+    /// copy coordinates, velocities and properties from other snapshot
+    void CopyFrom(CSnapshot* p_src);
+
 public:
     CSimpleVector<CPoint>   Coordinates;
     CSimpleVector<CPoint>   Velocities;         // optional velocities
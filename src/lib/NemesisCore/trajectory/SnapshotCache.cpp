@@ -0,0 +1,424 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <SnapshotCache.hpp>
+#include <Snapshot.hpp>
+#include <TrajectorySegment.hpp>
+#include <Point.hpp>
+
+//------------------------------------------------------------------------------
+
+// default memory budget in MB
+#define SNAPSHOT_CACHE_BUDGET   256
+
+// default number of prefetched snapshots
+#define SNAPSHOT_CACHE_DEPTH    16
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSnapshotCacheItem::CSnapshotCacheItem(void)
+{
+    Segment = NULL;
+    Index = 0;
+    Snapshot = NULL;
+    Size = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshotCacheItem::CSnapshotCacheItem(CTrajectorySegment* p_seg,long int index)
+{
+    Segment = p_seg;
+    Index = index;
+    Snapshot = NULL;
+    Size = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshotCacheKey CSnapshotCacheItem::GetKey(void) const
+{
+    return( CSnapshotCacheKey(Segment,Index) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSnapshotCache::CSnapshotCache(QObject* p_parent)
+    : QThread(p_parent)
+{
+    Current = NULL;
+    Recent = NULL;
+    MemoryBudget = (qint64)SNAPSHOT_CACHE_BUDGET*1024*1024;
+    MemoryUsage = 0;
+    PrefetchDepth = SNAPSHOT_CACHE_DEPTH;
+    NumOfAtoms = 0;
+    Generation = 0;
+    Terminate = false;
+
+    start(QThread::LowPriority);
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshotCache::~CSnapshotCache(void)
+{
+    CacheMutex.lock();
+    Terminate = true;
+    Requests.clear();
+    RequestCond.wakeAll();
+    CacheMutex.unlock();
+
+    wait();
+
+    Clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSnapshotCache::SetMemoryBudget(qint64 budget)
+{
+    QMutexLocker lock(&CacheMutex);
+    if( budget < 0 ) budget = 0;
+    MemoryBudget = budget;
+    Shrink();
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::SetPrefetchDepth(int depth)
+{
+    QMutexLocker lock(&CacheMutex);
+    if( depth < 0 ) depth = 0;
+    PrefetchDepth = depth;
+    while( Requests.count() > PrefetchDepth ) Requests.removeLast();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSnapshot* CSnapshotCache::Find(CTrajectorySegment* p_seg,long int index)
+{
+    QMutexLocker lock(&CacheMutex);
+
+    QHash<CSnapshotCacheKey,CItemList::iterator>::iterator hit;
+    hit = ItemIndex.find(CSnapshotCacheKey(p_seg,index));
+    if( hit == ItemIndex.end() ) return(NULL);
+
+    // iterators stay valid when the item is moved to the front
+    Items.splice(Items.begin(),Items,hit.value());
+
+    Recent = Items.front().Snapshot;
+    return(Recent);
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::Insert(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap)
+{
+    if( p_snap == NULL ) return;
+
+    QMutexLocker lock(&CacheMutex);
+
+    // the snapshot might be prefetched in the meantime
+    QHash<CSnapshotCacheKey,CItemList::iterator>::iterator hit;
+    hit = ItemIndex.find(CSnapshotCacheKey(p_seg,index));
+    if( hit != ItemIndex.end() ){
+        RemoveItem(hit.value());
+    }
+
+    InsertItem(p_seg,index,p_snap);
+    Recent = p_snap;
+    Shrink();
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::SetCurrent(CSnapshot* p_snap)
+{
+    QMutexLocker lock(&CacheMutex);
+    Current = p_snap;
+    Shrink();
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::Prefetch(const QList<CSnapshotCacheItem>& requests,int natoms)
+{
+    QMutexLocker lock(&CacheMutex);
+
+    Requests.clear();
+    NumOfAtoms = natoms;
+
+    // do not prefetch more than the budget can keep
+    qint64 size = GetSnapshotSize(natoms,false);
+    int    depth = PrefetchDepth;
+    if( size > 0 ){
+        qint64 max_depth = MemoryBudget / size - 1;
+        if( max_depth < depth ) depth = max_depth;
+    }
+
+    foreach(CSnapshotCacheItem item, requests){
+        if( Requests.count() >= depth ) break;
+        if( item.Segment == NULL ) continue;
+        if( ItemIndex.contains(item.GetKey()) ) continue;
+        Requests.append(CSnapshotCacheItem(item.Segment,item.Index));
+    }
+
+    if( Requests.count() > 0 ) RequestCond.wakeAll();
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::RemoveSegment(CTrajectorySegment* p_seg)
+{
+    QMutexLocker lock(&CacheMutex);
+
+    for(int i=Requests.count()-1; i >= 0; i--){
+        if( Requests.at(i).Segment == p_seg ) Requests.removeAt(i);
+    }
+
+    // segment data will be released, wait for the worker and readers
+    Generation++;
+    while( (Processing.Segment == p_seg) || Readers.contains(p_seg) ){
+        DoneCond.wait(&CacheMutex);
+    }
+
+    CItemList::iterator it = Items.begin();
+    while( it != Items.end() ){
+        if( it->Segment != p_seg ){
+            it++;
+            continue;
+        }
+        it = RemoveItem(it);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::Clear(void)
+{
+    QMutexLocker lock(&CacheMutex);
+
+    Requests.clear();
+    for(CItemList::iterator it = Items.begin(); it != Items.end(); it++){
+        delete it->Snapshot;
+    }
+    Items.clear();
+    ItemIndex.clear();
+    MemoryUsage = 0;
+    Current = NULL;
+    Recent = NULL;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CSnapshotCache::CopySnapshot(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap,
+                                  quint64 generation)
+{
+    if( (p_seg == NULL) || (p_snap == NULL) ) return(false);
+
+    CacheMutex.lock();
+
+    // the segment might be already released
+    if( generation != Generation ){
+        CacheMutex.unlock();
+        return(false);
+    }
+
+    CSnapshotCacheItem* p_item = FindItem(p_seg,index);
+    if( p_item != NULL ){
+        p_snap->CopyFrom(p_item->Snapshot);
+        CacheMutex.unlock();
+        return(true);
+    }
+
+    Readers[p_seg]++;
+    CacheMutex.unlock();
+
+    // RemoveSegment waits until the segment is decoded
+    bool result = p_seg->CopySnapshot(index,p_snap);
+
+    CacheMutex.lock();
+    if( --Readers[p_seg] == 0 ) Readers.remove(p_seg);
+    DoneCond.wakeAll();
+    CacheMutex.unlock();
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+quint64 CSnapshotCache::GetGeneration(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(Generation);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+qint64 CSnapshotCache::GetMemoryBudget(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(MemoryBudget);
+}
+
+//------------------------------------------------------------------------------
+
+int CSnapshotCache::GetPrefetchDepth(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(PrefetchDepth);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CSnapshotCache::GetMemoryUsage(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(MemoryUsage);
+}
+
+//------------------------------------------------------------------------------
+
+int CSnapshotCache::GetNumberOfSnapshots(void)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(ItemIndex.count());
+}
+
+//------------------------------------------------------------------------------
+
+bool CSnapshotCache::IsCached(CTrajectorySegment* p_seg,long int index)
+{
+    QMutexLocker lock(&CacheMutex);
+    return(ItemIndex.contains(CSnapshotCacheKey(p_seg,index)));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSnapshotCache::run(void)
+{
+    CacheMutex.lock();
+
+    while( Terminate == false ){
+        if( Requests.count() == 0 ){
+            RequestCond.wait(&CacheMutex);
+            continue;
+        }
+
+        Processing = Requests.takeFirst();
+        if( ItemIndex.contains(Processing.GetKey()) ){
+            Processing = CSnapshotCacheItem();
+            continue;
+        }
+        int natoms = NumOfAtoms;
+        CacheMutex.unlock();
+
+        // decode snapshot, the segment cannot release its data while it is processed
+        CSnapshot* p_snap = new CSnapshot(Processing.Segment);
+        p_snap->Coordinates.CreateVector(natoms);
+        bool result = Processing.Segment->CopySnapshot(Processing.Index,p_snap);
+
+        CacheMutex.lock();
+        if( result && (ItemIndex.contains(Processing.GetKey()) == false) ){
+            InsertItem(Processing.Segment,Processing.Index,p_snap);
+            Shrink();
+        } else {
+            delete p_snap;
+        }
+        Processing = CSnapshotCacheItem();
+        DoneCond.wakeAll();
+    }
+
+    CacheMutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshotCacheItem* CSnapshotCache::FindItem(CTrajectorySegment* p_seg,long int index)
+{
+    QHash<CSnapshotCacheKey,CItemList::iterator>::iterator hit;
+    hit = ItemIndex.find(CSnapshotCacheKey(p_seg,index));
+    if( hit == ItemIndex.end() ) return(NULL);
+    return( &(*hit.value()) );
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::InsertItem(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap)
+{
+    CSnapshotCacheItem item(p_seg,index);
+    item.Snapshot = p_snap;
+    item.Size = GetSnapshotSize(p_snap->Coordinates.GetLength(),p_snap->Velocities.GetLength() > 0);
+    Items.push_front(item);
+    ItemIndex.insert(item.GetKey(),Items.begin());
+    MemoryUsage += item.Size;
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshotCache::CItemList::iterator CSnapshotCache::RemoveItem(CItemList::iterator it)
+{
+    MemoryUsage -= it->Size;
+    if( Current == it->Snapshot ) Current = NULL;
+    if( Recent == it->Snapshot ) Recent = NULL;
+    ItemIndex.remove(it->GetKey());
+    delete it->Snapshot;
+    return( Items.erase(it) );
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotCache::Shrink(void)
+{
+    // the current and the recent snapshots are never released
+    CItemList::iterator it = Items.end();
+    while( (MemoryUsage > MemoryBudget) && (it != Items.begin()) ){
+        it--;
+        if( (it->Snapshot == Current) || (it->Snapshot == Recent) ) continue;
+        it = RemoveItem(it);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CSnapshotCache::GetSnapshotSize(int natoms,bool with_vel)
+{
+    qint64 size = sizeof(CSnapshot) + (qint64)natoms*sizeof(CPoint);
+    if( with_vel ) size += (qint64)natoms*sizeof(CPoint);
+    return(size);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,173 @@
+#ifndef SnapshotCacheH
+#define SnapshotCacheH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <list>
+
+// -----------------------------------------------------------------------------
+
+class CSnapshot;
+class CTrajectorySegment;
+
+// -----------------------------------------------------------------------------
+
+/// snapshot identification - segment and snapshot index within the segment
+
+typedef QPair<CTrajectorySegment*,long int> CSnapshotCacheKey;
+
+// -----------------------------------------------------------------------------
+
+/// cache record or prefetch request
+
+class NEMESIS_CORE_PACKAGE CSnapshotCacheItem {
+public:
+    CSnapshotCacheItem(void);
+    CSnapshotCacheItem(CTrajectorySegment* p_seg,long int index);
+public:
+    CTrajectorySegment* Segment;
+    long int            Index;      // snapshot index within the segment (counted from 1)
+    CSnapshot*          Snapshot;   // NULL for prefetch requests
+    qint64              Size;       // estimated memory in bytes
+
+    /// get lookup key of the item
+    CSnapshotCacheKey GetKey(void) const;
+};
+
+// -----------------------------------------------------------------------------
+
+///  LRU cache of decoded snapshots of one trajectory
+/*! the cache is limited by the memory budget, the snapshot used by the structure
+    and the last one returned by Find or Insert are never released,
+    snapshots requested by Prefetch are decoded in the worker thread
+    by CTrajectorySegment::CopySnapshot()
+*/
+
+class NEMESIS_CORE_PACKAGE CSnapshotCache : public QThread {
+public:
+// constructor -----------------------------------------------------------------
+    CSnapshotCache(QObject* p_parent=NULL);
+    ~CSnapshotCache(void);
+
+// setup methods ---------------------------------------------------------------
+    /// set memory budget in bytes
+    void SetMemoryBudget(qint64 budget);
+
+    /// set max number of prefetched snapshots
+    void SetPrefetchDepth(int depth);
+
+// executive methods - main thread ---------------------------------------------
+    /// find snapshot, it becomes the most recently used one
+    CSnapshot* Find(CTrajectorySegment* p_seg,long int index);
+
+    /// insert snapshot, the cache takes over its ownership
+    /*! the least recently used snapshots are destroyed if the budget is exceeded
+    */
+    void Insert(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap);
+
+    /// set snapshot used by the structure
+    void SetCurrent(CSnapshot* p_snap);
+
+    /// replace pending prefetch requests, the first request is processed first
+    void Prefetch(const QList<CSnapshotCacheItem>& requests,int natoms);
+
+    /// destroy all snapshots of the segment, it waits if its snapshot is being decoded
+    void RemoveSegment(CTrajectorySegment* p_seg);
+
+    /// destroy all cached snapshots
+    void Clear(void);
+
+// executive methods - any thread ----------------------------------------------
+    /// copy cached snapshot or decode it by CTrajectorySegment::CopySnapshot()
+    /*! the segment must support prefetching, it is not accessed if RemoveSegment
+        was called after the generation was obtained, the cache is not changed
+    */
+    bool CopySnapshot(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap,
+                      quint64 generation);
+
+    /// get generation, it is increased by RemoveSegment
+    quint64 GetGeneration(void);
+
+// information methods ---------------------------------------------------------
+    /// get memory budget in bytes
+    qint64 GetMemoryBudget(void);
+
+    /// get max number of prefetched snapshots
+    int GetPrefetchDepth(void);
+
+    /// get memory used by cached snapshots
+    qint64 GetMemoryUsage(void);
+
+    /// get number of cached snapshots
+    int GetNumberOfSnapshots(void);
+
+    /// is snapshot in the cache?
+    bool IsCached(CTrajectorySegment* p_seg,long int index);
+
+// section of private data -----------------------------------------------------
+private:
+    typedef std::list<CSnapshotCacheItem>   CItemList;
+
+    QMutex                      CacheMutex;
+    QWaitCondition              RequestCond;    // new requests or termination
+    QWaitCondition              DoneCond;       // the worker or a reader finished decoding
+    CItemList                   Items;          // LRU order, the most recently used is the first
+    QHash<CSnapshotCacheKey,CItemList::iterator>    ItemIndex;  // items by segment and index
+    QList<CSnapshotCacheItem>   Requests;       // prefetch requests
+    CSnapshotCacheItem          Processing;     // request decoded by the worker
+    QHash<CTrajectorySegment*,int>  Readers;    // segments decoded by CopySnapshot
+    quint64                     Generation;     // increased by RemoveSegment
+    CSnapshot*                  Current;        // snapshot used by the structure
+    CSnapshot*                  Recent;         // the last snapshot returned by Find or Insert
+    qint64                      MemoryBudget;
+    qint64                      MemoryUsage;
+    int                         PrefetchDepth;
+    int                         NumOfAtoms;     // for prefetched snapshots
+    bool                        Terminate;
+
+    /// worker main loop
+    virtual void run(void);
+
+    /// find item or return NULL - lock must be held
+    CSnapshotCacheItem* FindItem(CTrajectorySegment* p_seg,long int index);
+
+    /// insert item - lock must be held
+    void InsertItem(CTrajectorySegment* p_seg,long int index,CSnapshot* p_snap);
+
+    /// destroy item and its snapshot, return the next item - lock must be held
+    CItemList::iterator RemoveItem(CItemList::iterator it);
+
+    /// release snapshots over the budget - lock must be held
+    void Shrink(void);
+
+    /// estimate memory occupied by snapshot
+    static qint64 GetSnapshotSize(int natoms,bool with_vel);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,206 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <SnapshotIndex.hpp>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+#include <QThreadPool>
+
+//------------------------------------------------------------------------------
+
+// index file identification
+#define SNAPSHOT_INDEX_MAGIC    0x5844494E  // NIDX
+#define SNAPSHOT_INDEX_VERSION  1
+
+// size of the file beginning used for checksum
+#define SNAPSHOT_INDEX_HEADER   4096
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSnapshotIndex::CSnapshotIndex(void)
+{
+    NumOfAtoms = 0;
+    FileSize = 0;
+    FileTime = 0;
+    HeaderChecksum = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CSnapshotIndex::Load(const QString& traj_name,int natoms,const char* p_data,qint64 size)
+{
+    Offsets.clear();
+
+    QFile file(GetIndexName(traj_name));
+    if( file.open(QIODevice::ReadOnly) == false ) return(false);
+
+    QDataStream str(&file);
+    str.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    str >> magic >> version;
+    if( (magic != SNAPSHOT_INDEX_MAGIC) || (version != SNAPSHOT_INDEX_VERSION) ) return(false);
+
+    qint32  nidxatoms = 0;
+    str >> nidxatoms >> FileSize >> FileTime >> HeaderChecksum;
+    NumOfAtoms = nidxatoms;
+
+    // is the index valid for given trajectory?
+    if( NumOfAtoms != natoms ) return(false);
+    if( FileSize != size ) return(false);
+    if( FileTime != GetFileTime(traj_name) ) return(false);
+    if( HeaderChecksum != GetHeaderChecksum(p_data,size) ) return(false);
+
+    str >> Offsets;
+    if( str.status() != QDataStream::Ok ){
+        Offsets.clear();
+        return(false);
+    }
+
+    // check consistency of offsets
+    for(int i=0; i < Offsets.count(); i++){
+        if( (Offsets[i] < 0) || (Offsets[i] > FileSize) || ((i > 0) && (Offsets[i] <= Offsets[i-1])) ){
+            Offsets.clear();
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CSnapshotIndex::Save(const QString& traj_name)
+{
+    QFile file(GetIndexName(traj_name));
+    if( file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false ) return(false);
+
+    QDataStream str(&file);
+    str.setVersion(QDataStream::Qt_5_0);
+
+    str << (quint32)SNAPSHOT_INDEX_MAGIC << (quint32)SNAPSHOT_INDEX_VERSION;
+    str << (qint32)NumOfAtoms << FileSize << FileTime << HeaderChecksum;
+    str << Offsets;
+
+    if( str.status() != QDataStream::Ok ){
+        file.close();
+        file.remove();
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotIndex::SaveInBackground(const QString& traj_name,int natoms,const QVector<qint64>& offsets,
+                                      const char* p_data,qint64 size)
+{
+    // checksum must be evaluated now, data can be unmapped later
+    CSnapshotIndex index;
+    index.SetIndex(traj_name,natoms,offsets,p_data,size);
+
+    CSnapshotIndexWriter* p_writer = new CSnapshotIndexWriter(traj_name,index);
+    QThreadPool::globalInstance()->start(p_writer);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CSnapshotIndex::SetIndex(const QString& traj_name,int natoms,const QVector<qint64>& offsets,
+                              const char* p_data,qint64 size)
+{
+    NumOfAtoms = natoms;
+    FileSize = size;
+    FileTime = GetFileTime(traj_name);
+    HeaderChecksum = GetHeaderChecksum(p_data,size);
+    Offsets = offsets;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+const QVector<qint64>& CSnapshotIndex::GetOffsets(void) const
+{
+    return(Offsets);
+}
+
+//------------------------------------------------------------------------------
+
+QString CSnapshotIndex::GetIndexName(const QString& traj_name)
+{
+    return(traj_name + ".nidx");
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CSnapshotIndex::GetFileTime(const QString& traj_name)
+{
+    QFileInfo info(traj_name);
+    return(info.lastModified().toMSecsSinceEpoch());
+}
+
+//------------------------------------------------------------------------------
+
+quint32 CSnapshotIndex::GetHeaderChecksum(const char* p_data,qint64 size)
+{
+    // FNV-1a
+    quint32 hash = 2166136261u;
+    if( p_data == NULL ) return(hash);
+    if( size > SNAPSHOT_INDEX_HEADER ) size = SNAPSHOT_INDEX_HEADER;
+    for(qint64 i=0; i < size; i++){
+        hash ^= (unsigned char)p_data[i];
+        hash *= 16777619u;
+    }
+    return(hash);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CSnapshotIndexWriter::CSnapshotIndexWriter(const QString& traj_name,const CSnapshotIndex& index)
+{
+    TrajName = traj_name;
+    Index = index;
+    setAutoDelete(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CSnapshotIndexWriter::run(void)
+{
+    // failure is not fatal, the trajectory will be scanned again next time
+    Index.Save(TrajName);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
@@ -0,0 +1,100 @@
+#ifndef SnapshotIndexH
+#define SnapshotIndexH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QString>
+#include <QVector>
+#include <QRunnable>
+
+// -----------------------------------------------------------------------------
+
+///  persistent snapshot index stored next to the trajectory file (name.nidx)
+/*! the index contains byte offsets of snapshots, the last item is the end of data,
+    it is valid only for the same number of atoms, file size, modification time and
+    header checksum of the trajectory file
+*/
+
+class NEMESIS_CORE_PACKAGE CSnapshotIndex {
+public:
+// constructor -----------------------------------------------------------------
+    CSnapshotIndex(void);
+
+// input/output methods --------------------------------------------------------
+    /// load and validate index for the trajectory file
+    bool Load(const QString& traj_name,int natoms,const char* p_data,qint64 size);
+
+    /// save index for the trajectory file
+    bool Save(const QString& traj_name);
+
+    /// save index for the trajectory file from the background thread
+    static void SaveInBackground(const QString& traj_name,int natoms,const QVector<qint64>& offsets,
+                                 const char* p_data,qint64 size);
+
+// setup methods ---------------------------------------------------------------
+    /// set index data
+    void SetIndex(const QString& traj_name,int natoms,const QVector<qint64>& offsets,
+                  const char* p_data,qint64 size);
+
+// information methods ---------------------------------------------------------
+    /// get snapshot offsets
+    const QVector<qint64>& GetOffsets(void) const;
+
+    /// get name of index file
+    static QString GetIndexName(const QString& traj_name);
+
+// section of private data -----------------------------------------------------
+private:
+    int             NumOfAtoms;
+    qint64          FileSize;
+    qint64          FileTime;       // modification time in ms since epoch
+    quint32         HeaderChecksum;
+    QVector<qint64> Offsets;
+
+    /// get modification time of the file
+    static qint64 GetFileTime(const QString& traj_name);
+
+    /// checksum of the beginning of the file
+    static quint32 GetHeaderChecksum(const char* p_data,qint64 size);
+};
+
+// -----------------------------------------------------------------------------
+
+/// background writer of snapshot index
+
+class NEMESIS_CORE_PACKAGE CSnapshotIndexWriter : public QRunnable {
+public:
+// constructor -----------------------------------------------------------------
+    CSnapshotIndexWriter(const QString& traj_name,const CSnapshotIndex& index);
+
+// section of private data -----------------------------------------------------
+private:
+    QString         TrajName;
+    CSnapshotIndex  Index;
+
+    /// executed from the thread pool
+    virtual void run(void);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
+
@@ -31,6 +31,7 @@
 #include <TrajectorySegmentHistory.hpp>
 #include <SnapshotFilter.hpp>
 #include <SnapshotFilterHistory.hpp>
+#include <SnapshotCache.hpp>
 #include <QTimer>
 #include <PluginDatabase.hpp>
 #include <AtomList.hpp>
@@ -64,6 +65,7 @@ CTrajectory::CTrajectory(CTrajectoryList* p_list)
     UpdateLevel = 0;
 
     SegmentCounter.SetTopIndex(0);
+    SnapshotOffsetsValid = false;
 
     PlayMode = ETPM_ONCE;
     PlayStatus = ETPS_STOP;
@@ -72,6 +74,8 @@ CTrajectory::CTrajectory(CTrajectoryList* p_list)
 
     PlayTimer = new QTimer(this);
     connect(PlayTimer, SIGNAL(timeout()), this, SLOT(PlayTick(void)));
+
+    SnapshotCache = new CSnapshotCache();
 }
 
 //------------------------------------------------------------------------------
@@ -88,6 +92,7 @@ CTrajectory::CTrajectory(CTrajectoryList* p_list,bool no_index)
     UpdateLevel = 0;
 
     SegmentCounter.SetTopIndex(0);
+    SnapshotOffsetsValid = false;
 
     PlayMode = ETPM_ONCE;
     PlayStatus = ETPS_STOP;
@@ -96,6 +101,8 @@ CTrajectory::CTrajectory(CTrajectoryList* p_list,bool no_index)
 
     PlayTimer = new QTimer(this);
     connect(PlayTimer, SIGNAL(timeout()), this, SLOT(PlayTick(void)));
+
+    SnapshotCache = new CSnapshotCache();
 }
 
 //------------------------------------------------------------------------------
@@ -104,6 +111,9 @@ CTrajectory::~CTrajectory(void)
 {
     PlayTimer->stop();
 
+    // stop background evaluations before segments and cache are destroyed
+    emit OnTrajectoryAboutToBeDestroyed();
+
     CTrajectoryList* p_list = GetTrajectories();
     if( p_list ) p_list->BeginUpdate();
 
@@ -135,6 +145,9 @@ CTrajectory::~CTrajectory(void)
         delete p_filter;
     }
 
+    // segments are already destroyed
+    delete SnapshotCache;
+
     if( p_list ) p_list->EndUpdate();
 }
 
@@ -413,11 +426,7 @@ bool CTrajectory::NextSegment(void)
             break;
         }
         if( p_seg->FirstSnapshot() ){
-            CurrentSnapshotIndex = 0;
-            for(long int i=1; i < CurrentSegmentIndex; i++){
-                CurrentSnapshotIndex += GetSegment(i)->GetNumberOfSnapshots();
-            }
-            CurrentSnapshotIndex++;
+            CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + 1;
             EmitOnSnapshotChanged();
             return(true);
         }
@@ -443,11 +452,7 @@ bool CTrajectory::PrevSegment(void)
             break;
         }
         if( p_seg->FirstSnapshot() ){
-            CurrentSnapshotIndex = 0;
-            for(long int i=1; i < CurrentSegmentIndex; i++){
-                CurrentSnapshotIndex += GetSegment(i)->GetNumberOfSnapshots();
-            }
-            CurrentSnapshotIndex++;
+            CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + 1;
             EmitOnSnapshotChanged();
             return(true);
         }
@@ -474,11 +479,7 @@ bool CTrajectory::LastSegment(void)
             break;
         }
         if( p_seg->FirstSnapshot() ){
-            CurrentSnapshotIndex = 0;
-            for(long int i=1; i < CurrentSegmentIndex; i++){
-                CurrentSnapshotIndex += GetSegment(i)->GetNumberOfSnapshots();
-            }
-            CurrentSnapshotIndex++;
+            CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + 1;
             EmitOnSnapshotChanged();
             return(true);
         }
@@ -505,14 +506,11 @@ bool CTrajectory::MoveToSegment(long int index)
             break;
         }
         if( p_seg->GetSeqIndex() == index ){
-            CurrentSnapshotIndex += p_seg->GetCurrentSnapshotIndex();
+            CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + p_seg->GetCurrentSnapshotIndex();
             EmitOnSnapshotChanged();
             return(true);
         }
-        long int slen = p_seg->GetNumberOfSnapshots();
         CurrentSegmentIndex++;
-        CurrentSnapshotIndex += slen;
-
     }
 
     CurrentSegmentIndex = 0;
@@ -528,23 +526,13 @@ bool CTrajectory::MoveToSnapshot(long int index)
     if( (index < 1) || (index > GetNumberOfSnapshots()) ) return(false);
 
     // find segment
-    CurrentSegmentIndex = 1;
-    CurrentSnapshotIndex = 0;
-    while( CurrentSegmentIndex > 0 ){
-        CTrajectorySegment* p_seg = GetSegment(CurrentSegmentIndex);
-        if( p_seg == NULL ){
-            break;
-        }
-        long int slen = p_seg->GetNumberOfSnapshots();
-        if( index <= slen ){
-            p_seg->MoveToSnapshot(index);
-            CurrentSnapshotIndex += index;
-            EmitOnSnapshotChanged();
-            return(true);
-        }
-        index -= slen;
-        CurrentSegmentIndex++;
-        CurrentSnapshotIndex += slen;
+    long int segidx,snapidx;
+    if( FindSnapshot(index,segidx,snapidx) ){
+        CurrentSegmentIndex = segidx;
+        CurrentSnapshotIndex = index;
+        GetSegment(segidx)->MoveToSnapshot(snapidx);
+        EmitOnSnapshotChanged();
+        return(true);
     }
 
     CurrentSegmentIndex = 0;
@@ -564,6 +552,7 @@ void CTrajectory::Play(void)
     PlayForward = true;
     EmitOnSnapshotChanged();
     PlayTimer->start(10);
+    PrefetchSnapshots();
 }
 
 //------------------------------------------------------------------------------
@@ -668,6 +657,86 @@ void CTrajectory::PlayTick(void)
             }
         }
     }
+
+    PrefetchSnapshots();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectory::PrefetchSnapshots(void)
+{
+    if( (PlayStatus != ETPS_PLAY) || (GetStructure() == NULL) ) return;
+
+    CTrajectorySegment* p_seg = GetSegment(CurrentSegmentIndex);
+    if( p_seg == NULL ) return;
+
+    long int    start_seg = CurrentSegmentIndex;
+    long int    start_snap = p_seg->GetCurrentSnapshotIndex();
+    long int    segidx = start_seg;
+    long int    snapidx = start_snap;
+    bool        forward = PlayForward;
+    int         depth = SnapshotCache->GetPrefetchDepth();
+
+    // follow the same path as PlayTick
+    QList<CSnapshotCacheItem> requests;
+    for(int i=0; i < depth; i++){
+        if( StepSnapshot(segidx,snapidx,forward) == false ){
+            if( PlayMode == ETPM_ONCE ) break;
+            if( PlayMode == ETPM_LOOP ){
+                segidx = 1;
+                snapidx = 0;
+                if( StepSnapshot(segidx,snapidx,true) == false ) break;
+            }
+            if( PlayMode == ETPM_ROLL ){
+                forward = ! forward;
+                if( StepSnapshot(segidx,snapidx,forward) == false ) break;
+            }
+        }
+        // the whole trajectory is requested
+        if( (segidx == start_seg) && (snapidx == start_snap) ) break;
+
+        CTrajectorySegment* p_pseg = GetSegment(segidx);
+        if( p_pseg->CanPrefetchSnapshots() && (p_pseg->IsTrajectoryDataLoading() == false) ){
+            requests.append(CSnapshotCacheItem(p_pseg,snapidx));
+        }
+    }
+
+    SnapshotCache->Prefetch(requests,GetStructure()->GetAtoms()->GetNumberOfAtoms());
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectory::StepSnapshot(long int& segidx,long int& snapidx,bool forward)
+{
+    if( forward ){
+        CTrajectorySegment* p_seg = GetSegment(segidx);
+        if( (p_seg != NULL) && (snapidx < p_seg->GetNumberOfSnapshots()) ){
+            snapidx++;
+            return(true);
+        }
+        for(long int i = segidx + 1; i <= GetNumberOfSegments(); i++){
+            if( GetSegment(i)->GetNumberOfSnapshots() > 0 ){
+                segidx = i;
+                snapidx = 1;
+                return(true);
+            }
+        }
+        return(false);
+    }
+
+    if( snapidx > 1 ){
+        snapidx--;
+        return(true);
+    }
+    for(long int i = segidx - 1; i >= 1; i--){
+        long int nsnaps = GetSegment(i)->GetNumberOfSnapshots();
+        if( nsnaps > 0 ){
+            segidx = i;
+            snapidx = nsnaps;
+            return(true);
+        }
+    }
+    return(false);
 }
 
 //==============================================================================
@@ -727,11 +796,8 @@ CTrajectoryList* CTrajectory::GetTrajectories(void) const
 
 long int CTrajectory::GetNumberOfSnapshots(void)
 {
-    long int count = 0;
-    foreach(CTrajectorySegment* p_segment,findChildren<CTrajectorySegment*>()){
-        count += p_segment->GetNumberOfSnapshots();
-    }
-    return(count);
+    UpdateSnapshotOffsets();
+    return(SnapshotOffsets.last());
 }
 
 //------------------------------------------------------------------------------
@@ -739,21 +805,29 @@ long int CTrajectory::GetNumberOfSnapshots(void)
 long int CTrajectory::GetNumberOfSnapshotsBefore(long int index)
 {
     // method get count of segment before segment of index
-    long int count = 0;
-    int n = 1;
-    while( n <= GetNumberOfSegments() ){
-        CTrajectorySegment* p_seg = GetSegment(n);
-        if( p_seg == NULL ){
-            break;
+    // segments are ordered by seqindex
+    int low = 0;
+    int high = Segments.count() - 1;
+    while( low <= high ){
+        int mid = (low + high) / 2;
+        int seqidx = Segments.at(mid)->GetSeqIndex();
+        if( seqidx == index ){
+            return( GetSnapshotOffset(mid+1) );
         }
-        if( p_seg->GetSeqIndex() == index ){
-            return(count);
+        if( seqidx < index ){
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
-        count += p_seg->GetNumberOfSnapshots();
-        n++;
     }
-    return (-1);
 
+    // segments are not sorted yet
+    for(int i=0; i < Segments.count(); i++){
+        if( Segments.at(i)->GetSeqIndex() == index ){
+            return( GetSnapshotOffset(i+1) );
+        }
+    }
+    return (-1);
 }
 
 //------------------------------------------------------------------------------
@@ -911,6 +985,7 @@ CTrajectorySegment* CTrajectory::CreateSegment(CXMLElement* p_ele,CHistoryNode*
     BeginUpdate();
 
     Segments.append(p_seg);
+    InvalidateSnapshotOffsets();
 
     // load data
     GetProject()->BeginLinkProcedure(0);
@@ -944,6 +1019,7 @@ void CTrajectory::RegisterSegment(CTrajectorySegment* p_seg,CHistoryNode* p_hist
 
     p_seg->SetIndex(GetProject()->GetFreeObjectIndex());
     Segments.append(p_seg);
+    InvalidateSnapshotOffsets();
     p_seg->SeqIndex = SegmentCounter.GetIndex();
 
     // register change to history
@@ -1153,6 +1229,7 @@ void CTrajectory::EmitOnSnapshotChanged(void)
         CSnapshot* p_oldsnap = GetStructure()->GetAtoms()->GetSnapshot();
         CSnapshot* p_newsnap = GetCurrentSnapshot();
         GetStructure()->GetAtoms()->SetSnapshot(p_newsnap);
+        SnapshotCache->SetCurrent(p_newsnap);
         if( p_oldsnap != p_newsnap ){
             // rebuild bonds if requested
             if( IsFlagSet(static_cast<EProObjectFlag>(EPOF_TRAJ_REBUILD_BONDS)) ){
@@ -1172,6 +1249,9 @@ void CTrajectory::EmitOnSnapshotChanged(void)
 
 void CTrajectory::EmitOnTrajectorySegmentsChanged(void)
 {
+    // number of segments or snapshots might be changed
+    InvalidateSnapshotOffsets();
+
     if( UpdateLevel > 0 ){
         SegmentsChanged = true;
         return;
@@ -1200,18 +1280,16 @@ void CTrajectory::SortSegments(void)
 {
     qSort(Segments.begin(),Segments.end(),LessThanBySeqIndexSegment);
 
+    InvalidateSnapshotOffsets();
+
     // update indexes
     if( CurrentSegmentIndex > Segments.count() ){
         CurrentSegmentIndex = Segments.count();
     }
     CurrentSnapshotIndex = 0;
-    for(int i=1; i < CurrentSegmentIndex; i++){
-        CTrajectorySegment* p_seg = GetSegment(i);
-        CurrentSnapshotIndex += p_seg->GetNumberOfSnapshots();
-    }
     if( CurrentSegmentIndex > 0 ){
         CTrajectorySegment* p_seg = GetSegment(CurrentSegmentIndex);
-        CurrentSnapshotIndex += p_seg->GetCurrentSnapshotIndex();
+        CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + p_seg->GetCurrentSnapshotIndex();
     }
 }
 
@@ -1228,18 +1306,16 @@ void CTrajectory::SortSegmentsByID(void)
 {
     qSort(Segments.begin(),Segments.end(),LessThanByIdIndexSegment);
 
+    InvalidateSnapshotOffsets();
+
     // update indexes
     if( CurrentSegmentIndex > Segments.count() ){
         CurrentSegmentIndex = Segments.count();
     }
     CurrentSnapshotIndex = 0;
-    for(int i=1; i < CurrentSegmentIndex; i++){
-        CTrajectorySegment* p_seg = GetSegment(i);
-        CurrentSnapshotIndex += p_seg->GetNumberOfSnapshots();
-    }
     if( CurrentSegmentIndex > 0 ){
         CTrajectorySegment* p_seg = GetSegment(CurrentSegmentIndex);
-        CurrentSnapshotIndex += p_seg->GetCurrentSnapshotIndex();
+        CurrentSnapshotIndex = GetSnapshotOffset(CurrentSegmentIndex) + p_seg->GetCurrentSnapshotIndex();
     }
 }
 
@@ -1266,6 +1342,13 @@ bool CTrajectory::LessThanBySeqIndexFilter(CSnapshotFilter* p_left,CSnapshotFilt
 
 //------------------------------------------------------------------------------
 
+CSnapshotCache* CTrajectory::GetSnapshotCache(void)
+{
+    return(SnapshotCache);
+}
+
+//------------------------------------------------------------------------------
+
 CTrajectorySegment* CTrajectory::GetSegment(long int segid)
 {
     if( (segid < 1) || (segid > GetNumberOfSegments()) ) return(NULL);
@@ -1273,6 +1356,55 @@ CTrajectorySegment* CTrajectory::GetSegment(long int segid)
     return( Segments.at(segid) );
 }
 
+//------------------------------------------------------------------------------
+
+void CTrajectory::InvalidateSnapshotOffsets(void)
+{
+    SnapshotOffsetsValid = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectory::UpdateSnapshotOffsets(void)
+{
+    if( SnapshotOffsetsValid ) return;
+
+    SnapshotOffsets.resize(Segments.count() + 1);
+    long int count = 0;
+    for(int i=0; i < Segments.count(); i++){
+        SnapshotOffsets[i] = count;
+        count += Segments.at(i)->GetNumberOfSnapshots();
+    }
+    SnapshotOffsets[Segments.count()] = count;
+
+    SnapshotOffsetsValid = true;
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectory::GetSnapshotOffset(long int segidx)
+{
+    UpdateSnapshotOffsets();
+    if( (segidx < 1) || (segidx > Segments.count()) ) return(0);
+    return(SnapshotOffsets[segidx-1]);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectory::FindSnapshot(long int index,long int& segidx,long int& snapidx)
+{
+    UpdateSnapshotOffsets();
+    if( (index < 1) || (index > SnapshotOffsets.last()) ) return(false);
+
+    // the first offset that is not smaller than index belongs to the next segment,
+    // empty segments have the same offset as the next one thus they are skipped
+    QVector<long int>::const_iterator it = qLowerBound(SnapshotOffsets.constBegin(),SnapshotOffsets.constEnd(),index);
+    segidx = it - SnapshotOffsets.constBegin();
+    snapidx = index - SnapshotOffsets[segidx-1];
+
+    return(true);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -1305,7 +1437,11 @@ void CTrajectory::LoadData(CXMLElement* p_ele)
     if( p_sele != NULL ){
         CXMLElement* p_seg_ele = p_sele->GetFirstChildElement("segment");
         while( p_seg_ele != NULL ){
-            CreateSegment(p_seg_ele);
+            CTrajectorySegment* p_seg = CreateSegment(p_seg_ele);
+            if( p_seg ){
+                // snapshot index is reused from the sidecar file if it is valid
+                p_seg->LoadTrajectoryDataInBackground();
+            }
             p_seg_ele = p_seg_ele->GetNextSiblingElement("segment");
         }
     }
@@ -24,6 +24,7 @@
 #include <ProObject.hpp>
 #include <IndexCounter.hpp>
 #include <QTimer>
+#include <QVector>
 
 // -----------------------------------------------------------------------------
 
@@ -32,6 +33,7 @@ class CTrajectorySegment;
 class CSnapshot;
 class CSnapshotFilter;
 class CStructure;
+class CSnapshotCache;
 
 // -----------------------------------------------------------------------------
 
@@ -192,6 +194,9 @@ public:
     /// is segment active
     bool IsSegmentActive(CTrajectorySegment* p_segment);
 
+    /// get cache of decoded snapshots
+    CSnapshotCache* GetSnapshotCache(void);
+
 // executive methods -----------------------------------------------------------
     /// set structure
     void SetStructure(CStructure* p_str,CHistoryNode* p_history=NULL);
@@ -245,6 +250,8 @@ public:
     void EmitOnSnapshotChanged(void);
 
     /// emit OnTrajectorySegmentsChanged signal
+    /*! it must be called when the number of snapshots in a segment is changed
+    */
     void EmitOnTrajectorySegmentsChanged(void);
 
     /// emit OnSnaphsotFiltersChanged signal
@@ -260,6 +267,9 @@ signals:
     /// emmited when snapshot filter list is changed
     void OnSnapshotFiltersChanged(void);
 
+    /// emmited at the beginning of destructor while segments are still alive
+    void OnTrajectoryAboutToBeDestroyed(void);
+
 // section of private data -----------------------------------------------------
 private:   
     bool                SegmentsChanged;
@@ -276,13 +286,39 @@ private:
     int                     PlayTickTime;
     bool                    PlayForward;
     QTimer*                 PlayTimer;
+    CSnapshotCache*         SnapshotCache;
+
+    /// request snapshots that will be played next
+    void PrefetchSnapshots(void);
+
+    /// move segment and snapshot index by one snapshot, false at the trajectory end
+    bool StepSnapshot(long int& segidx,long int& snapidx,bool forward);
 
     /// lists - ordered by seqindex
     QList<CTrajectorySegment*>  Segments;
     CIndexCounter               SegmentCounter;
 
+    // number of snapshots before each segment, the last item is the total number of snapshots
+    QVector<long int>           SnapshotOffsets;
+    bool                        SnapshotOffsetsValid;
+
+    /// invalidate SnapshotOffsets
+    void InvalidateSnapshotOffsets(void);
+
+    /// rebuild SnapshotOffsets if necessary
+    void UpdateSnapshotOffsets(void);
+
+    /// get number of snapshots before segment (counted from 1)
+    long int GetSnapshotOffset(long int segidx);
+
+    /// find segment (counted from 1) and local index for global snapshot index
+    bool FindSnapshot(long int index,long int& segidx,long int& snapidx);
+
     friend class CTrajectorySegment;
     friend class CTrajectoryModelSegments;
+    friend class CBinTrajWriter;
+    friend class CTrajectorySelection;
+    friend class CTrajectoryAnalysis;
 
     /// sort segments
     void SortSegments(void);
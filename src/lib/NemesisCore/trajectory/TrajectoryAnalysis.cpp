@@ -0,0 +1,629 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <TrajectoryAnalysis.hpp>
+#include <ErrorSystem.hpp>
+#include <Trajectory.hpp>
+#include <TrajectorySegment.hpp>
+#include <Snapshot.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Property.hpp>
+#include <PhysicalQuantity.hpp>
+#include <QThreadPool>
+#include <QFile>
+#include <QTextStream>
+#include <QtEndian>
+
+//------------------------------------------------------------------------------
+
+#define PROP_TABLE_MAGIC        "NEMPTAB1"
+#define PROP_TABLE_VERSION      1
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectoryAnalysisWorker::CTrajectoryAnalysisWorker(CTrajectoryAnalysis* p_owner)
+{
+    Owner = p_owner;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysisWorker::run(void)
+{
+    Owner->RunWorker();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectoryAnalysis::CTrajectoryAnalysis(CTrajectory* p_traj)
+{
+    Trajectory = p_traj;
+    SnapshotCache = NULL;
+    NumOfAtoms = 0;
+
+    FirstFrame = 0;
+    Stride = 1;
+    NumOfRows = 0;
+    NumOfEvaluated = 0;
+
+    NextJob = 0;
+    NumOfWorkers = 0;
+    RunID = 0;
+    Generation = 0;
+    Terminate = false;
+
+    if( Trajectory == NULL ) return;
+
+    SnapshotCache = Trajectory->GetSnapshotCache();
+
+    connect(Trajectory,SIGNAL(OnTrajectorySegmentsChanged(void)),
+            this,SLOT(TrajectorySegmentsChanged(void)));
+    //---------------
+    connect(Trajectory,SIGNAL(OnTrajectoryAboutToBeDestroyed(void)),
+            this,SLOT(TrajectoryDestroyed(void)),Qt::DirectConnection);
+}
+
+//------------------------------------------------------------------------------
+
+CTrajectoryAnalysis::~CTrajectoryAnalysis(void)
+{
+    Abort();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectoryAnalysis::AddProperty(CProperty* p_prop)
+{
+    if( p_prop == NULL ){
+        INVALID_ARGUMENT("p_prop is NULL");
+    }
+
+    Clear();
+
+    if( Trajectory == NULL ){
+        ES_ERROR("no trajectory is assigned with analysis");
+        return(false);
+    }
+
+    CStructure* p_str = Trajectory->GetStructure();
+    if( p_str == NULL ){
+        ES_ERROR("trajectory has no structure");
+        return(false);
+    }
+
+    if( p_prop->IsFromStructure(p_str) == false ){
+        ES_ERROR("property is not from the trajectory structure");
+        return(false);
+    }
+
+    CPropertyTerms terms;
+    if( p_prop->GetPropertyTerms(terms) == false ){
+        ES_ERROR("property cannot be evaluated for trajectory snapshots");
+        return(false);
+    }
+
+    Terms.append(terms);
+    Names.append(p_prop->GetName());
+    Units.append(p_prop->GetPropertyUnit());
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::RemoveAllProperties(void)
+{
+    Clear();
+    Terms.clear();
+    Names.clear();
+    Units.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectoryAnalysis::Evaluate(long int first,long int last,long int stride)
+{
+    Clear();
+
+    if( Trajectory == NULL ){
+        ES_ERROR("no trajectory is assigned with analysis");
+        return(false);
+    }
+    if( Terms.isEmpty() ){
+        ES_ERROR("no properties");
+        return(false);
+    }
+    if( Trajectory->GetStructure() == NULL ){
+        ES_ERROR("trajectory has no structure");
+        return(false);
+    }
+    if( stride < 1 ) stride = 1;
+
+    long int nframes = Trajectory->GetNumberOfSnapshots();
+    if( first < 1 ) first = 1;
+    if( last > nframes ) last = nframes;
+    if( first > last ){
+        ES_ERROR("no snapshots in the range");
+        return(false);
+    }
+
+    long int nrows = (last - first)/stride + 1;
+    NumOfAtoms = Trajectory->GetStructure()->GetAtoms()->GetNumberOfAtoms();
+
+    ResultMutex.lock();
+    FirstFrame = first;
+    Stride = stride;
+    NumOfRows = nrows;
+    Values.fill(0.0,Terms.count()*nrows);
+    Evaluated.fill(false,nrows);
+    NumOfEvaluated = 0;
+    ResultMutex.unlock();
+
+    // segments must not be released before the generation is obtained
+    Generation = SnapshotCache->GetGeneration();
+
+    QVector<CSnapshotCacheItem> jobs;
+    jobs.reserve(nrows);
+    int njobs = 0;
+
+    for(long int row = 0; row < nrows; row++){
+        long int frame = first + row*stride;
+        long int segidx,snapidx;
+        CTrajectorySegment* p_seg = NULL;
+        if( Trajectory->FindSnapshot(frame,segidx,snapidx) ){
+            p_seg = Trajectory->GetSegment(segidx);
+        }
+        if( p_seg == NULL ){
+            jobs.append(CSnapshotCacheItem());
+            continue;
+        }
+        if( p_seg->CanPrefetchSnapshots() && (p_seg->IsTrajectoryDataLoading() == false) ){
+            jobs.append(CSnapshotCacheItem(p_seg,snapidx));
+            njobs++;
+            continue;
+        }
+        // other segments are not thread safe
+        QVector<double> values;
+        if( EvaluateFrame(p_seg,snapidx,values) ){
+            StoreRow(row,values);
+        }
+        jobs.append(CSnapshotCacheItem());
+    }
+
+    int nworkers = QThreadPool::globalInstance()->maxThreadCount();
+    if( nworkers > njobs ) nworkers = njobs;
+
+    ResultMutex.lock();
+    Jobs = jobs;
+    NextJob = 0;
+    Terminate = false;
+    NumOfWorkers = nworkers;
+    RunID++;
+    int runid = RunID;
+    ResultMutex.unlock();
+
+    if( nworkers == 0 ){
+        QMetaObject::invokeMethod(this,"EvaluationFinished",Qt::QueuedConnection,Q_ARG(int,runid));
+        return(true);
+    }
+
+    for(int i=0; i < nworkers; i++){
+        QThreadPool::globalInstance()->start(new CTrajectoryAnalysisWorker(this));
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::EvaluateAll(void)
+{
+    if( Trajectory == NULL ) return(false);
+    return( Evaluate(1,Trajectory->GetNumberOfSnapshots()) );
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::Abort(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    Terminate = true;
+    while( NumOfWorkers > 0 ){
+        WorkersDone.wait(&ResultMutex);
+    }
+    Jobs.clear();
+    NextJob = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::Clear(void)
+{
+    Abort();
+
+    QMutexLocker lock(&ResultMutex);
+    FirstFrame = 0;
+    Stride = 1;
+    NumOfRows = 0;
+    Values.clear();
+    Evaluated.clear();
+    NumOfEvaluated = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectoryAnalysis::ExportCSV(const QString& name)
+{
+    QFile file(name);
+    if( file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text) == false ){
+        CSmallString error;
+        error << "unable to create CSV file '" << name << "'";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    QTextStream str(&file);
+
+    // header
+    str << "frame";
+    for(int i=0; i < Names.count(); i++){
+        QString title = Names.at(i);
+        if( Units.at(i) != NULL ){
+            title += " [" + Units.at(i)->GetUnitName() + "]";
+        }
+        title.replace("\"","\"\"");
+        str << ",\"" << title << "\"";
+    }
+    str << "\n";
+
+    // rows
+    QMutexLocker lock(&ResultMutex);
+    for(long int row=0; row < NumOfRows; row++){
+        if( Evaluated.at(row) == false ) continue;
+        str << FirstFrame + row*Stride;
+        for(int i=0; i < Terms.count(); i++){
+            double value = Values.at(i*NumOfRows + row);
+            if( Units.at(i) != NULL ) value = Units.at(i)->GetRealValue(value);
+            str << "," << QString::number(value,'g',12);
+        }
+        str << "\n";
+    }
+
+    str.flush();
+    if( file.error() != QFile::NoError ){
+        ES_ERROR("unable to write CSV file");
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::ExportBinary(const QString& name)
+{
+    QFile file(name);
+    if( file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false ){
+        CSmallString error;
+        error << "unable to create binary file '" << name << "'";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    QMutexLocker lock(&ResultMutex);
+
+    QVector<long int> rows;
+    rows.reserve(NumOfEvaluated);
+    for(long int row=0; row < NumOfRows; row++){
+        if( Evaluated.at(row) ) rows.append(row);
+    }
+
+    QByteArray  buffer;
+    uchar       data[8];
+
+    // header
+    buffer.append(PROP_TABLE_MAGIC,8);
+    qToLittleEndian<quint32>(PROP_TABLE_VERSION,data);
+    buffer.append(reinterpret_cast<const char*>(data),4);
+    qToLittleEndian<quint32>(Terms.count(),data);
+    buffer.append(reinterpret_cast<const char*>(data),4);
+    qToLittleEndian<quint64>(rows.count(),data);
+    buffer.append(reinterpret_cast<const char*>(data),8);
+
+    foreach(QString title, Names){
+        QByteArray utf8 = title.toUtf8();
+        qToLittleEndian<quint32>(utf8.size(),data);
+        buffer.append(reinterpret_cast<const char*>(data),4);
+        buffer.append(utf8);
+    }
+
+    // frame column
+    foreach(long int row, rows){
+        qToLittleEndian<qint64>(FirstFrame + row*Stride,data);
+        buffer.append(reinterpret_cast<const char*>(data),8);
+    }
+
+    // property columns
+    for(int i=0; i < Terms.count(); i++){
+        const double* p_col = Values.constData() + i*NumOfRows;
+        foreach(long int row, rows){
+            quint64 bits;
+            memcpy(&bits,&p_col[row],sizeof(bits));
+            qToLittleEndian<quint64>(bits,data);
+            buffer.append(reinterpret_cast<const char*>(data),8);
+        }
+    }
+
+    if( file.write(buffer) != buffer.size() ){
+        ES_ERROR("unable to write binary file");
+        return(false);
+    }
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectory* CTrajectoryAnalysis::GetTrajectory(void) const
+{
+    return(Trajectory);
+}
+
+//------------------------------------------------------------------------------
+
+int CTrajectoryAnalysis::GetNumberOfProperties(void) const
+{
+    return(Terms.count());
+}
+
+//------------------------------------------------------------------------------
+
+const QString& CTrajectoryAnalysis::GetPropertyName(int prop) const
+{
+    return(Names.at(prop));
+}
+
+//------------------------------------------------------------------------------
+
+CPhysicalQuantity* CTrajectoryAnalysis::GetPropertyUnit(int prop) const
+{
+    return(Units.at(prop));
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::IsRunning(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(NumOfWorkers > 0);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::CanEvaluateInBackground(void)
+{
+    if( Trajectory == NULL ) return(false);
+
+    for(long int segid=1; segid <= Trajectory->GetNumberOfSegments(); segid++){
+        CTrajectorySegment* p_seg = Trajectory->GetSegment(segid);
+        if( p_seg->CanPrefetchSnapshots() == false ) return(false);
+        if( p_seg->IsTrajectoryDataLoading() ) return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectoryAnalysis::GetNumberOfRows(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(NumOfRows);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectoryAnalysis::GetFrame(long int row)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(FirstFrame + row*Stride);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectoryAnalysis::GetNumberOfEvaluatedRows(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(NumOfEvaluated);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::IsRowEvaluated(long int row)
+{
+    QMutexLocker lock(&ResultMutex);
+    if( (row < 0) || (row >= NumOfRows) ) return(false);
+    return(Evaluated.at(row));
+}
+
+//------------------------------------------------------------------------------
+
+double CTrajectoryAnalysis::GetValue(int prop,long int row)
+{
+    QMutexLocker lock(&ResultMutex);
+    if( (prop < 0) || (prop >= Terms.count()) ) return(0.0);
+    if( (row < 0) || (row >= NumOfRows) ) return(0.0);
+    return(Values.at(prop*NumOfRows + row));
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::GetColumn(int prop,QVector<double>& values)
+{
+    QMutexLocker lock(&ResultMutex);
+    values.clear();
+    if( (prop < 0) || (prop >= Terms.count()) ) return(false);
+    values = Values.mid(prop*NumOfRows,NumOfRows);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CTrajectoryAnalysis::GetMemoryUsage(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return( Values.count()*sizeof(double) + Evaluated.count()*sizeof(bool) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectoryAnalysis::EvaluateFrame(CSnapshot* p_snap,QVector<double>& values)
+{
+    values.resize(Terms.count());
+    for(int i=0; i < Terms.count(); i++){
+        values[i] = Terms.at(i).GetValue(p_snap->Coordinates);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::EvaluateFrame(CTrajectorySegment* p_seg,long int index,QVector<double>& values)
+{
+    CSnapshot snap(p_seg);
+    snap.Coordinates.CreateVector(NumOfAtoms);
+    if( p_seg->CopySnapshot(index,&snap) == false ) return(false);
+    EvaluateFrame(&snap,values);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::StoreRow(long int row,const QVector<double>& values)
+{
+    QMutexLocker lock(&ResultMutex);
+    if( (row < 0) || (row >= NumOfRows) ) return;
+    for(int i=0; i < values.count(); i++){
+        Values[i*NumOfRows + row] = values.at(i);
+    }
+    if( Evaluated.at(row) == false ){
+        Evaluated[row] = true;
+        NumOfEvaluated++;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectoryAnalysis::RunWorker(void)
+{
+    long int            row;
+    CSnapshotCacheItem  job;
+
+    QVector<double>     values;
+
+    while( TakeJob(row,job) ){
+        CSnapshot snap(job.Segment);
+        snap.Coordinates.CreateVector(NumOfAtoms);
+
+        // it fails for released segments
+        if( SnapshotCache->CopySnapshot(job.Segment,job.Index,&snap,Generation) == false ) continue;
+
+        EvaluateFrame(&snap,values);
+        StoreRow(row,values);
+    }
+
+    WorkerFinished();
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysis::TakeJob(long int& row,CSnapshotCacheItem& job)
+{
+    QMutexLocker lock(&ResultMutex);
+    while( (Terminate == false) && (NextJob < Jobs.count()) ){
+        int i = NextJob++;
+        if( Jobs.at(i).Segment == NULL ) continue;
+        job = Jobs.at(i);
+        row = i;
+        return(true);
+    }
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::WorkerFinished(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    NumOfWorkers--;
+    if( NumOfWorkers > 0 ) return;
+
+    WorkersDone.wakeAll();
+    if( Terminate == false ){
+        // the signal is emitted from the main thread
+        QMetaObject::invokeMethod(this,"EvaluationFinished",Qt::QueuedConnection,Q_ARG(int,RunID));
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectoryAnalysis::TrajectorySegmentsChanged(void)
+{
+    // snapshots were renumbered
+    Clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::TrajectoryDestroyed(void)
+{
+    Abort();
+    Trajectory = NULL;
+    SnapshotCache = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysis::EvaluationFinished(int runid)
+{
+    if( runid != RunID ) return;
+    emit OnEvaluationFinished();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,213 @@
+#ifndef TrajectoryAnalysisH
+#define TrajectoryAnalysisH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <PropertyTerms.hpp>
+#include <SnapshotCache.hpp>
+#include <QObject>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QStringList>
+
+// -----------------------------------------------------------------------------
+
+class CTrajectory;
+class CTrajectorySegment;
+class CTrajectoryAnalysis;
+class CSnapshot;
+class CProperty;
+class CPhysicalQuantity;
+
+// -----------------------------------------------------------------------------
+
+/// background worker of trajectory analysis
+
+class NEMESIS_CORE_PACKAGE CTrajectoryAnalysisWorker : public QRunnable {
+public:
+// constructor -----------------------------------------------------------------
+    CTrajectoryAnalysisWorker(CTrajectoryAnalysis* p_owner);
+
+// section of private data -----------------------------------------------------
+private:
+    CTrajectoryAnalysis*    Owner;
+
+    /// executed from the thread pool
+    virtual void run(void);
+};
+
+// -----------------------------------------------------------------------------
+
+///  values of properties evaluated for snapshots of the trajectory
+/*! properties are converted to CPropertyTerms when they are added thus the
+    structure and properties are not touched by workers, frames are evaluated
+    in parallel by the global thread pool and their values are stored
+    in a columnar table (one column per property) as soon as they are known,
+    results are destroyed when trajectory segments are changed
+*/
+
+class NEMESIS_CORE_PACKAGE CTrajectoryAnalysis : public QObject {
+Q_OBJECT
+public:
+// constructor -----------------------------------------------------------------
+    CTrajectoryAnalysis(CTrajectory* p_traj);
+    ~CTrajectoryAnalysis(void);
+
+// setup methods ---------------------------------------------------------------
+    /// add property, previous results are destroyed
+    bool AddProperty(CProperty* p_prop);
+
+    /// remove all properties and results
+    void RemoveAllProperties(void);
+
+// executive methods -----------------------------------------------------------
+    /// evaluate every stride-th frame in the range (counted from 1) in the background
+    /*! frames of segments that cannot be decoded in parallel are evaluated
+        immediately, OnEvaluationFinished is emitted at the end
+    */
+    bool Evaluate(long int first,long int last,long int stride=1);
+
+    /// evaluate all frames in the background
+    bool EvaluateAll(void);
+
+    /// stop background evaluation and wait for workers
+    void Abort(void);
+
+    /// destroy all results
+    void Clear(void);
+
+// input/output methods --------------------------------------------------------
+    /// export evaluated frames as CSV, values are in user units
+    bool ExportCSV(const QString& name);
+
+    /// export evaluated frames as binary table, values are in internal units
+    /*! little endian: "NEMPTAB1", version, number of properties, number of rows,
+        property names (length and UTF-8 data), then frame column (int64)
+        and property columns (double)
+    */
+    bool ExportBinary(const QString& name);
+
+// information methods ---------------------------------------------------------
+    /// get associated trajectory
+    CTrajectory* GetTrajectory(void) const;
+
+    /// get number of properties
+    int GetNumberOfProperties(void) const;
+
+    /// get property name
+    const QString& GetPropertyName(int prop) const;
+
+    /// get property unit
+    CPhysicalQuantity* GetPropertyUnit(int prop) const;
+
+    /// is background evaluation running?
+    bool IsRunning(void);
+
+    /// can all frames be evaluated by workers?
+    /*! segments that cannot prefetch snapshots or that are still being loaded
+        are evaluated by Evaluate in the calling thread
+    */
+    bool CanEvaluateInBackground(void);
+
+    /// get number of table rows
+    long int GetNumberOfRows(void);
+
+    /// get frame of the row (counted from 1)
+    long int GetFrame(long int row);
+
+    /// get number of already evaluated rows
+    long int GetNumberOfEvaluatedRows(void);
+
+    /// is row evaluated?
+    bool IsRowEvaluated(long int row);
+
+    /// get property value in the row, values are in internal units
+    double GetValue(int prop,long int row);
+
+    /// get values of the property for all rows, not evaluated rows are zero
+    bool GetColumn(int prop,QVector<double>& values);
+
+    /// get memory occupied by results in bytes
+    qint64 GetMemoryUsage(void);
+
+signals:
+    /// emmited when background evaluation is finished
+    void OnEvaluationFinished(void);
+
+// section of private data -----------------------------------------------------
+private:
+    CTrajectory*                Trajectory;
+    CSnapshotCache*             SnapshotCache;
+    QVector<CPropertyTerms>     Terms;
+    QStringList                 Names;
+    QVector<CPhysicalQuantity*> Units;
+    int                         NumOfAtoms;     // number of coordinates in snapshots
+
+    // results
+    QMutex                      ResultMutex;
+    long int                    FirstFrame;
+    long int                    Stride;
+    long int                    NumOfRows;
+    QVector<double>             Values;         // columns of properties
+    QVector<bool>               Evaluated;
+    long int                    NumOfEvaluated;
+
+    // background evaluation
+    QWaitCondition              WorkersDone;
+    QVector<CSnapshotCacheItem> Jobs;   // segment is NULL for already evaluated rows
+    int                         NextJob;
+    int                         NumOfWorkers;
+    int                         RunID;
+    quint64                     Generation;
+    bool                        Terminate;
+
+    /// evaluate properties for coordinates of the snapshot
+    void EvaluateFrame(CSnapshot* p_snap,QVector<double>& values);
+
+    /// evaluate frame from the segment in the calling thread
+    bool EvaluateFrame(CTrajectorySegment* p_seg,long int index,QVector<double>& values);
+
+    /// store row results
+    void StoreRow(long int row,const QVector<double>& values);
+
+    // workers
+    /// worker main loop
+    void RunWorker(void);
+
+    /// take next row
+    bool TakeJob(long int& row,CSnapshotCacheItem& job);
+
+    /// worker finished
+    void WorkerFinished(void);
+
+    friend class CTrajectoryAnalysisWorker;
+
+private slots:
+    void TrajectorySegmentsChanged(void);
+    void TrajectoryDestroyed(void);
+    void EvaluationFinished(int runid);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
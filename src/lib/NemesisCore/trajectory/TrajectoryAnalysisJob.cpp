@@ -0,0 +1,176 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <TrajectoryAnalysisJob.hpp>
+#include <TrajectoryAnalysis.hpp>
+#include <Trajectory.hpp>
+#include <Project.hpp>
+#include <NemesisCoreModule.hpp>
+#include <CategoryUUID.hpp>
+#include <ErrorSystem.hpp>
+#include <QThread>
+
+//------------------------------------------------------------------------------
+
+CExtUUID        TrajectoryAnalysisJobID(
+                    "{TRAJECTORY_ANALYSIS_JOB:48bcc72d-8df7-4d14-b8da-5bcfa7108cd7}",
+                    "Trajectory Analysis");
+
+CPluginObject   TrajectoryAnalysisJobObject(&NemesisCorePlugin,
+                    TrajectoryAnalysisJobID,JOB_CAT,
+                    ":/images/NemesisCore/properties/PropertyList.svg",
+                    NULL);
+
+// time between two progress notifications in ms
+#define TRAJ_ANALYSIS_JOB_NOTIFY_TIME   250
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectoryAnalysisJob::CTrajectoryAnalysisJob(CTrajectory* p_traj,const QString& name,bool binary)
+    : CJob(&TrajectoryAnalysisJobObject,p_traj->GetProject())
+{
+    Analysis = new CTrajectoryAnalysis(p_traj);
+    FileName = name;
+    Binary = binary;
+    Initialized = false;
+
+    connect(this,SIGNAL(OnProgressTick(int)),
+            this,SLOT(ProgressTick(int)));
+}
+
+//------------------------------------------------------------------------------
+
+CTrajectoryAnalysisJob::~CTrajectoryAnalysisJob(void)
+{
+    delete Analysis;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectoryAnalysisJob::AddProperty(CProperty* p_prop)
+{
+    return( Analysis->AddProperty(p_prop) );
+}
+
+//------------------------------------------------------------------------------
+
+int CTrajectoryAnalysisJob::GetNumberOfProperties(void) const
+{
+    return( Analysis->GetNumberOfProperties() );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectoryAnalysisJob::JobAboutToBeSubmitted(void)
+{
+    if( Analysis->CanEvaluateInBackground() == false ){
+        ES_ERROR("trajectory segments must be loaded and support background reading");
+        return(false);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysisJob::InitializeJob(void)
+{
+    // always start the thread, the job is aborted in ExecuteJob if not initialized
+    // otherwise it would stay in the queue forever
+    Initialized = false;
+
+    // other segments would be evaluated here in the main thread,
+    // the segments might be changed while the job was queued
+    if( Analysis->CanEvaluateInBackground() == false ){
+        ES_ERROR("trajectory segments must be loaded and support background reading");
+        return(true);
+    }
+
+    // only the list of frames is built here, they are evaluated by workers
+    Initialized = Analysis->EvaluateAll();
+    if( Initialized ){
+        GetProject()->StartProgressNotification(100);
+        GetProject()->ProgressNotification(0,tr("evaluating properties"));
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysisJob::ExecuteJob(void)
+{
+    if( Initialized == false ) return(false);
+
+    // frames are evaluated by the global thread pool, the job only watches them
+    long int nrows = Analysis->GetNumberOfRows();
+    while( Analysis->IsRunning() ){
+        if( Terminated ){
+            Analysis->Abort();
+            return(false);
+        }
+        if( nrows > 0 ){
+            emit OnProgressTick(100*Analysis->GetNumberOfEvaluatedRows()/nrows);
+        }
+        QThread::msleep(TRAJ_ANALYSIS_JOB_NOTIFY_TIME);
+    }
+
+    // results are destroyed when trajectory segments are changed
+    return( (Terminated == false) && (nrows > 0)
+            && (Analysis->GetNumberOfEvaluatedRows() == nrows) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectoryAnalysisJob::FinalizeJob(void)
+{
+    if( Initialized ){
+        GetProject()->EndProgressNotification();
+    }
+    if( (Initialized == false) || (GetJobStatus() != EJS_FINISHED) ) return(false);
+
+    bool result;
+    if( Binary ){
+        result = Analysis->ExportBinary(FileName);
+    } else {
+        result = Analysis->ExportCSV(FileName);
+    }
+    if( result == false ){
+        ES_ERROR("unable to export property values");
+        GetProject()->TextNotification(ETNT_ERROR,tr("unable to export property values"),ETNT_ERROR_DELAY);
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryAnalysisJob::ProgressTick(int progress)
+{
+    GetProject()->ProgressNotification(progress,tr("evaluating properties"));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,85 @@
+#ifndef TrajectoryAnalysisJobH
+#define TrajectoryAnalysisJobH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Job.hpp>
+
+//------------------------------------------------------------------------------
+
+class CTrajectory;
+class CTrajectoryAnalysis;
+class CProperty;
+
+//------------------------------------------------------------------------------
+
+extern CExtUUID NEMESIS_CORE_PACKAGE TrajectoryAnalysisJobID;
+
+//------------------------------------------------------------------------------
+
+/// background evaluation of properties over the trajectory and export of values
+
+class NEMESIS_CORE_PACKAGE CTrajectoryAnalysisJob : public CJob {
+    Q_OBJECT
+public:
+// constructor and destructor --------------------------------------------------
+    /// values are exported as CSV or as binary table into the file
+    CTrajectoryAnalysisJob(CTrajectory* p_traj,const QString& name,bool binary);
+    ~CTrajectoryAnalysisJob(void);
+
+// setup methods ---------------------------------------------------------------
+    /// add property, it must be called before the job is submitted
+    bool AddProperty(CProperty* p_prop);
+
+// information methods ---------------------------------------------------------
+    /// get number of properties
+    int GetNumberOfProperties(void) const;
+
+// section of private data -----------------------------------------------------
+protected:
+    CTrajectoryAnalysis*    Analysis;
+    QString                 FileName;
+    bool                    Binary;
+    bool                    Initialized;
+
+    /// can we submit the job?
+    virtual bool JobAboutToBeSubmitted(void);
+
+    /// initialize job - executed from main thread
+    virtual bool InitializeJob(void);
+
+    /// job main execution point - executed from job thread
+    virtual bool ExecuteJob(void);
+
+    /// finalize job - executed from main thread
+    virtual bool FinalizeJob(void);
+
+signals:
+    // this signal is used due to thread safety - all GUI is done by master thread
+    void OnProgressTick(int progress);
+
+public slots:
+    // executed from main thread
+    void ProgressTick(int progress);
+};
+
+//------------------------------------------------------------------------------
+
+#endif
@@ -36,6 +36,16 @@
 #include <TrajectorySegment.hpp>
 #include <SnapshotFilter.hpp>
 #include <MainWindow.hpp>
+#include <BinTrajSegment.hpp>
+#include <BinTrajWriter.hpp>
+#include <TrajectoryAnalysisJob.hpp>
+#include <PropertyTerms.hpp>
+#include <PropertyList.hpp>
+#include <Property.hpp>
+#include <GlobalSetup.hpp>
+#include <ErrorSystem.hpp>
+#include <QFileDialog>
+#include <QMessageBox>
 
 #include <TrajectoryDesigner.hpp>
 
@@ -138,6 +148,12 @@ CTrajectoryDesigner::CTrajectoryDesigner(CTrajectory* p_owner)
     //------------------
     connect(WidgetUI.infoSegmentPB,SIGNAL(clicked(bool)),
             this,SLOT(SegmentInfo(void)));
+    //------------------
+    connect(WidgetUI.exportSegmentsPB,SIGNAL(clicked(bool)),
+            this,SLOT(ExportSegments(void)));
+    //----------------
+    connect(WidgetUI.exportPropertiesPB,SIGNAL(clicked(bool)),
+            this,SLOT(ExportProperties(void)));
 
     connect(WidgetUI.filtersTV->selectionModel(), SIGNAL(selectionChanged(const QItemSelection&, const QItemSelection&)),
             this,SLOT(FiltersTVSelectionChanged(void)));
@@ -337,6 +353,8 @@ void CTrajectoryDesigner::SegmentsTVSelectionChanged(void)
 {
     QModelIndexList selected_rows = WidgetUI.segmentsTV->selectionModel()->selectedRows();
     WidgetUI.deleteSegmentPB->setEnabled(selected_rows.count() > 0);
+    WidgetUI.exportSegmentsPB->setEnabled(Object->GetNumberOfSnapshots() > 0);
+    WidgetUI.exportPropertiesPB->setEnabled(Object->GetNumberOfSnapshots() > 0);
     WidgetUI.infoSegmentPB->setEnabled(selected_rows.count() > 0);
 
     if( selected_rows.count() == 1 ){
@@ -427,6 +445,98 @@ void CTrajectoryDesigner::SegmentInfo(void)
     }
 }
 
+//------------------------------------------------------------------------------
+
+void CTrajectoryDesigner::ExportSegments(void)
+{
+    QString filter;
+    QString filename = QFileDialog::getSaveFileName(this,
+                       tr("Export Binary Trajectory"),
+                       QString(GlobalSetup->GetLastOpenFilePath(BinTrajSegmentID)),
+                       "Binary trajectories (*.nbt);;Compressed binary trajectories (*.nbt)",
+                       &filter);
+
+    if( filename == NULL ) return;  // no file was selected
+
+    // update last open path
+    GlobalSetup->SetLastOpenFilePathFromFile(filename,BinTrajSegmentID);
+
+    if( ! filename.endsWith(".nbt") ){
+        filename += ".nbt";
+    }
+
+    CBinTrajWriter writer;
+    writer.SetCompression(filter.startsWith("Compressed"));
+
+    if( writer.ExportTrajectory(Object,filename) == true ) return;
+
+    ES_ERROR("unable to export trajectory");
+    QMessageBox::critical(NULL, tr("Export Binary Trajectory"),
+                          tr("An error occurred during trajectory export!"),
+                          QMessageBox::Ok,
+                          QMessageBox::Ok);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectoryDesigner::ExportProperties(void)
+{
+    CStructure* p_str = Object->GetStructure();
+    if( p_str == NULL ) return;
+
+    // only geometric properties of the trajectory structure can be evaluated
+    QList<CProperty*> properties;
+    foreach(QObject* p_qobj,Object->GetProject()->GetProperties()->children()){
+        CProperty* p_prop = static_cast<CProperty*>(p_qobj);
+        CPropertyTerms terms;
+        if( p_prop->IsFromStructure(p_str) == false ) continue;
+        if( p_prop->GetPropertyTerms(terms) == false ) continue;
+        properties.append(p_prop);
+    }
+
+    if( properties.isEmpty() ){
+        QMessageBox::information(NULL, tr("Export Property Values"),
+                                 tr("There are no properties of the trajectory structure!"),
+                                 QMessageBox::Ok,
+                                 QMessageBox::Ok);
+        return;
+    }
+
+    QString filter;
+    QString filename = QFileDialog::getSaveFileName(this,
+                       tr("Export Property Values"),
+                       QString(GlobalSetup->GetLastOpenFilePath(TrajectoryAnalysisJobID)),
+                       "CSV files (*.csv);;Binary property tables (*.npt)",
+                       &filter);
+
+    if( filename == NULL ) return;  // no file was selected
+
+    // update last open path
+    GlobalSetup->SetLastOpenFilePathFromFile(filename,TrajectoryAnalysisJobID);
+
+    bool binary = filter.startsWith("Binary");
+    if( binary && (! filename.endsWith(".npt")) ){
+        filename += ".npt";
+    }
+    if( (! binary) && (! filename.endsWith(".csv")) ){
+        filename += ".csv";
+    }
+
+    // frames are evaluated in the background, values are exported at the end
+    CTrajectoryAnalysisJob* p_job = new CTrajectoryAnalysisJob(Object,filename,binary);
+    foreach(CProperty* p_prop,properties){
+        p_job->AddProperty(p_prop);
+    }
+    if( p_job->SubmitJob() == true ) return;
+
+    delete p_job;
+    ES_ERROR("unable to submit trajectory analysis job");
+    QMessageBox::critical(NULL, tr("Export Property Values"),
+                          tr("Properties can be evaluated only when all trajectory segments are loaded and support background reading!"),
+                          QMessageBox::Ok,
+                          QMessageBox::Ok);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
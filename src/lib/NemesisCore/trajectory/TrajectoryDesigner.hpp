@@ -65,6 +65,8 @@ private slots:
     void MoveUpSegment(void);
     void MoveDownSegment(void);
     void SegmentInfo(void);
+    void ExportSegments(void);
+    void ExportProperties(void);
 
     void FiltersTVSelectionChanged(void);
     void FiltersTVDblClicked(const QModelIndex& index);
@@ -24,8 +24,15 @@
 #include <XMLElement.hpp>
 #include <ErrorSystem.hpp>
 #include <QFileInfo>
+#include <cctype>
+#include <cstdlib>
 #include <Structure.hpp>
 #include <AtomList.hpp>
+#include <Snapshot.hpp>
+#include <TrajectorySegmentJob.hpp>
+#include <JobScheduler.hpp>
+#include <JobList.hpp>
+#include <Project.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -36,18 +43,23 @@ CTrajectorySegment::CTrajectorySegment(CPluginObject* p_po,CTrajectory* p_traj,b
 {
     SeqIndex = 0;
     SnapshotIndex = 0;
+    LoadingJob = NULL;
 }
 
 //------------------------------------------------------------------------------
 
 CTrajectorySegment::~CTrajectorySegment(void)
 {
+    // derived classes should abort loading before they release their data
+    AbortTrajectoryDataLoading();
+
     CTrajectory* p_list = GetTrajectory();
 
     setParent(NULL);    // remove object from the list
 
     if( p_list ){
         p_list->Segments.removeOne(this);
+        p_list->InvalidateSnapshotOffsets();
         p_list->EmitOnTrajectorySegmentsChanged();
     }
 }
@@ -406,6 +418,34 @@ long int CTrajectorySegment::GetCurrentSnapshotIndex(void)
 
 //------------------------------------------------------------------------------
 
+bool CTrajectorySegment::CopySnapshot(long int index,CSnapshot* p_snap)
+{
+    if( p_snap == NULL ) return(false);
+    if( (index < 1) || (index > GetNumberOfSnapshots()) ) return(false);
+
+    // generic implementation - temporarily activate the requested snapshot
+    long int old_index = SnapshotIndex;
+    SnapshotIndex = index;
+    SnapshotChanged();
+
+    CSnapshot* p_src = GetCurrentSnapshot();
+    if( p_src != NULL ) p_snap->CopyFrom(p_src);
+
+    SnapshotIndex = old_index;
+    SnapshotChanged();
+
+    return(p_src != NULL);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::CanPrefetchSnapshots(void)
+{
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
 void CTrajectorySegment::SnapshotChanged(void)
 {
     // nothing to be here
@@ -490,6 +530,84 @@ void CTrajectorySegment::SaveData(CXMLElement* p_ele)
 //------------------------------------------------------------------------------
 
 void CTrajectorySegment::LoadTrajectoryData(void)
+{
+    AbortTrajectoryDataLoading();
+
+    if( BeginTrajectoryDataLoading() == false ) return;
+    bool result = ReadTrajectoryData(NULL);
+    PublishTrajectoryData();
+    EndTrajectoryDataLoading(result);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegment::LoadTrajectoryDataInBackground(void)
+{
+    if( (CanLoadTrajectoryDataInBackground() == false) || (JobScheduler == NULL) ){
+        LoadTrajectoryData();
+        return;
+    }
+
+    AbortTrajectoryDataLoading();
+
+    LoadingJob = new CTrajectorySegmentJob(this);
+    GetProject()->GetJobs()->RegisterJob(LoadingJob);
+    if( LoadingJob->SubmitJob() == false ){
+        delete LoadingJob;
+        LoadingJob = NULL;
+        LoadTrajectoryData();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::IsTrajectoryDataLoading(void)
+{
+    return(LoadingJob != NULL);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegment::AbortTrajectoryDataLoading(void)
+{
+    if( LoadingJob == NULL ) return;
+    CTrajectorySegmentJob* p_job = LoadingJob;
+    LoadingJob = NULL;
+    // the job finishes itself (and it is destroyed) from the event loop
+    p_job->DetachSegment();
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::CanLoadTrajectoryDataInBackground(void)
+{
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::BeginTrajectoryDataLoading(void)
+{
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::ReadTrajectoryData(CTrajectorySegmentJob* p_job)
+{
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegment::PublishTrajectoryData(void)
+{
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegment::EndTrajectoryDataLoading(bool result)
 {
     // nothing to be here
 }
@@ -498,3 +616,28 @@ void CTrajectorySegment::LoadTrajectoryData(void)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+
+const char* CTrajectorySegment::ReadNumber(const char* p_beg,const char* p_end,double& value)
+{
+    // the mapped data are not null terminated, thus copy the token
+    char    buffer[64];
+    int     len = 0;
+
+    while( (p_beg < p_end) && ((*p_beg == ' ') || (*p_beg == '\t')) ) p_beg++;
+    while( (p_beg < p_end) && (isspace(*p_beg) == 0) ){
+        if( len >= 63 ) return(NULL);
+        buffer[len++] = *p_beg++;
+    }
+    if( len == 0 ) return(NULL);
+    buffer[len] = '\0';
+
+    char* p_last = NULL;
+    value = strtod(buffer,&p_last);
+    if( p_last != buffer + len ) return(NULL);
+
+    return(p_beg);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -28,6 +28,7 @@
 class CTrajectory;
 class CSnapshot;
 class CStructure;
+class CTrajectorySegmentJob;
 
 // -----------------------------------------------------------------------------
 
@@ -124,6 +125,16 @@ public:
     /// get current snapshot index
     virtual long int GetCurrentSnapshotIndex(void);
 
+    /// copy snapshot with given index (1-based) into p_snap
+    /*! the current snapshot is not changed
+    */
+    virtual bool CopySnapshot(long int index,CSnapshot* p_snap);
+
+    /// can be snapshots decoded by the prefetch worker of CSnapshotCache?
+    /*! CopySnapshot must be thread safe if it returns true
+    */
+    virtual bool CanPrefetchSnapshots(void);
+
     /// snapshot index was changed
     virtual void SnapshotChanged(void);
 
@@ -147,13 +158,51 @@ public:
     /// load trajectory data
     virtual void LoadTrajectoryData(void);
 
+    /// load trajectory data by the background job
+    void LoadTrajectoryDataInBackground(void);
+
+    /// is trajectory data being loaded by the background job?
+    bool IsTrajectoryDataLoading(void);
+
+    /// terminate background loading and wait for its end
+    void AbortTrajectoryDataLoading(void);
+
 // section of private data -----------------------------------------------------
 protected:
-    int         SeqIndex;       // sequential index
-    QString     FileName;       // file name
-    long int    SnapshotIndex;  // snapshot index within the segment
+    int                     SeqIndex;       // sequential index
+    QString                 FileName;       // file name
+    long int                SnapshotIndex;  // snapshot index within the segment
+    CTrajectorySegmentJob*  LoadingJob;     // background loading job
+
+// data loading - see LoadTrajectoryData() for the sequence
+    /// can be data loaded in the background job?
+    virtual bool CanLoadTrajectoryDataInBackground(void);
+
+    /// prepare data loading - executed from main thread
+    virtual bool BeginTrajectoryDataLoading(void);
+
+    /// read data - executed from job thread or from main thread if p_job is NULL
+    /*! the method must not access GUI, project and other segment data
+        except those protected by the segment itself
+    */
+    virtual bool ReadTrajectoryData(CTrajectorySegmentJob* p_job);
+
+    /// make already read snapshots available - executed from main thread
+    /*! it returns true if new snapshots were published
+    */
+    virtual bool PublishTrajectoryData(void);
+
+    /// finish data loading - executed from main thread
+    virtual void EndTrajectoryDataLoading(bool result);
+
+// helpers for text formats
+    /// read whitespace separated real number from not null terminated data
+    /*! it returns position after the number or NULL on error
+    */
+    static const char* ReadNumber(const char* p_beg,const char* p_end,double& value);
 
     friend class CTrajectory;
+    friend class CTrajectorySegmentJob;
 };
 
 // -----------------------------------------------------------------------------
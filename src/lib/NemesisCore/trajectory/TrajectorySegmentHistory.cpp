@@ -57,7 +57,7 @@ void CTrajectorySegmentHI::Forward(void)
     p_traj->BeginUpdate();
     CTrajectorySegment* p_seg = p_traj->CreateSegment(p_ele);
     if( p_seg ){
-        p_seg->LoadTrajectoryData();
+        p_seg->LoadTrajectoryDataInBackground();
     }
     p_traj->EndUpdate();
 }
@@ -0,0 +1,165 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <TrajectorySegmentJob.hpp>
+#include <TrajectorySegment.hpp>
+#include <Trajectory.hpp>
+#include <Project.hpp>
+#include <NemesisCoreModule.hpp>
+#include <CategoryUUID.hpp>
+#include <QThread>
+
+//------------------------------------------------------------------------------
+
+CExtUUID        TrajectorySegmentJobID(
+                    "{TRAJECTORY_SEGMENT_JOB:3b6d0f52-8e7a-4c41-9d5e-1f2a6c7b8e90}",
+                    "Trajectory Segment Loader");
+
+CPluginObject   TrajectorySegmentJobObject(&NemesisCorePlugin,
+                    TrajectorySegmentJobID,JOB_CAT,
+                    ":/images/NemesisCore/trajectory/TrajectorySegment.svg",
+                    NULL);
+
+// minimum time between two notifications in ms
+#define TRAJ_SEGMENT_JOB_NOTIFY_TIME    250
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectorySegmentJob::CTrajectorySegmentJob(CTrajectorySegment* p_seg)
+    : CJob(&TrajectorySegmentJobObject,p_seg->GetProject())
+{
+    Segment = p_seg;
+    Initialized = false;
+    LastProgress = -1;
+
+    connect(this,SIGNAL(OnProgressTick(int)),
+            this,SLOT(ProgressTick(int)));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectorySegmentJob::IsTerminated(void)
+{
+    return(Terminated);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegmentJob::NotifyProgress(int progress)
+{
+    // the first notification is sent immediately so the first snapshots are available
+    if( (LastProgress >= 0) && (NotifyTimer.elapsed() < TRAJ_SEGMENT_JOB_NOTIFY_TIME) ) return;
+    if( progress == LastProgress ) return;
+
+    LastProgress = progress;
+    NotifyTimer.restart();
+
+    // this is due to thread safety
+    emit OnProgressTick(progress);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegmentJob::DetachSegment(void)
+{
+    TerminateJob();
+    // wait until the job thread stops to access segment data
+    GetJobThread()->wait();
+    Segment = NULL;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectorySegmentJob::InitializeJob(void)
+{
+    // always start the thread, the job is aborted in ExecuteJob if not initialized
+    // otherwise it would stay in the queue forever
+    Initialized = false;
+    if( Segment == NULL ) return(true);
+
+    Initialized = Segment->BeginTrajectoryDataLoading();
+    if( Initialized ){
+        QString text = tr("loading") + " " + Segment->GetName();
+        GetProject()->StartProgressNotification(100);
+        GetProject()->ProgressNotification(0,text);
+    }
+    NotifyTimer.start();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegmentJob::ExecuteJob(void)
+{
+    CTrajectorySegment* p_seg = Segment;
+    if( (p_seg == NULL) || (Initialized == false) ) return(false);
+    if( p_seg->ReadTrajectoryData(this) == false ) return(false);
+    return(Terminated == false);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySegmentJob::FinalizeJob(void)
+{
+    if( Initialized ){
+        GetProject()->EndProgressNotification();
+    }
+    if( Segment == NULL ) return(false);
+
+    CTrajectorySegment* p_seg = Segment;
+    Segment = NULL;
+    p_seg->LoadingJob = NULL;
+
+    if( Initialized == false ) return(false);
+
+    p_seg->PublishTrajectoryData();
+    p_seg->EndTrajectoryDataLoading(GetJobStatus() == EJS_FINISHED);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySegmentJob::ProgressTick(int progress)
+{
+    if( Segment == NULL ) return;
+
+    QString text = tr("loading") + " " + Segment->GetName();
+    GetProject()->ProgressNotification(progress,text);
+
+    // make already loaded snapshots available
+    if( Segment->PublishTrajectoryData() ){
+        if( Segment->GetTrajectory() ){
+            Segment->GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
@@ -0,0 +1,79 @@
+#ifndef TrajectorySegmentJobH
+#define TrajectorySegmentJobH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <Job.hpp>
+#include <QElapsedTimer>
+
+//------------------------------------------------------------------------------
+
+class CTrajectorySegment;
+
+//------------------------------------------------------------------------------
+
+/// background loading of trajectory segment data
+
+class NEMESIS_CORE_PACKAGE CTrajectorySegmentJob : public CJob {
+    Q_OBJECT
+public:
+// constructor and destructor --------------------------------------------------
+    CTrajectorySegmentJob(CTrajectorySegment* p_seg);
+
+// executed from job thread ----------------------------------------------------
+    /// was the job terminated by user?
+    bool IsTerminated(void);
+
+    /// notify about progress (0-100%) and publish already loaded snapshots
+    void NotifyProgress(int progress);
+
+// executed from main thread ---------------------------------------------------
+    /// terminate job and wait for its end, the segment is being destroyed
+    void DetachSegment(void);
+
+// section of private data -----------------------------------------------------
+protected:
+    CTrajectorySegment* Segment;
+    bool                Initialized;
+    int                 LastProgress;
+    QElapsedTimer       NotifyTimer;
+
+    /// initialize job - executed from main thread
+    virtual bool InitializeJob(void);
+
+    /// job main execution point - executed from job thread
+    virtual bool ExecuteJob(void);
+
+    /// finalize job - executed from main thread
+    virtual bool FinalizeJob(void);
+
+signals:
+    // this signal is used due to thread safety - all GUI is done by master thread
+    void OnProgressTick(int progress);
+
+public slots:
+    // executed from main thread
+    void ProgressTick(int progress);
+};
+
+//------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,639 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <TrajectorySelection.hpp>
+#include <ErrorSystem.hpp>
+#include <Trajectory.hpp>
+#include <TrajectorySegment.hpp>
+#include <Snapshot.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Atom.hpp>
+#include <ASLSelection.hpp>
+#include <ASLMaskCache.hpp>
+#include <SpatialIndex.hpp>
+#include <QThreadPool>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectorySelectionWorker::CTrajectorySelectionWorker(CTrajectorySelection* p_owner)
+{
+    Owner = p_owner;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelectionWorker::run(void)
+{
+    Owner->RunWorker();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectorySelection::CTrajectorySelection(CTrajectory* p_traj)
+{
+    Trajectory = p_traj;
+    Structure = NULL;
+    SnapshotCache = NULL;
+    NumOfAtoms = 0;
+    UseFrameIndex = false;
+    Valid = false;
+
+    FirstFrame = 0;
+    NumOfEvaluated = 0;
+    CurrentFrame = -1;
+
+    NextJob = 0;
+    NumOfWorkers = 0;
+    RunID = 0;
+    Generation = 0;
+    Terminate = false;
+
+    if( Trajectory == NULL ) return;
+
+    connect(Trajectory,SIGNAL(OnSnapshotChanged(void)),
+            this,SLOT(SnapshotChanged(void)));
+    //---------------
+    connect(Trajectory,SIGNAL(OnTrajectorySegmentsChanged(void)),
+            this,SLOT(TrajectorySegmentsChanged(void)));
+    //---------------
+    connect(Trajectory,SIGNAL(OnTrajectoryAboutToBeDestroyed(void)),
+            this,SLOT(TrajectoryDestroyed(void)),Qt::DirectConnection);
+}
+
+//------------------------------------------------------------------------------
+
+CTrajectorySelection::~CTrajectorySelection(void)
+{
+    Abort();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectorySelection::SetMask(const QString& mask)
+{
+    Invalidate();
+    Mask = mask;
+
+    if( Trajectory == NULL ){
+        ES_ERROR("no trajectory is assigned with selection");
+        return(false);
+    }
+
+    if( mask.isEmpty() ) {
+        ES_ERROR("mask is empty");
+        return(false);
+    }
+
+    Structure = Trajectory->GetStructure();
+    if( Structure == NULL ){
+        ES_ERROR("trajectory has no structure");
+        return(false);
+    }
+
+    // get compiled mask, it is parsed only if it was not used before
+    if( ASLMaskCache.GetProgram(Mask,Program) == false ) {
+        ES_ERROR("unable to compile mask");
+        return(false);
+    }
+
+    // topology is shared by all frames, only positions are replaced
+    Table.Build(Structure);
+    TrajIndexes.resize(Table.GetNumberOfAtoms());
+    for(int i=0; i < Table.GetNumberOfAtoms(); i++){
+        TrajIndexes[i] = Table.Atoms.at(i)->GetTrajIndex();
+    }
+    NumOfAtoms = Structure->GetAtoms()->GetNumberOfAtoms();
+    SnapshotCache = Trajectory->GetSnapshotCache();
+
+    // the spatial index of the structure describes only the current snapshot
+    UseFrameIndex = false;
+    foreach(const CASLInstruction& instr, Program.GetInstructions()){
+        if( (instr.Type == EASLI_DISTANCE) && (instr.Modificator == D_LIST) ){
+            UseFrameIndex = true;
+        }
+    }
+
+    Valid = true;
+
+    UpdateCurrentFrame();
+    emit OnSelectionChanged();
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectorySelection::Evaluate(long int first,long int last)
+{
+    Abort();
+
+    if( Valid == false ){
+        ES_ERROR("mask is not set");
+        return(false);
+    }
+
+    long int nframes = Trajectory->GetNumberOfSnapshots();
+    if( first < 1 ) first = 1;
+    if( last > nframes ) last = nframes;
+    if( first > last ){
+        ES_ERROR("no snapshots in the range");
+        return(false);
+    }
+
+    ResultMutex.lock();
+    FirstFrame = first;
+    Runs.fill(QVector<int>(),last - first + 1);
+    Evaluated.fill(false,last - first + 1);
+    NumOfEvaluated = 0;
+    ResultMutex.unlock();
+
+    // segments must not be released before the generation is obtained
+    Generation = SnapshotCache->GetGeneration();
+
+    QVector<CSnapshotCacheItem> jobs;
+    jobs.reserve(last - first + 1);
+    int njobs = 0;
+
+    for(long int frame = first; frame <= last; frame++){
+        long int segidx,snapidx;
+        CTrajectorySegment* p_seg = NULL;
+        if( Trajectory->FindSnapshot(frame,segidx,snapidx) ){
+            p_seg = Trajectory->GetSegment(segidx);
+        }
+        if( p_seg == NULL ){
+            jobs.append(CSnapshotCacheItem());
+            continue;
+        }
+        if( p_seg->CanPrefetchSnapshots() && (p_seg->IsTrajectoryDataLoading() == false) ){
+            jobs.append(CSnapshotCacheItem(p_seg,snapidx));
+            njobs++;
+            continue;
+        }
+        // other segments are not thread safe
+        QVector<int> runs;
+        if( EvaluateFrame(p_seg,snapidx,runs) ){
+            StoreFrame(frame,runs);
+        }
+        jobs.append(CSnapshotCacheItem());
+    }
+
+    int nworkers = QThreadPool::globalInstance()->maxThreadCount();
+    if( nworkers > njobs ) nworkers = njobs;
+
+    ResultMutex.lock();
+    Jobs = jobs;
+    NextJob = 0;
+    Terminate = false;
+    NumOfWorkers = nworkers;
+    RunID++;
+    int runid = RunID;
+    ResultMutex.unlock();
+
+    if( nworkers == 0 ){
+        QMetaObject::invokeMethod(this,"EvaluationFinished",Qt::QueuedConnection,Q_ARG(int,runid));
+        return(true);
+    }
+
+    for(int i=0; i < nworkers; i++){
+        QThreadPool::globalInstance()->start(new CTrajectorySelectionWorker(this));
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::EvaluateAll(void)
+{
+    if( Trajectory == NULL ) return(false);
+    return( Evaluate(1,Trajectory->GetNumberOfSnapshots()) );
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::Abort(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    Terminate = true;
+    while( NumOfWorkers > 0 ){
+        WorkersDone.wait(&ResultMutex);
+    }
+    Jobs.clear();
+    NextJob = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::Clear(void)
+{
+    Abort();
+
+    ResultMutex.lock();
+    FirstFrame = 0;
+    Runs.clear();
+    Evaluated.clear();
+    NumOfEvaluated = 0;
+    ResultMutex.unlock();
+
+    CurrentFrame = -1;
+    CurrentRuns.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::Invalidate(void)
+{
+    Clear();
+    Valid = false;
+    Structure = NULL;
+    Program.Clear();
+    Table.Clear();
+    TrajIndexes.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CTrajectory* CTrajectorySelection::GetTrajectory(void) const
+{
+    return(Trajectory);
+}
+
+//------------------------------------------------------------------------------
+
+const QString& CTrajectorySelection::GetMask(void) const
+{
+    return(Mask);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::IsRunning(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(NumOfWorkers > 0);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectorySelection::GetFirstFrame(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(FirstFrame);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectorySelection::GetLastFrame(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    if( Runs.count() == 0 ) return(0);
+    return(FirstFrame + Runs.count() - 1);
+}
+
+//------------------------------------------------------------------------------
+
+long int CTrajectorySelection::GetNumberOfEvaluatedFrames(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    return(NumOfEvaluated);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::IsFrameEvaluated(long int frame)
+{
+    QMutexLocker lock(&ResultMutex);
+    long int i = frame - FirstFrame;
+    if( (i < 0) || (i >= Evaluated.count()) ) return(false);
+    return(Evaluated.at(i));
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::GetFrameSelection(long int frame,CASLBitSet& bits)
+{
+    QVector<int> runs;
+    if( GetFrameRuns(frame,runs) == false ) return(false);
+    DecodeRuns(runs,Table.GetNumberOfAtoms(),bits);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int CTrajectorySelection::GetNumberOfSelectedAtoms(long int frame)
+{
+    QVector<int> runs;
+    if( GetFrameRuns(frame,runs) == false ) return(0);
+    return(GetNumberOfAtoms(runs));
+}
+
+//------------------------------------------------------------------------------
+
+const QList<CAtom*> CTrajectorySelection::GetSelectedAtoms(long int frame)
+{
+    QVector<int> runs;
+    GetFrameRuns(frame,runs);
+    return(GetAtoms(runs));
+}
+
+//------------------------------------------------------------------------------
+
+const QList<CAtom*> CTrajectorySelection::GetCurrentAtoms(void)
+{
+    return(GetAtoms(CurrentRuns));
+}
+
+//------------------------------------------------------------------------------
+
+qint64 CTrajectorySelection::GetMemoryUsage(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    qint64 size = Runs.count()*(sizeof(QVector<int>) + sizeof(bool));
+    foreach(const QVector<int>& runs, Runs){
+        size += runs.count()*sizeof(int);
+    }
+    return(size);
+}
+
+//------------------------------------------------------------------------------
+
+const QList<CAtom*> CTrajectorySelection::GetAtoms(const QVector<int>& runs)
+{
+    QList<CAtom*> list;
+    if( Valid == false ) return(list);
+
+    for(int i=0; i + 1 < runs.count(); i += 2){
+        for(int j=runs.at(i); j < runs.at(i+1); j++){
+            list.append(Table.Atoms.at(j));
+        }
+    }
+
+    return(list);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CTrajectorySelection::EvaluateFrame(CSnapshot* p_snap,QVector<int>& runs)
+{
+    // positions of the frame replace structure positions
+    CASLAtomTable table(Table);
+    if( p_snap != NULL ){
+        int ncrds = p_snap->Coordinates.GetLength();
+        for(int i=0; i < table.GetNumberOfAtoms(); i++){
+            int ti = TrajIndexes.at(i);
+            if( (ti >= 0) && (ti < ncrds) ) table.Positions[i] = p_snap->Coordinates[ti];
+        }
+    }
+
+    CSpatialIndex index;
+    if( UseFrameIndex ){
+        index.Build(table.Atoms,table.Positions,Structure->PBCInfo);
+    }
+
+    CASLSelection   evaluator(Structure,&table,UseFrameIndex ? &index : NULL);
+    CASLBitSet      bits;
+
+    if( evaluator.Evaluate(Program,bits) == false ) return(false);
+
+    EncodeRuns(bits,runs);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::EvaluateFrame(CTrajectorySegment* p_seg,long int index,QVector<int>& runs)
+{
+    CSnapshot snap(p_seg);
+    snap.Coordinates.CreateVector(NumOfAtoms);
+    if( p_seg->CopySnapshot(index,&snap) == false ) return(false);
+    return( EvaluateFrame(&snap,runs) );
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::StoreFrame(long int frame,const QVector<int>& runs)
+{
+    QMutexLocker lock(&ResultMutex);
+    long int i = frame - FirstFrame;
+    if( (i < 0) || (i >= Runs.count()) ) return;
+    Runs[i] = runs;
+    if( Evaluated.at(i) == false ){
+        Evaluated[i] = true;
+        NumOfEvaluated++;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::GetFrameRuns(long int frame,QVector<int>& runs)
+{
+    QMutexLocker lock(&ResultMutex);
+    long int i = frame - FirstFrame;
+    if( (i < 0) || (i >= Evaluated.count()) ) return(false);
+    if( Evaluated.at(i) == false ) return(false);
+    runs = Runs.at(i);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::UpdateCurrentFrame(void)
+{
+    CurrentRuns.clear();
+    CurrentFrame = Trajectory->GetCurrentSnapshotIndex();
+
+    if( GetFrameRuns(CurrentFrame,CurrentRuns) ) return;
+
+    // the snapshot is already decoded, evaluate it now
+    if( EvaluateFrame(Trajectory->GetCurrentSnapshot(),CurrentRuns) ){
+        StoreFrame(CurrentFrame,CurrentRuns);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectorySelection::RunWorker(void)
+{
+    long int            frame;
+    CSnapshotCacheItem  job;
+
+    while( TakeJob(frame,job) ){
+        CSnapshot snap(job.Segment);
+        snap.Coordinates.CreateVector(NumOfAtoms);
+
+        // it fails for released segments
+        if( SnapshotCache->CopySnapshot(job.Segment,job.Index,&snap,Generation) == false ) continue;
+
+        QVector<int> runs;
+        if( EvaluateFrame(&snap,runs) ){
+            StoreFrame(frame,runs);
+        }
+    }
+
+    WorkerFinished();
+}
+
+//------------------------------------------------------------------------------
+
+bool CTrajectorySelection::TakeJob(long int& frame,CSnapshotCacheItem& job)
+{
+    QMutexLocker lock(&ResultMutex);
+    while( (Terminate == false) && (NextJob < Jobs.count()) ){
+        int i = NextJob++;
+        if( Jobs.at(i).Segment == NULL ) continue;
+        job = Jobs.at(i);
+        frame = FirstFrame + i;
+        return(true);
+    }
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::WorkerFinished(void)
+{
+    QMutexLocker lock(&ResultMutex);
+    NumOfWorkers--;
+    if( NumOfWorkers > 0 ) return;
+
+    WorkersDone.wakeAll();
+    if( Terminate == false ){
+        // the signal is emitted from the main thread
+        QMetaObject::invokeMethod(this,"EvaluationFinished",Qt::QueuedConnection,Q_ARG(int,RunID));
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectorySelection::EncodeRuns(const CASLBitSet& bits,QVector<int>& runs)
+{
+    runs.clear();
+    int size = bits.GetSize();
+    int i = 0;
+    while( i < size ){
+        if( bits.Test(i) == false ){
+            i++;
+            continue;
+        }
+        int begin = i;
+        while( (i < size) && bits.Test(i) ) i++;
+        runs.append(begin);
+        runs.append(i);
+    }
+    runs.squeeze();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::DecodeRuns(const QVector<int>& runs,int size,CASLBitSet& bits)
+{
+    bits.Resize(size);
+    for(int i=0; i + 1 < runs.count(); i += 2){
+        bits.SetRange(runs.at(i),runs.at(i+1) - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int CTrajectorySelection::GetNumberOfAtoms(const QVector<int>& runs)
+{
+    int count = 0;
+    for(int i=0; i + 1 < runs.count(); i += 2){
+        count += runs.at(i+1) - runs.at(i);
+    }
+    return(count);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CTrajectorySelection::SnapshotChanged(void)
+{
+    if( Valid == false ) return;
+
+    // the topology was changed
+    if( (Trajectory->GetStructure() != Structure) ||
+        (Structure->GetAtoms()->GetNumberOfAtoms() != Table.GetNumberOfAtoms()) ){
+        Invalidate();
+        emit OnSelectionChanged();
+        return;
+    }
+
+    if( CurrentFrame == Trajectory->GetCurrentSnapshotIndex() ) return;
+
+    UpdateCurrentFrame();
+    emit OnSelectionChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::TrajectorySegmentsChanged(void)
+{
+    // snapshots were renumbered
+    Clear();
+    SnapshotChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::TrajectoryDestroyed(void)
+{
+    Invalidate();
+    Trajectory = NULL;
+    SnapshotCache = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void CTrajectorySelection::EvaluationFinished(int runid)
+{
+    if( runid != RunID ) return;
+
+    // frames evaluated in the background can differ from the current one
+    if( Valid && (Trajectory != NULL) ){
+        UpdateCurrentFrame();
+        emit OnSelectionChanged();
+    }
+
+    emit OnEvaluationFinished();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
@@ -0,0 +1,223 @@
+#ifndef TrajectorySelectionH
+#define TrajectorySelectionH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <ASLProgram.hpp>
+#include <ASLAtomTable.hpp>
+#include <ASLBitSet.hpp>
+#include <SnapshotCache.hpp>
+#include <QObject>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QList>
+
+// -----------------------------------------------------------------------------
+
+class CTrajectory;
+class CTrajectorySegment;
+class CTrajectorySelection;
+class CSnapshot;
+class CStructure;
+class CAtom;
+
+// -----------------------------------------------------------------------------
+
+/// background worker of trajectory selection
+
+class NEMESIS_CORE_PACKAGE CTrajectorySelectionWorker : public QRunnable {
+public:
+// constructor -----------------------------------------------------------------
+    CTrajectorySelectionWorker(CTrajectorySelection* p_owner);
+
+// section of private data -----------------------------------------------------
+private:
+    CTrajectorySelection*   Owner;
+
+    /// executed from the thread pool
+    virtual void run(void);
+};
+
+// -----------------------------------------------------------------------------
+
+///  ASL mask evaluated for each snapshot of the trajectory
+/*! the mask is compiled once, frames are evaluated in parallel by the global
+    thread pool, selected atoms of each frame are stored as runs of atom indexes
+    in the order of CAtomList children, the selection of the current snapshot
+    is updated when the trajectory emits OnSnapshotChanged,
+    results are destroyed when trajectory segments are changed,
+    the structure topology must not be changed while frames are evaluated
+*/
+
+class NEMESIS_CORE_PACKAGE CTrajectorySelection : public QObject {
+Q_OBJECT
+public:
+// constructor -----------------------------------------------------------------
+    CTrajectorySelection(CTrajectory* p_traj);
+    ~CTrajectorySelection(void);
+
+// setup methods ---------------------------------------------------------------
+    /// set mask, previous results are destroyed
+    bool SetMask(const QString& mask);
+
+// executive methods -----------------------------------------------------------
+    /// evaluate frames in the range (counted from 1) in the background
+    /*! frames of segments that cannot be decoded in parallel are evaluated
+        immediately, OnEvaluationFinished is emitted at the end
+    */
+    bool Evaluate(long int first,long int last);
+
+    /// evaluate all frames in the background
+    bool EvaluateAll(void);
+
+    /// stop background evaluation and wait for workers
+    void Abort(void);
+
+    /// destroy all results
+    void Clear(void);
+
+// information methods ---------------------------------------------------------
+    /// get associated trajectory
+    CTrajectory* GetTrajectory(void) const;
+
+    /// return current mask specification
+    const QString& GetMask(void) const;
+
+    /// is background evaluation running?
+    bool IsRunning(void);
+
+    /// get the first frame of the evaluated range
+    long int GetFirstFrame(void);
+
+    /// get the last frame of the evaluated range
+    long int GetLastFrame(void);
+
+    /// get number of already evaluated frames
+    long int GetNumberOfEvaluatedFrames(void);
+
+    /// is frame evaluated?
+    bool IsFrameEvaluated(long int frame);
+
+    /// get selected atoms of the frame as bits in the order of CAtomList children
+    bool GetFrameSelection(long int frame,CASLBitSet& bits);
+
+    /// get number of selected atoms in the frame
+    int GetNumberOfSelectedAtoms(long int frame);
+
+    /// get selected atoms of the frame
+    const QList<CAtom*> GetSelectedAtoms(long int frame);
+
+    /// get selected atoms of the current snapshot
+    const QList<CAtom*> GetCurrentAtoms(void);
+
+    /// get memory occupied by results in bytes
+    qint64 GetMemoryUsage(void);
+
+signals:
+    /// emmited when selection of the current snapshot is changed
+    void OnSelectionChanged(void);
+
+    /// emmited when background evaluation is finished
+    void OnEvaluationFinished(void);
+
+// section of private data -----------------------------------------------------
+private:
+    CTrajectory*        Trajectory;
+    CStructure*         Structure;
+    CSnapshotCache*     SnapshotCache;
+    QString             Mask;
+    CASLProgram         Program;
+    CASLAtomTable       Table;
+    QVector<int>        TrajIndexes;    // snapshot index of each atom in Table
+    int                 NumOfAtoms;     // number of coordinates in snapshots
+    bool                UseFrameIndex;  // build spatial index for each frame
+    bool                Valid;
+
+    // results
+    QMutex                  ResultMutex;
+    long int                FirstFrame;
+    QVector< QVector<int> > Runs;       // [begin,end) pairs of selected atoms
+    QVector<bool>           Evaluated;
+    long int                NumOfEvaluated;
+
+    // current snapshot
+    long int                CurrentFrame;
+    QVector<int>            CurrentRuns;
+
+    // background evaluation
+    QWaitCondition              WorkersDone;
+    QVector<CSnapshotCacheItem> Jobs;   // segment is NULL for already evaluated frames
+    int                         NextJob;
+    int                         NumOfWorkers;
+    int                         RunID;
+    quint64                     Generation;
+    bool                        Terminate;
+
+    /// destroy results and mask
+    void Invalidate(void);
+
+    /// evaluate mask for coordinates of the snapshot, structure positions are used for NULL
+    bool EvaluateFrame(CSnapshot* p_snap,QVector<int>& runs);
+
+    /// evaluate frame from the segment in the calling thread
+    bool EvaluateFrame(CTrajectorySegment* p_seg,long int index,QVector<int>& runs);
+
+    /// store frame results
+    void StoreFrame(long int frame,const QVector<int>& runs);
+
+    /// get frame results
+    bool GetFrameRuns(long int frame,QVector<int>& runs);
+
+    /// update selection of the current snapshot
+    void UpdateCurrentFrame(void);
+
+    /// get atoms from runs
+    const QList<CAtom*> GetAtoms(const QVector<int>& runs);
+
+    // workers
+    /// worker main loop
+    void RunWorker(void);
+
+    /// take next frame
+    bool TakeJob(long int& frame,CSnapshotCacheItem& job);
+
+    /// worker finished
+    void WorkerFinished(void);
+
+    // run-length encoding
+    static void EncodeRuns(const CASLBitSet& bits,QVector<int>& runs);
+    static void DecodeRuns(const QVector<int>& runs,int size,CASLBitSet& bits);
+    static int  GetNumberOfAtoms(const QVector<int>& runs);
+
+    friend class CTrajectorySelectionWorker;
+
+private slots:
+    void SnapshotChanged(void);
+    void TrajectorySegmentsChanged(void);
+    void TrajectoryDestroyed(void);
+    void EvaluationFinished(int runid);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
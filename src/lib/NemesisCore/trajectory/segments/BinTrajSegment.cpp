@@ -0,0 +1,430 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <Trajectory.hpp>
+#include <XMLElement.hpp>
+#include <ErrorSystem.hpp>
+#include <Project.hpp>
+#include <cstring>
+#include <QtEndian>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+
+#include <BinTrajSegment.hpp>
+#include <TrajectorySegmentJob.hpp>
+#include <NemesisCoreModule.hpp>
+#include <SnapshotCache.hpp>
+
+//------------------------------------------------------------------------------
+
+QObject* BinTrajSegmentCB(void* p_data);
+
+CExtUUID        BinTrajSegmentID(
+                    "{BIN_TRAJ_SEGMENT:0c8f5a3e-6b2d-4f7a-9e41-2d7c5b8a1f36}",
+                    "Binary Trajectory");
+
+CPluginObject   BinTrajSegmentObject(&NemesisCorePlugin,
+                    BinTrajSegmentID,TRAJECTORY_SEGMENT_CAT,
+                    ":/images/NemesisCore/trajectory/segments/XYZTrajSegment.svg",
+                    BinTrajSegmentCB);
+
+// -----------------------------------------------------------------------------
+
+QObject* BinTrajSegmentCB(void* p_data)
+{
+    CTrajectory* p_traj = static_cast<CTrajectory*>(p_data);
+    if( p_traj == NULL ){
+        ES_ERROR("CBinTrajSegment requires active trajectory");
+        return(NULL);
+    }
+
+    QObject* p_build_wp = new CBinTrajSegment(p_traj);
+    return(p_build_wp);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBinTrajSegment::CBinTrajSegment(CTrajectory* p_traj)
+    : CTrajectorySegment(&BinTrajSegmentObject,p_traj,true)
+{
+    FileData = NULL;
+    FileSize = 0;
+    Compressed = false;
+    Precision = 0.0;
+    NumOfFrames = 0;
+    IndexOffset = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CBinTrajSegment::~CBinTrajSegment(void)
+{
+    AbortTrajectoryDataLoading();
+    CloseTrajectoryData();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+long int CBinTrajSegment::GetNumberOfSnapshots(void)
+{
+    return(FrameOffsets.count());
+}
+
+//------------------------------------------------------------------------------
+
+CSnapshot* CBinTrajSegment::GetCurrentSnapshot(void)
+{
+    if( (SnapshotIndex < 1) || (SnapshotIndex > GetNumberOfSnapshots()) ) return(NULL);
+
+    CSnapshotCache* p_cache = GetTrajectory()->GetSnapshotCache();
+    CSnapshot* p_snap = p_cache->Find(this,SnapshotIndex);
+    if( p_snap != NULL ) return(p_snap);
+
+    // decode snapshot from the file
+    p_snap = new CSnapshot(this);
+    p_snap->InitSnapshot();
+    if( ReadSnapshot(SnapshotIndex,p_snap) == false ){
+        delete p_snap;
+        CSmallString error;
+        error << tr("unable read snapshot") << " '" << SnapshotIndex << "' (corrupted data)";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        return(NULL);
+    }
+    p_cache->Insert(this,SnapshotIndex,p_snap);
+
+    return(p_snap);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::CopySnapshot(long int index,CSnapshot* p_snap)
+{
+    if( p_snap == NULL ) return(false);
+    // decode directly, the cache must keep the current snapshot
+    return( ReadSnapshot(index,p_snap) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::CanPrefetchSnapshots(void)
+{
+    // ReadSnapshot uses only the mapped file and the frame index
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::IsCompressed(void) const
+{
+    return(Compressed);
+}
+
+//------------------------------------------------------------------------------
+
+double CBinTrajSegment::GetPrecision(void) const
+{
+    return(Precision);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CBinTrajSegment::CanLoadTrajectoryDataInBackground(void)
+{
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::BeginTrajectoryDataLoading(void)
+{
+    bool had_data = FrameOffsets.count() > 0;
+    CloseTrajectoryData();
+    if( had_data ){
+        // release the snapshot from the structure
+        GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+    }
+
+    File.setFileName(FileName);
+    if( File.open(QIODevice::ReadOnly) == false ) {
+        CSmallString error;
+        error << tr("unable open trajectory segment") << " '" << FileName << "'";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        return(false);
+    }
+
+    FileSize = File.size();
+    if( FileSize >= BIN_TRAJ_HEADER_SIZE ){
+        FileData = reinterpret_cast<const char*>(File.map(0,FileSize));
+    }
+    if( FileData == NULL ){
+        CSmallString error;
+        error << tr("unable map trajectory segment") << " '" << FileName << "'";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        CloseTrajectoryData();
+        return(false);
+    }
+
+    // check header
+    const uchar* p_header = reinterpret_cast<const uchar*>(FileData);
+    quint32 version = qFromLittleEndian<quint32>(p_header + 8);
+    quint32 natoms  = qFromLittleEndian<quint32>(p_header + 12);
+    quint32 flags   = qFromLittleEndian<quint32>(p_header + 16);
+    quint64 prec    = qFromLittleEndian<quint64>(p_header + 24);
+    NumOfFrames     = qFromLittleEndian<qint64>(p_header + 32);
+    IndexOffset     = qFromLittleEndian<qint64>(p_header + 40);
+
+    Compressed = (flags & BIN_TRAJ_COMPRESSED) != 0;
+    memcpy(&Precision,&prec,sizeof(Precision));
+
+    if( (memcmp(FileData,BIN_TRAJ_MAGIC,8) != 0) || (version != BIN_TRAJ_VERSION) ){
+        CSmallString error;
+        error << tr("ERROR: not a valid binary trajectory file") << " '" << FileName << "'";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        CloseTrajectoryData();
+        return(false);
+    }
+
+    if( (int)natoms != GetNumberOfAtoms() ){
+        CSmallString error;
+        error << tr("unable open trajectory segment") << " '" << FileName << "' (inconsistent number of atoms)";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        CloseTrajectoryData();
+        return(false);
+    }
+
+    if( Compressed && (Precision <= 0.0) ){
+        CSmallString error;
+        error << tr("ERROR: illegal precision in binary trajectory file") << " '" << FileName << "'";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        CloseTrajectoryData();
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::ReadTrajectoryData(CTrajectorySegmentJob* p_job)
+{
+    if( ReadFrameIndex() ) return(true);
+    return( ScanFrames(p_job) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::PublishTrajectoryData(void)
+{
+    QMutexLocker lock(&LoadingMutex);
+
+    if( PendingOffsets.count() == 0 ) return(false);
+
+    FrameOffsets += PendingOffsets;
+    PendingOffsets.clear();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CBinTrajSegment::EndTrajectoryDataLoading(bool result)
+{
+    if( LoadingError.isEmpty() == false ){
+        GetProject()->TextNotification(ETNT_ERROR,LoadingError,ETNT_ERROR_DELAY);
+    }
+    LoadingError.clear();
+
+    // notify about changes
+    GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CBinTrajSegment::CloseTrajectoryData(void)
+{
+    // the cache and the prefetch worker must not access released data
+    if( GetTrajectory() ) GetTrajectory()->GetSnapshotCache()->RemoveSegment(this);
+    FrameOffsets.clear();
+    PendingOffsets.clear();
+    LoadingError.clear();
+    NumOfFrames = 0;
+    IndexOffset = 0;
+    if( FileData != NULL ){
+        File.unmap(reinterpret_cast<uchar*>(const_cast<char*>(FileData)));
+        FileData = NULL;
+    }
+    FileSize = 0;
+    if( File.isOpen() ) File.close();
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::ReadFrameIndex(void)
+{
+    if( (IndexOffset < BIN_TRAJ_HEADER_SIZE) || (NumOfFrames < 0) ) return(false);
+    if( IndexOffset + NumOfFrames*8 != FileSize ) return(false);
+
+    QVector<qint64> offsets;
+    offsets.reserve(NumOfFrames);
+
+    const uchar* p_index = reinterpret_cast<const uchar*>(FileData + IndexOffset);
+    for(qint64 i=0; i < NumOfFrames; i++){
+        qint64 offset = qFromLittleEndian<qint64>(p_index + 8*i);
+        if( (offset < BIN_TRAJ_HEADER_SIZE) || (offset + 8 > IndexOffset) ) return(false);
+        if( (i > 0) && (offset <= offsets.last()) ) return(false);
+        offsets.append(offset);
+    }
+
+    QMutexLocker lock(&LoadingMutex);
+    PendingOffsets = offsets;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::ScanFrames(CTrajectorySegmentJob* p_job)
+{
+    // the index is missing, the frames are chained by their sizes
+    qint64          end = IndexOffset >= BIN_TRAJ_HEADER_SIZE ? IndexOffset : FileSize;
+    qint64          pos = BIN_TRAJ_HEADER_SIZE;
+    QVector<qint64> offsets;
+
+    while( pos + 8 <= end ){
+        quint32 size = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(FileData + pos));
+        if( pos + 4 + size > end ){
+            CSmallString error;
+            error << tr("unable read snapshot") << " '" << (FrameOffsets.count() + offsets.count() + 1) << "' (premature end of snapshot)";
+            LoadingError = QString(error);
+            break;
+        }
+        offsets.append(pos);
+        pos += 4 + size;
+
+        // publish snapshots in blocks
+        if( offsets.count() >= 256 ){
+            LoadingMutex.lock();
+            PendingOffsets += offsets;
+            LoadingMutex.unlock();
+            offsets.clear();
+            if( p_job != NULL ){
+                p_job->NotifyProgress(int(100*pos/FileSize));
+                if( p_job->IsTerminated() ) return(false);
+            }
+        }
+    }
+
+    QMutexLocker lock(&LoadingMutex);
+    PendingOffsets += offsets;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajSegment::ReadSnapshot(long int index,CSnapshot* p_snap)
+{
+    if( (index < 1) || (index > GetNumberOfSnapshots()) ) return(false);
+
+    const uchar* p_cur = reinterpret_cast<const uchar*>(FileData + FrameOffsets[index-1]);
+    const uchar* p_file_end = reinterpret_cast<const uchar*>(FileData + FileSize);
+
+    if( p_cur + 8 > p_file_end ) return(false);
+    quint32 size   = qFromLittleEndian<quint32>(p_cur);
+    const uchar* p_end = p_cur + 4 + size;
+    if( p_end > p_file_end ) return(false);
+    quint32 nprops = qFromLittleEndian<quint32>(p_cur + 4);
+    p_cur += 8;
+
+    // properties
+    if( p_cur + (qint64)nprops*12 > p_end ) return(false);
+    for(quint32 i=0; i < nprops; i++){
+        qint32  key  = qFromLittleEndian<qint32>(p_cur);
+        quint64 bits = qFromLittleEndian<quint64>(p_cur + 4);
+        double  value;
+        memcpy(&value,&bits,sizeof(value));
+        p_snap->SetProperty(key,value);
+        p_cur += 12;
+    }
+
+    // the snapshot size is used, this can be executed from the prefetch worker
+    int natoms = p_snap->Coordinates.GetLength();
+
+    // uncompressed coordinates
+    if( Compressed == false ){
+        if( p_cur + (qint64)natoms*12 > p_end ) return(false);
+        for(int i=0; i < natoms; i++){
+            float   xyz[3];
+            for(int k=0; k < 3; k++){
+                quint32 bits = qFromLittleEndian<quint32>(p_cur);
+                memcpy(&xyz[k],&bits,sizeof(float));
+                p_cur += 4;
+            }
+            p_snap->SetPos(i,CPoint(xyz[0],xyz[1],xyz[2]));
+        }
+        return(true);
+    }
+
+    // compressed coordinates
+    qint64  q[3] = {0, 0, 0};
+    double  scale = 1.0 / Precision;
+    for(int i=0; i < natoms; i++){
+        for(int k=0; k < 3; k++){
+            qint64 delta;
+            if( (p_cur = ReadVarInt(p_cur,p_end,delta)) == NULL ) return(false);
+            q[k] += delta;
+        }
+        p_snap->SetPos(i,CPoint(q[0]*scale,q[1]*scale,q[2]*scale));
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+const uchar* CBinTrajSegment::ReadVarInt(const uchar* p_beg,const uchar* p_end,qint64& value)
+{
+    quint64 data = 0;
+    int     shift = 0;
+
+    while( p_beg < p_end ){
+        uchar byte = *p_beg++;
+        data |= (quint64)(byte & 0x7F) << shift;
+        if( (byte & 0x80) == 0 ){
+            // zigzag decoding
+            value = (qint64)(data >> 1) ^ -(qint64)(data & 1);
+            return(p_beg);
+        }
+        shift += 7;
+        if( shift > 63 ) return(NULL);
+    }
+
+    return(NULL);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
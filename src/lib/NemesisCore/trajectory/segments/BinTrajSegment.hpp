@@ -0,0 +1,144 @@
+#ifndef BinTrajSegmentH
+#define BinTrajSegmentH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <TrajectorySegment.hpp>
+#include <Snapshot.hpp>
+#include <QFile>
+#include <QVector>
+#include <QMutex>
+
+// -----------------------------------------------------------------------------
+
+class CTrajectory;
+
+// -----------------------------------------------------------------------------
+
+extern CExtUUID NEMESIS_CORE_PACKAGE BinTrajSegmentID;
+
+// -----------------------------------------------------------------------------
+
+/*
+ binary trajectory file (.nbt), all items are little endian
+
+ header (48 bytes):
+    char[8]     magic "NEMBTRJ1"
+    uint32      version
+    uint32      number of atoms
+    uint32      flags (BIN_TRAJ_COMPRESSED)
+    uint32      reserved
+    float64     precision (compressed files only, 1000 means 0.001 A)
+    uint64      number of frames
+    uint64      offset of frame index (0 if the file was not closed properly)
+
+ frame:
+    uint32      size of frame data
+    uint32      number of properties
+    n x         int32 key, float64 value
+    data        uncompressed: natoms x 3 float32
+                compressed: coordinates multiplied by precision and rounded to integers,
+                            differences to the previous atom stored as zigzag varints
+
+ frame index:
+    nframes x   uint64 offset of frame
+*/
+
+#define BIN_TRAJ_MAGIC          "NEMBTRJ1"
+#define BIN_TRAJ_VERSION        1
+#define BIN_TRAJ_HEADER_SIZE    48
+#define BIN_TRAJ_COMPRESSED     0x00000001
+
+// -----------------------------------------------------------------------------
+
+///  binary trajectory segment
+/*! the file is memory mapped, the frame index is stored at the end of file,
+    snapshots are decoded on demand and kept in a small LRU cache
+*/
+
+class NEMESIS_CORE_PACKAGE CBinTrajSegment : public CTrajectorySegment {
+Q_OBJECT
+public:
+// constructor -----------------------------------------------------------------
+    CBinTrajSegment(CTrajectory* p_traj);
+    ~CBinTrajSegment(void);
+
+// information methods ---------------------------------------------------------
+    /// get number of snaphots in the file
+    virtual long int GetNumberOfSnapshots(void);
+
+    /// get current segment
+    virtual CSnapshot* GetCurrentSnapshot(void);
+
+    /// copy snapshot with given index into p_snap
+    virtual bool CopySnapshot(long int index,CSnapshot* p_snap);
+
+    /// snapshots can be decoded by the prefetch worker
+    virtual bool CanPrefetchSnapshots(void);
+
+    /// are coordinates stored with fixed precision?
+    bool IsCompressed(void) const;
+
+    /// get precision of compressed coordinates
+    double GetPrecision(void) const;
+
+// section of private data -----------------------------------------------------
+private:
+    QFile               File;
+    const char*         FileData;       // memory mapped file
+    qint64              FileSize;
+    bool                Compressed;
+    double              Precision;
+    qint64              NumOfFrames;    // number of frames from the header
+    qint64              IndexOffset;    // offset of the frame index from the header
+    QVector<qint64>     FrameOffsets;   // offsets of frames
+
+    // data shared with the loading job
+    QMutex              LoadingMutex;
+    QVector<qint64>     PendingOffsets; // offsets of frames that are not published yet
+    QString             LoadingError;
+
+    /// data loading
+    virtual bool CanLoadTrajectoryDataInBackground(void);
+    virtual bool BeginTrajectoryDataLoading(void);
+    virtual bool ReadTrajectoryData(CTrajectorySegmentJob* p_job);
+    virtual bool PublishTrajectoryData(void);
+    virtual void EndTrajectoryDataLoading(bool result);
+
+    /// unmap the file and release index and cache
+    void CloseTrajectoryData(void);
+
+    /// read frame index stored in the file
+    bool ReadFrameIndex(void);
+
+    /// build frame index from frame sizes (file was not closed properly)
+    bool ScanFrames(CTrajectorySegmentJob* p_job);
+
+    /// decode snapshot from the mapped file
+    bool ReadSnapshot(long int index,CSnapshot* p_snap);
+
+    /// decode zigzag varint, it returns position after the number or NULL on error
+    const uchar* ReadVarInt(const uchar* p_beg,const uchar* p_end,qint64& value);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,286 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <BinTrajWriter.hpp>
+#include <BinTrajSegment.hpp>
+#include <Trajectory.hpp>
+#include <TrajectorySegment.hpp>
+#include <Snapshot.hpp>
+#include <Structure.hpp>
+#include <AtomList.hpp>
+#include <Project.hpp>
+#include <ErrorSystem.hpp>
+#include <cmath>
+#include <cstring>
+#include <QtEndian>
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CBinTrajWriter::CBinTrajWriter(void)
+{
+    NumOfAtoms = 0;
+    Compressed = false;
+    Precision = 1000.0;
+}
+
+//------------------------------------------------------------------------------
+
+CBinTrajWriter::~CBinTrajWriter(void)
+{
+    if( File.isOpen() ) Close();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBinTrajWriter::SetCompression(bool compressed,double precision)
+{
+    Compressed = compressed;
+    Precision = precision;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CBinTrajWriter::Open(const QString& name,int natoms)
+{
+    if( File.isOpen() ){
+        ES_ERROR("file is already opened");
+        return(false);
+    }
+    if( Compressed && (Precision <= 0.0) ){
+        ES_ERROR("precision must be positive number");
+        return(false);
+    }
+
+    File.setFileName(name);
+    if( File.open(QIODevice::WriteOnly | QIODevice::Truncate) == false ){
+        CSmallString error;
+        error << "unable to create binary trajectory file '" << name << "'";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    NumOfAtoms = natoms;
+    FrameOffsets.clear();
+
+    // header - the number of frames and the index offset are written in Close()
+    quint64 prec;
+    memcpy(&prec,&Precision,sizeof(prec));
+
+    Buffer.clear();
+    Buffer.append(BIN_TRAJ_MAGIC,8);
+    AppendUInt32(BIN_TRAJ_VERSION);
+    AppendUInt32(NumOfAtoms);
+    AppendUInt32(Compressed ? BIN_TRAJ_COMPRESSED : 0);
+    AppendUInt32(0);
+    AppendUInt64(prec);
+    AppendUInt64(0);
+    AppendUInt64(0);
+
+    if( File.write(Buffer) != Buffer.size() ){
+        ES_ERROR("unable to write header");
+        File.close();
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajWriter::WriteSnapshot(CSnapshot* p_snap)
+{
+    if( (File.isOpen() == false) || (p_snap == NULL) ) return(false);
+    if( p_snap->Coordinates.GetLength() != NumOfAtoms ){
+        ES_ERROR("inconsistent number of atoms");
+        return(false);
+    }
+
+    Buffer.clear();
+    AppendUInt32(0);    // frame size, updated below
+    AppendUInt32(p_snap->ScalarProperties.count());
+
+    QMapIterator<int,double> it(p_snap->ScalarProperties);
+    while( it.hasNext() ){
+        it.next();
+        double  value = it.value();
+        quint64 bits;
+        memcpy(&bits,&value,sizeof(bits));
+        AppendUInt32((quint32)it.key());
+        AppendUInt64(bits);
+    }
+
+    if( Compressed == false ){
+        for(int i=0; i < NumOfAtoms; i++){
+            const CPoint& pos = p_snap->Coordinates[i];
+            float   xyz[3] = {(float)pos.x, (float)pos.y, (float)pos.z};
+            for(int k=0; k < 3; k++){
+                quint32 bits;
+                memcpy(&bits,&xyz[k],sizeof(bits));
+                AppendUInt32(bits);
+            }
+        }
+    } else {
+        // neighbouring atoms are close in space thus differences are small numbers
+        qint64  last[3] = {0, 0, 0};
+        for(int i=0; i < NumOfAtoms; i++){
+            const CPoint& pos = p_snap->Coordinates[i];
+            qint64  q[3];
+            q[0] = llround(pos.x*Precision);
+            q[1] = llround(pos.y*Precision);
+            q[2] = llround(pos.z*Precision);
+            for(int k=0; k < 3; k++){
+                AppendVarInt(q[k] - last[k]);
+                last[k] = q[k];
+            }
+        }
+    }
+
+    qToLittleEndian<quint32>(Buffer.size() - 4,reinterpret_cast<uchar*>(Buffer.data()));
+
+    FrameOffsets.append(File.pos());
+    if( File.write(Buffer) != Buffer.size() ){
+        ES_ERROR("unable to write snapshot");
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajWriter::Close(void)
+{
+    if( File.isOpen() == false ) return(false);
+
+    // frame index
+    qint64 index_offset = File.pos();
+    Buffer.clear();
+    foreach(qint64 offset, FrameOffsets){
+        AppendUInt64(offset);
+    }
+    bool result = File.write(Buffer) == Buffer.size();
+
+    // update header
+    Buffer.clear();
+    AppendUInt64(FrameOffsets.count());
+    AppendUInt64(index_offset);
+    result &= File.seek(32);
+    result &= File.write(Buffer) == Buffer.size();
+
+    File.close();
+    FrameOffsets.clear();
+
+    if( result == false ){
+        ES_ERROR("unable to write frame index");
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+bool CBinTrajWriter::ExportTrajectory(CTrajectory* p_traj,const QString& name)
+{
+    if( (p_traj == NULL) || (p_traj->GetStructure() == NULL) ){
+        ES_ERROR("trajectory with structure is required");
+        return(false);
+    }
+
+    if( Open(name,p_traj->GetStructure()->GetAtoms()->GetNumberOfAtoms()) == false ){
+        return(false);
+    }
+
+    CProject* p_project = p_traj->GetProject();
+    p_project->StartProgressNotification(p_traj->GetNumberOfSnapshots());
+
+    bool    result = true;
+    long int count = 0;
+    for(long int s=1; (s <= p_traj->GetNumberOfSegments()) && result; s++){
+        CTrajectorySegment* p_seg = p_traj->GetSegment(s);
+        if( p_seg == NULL ) continue;
+
+        CSnapshot snap(p_seg);
+        snap.InitSnapshot();
+
+        for(long int i=1; i <= p_seg->GetNumberOfSnapshots(); i++){
+            if( p_seg->CopySnapshot(i,&snap) == false ){
+                CSmallString error;
+                error << "unable to read snapshot " << i << " from segment '" << p_seg->GetName() << "'";
+                ES_ERROR(error);
+                result = false;
+                break;
+            }
+            if( WriteSnapshot(&snap) == false ){
+                result = false;
+                break;
+            }
+            count++;
+            p_project->ProgressNotification(count,QObject::tr("exporting trajectory"));
+        }
+    }
+
+    p_project->EndProgressNotification();
+
+    result &= Close();
+    return(result);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CBinTrajWriter::AppendUInt32(quint32 value)
+{
+    uchar data[4];
+    qToLittleEndian<quint32>(value,data);
+    Buffer.append(reinterpret_cast<const char*>(data),4);
+}
+
+//------------------------------------------------------------------------------
+
+void CBinTrajWriter::AppendUInt64(quint64 value)
+{
+    uchar data[8];
+    qToLittleEndian<quint64>(value,data);
+    Buffer.append(reinterpret_cast<const char*>(data),8);
+}
+
+//------------------------------------------------------------------------------
+
+void CBinTrajWriter::AppendVarInt(qint64 value)
+{
+    // zigzag encoding
+    quint64 data = ((quint64)value << 1) ^ (quint64)(value >> 63);
+    while( data >= 0x80 ){
+        Buffer.append((char)((data & 0x7F) | 0x80));
+        data >>= 7;
+    }
+    Buffer.append((char)data);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
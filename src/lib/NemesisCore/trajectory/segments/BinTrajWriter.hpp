@@ -0,0 +1,81 @@
+#ifndef BinTrajWriterH
+#define BinTrajWriterH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+
+// -----------------------------------------------------------------------------
+
+class CTrajectory;
+class CSnapshot;
+
+// -----------------------------------------------------------------------------
+
+///  writer of binary trajectory files
+/*! see BinTrajSegment.hpp for the file format
+*/
+
+class NEMESIS_CORE_PACKAGE CBinTrajWriter {
+public:
+// constructor -----------------------------------------------------------------
+    CBinTrajWriter(void);
+    ~CBinTrajWriter(void);
+
+// setup methods ---------------------------------------------------------------
+    /// store coordinates as integers with given precision (1000 means 0.001 A)
+    void SetCompression(bool compressed,double precision=1000.0);
+
+// input/output methods --------------------------------------------------------
+    /// create the file
+    bool Open(const QString& name,int natoms);
+
+    /// append snapshot
+    bool WriteSnapshot(CSnapshot* p_snap);
+
+    /// write frame index and close the file
+    bool Close(void);
+
+    /// export all snapshots from all segments of the trajectory
+    bool ExportTrajectory(CTrajectory* p_traj,const QString& name);
+
+// section of private data -----------------------------------------------------
+private:
+    QFile           File;
+    int             NumOfAtoms;
+    bool            Compressed;
+    double          Precision;
+    QVector<qint64> FrameOffsets;
+    QByteArray      Buffer;
+
+    /// append little endian items to the buffer
+    void AppendUInt32(quint32 value);
+    void AppendUInt64(quint64 value);
+
+    /// append zigzag varint to the buffer
+    void AppendVarInt(qint64 value);
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,145 @@
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <PDBQTPoseTable.hpp>
+#include <algorithm>
+
+//------------------------------------------------------------------------------
+
+class CPDBQTPoseLess {
+public:
+    CPDBQTPoseLess(const QVector<double>& values,bool ascending)
+        : Values(values), Ascending(ascending) {}
+
+    bool operator()(int left,int right) const {
+        if( Ascending ) return(Values[left] < Values[right]);
+        return(Values[right] < Values[left]);
+    }
+
+private:
+    const QVector<double>&  Values;
+    bool                    Ascending;
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CPDBQTPoseTable::CPDBQTPoseTable(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CPDBQTPoseTable::Clear(void)
+{
+    Model.clear();
+    VinaScore.clear();
+    RMSDLower.clear();
+    RMSDUpper.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTPoseTable::AddPose(int model,double score,double rmsd_lb,double rmsd_ub)
+{
+    Model.append(model);
+    VinaScore.append(score);
+    RMSDLower.append(rmsd_lb);
+    RMSDUpper.append(rmsd_ub);
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTPoseTable::Append(const CPDBQTPoseTable& table)
+{
+    Model += table.Model;
+    VinaScore += table.VinaScore;
+    RMSDLower += table.RMSDLower;
+    RMSDUpper += table.RMSDUpper;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CPDBQTPoseTable::GetNumberOfPoses(void) const
+{
+    return(Model.count());
+}
+
+//------------------------------------------------------------------------------
+
+double CPDBQTPoseTable::GetValue(int pose,EPDBQTPoseColumn column) const
+{
+    if( (pose < 0) || (pose >= Model.count()) ) return(0.0);
+
+    switch(column){
+        case EPPC_MODEL:
+            return(Model[pose]);
+        case EPPC_VINA_SCORE:
+            return(VinaScore[pose]);
+        case EPPC_RMSD_LB:
+            return(RMSDLower[pose]);
+        case EPPC_RMSD_UB:
+            return(RMSDUpper[pose]);
+    }
+    return(0.0);
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTPoseTable::GetSortedPoses(EPDBQTPoseColumn column,bool ascending,QVector<int>& poses) const
+{
+    poses.resize(Model.count());
+    for(int i=0; i < poses.count(); i++) poses[i] = i;
+
+    if( column == EPPC_MODEL ){
+        QVector<double> values(Model.count());
+        for(int i=0; i < values.count(); i++) values[i] = Model[i];
+        std::stable_sort(poses.begin(),poses.end(),CPDBQTPoseLess(values,ascending));
+        return;
+    }
+
+    const QVector<double>* p_values = &VinaScore;
+    if( column == EPPC_RMSD_LB ) p_values = &RMSDLower;
+    if( column == EPPC_RMSD_UB ) p_values = &RMSDUpper;
+
+    std::stable_sort(poses.begin(),poses.end(),CPDBQTPoseLess(*p_values,ascending));
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTPoseTable::FilterPoses(double max_score,QVector<int>& poses) const
+{
+    int j = 0;
+    for(int i=0; i < poses.count(); i++){
+        if( VinaScore[poses[i]] > max_score ) continue;
+        poses[j++] = poses[i];
+    }
+    poses.resize(j);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
@@ -0,0 +1,80 @@
+#ifndef PDBQTPoseTableH
+#define PDBQTPoseTableH
+// =============================================================================
+// NEMESIS - Molecular Modelling Package
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2012 Petr Kulhanek, kulhanek@chemi.muni.cz
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+
+#include <NemesisCoreMainHeader.hpp>
+#include <QVector>
+
+// -----------------------------------------------------------------------------
+
+/// columns of the pose table
+enum EPDBQTPoseColumn {
+    EPPC_MODEL          = 0,
+    EPPC_VINA_SCORE     = 1,
+    EPPC_RMSD_LB        = 2,
+    EPPC_RMSD_UB        = 3
+};
+
+// -----------------------------------------------------------------------------
+
+///  docking pose metadata stored by columns
+/*! poses are indexed from 0, the pose index is equal to the snapshot index - 1
+*/
+
+class NEMESIS_CORE_PACKAGE CPDBQTPoseTable {
+public:
+// constructor -----------------------------------------------------------------
+    CPDBQTPoseTable(void);
+
+// executive methods -----------------------------------------------------------
+    /// remove all poses
+    void Clear(void);
+
+    /// add pose
+    void AddPose(int model,double score,double rmsd_lb,double rmsd_ub);
+
+    /// append all poses from other table
+    void Append(const CPDBQTPoseTable& table);
+
+// information methods ---------------------------------------------------------
+    /// get number of poses
+    int GetNumberOfPoses(void) const;
+
+    /// get column value as double
+    double GetValue(int pose,EPDBQTPoseColumn column) const;
+
+    /// return pose indexes sorted by the column, the sort is stable
+    void GetSortedPoses(EPDBQTPoseColumn column,bool ascending,QVector<int>& poses) const;
+
+    /// remove poses with the score above the limit, the order of remaining poses is kept
+    void FilterPoses(double max_score,QVector<int>& poses) const;
+
+public:
+    QVector<int>        Model;          // model number from the MODEL record
+    QVector<double>     VinaScore;      // in kcal/mol
+    QVector<double>     RMSDLower;      // RMSD lower bound
+    QVector<double>     RMSDUpper;      // RMSD upper bound
+};
+
+// -----------------------------------------------------------------------------
+
+#endif
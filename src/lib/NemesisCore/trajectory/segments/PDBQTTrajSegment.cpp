@@ -18,9 +18,12 @@
 //     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 // =============================================================================
 
-#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
 
 #include <NemesisCoreModule.hpp>
+#include <TrajectorySegmentJob.hpp>
 
 #include <XMLElement.hpp>
 #include <ErrorSystem.hpp>
@@ -66,7 +69,8 @@ QObject* PDBQTTrajSegmentCB(void* p_data)
 CPDBQTTrajSegment::CPDBQTTrajSegment(CTrajectory* p_traj)
     : CTrajectorySegment(&PDBQTTrajSegmentObject,p_traj,true)
 {
-
+    FileData = NULL;
+    FileSize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -74,11 +78,8 @@ CPDBQTTrajSegment::CPDBQTTrajSegment(CTrajectory* p_traj)
 CPDBQTTrajSegment::~CPDBQTTrajSegment(void)
 {
     // tidy up
-    foreach(CSnapshot* p_snap, Snapshots){
-        delete p_snap;
-    }
-
-    Snapshots.clear();
+    AbortTrajectoryDataLoading();
+    ClearSnapshots();
 }
 
 //==============================================================================
@@ -100,13 +101,7 @@ bool CPDBQTTrajSegment::IsSnapshotActive (CSnapshot* p_snap)
     if (p_curr_snap == NULL) {
         return (false);
     }
-    int curr_indx = int(p_curr_snap->GetProperty(0) );
-    int snap_indx = int(p_snap->GetProperty(0) );
-    if (curr_indx == snap_indx) {
-        return (true);
-    } else {
-        return (false);
-    }
+    return( p_curr_snap == p_snap );
 }
 
 //------------------------------------------------------------------------------
@@ -121,128 +116,309 @@ CSnapshot* CPDBQTTrajSegment::GetCurrentSnapshot(void)
 
 //------------------------------------------------------------------------------
 
+bool CPDBQTTrajSegment::CopySnapshot(long int index,CSnapshot* p_snap)
+{
+    if( p_snap == NULL ) return(false);
+    if( (index < 1) || (index > Snapshots.count()) ) return(false);
+    p_snap->CopyFrom(Snapshots.at(index-1));
+
+    // pose metadata are not stored in snapshots
+    p_snap->SetProperty(EPPC_MODEL,Poses.Model[index-1]);
+    p_snap->SetProperty(EPPC_VINA_SCORE,Poses.VinaScore[index-1]);
+    p_snap->SetProperty(EPPC_RMSD_LB,Poses.RMSDLower[index-1]);
+    p_snap->SetProperty(EPPC_RMSD_UB,Poses.RMSDUpper[index-1]);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 long int CPDBQTTrajSegment::GetSnapshotIndex(CSnapshot* p_snap)
 {
     // determine snapshot index in pdbqt segment
     return(Snapshots.indexOf(p_snap));
 }
 
+//------------------------------------------------------------------------------
+
+const CPDBQTPoseTable& CPDBQTTrajSegment::GetPoseTable(void) const
+{
+    return(Poses);
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-void CPDBQTTrajSegment::LoadTrajectoryData(void)
+bool CPDBQTTrajSegment::CanLoadTrajectoryDataInBackground(void)
 {
-    // load pdbqt results file from Autodock vina
-    std::ifstream   sin;
+    return(true);
+}
 
-    sin.open(FileName.toLatin1());
-    if( !sin ) {
+//------------------------------------------------------------------------------
+
+
+bool CPDBQTTrajSegment::BeginTrajectoryDataLoading(void)
+{
+    if( Snapshots.count() > 0 ){
+        ClearSnapshots();
+        // release the snapshot from the structure
+        GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+    }
+
+    // load pdbqt results file from Autodock vina
+    File.setFileName(FileName);
+    if( File.open(QIODevice::ReadOnly) == false ) {
         CSmallString error;
         error << tr("unable open trajectory segment") << " '" << FileName << "'";
         GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-        return;
+        return(false);
     }
 
-    // read snapshots
-    int i = 1;
-    while( sin.eof() == false ){
-        CSnapshot* p_snap = new CSnapshot(this);
-        p_snap->InitSnapshot();
-        if( ReadSnapshot(sin,p_snap,i) == true ) {
-            Snapshots.append(p_snap);
-        } else {
-            delete p_snap;
-            break;
+    FileSize = File.size();
+    FileData = NULL;
+    if( FileSize > 0 ){
+        FileData = reinterpret_cast<const char*>(File.map(0,FileSize));
+        if( FileData == NULL ){
+            File.close();
+            CSmallString error;
+            error << tr("unable to map trajectory segment") << " '" << FileName << "'";
+            GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+            return(false);
         }
-        i++;
     }
 
-    // notify about changes
-    MoveToSnapshot(1);
-    GetTrajectory()->EmitOnTrajectorySegmentsChanged();
-    sin.close();
-    return;
-}
-
-//------------------------------------------------------------------------------
-
-bool CPDBQTTrajSegment::ReadSnapshot(std::istream& sin,CSnapshot* p_snap,int snap)
-{
-    int natoms = 0;
-    int nmodel = 0;
-    // Score in kcal/mol
-    double vina_score = 0.0;
-    //rmsd/lb (RMSD lower bound) and rmsd/ub (RMSD upper bound)
-    double rmsd_lb, rmsd_ub;
-
-    std::string model, get_remark, get_vina, get_result;
-    // read header
-    sin >> model >> nmodel;
-    if( sin.eof() == true ) return(false); // no data
-
-    // read info about pose
-    sin >> get_remark >> get_vina >> get_result >> vina_score >> rmsd_lb >> rmsd_ub;
-    p_snap->SetProperty(0,nmodel);
-    p_snap->SetProperty(1,vina_score);
-    p_snap->SetProperty(2,rmsd_lb);
-    p_snap->SetProperty(3,rmsd_ub);
-    // read end of line from parsed line
-    std::string end_of_line;
-    getline(sin,end_of_line);
-
-    // read model data
-    std::string line;
-    while ((getline(sin,line).good()))
-    {
-        if (line.length() == 0)
-        {
-            // skip the empty line
-            continue;
-        }
-        if (line.length() < 3)
-        {
+    LoadingError.clear();
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CPDBQTTrajSegment::ReadTrajectoryData(CTrajectorySegmentJob* p_job)
+{
+    if( FileData == NULL ) return(true);
+
+    const char* p_cur = FileData;
+    const char* p_end = FileData + FileSize;
+
+    int                 natoms = GetNumberOfAtoms();
+    int                 snap = 0;
+    int                 iatom = 0;
+    CSnapshot*          p_snap = NULL;
+    int                 model = 0;
+    double              score = 0.0;
+    double              rmsd_lb = 0.0;
+    double              rmsd_ub = 0.0;
+    QList<CSnapshot*>   snaps;
+    CPDBQTPoseTable     poses;
+
+    while( p_cur < p_end ){
+        // line without the end of line characters
+        const char* p_eol = static_cast<const char*>(memchr(p_cur,'\n',p_end-p_cur));
+        if( p_eol == NULL ) p_eol = p_end;
+        const char* p_line = p_cur;
+        int len = p_eol - p_cur;
+        if( (len > 0) && (p_line[len-1] == '\r') ) len--;
+        p_cur = p_eol < p_end ? p_eol + 1 : p_end;
+
+        if( len == 0 ) continue;    // skip the empty line
+        if( len < 3 ){
             CSmallString error;
             error << tr("ERROR: not a valid PDBQT file") << " '" << FileName << "'";
-            GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-            return (false);
+            LoadingError = QString(error);
+            break;
         }
 
-        if (EQn(line.c_str(),"REMARK",6)) {continue;}
+        bool is_atom = IsRecord(p_line,len,"ATOM") || IsRecord(p_line,len,"HETATM");
+
+        // start of pose, the MODEL record is optional for single pose files
+        if( (p_snap == NULL) && (IsRecord(p_line,len,"MODEL") || is_atom) ){
+            snap++;
+            p_snap = new CSnapshot(this);
+            p_snap->InitSnapshot();
+            iatom = 0;
+            model = snap;
+            score = 0.0;
+            rmsd_lb = 0.0;
+            rmsd_ub = 0.0;
+            if( is_atom == false ){
+                double value;
+                if( ReadNumber(p_line+5,p_line+len,value) != NULL ) model = int(value);
+                continue;
+            }
+        }
 
-        if (EQn(line.c_str(),"ROOT",4)) {continue;}
-        if (EQn(line.c_str(),"ENDROOT",7)) {continue;}
-        if (EQn(line.c_str(),"BRANCH",6)) {continue;}
-        if (EQn(line.c_str(),"ENDBRANCH",9)) {continue;}
-        if (EQn(line.c_str(),"TORSDOF",7)) {continue;}
+        if( p_snap == NULL ) continue;
 
-        if (EQn(line.c_str(),"ENDMDL",6)) {break;}
+        if( IsRecord(p_line,len,"REMARK VINA RESULT:") ){
+            const char* p_num = p_line + 19;
+            const char* p_lend = p_line + len;
+            if( (p_num = ReadNumber(p_num,p_lend,score)) != NULL ){
+                if( (p_num = ReadNumber(p_num,p_lend,rmsd_lb)) != NULL ){
+                    ReadNumber(p_num,p_lend,rmsd_ub);
+                }
+            }
+            continue;
+        }
 
-        if (EQn(line.c_str(),"ATOM",4) || EQn(line.c_str(),"HETATM",6))
-        {
-            std::stringstream sstr(line);
-            int order, nres;
-            std::string label,symbol, res;
-            // read n atom properties
+        if( is_atom ){
+            if( iatom >= natoms ){
+                CSmallString error;
+                error << tr("unable read snapshot") << " '" << snap << "' (inconsistent number of atoms)";
+                LoadingError = QString(error);
+                break;
+            }
+            // x, y, z are in columns 31-38, 39-46, and 47-54
             CPoint pos;
-            sstr >> label >> order >> symbol >> res >> nres >> pos.x >> pos.y >> pos.z;
-            p_snap->SetPos(natoms,pos);
+            bool result = ReadField(p_line,len,30,8,pos.x);
+            result = result && ReadField(p_line,len,38,8,pos.y);
+            result = result && ReadField(p_line,len,46,8,pos.z);
+            if( result == false ){
+                CSmallString error;
+                error << tr("unable read snapshot") << " '" << snap << "' (illegal atom record)";
+                LoadingError = QString(error);
+                break;
+            }
+            p_snap->SetPos(iatom,pos);
+            iatom++;
+            continue;
+        }
+
+        if( IsRecord(p_line,len,"ENDMDL") ){
+            if( iatom != natoms ){
+                CSmallString error;
+                error << tr("unable read snapshot") << " '" << snap << "' (inconsistent number of atoms)";
+                LoadingError = QString(error);
+                break;
+            }
+            snaps.append(p_snap);
+            poses.AddPose(model,score,rmsd_lb,rmsd_ub);
+            p_snap = NULL;
+
+            // publish snapshots in blocks
+            if( (p_job != NULL) && (snaps.count() >= 64) ){
+                FlushPendingSnapshots(snaps,poses);
+                p_job->NotifyProgress(int(100*(p_cur - FileData)/FileSize));
+                if( p_job->IsTerminated() ) break;
+            }
         }
-        natoms++;
     }
 
-    if (natoms != GetTrajectory()->GetStructure()->GetAtoms()->GetNumberOfAtoms())
-    {
-        CSmallString error;
-        error << tr("unable read snapshot") << " '" << snap << "' (inconsistent number of atoms)";
-        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-        return(false);
+    // the last pose without the ENDMDL record
+    if( (p_snap != NULL) && LoadingError.isEmpty() && (iatom == natoms) && (iatom > 0) ){
+        snaps.append(p_snap);
+        poses.AddPose(model,score,rmsd_lb,rmsd_ub);
+        p_snap = NULL;
     }
-    return( sin.fail() == false );
+    delete p_snap;
+
+    FlushPendingSnapshots(snaps,poses);
 
+    if( (p_job != NULL) && p_job->IsTerminated() ) return(false);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CPDBQTTrajSegment::PublishTrajectoryData(void)
+{
+    QMutexLocker lock(&LoadingMutex);
+
+    if( PendingSnapshots.count() == 0 ) return(false);
+
+    Snapshots += PendingSnapshots;
+    PendingSnapshots.clear();
+    Poses.Append(PendingPoses);
+    PendingPoses.Clear();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegment::EndTrajectoryDataLoading(bool result)
+{
+    if( FileData != NULL ){
+        File.unmap(reinterpret_cast<uchar*>(const_cast<char*>(FileData)));
+        FileData = NULL;
+    }
+    File.close();
+    FileSize = 0;
+
+    if( LoadingError.isEmpty() == false ){
+        GetProject()->TextNotification(ETNT_ERROR,LoadingError,ETNT_ERROR_DELAY);
+        LoadingError.clear();
+    }
+
+    // notify about changes
+    MoveToSnapshot(1);
+    GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegment::ClearSnapshots(void)
+{
+    foreach(CSnapshot* p_snap, Snapshots){
+        delete p_snap;
+    }
+    Snapshots.clear();
+    Poses.Clear();
+
+    foreach(CSnapshot* p_snap, PendingSnapshots){
+        delete p_snap;
+    }
+    PendingSnapshots.clear();
+    PendingPoses.Clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegment::FlushPendingSnapshots(QList<CSnapshot*>& snaps,CPDBQTPoseTable& poses)
+{
+    if( snaps.count() == 0 ) return;
+
+    LoadingMutex.lock();
+    PendingSnapshots += snaps;
+    PendingPoses.Append(poses);
+    LoadingMutex.unlock();
+
+    snaps.clear();
+    poses.Clear();
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
+bool CPDBQTTrajSegment::IsRecord(const char* p_line,int len,const char* p_name)
+{
+    int nlen = strlen(p_name);
+    if( len < nlen ) return(false);
+    return( strncmp(p_line,p_name,nlen) == 0 );
+}
+
+//------------------------------------------------------------------------------
+
+bool CPDBQTTrajSegment::ReadField(const char* p_line,int len,int first,int width,double& value)
+{
+    if( first >= len ) return(false);
+    if( first + width > len ) width = len - first;
+
+    // the mapped data are not null terminated, thus copy the field
+    char    buffer[32];
+    int     blen = 0;
+    for(int i=first; i < first + width; i++){
+        if( (p_line[i] == ' ') || (p_line[i] == '\t') ) continue;
+        buffer[blen++] = p_line[i];
+    }
+    if( blen == 0 ) return(false);
+    buffer[blen] = '\0';
+
+    char* p_last = NULL;
+    value = strtod(buffer,&p_last);
+    return(p_last == buffer + blen);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
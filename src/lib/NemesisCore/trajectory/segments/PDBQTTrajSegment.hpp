@@ -20,11 +20,12 @@
 //     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 // =============================================================================
 
-#include <istream>
-
 #include <NemesisCoreMainHeader.hpp>
 #include <TrajectorySegment.hpp>
 #include <Snapshot.hpp>
+#include <PDBQTPoseTable.hpp>
+#include <QMutex>
+#include <QFile>
 
 // -----------------------------------------------------------------------------
 
@@ -33,6 +34,9 @@ class CTrajectory;
 // -----------------------------------------------------------------------------
 
 ///  PDBQT cached trajectory segment
+/*! the file is memory mapped during loading and ATOM/HETATM records are parsed
+    from fixed columns, pose metadata are kept in the pose table
+*/
 
 class NEMESIS_CORE_PACKAGE CPDBQTTrajSegment : public CTrajectorySegment {
 Q_OBJECT
@@ -48,32 +52,51 @@ public:
     /// get current segment
     virtual CSnapshot* GetCurrentSnapshot(void);
 
+    /// copy snapshot with given index into p_snap
+    virtual bool CopySnapshot(long int index,CSnapshot* p_snap);
+
     long int GetSnapshotIndex(CSnapshot* p_snap);
 
     bool IsSnapshotActive (CSnapshot* p_snap);
 
-    // input/output methods --------------------------------------------------------
-    /// load trajectory data
-    virtual void LoadTrajectoryData(void);
+    /// get pose metadata
+    const CPDBQTPoseTable& GetPoseTable(void) const;
 
 // section of private data -----------------------------------------------------
 private:
     QList<CSnapshot*>   Snapshots;
-
-    friend class CPDBQTTrajSegmentModel;
-
-    // read snapshot
-    bool ReadSnapshot(std::istream& sin,CSnapshot* p_snap,int snap);
-
+    CPDBQTPoseTable     Poses;
+
+    // data shared with the loading job
+    QFile               File;
+    const char*         FileData;           // memory mapped file
+    qint64              FileSize;
+    QMutex              LoadingMutex;
+    QList<CSnapshot*>   PendingSnapshots;   // snapshots that are not published yet
+    CPDBQTPoseTable     PendingPoses;
+    QString             LoadingError;
+
+    /// data loading
+    virtual bool CanLoadTrajectoryDataInBackground(void);
+    virtual bool BeginTrajectoryDataLoading(void);
+    virtual bool ReadTrajectoryData(CTrajectorySegmentJob* p_job);
+    virtual bool PublishTrajectoryData(void);
+    virtual void EndTrajectoryDataLoading(bool result);
+
+    /// release all snapshots
+    void ClearSnapshots(void);
+
+    /// move pending snapshots and poses to the loading job
+    void FlushPendingSnapshots(QList<CSnapshot*>& snaps,CPDBQTPoseTable& poses);
+
+    /// does the line start with the record name?
+    static bool IsRecord(const char* p_line,int len,const char* p_name);
+
+    /// read number from fixed columns [first,first+width) of the line
+    static bool ReadField(const char* p_line,int len,int first,int width,double& value);
 };
 
 // -----------------------------------------------------------------------------
 
-#ifndef EQn
-#define EQn(a,b,n) (!strncmp((a), (b), (n)))
-#endif
-
-// -----------------------------------------------------------------------------
-
 #endif
 
@@ -31,6 +31,7 @@
 
 #include <PDBQTTrajSegment.hpp>
 #include <PDBQTTrajSegmentModel.hpp>
+#include <PDBQTPoseTable.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -70,6 +71,10 @@ CPDBQTTrajSegmentModel::CPDBQTTrajSegmentModel(QObject* p_parent)
     : CContainerModel(&PDBQTTrajSegmentModelObject,p_parent)
 {
     RootObject = NULL;
+    SortColumn = -1;
+    SortOrder = Qt::AscendingOrder;
+    FilterEnabled = false;
+    FilterMaxScore = 0.0;
 }
 
 //------------------------------------------------------------------------------
@@ -87,9 +92,13 @@ void CPDBQTTrajSegmentModel::SetRootObject(CPDBQTTrajSegment *p_data)
 
         connect(RootObject->GetTrajectory(),SIGNAL(OnSnapshotChanged(void)),
                 this,SLOT(ListChanged()));
+
+        connect(RootObject->GetTrajectory(),SIGNAL(OnTrajectorySegmentsChanged(void)),
+                this,SLOT(ListChanged()));
     }
         // FIXME
     beginResetModel();
+    UpdateRows();
     endResetModel();
 }
 
@@ -98,8 +107,54 @@ void CPDBQTTrajSegmentModel::SetRootObject(CPDBQTTrajSegment *p_data)
 QObject* CPDBQTTrajSegmentModel::GetItem(const QModelIndex& index) const
 {
     if( ! index.isValid() ) return(NULL);
-    CPDBQTTrajSegment* p_obj = static_cast<CPDBQTTrajSegment*>(index.internalPointer());
-    return (p_obj);
+    // poses are not objects
+    return(NULL);
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegmentModel::SetScoreFilter(bool enabled,double max_score)
+{
+    FilterEnabled = enabled;
+    FilterMaxScore = max_score;
+
+    beginResetModel();
+    UpdateRows();
+    endResetModel();
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegmentModel::sort(int column,Qt::SortOrder order)
+{
+    SortColumn = column;
+    SortOrder = order;
+
+    beginResetModel();
+    UpdateRows();
+    endResetModel();
+}
+
+//------------------------------------------------------------------------------
+
+void CPDBQTTrajSegmentModel::UpdateRows(void)
+{
+    Rows.clear();
+    if( RootObject == NULL ) return;
+
+    const CPDBQTPoseTable& poses = RootObject->GetPoseTable();
+
+    if( (SortColumn >= EPPC_MODEL) && (SortColumn <= EPPC_RMSD_UB) ){
+        poses.GetSortedPoses(static_cast<EPDBQTPoseColumn>(SortColumn),
+                             SortOrder == Qt::AscendingOrder,Rows);
+    } else {
+        Rows.resize(poses.GetNumberOfPoses());
+        for(int i=0; i < Rows.count(); i++) Rows[i] = i;
+    }
+
+    if( FilterEnabled ){
+        poses.FilterPoses(FilterMaxScore,Rows);
+    }
 }
 
 //==============================================================================
@@ -148,7 +203,7 @@ int CPDBQTTrajSegmentModel::columnCount(const QModelIndex &parent) const
 int CPDBQTTrajSegmentModel::rowCount(const QModelIndex &parent) const
 {
     if( RootObject == 0 ) return(0);
-    return( RootObject->Snapshots.count() );
+    return( Rows.count() );
 }
 
 //------------------------------------------------------------------------------
@@ -160,8 +215,8 @@ QModelIndex CPDBQTTrajSegmentModel::index(int row, int column,
 
     if( ! hasIndex(row, column, parent) ) return( QModelIndex() );
     if( parent.isValid() )  return( QModelIndex() );
-    // snapshots are numered from 0 id QList and row is from 0 too
-    QModelIndex index = createIndex(row, column, RootObject->Snapshots[row]);
+    // pose index is stored in the index, it is equal to the snapshot index - 1
+    QModelIndex index = createIndex(row, column, (quintptr)Rows[row]);
     return(index);
 }
 
@@ -180,25 +235,31 @@ QVariant CPDBQTTrajSegmentModel::data(const QModelIndex &index, int role) const
     if( RootObject == NULL ) return( QVariant() );
     if( ! index.isValid() ) return( QVariant() );
 
-    CSnapshot* p_obj = static_cast<CSnapshot*>(index.internalPointer());
+    const CPDBQTPoseTable& poses = RootObject->GetPoseTable();
+    int pose = index.internalId();
+    if( (pose < 0) || (pose >= poses.GetNumberOfPoses()) ) return( QVariant() );
+    bool active = RootObject->GetCurrentSnapshotIndex() == pose + 1;
 
     switch(role) {
         case Qt::DisplayRole: {
             switch( index.column() ) {
                 case 0:
-                    return(p_obj->GetProperty(0) );
+                    return(poses.Model[pose]);
                 case 1:
-                    return(PQ_ENERGY->GetRealValueText(p_obj->GetProperty(1) ) );
+                    return(PQ_ENERGY->GetRealValueText(poses.VinaScore[pose]) );
                 case 2:
-                    return(PQ_DISTANCE->GetRealValueText(p_obj->GetProperty(2) ) );
+                    return(PQ_DISTANCE->GetRealValueText(poses.RMSDLower[pose]) );
                 case 3:
-                    return(PQ_DISTANCE->GetRealValueText(p_obj->GetProperty(3) ) );
+                    return(PQ_DISTANCE->GetRealValueText(poses.RMSDUpper[pose]) );
                 default:
                     return( QVariant() );
             }
         }
         break;
 
+        case PDBQT_SNAPSHOT_INDEX_ROLE:
+            return(pose + 1);
+
         case Qt::TextAlignmentRole:
             switch( index.column() ) {
                 case 0:
@@ -217,7 +278,7 @@ QVariant CPDBQTTrajSegmentModel::data(const QModelIndex &index, int role) const
         case Qt::DecorationRole: {
             switch( index.column() ) {
                 case 0:{
-                    if( RootObject->IsSnapshotActive(p_obj) ){
+                    if( active ){
                         return(QIcon(":/images/NemesisCore/models/active.svg"));
                     } else {
                         return(QIcon(":/images/NemesisCore/models/notactive.svg"));
@@ -234,7 +295,7 @@ QVariant CPDBQTTrajSegmentModel::data(const QModelIndex &index, int role) const
            switch( index.column() ) {
            // for every of columns will check if is snaphot active
            default:
-               if( RootObject->IsSnapshotActive(p_obj) ){
+               if( active ){
                    QFont boldFont;
                    boldFont.setBold(true);
                    return boldFont;
@@ -264,6 +325,7 @@ void CPDBQTTrajSegmentModel::RootObjectDeleted(void)
     RootObject = NULL;
         // FIXME
     beginResetModel();
+    UpdateRows();
     endResetModel();
 }
 
@@ -273,6 +335,7 @@ void CPDBQTTrajSegmentModel::ListChanged(void)
 {
         // FIXME
     beginResetModel();
+    UpdateRows();
     endResetModel();
 }
 
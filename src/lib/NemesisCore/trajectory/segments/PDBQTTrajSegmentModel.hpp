@@ -22,6 +22,7 @@
 
 #include <NemesisCoreMainHeader.hpp>
 #include <ContainerModel.hpp>
+#include <QVector>
 
 // -----------------------------------------------------------------------------
 
@@ -32,7 +33,12 @@ class CPDBQTTrajSegment;
 
 // -----------------------------------------------------------------------------
 
+// data role providing the snapshot index of the row
+#define PDBQT_SNAPSHOT_INDEX_ROLE   Qt::UserRole
 
+// -----------------------------------------------------------------------------
+
+/// model of poses, rows are sorted and filtered by the pose table of the segment
 
 class NEMESIS_CORE_PACKAGE CPDBQTTrajSegmentModel : public CContainerModel {
 Q_OBJECT
@@ -46,9 +52,23 @@ public:
     /// return object item from model index
     virtual QObject* GetItem(const QModelIndex& index) const;
 
+    /// show only poses with the score lower or equal to max_score (internal units)
+    void SetScoreFilter(bool enabled,double max_score);
+
+    /// sort poses by the column
+    virtual void sort(int column,Qt::SortOrder order = Qt::AscendingOrder);
+
     // section of private data ----------------------------------------------------
 private:
     CPDBQTTrajSegment*    RootObject;
+    QVector<int>          Rows;           // row -> pose index
+    int                   SortColumn;     // -1 for the file order
+    Qt::SortOrder         SortOrder;
+    bool                  FilterEnabled;
+    double                FilterMaxScore;
+
+    /// update row to pose mapping
+    void UpdateRows(void);
 
     QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const;
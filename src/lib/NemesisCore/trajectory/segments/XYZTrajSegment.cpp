@@ -22,12 +22,17 @@
 #include <XMLElement.hpp>
 #include <ErrorSystem.hpp>
 #include <Project.hpp>
-#include <fstream>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <Structure.hpp>
 #include <AtomList.hpp>
 
 #include <XYZTrajSegment.hpp>
+#include <SnapshotIndex.hpp>
+#include <TrajectorySegmentJob.hpp>
 #include <NemesisCoreModule.hpp>
+#include <SnapshotCache.hpp>
 
 //------------------------------------------------------------------------------
 
@@ -63,16 +68,18 @@ QObject* XYZTrajSegmentCB(void* p_data)
 CXYZTrajSegment::CXYZTrajSegment(CTrajectory* p_traj)
     : CTrajectorySegment(&XYZTrajSegmentObject,p_traj,true)
 {
+    FileData = NULL;
+    FileSize = 0;
+    PendingEnd = 0;
+    IndexLoaded = false;
 }
 
 //------------------------------------------------------------------------------
 
 CXYZTrajSegment::~CXYZTrajSegment(void)
 {
-    foreach(CSnapshot* p_snap, Snapshots){
-        delete p_snap;
-    }
-    Snapshots.clear();
+    AbortTrajectoryDataLoading();
+    CloseTrajectoryData();
 }
 
 //==============================================================================
@@ -81,91 +88,285 @@ CXYZTrajSegment::~CXYZTrajSegment(void)
 
 long int CXYZTrajSegment::GetNumberOfSnapshots(void)
 {
-    return(Snapshots.count());
+    if( FrameOffsets.count() < 2 ) return(0);
+    return(FrameOffsets.count() - 1);
 }
 
 //------------------------------------------------------------------------------
 
 CSnapshot* CXYZTrajSegment::GetCurrentSnapshot(void)
 {
-    if( (SnapshotIndex < 1) || (SnapshotIndex > Snapshots.count()) ) return(NULL);
-    return(Snapshots.at(SnapshotIndex-1));
+    if( (SnapshotIndex < 1) || (SnapshotIndex > GetNumberOfSnapshots()) ) return(NULL);
+
+    CSnapshotCache* p_cache = GetTrajectory()->GetSnapshotCache();
+    CSnapshot* p_snap = p_cache->Find(this,SnapshotIndex);
+    if( p_snap != NULL ) return(p_snap);
+
+    // decode snapshot from the file
+    p_snap = new CSnapshot(this);
+    p_snap->InitSnapshot();
+    if( ReadSnapshot(SnapshotIndex,p_snap) == false ){
+        delete p_snap;
+        CSmallString error;
+        error << tr("unable read snapshot") << " '" << SnapshotIndex << "' (corrupted data)";
+        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+        return(NULL);
+    }
+    p_cache->Insert(this,SnapshotIndex,p_snap);
+
+    return(p_snap);
+}
+
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::CopySnapshot(long int index,CSnapshot* p_snap)
+{
+    if( p_snap == NULL ) return(false);
+    // decode directly, the cache must keep the current snapshot
+    return( ReadSnapshot(index,p_snap) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::CanPrefetchSnapshots(void)
+{
+    // ReadSnapshot uses only the mapped file and the frame index
+    return(true);
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-void CXYZTrajSegment::LoadTrajectoryData(void)
+bool CXYZTrajSegment::CanLoadTrajectoryDataInBackground(void)
 {
-    std::ifstream   sin;
+    return(true);
+}
 
-    sin.open(FileName.toLatin1());
-    if( !sin ) {
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::BeginTrajectoryDataLoading(void)
+{
+    bool had_data = FrameOffsets.count() > 0;
+    CloseTrajectoryData();
+    if( had_data ){
+        // release the snapshot from the structure
+        GetTrajectory()->EmitOnTrajectorySegmentsChanged();
+    }
+
+    File.setFileName(FileName);
+    if( File.open(QIODevice::ReadOnly) == false ) {
         CSmallString error;
         error << tr("unable open trajectory segment") << " '" << FileName << "'";
         GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-        return;
+        return(false);
     }
 
-    // read snapshots
-    int i = 1;
-    while( sin.eof() == false ){
-        CSnapshot* p_snap = new CSnapshot(this);
-        p_snap->InitSnapshot();
-        if( ReadSnapshot(sin,p_snap,i) == true ) {
-            Snapshots.append(p_snap);
-        } else {
-            delete p_snap;
-            break;
+    FileSize = File.size();
+    if( FileSize > 0 ){
+        FileData = reinterpret_cast<const char*>(File.map(0,FileSize));
+        if( FileData == NULL ){
+            CSmallString error;
+            error << tr("unable map trajectory segment") << " '" << FileName << "'";
+            GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
+            CloseTrajectoryData();
+            return(false);
         }
-        i++;
     }
 
+    // try the sidecar index first
+    CSnapshotIndex index;
+    if( index.Load(FileName,GetNumberOfAtoms(),FileData,FileSize) ){
+        FrameOffsets = index.GetOffsets();
+        IndexLoaded = true;
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::ReadTrajectoryData(CTrajectorySegmentJob* p_job)
+{
+    if( IndexLoaded ) return(true);
+    return( IndexSnapshots(p_job) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::PublishTrajectoryData(void)
+{
+    QMutexLocker lock(&LoadingMutex);
+
+    if( PendingOffsets.count() == 0 ) return(false);
+
+    // replace terminal record
+    if( FrameOffsets.count() > 0 ) FrameOffsets.removeLast();
+    FrameOffsets += PendingOffsets;
+    FrameOffsets.append(PendingEnd);
+    PendingOffsets.clear();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CXYZTrajSegment::EndTrajectoryDataLoading(bool result)
+{
+    if( LoadingError.isEmpty() == false ){
+        GetProject()->TextNotification(ETNT_ERROR,LoadingError,ETNT_ERROR_DELAY);
+    }
+
+    // store index for the next time
+    if( result && (IndexLoaded == false) && LoadingError.isEmpty() && (FrameOffsets.count() > 0) ){
+        CSnapshotIndex::SaveInBackground(FileName,GetNumberOfAtoms(),FrameOffsets,FileData,FileSize);
+    }
+
+    LoadingError.clear();
+
     // notify about changes
     GetTrajectory()->EmitOnTrajectorySegmentsChanged();
 }
 
 //------------------------------------------------------------------------------
 
-bool CXYZTrajSegment::ReadSnapshot(std::istream& sin,CSnapshot* p_snap,int snap)
+void CXYZTrajSegment::CloseTrajectoryData(void)
 {
-    int natoms = 0;
+    // the cache and the prefetch worker must not access released data
+    if( GetTrajectory() ) GetTrajectory()->GetSnapshotCache()->RemoveSegment(this);
+    FrameOffsets.clear();
+    PendingOffsets.clear();
+    PendingEnd = 0;
+    IndexLoaded = false;
+    LoadingError.clear();
+    if( FileData != NULL ){
+        File.unmap(reinterpret_cast<uchar*>(const_cast<char*>(FileData)));
+        FileData = NULL;
+    }
+    FileSize = 0;
+    if( File.isOpen() ) File.close();
+}
 
-    // read header
-    sin >> natoms;
-    if( sin.eof() == true ) return(false); // no data
+//------------------------------------------------------------------------------
 
-    // check header
-    if( natoms != GetTrajectory()->GetStructure()->GetAtoms()->GetNumberOfAtoms() ){
-        CSmallString error;
-        error << tr("unable read snapshot") << " '" << snap << "' (inconsistent number of atoms)";
-        GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-        return(false);
-    }
+bool CXYZTrajSegment::IndexSnapshots(CTrajectorySegmentJob* p_job)
+{
+    if( FileData == NULL ) return(true);
 
-    // read comment
-    std::string comment;
-    getline(sin,comment); // end of first line winth number of atoms
-    getline(sin,comment); // comment
+    const char*     p_end = FileData + FileSize;
+    const char*     p_cur = FileData;
+    int             natoms = GetNumberOfAtoms();
+    qint64          last = 0;
+    int             snap = 1;
+    QVector<qint64> offsets;
 
-    for(int i=0; i < natoms; i++){
-        if( sin.eof() == true ) {
+    while( p_cur < p_end ){
+        // skip empty lines between snapshots
+        while( (p_cur < p_end) && isspace(*p_cur) ) p_cur++;
+        if( p_cur >= p_end ) break;
+
+        // read header
+        const char* p_header = p_cur;
+        double      value = 0.0;
+        if( (ReadNumber(p_cur,p_end,value) == NULL) || (int(value) != natoms) ){
+            CSmallString error;
+            error << tr("unable read snapshot") << " '" << snap << "' (inconsistent number of atoms)";
+            LoadingError = QString(error);
+            break;
+        }
+
+        // skip header, comment and atom lines
+        bool complete = true;
+        for(int i=0; i < natoms + 2; i++){
+            if( p_cur >= p_end ){
+                complete = false;
+                break;
+            }
+            p_cur = SkipLine(p_cur,p_end);
+        }
+        if( complete == false ){
             CSmallString error;
             error << tr("unable read snapshot") << " '" << snap << "' (premature end of snapshot)";
-            GetProject()->TextNotification(ETNT_ERROR,QString(error),ETNT_ERROR_DELAY);
-            return(false);
+            LoadingError = QString(error);
+            break;
         }
-        std::string symbol;
+
+        offsets.append(p_header - FileData);
+        last = p_cur - FileData;
+        snap++;
+
+        // publish snapshots in blocks
+        if( (p_job != NULL) && (offsets.count() >= 256) ){
+            FlushSnapshotOffsets(offsets,last);
+            p_job->NotifyProgress(int(100*last/FileSize));
+            if( p_job->IsTerminated() ) return(false);
+        }
+    }
+
+    FlushSnapshotOffsets(offsets,last);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CXYZTrajSegment::FlushSnapshotOffsets(QVector<qint64>& offsets,qint64 last)
+{
+    if( offsets.count() == 0 ) return;
+
+    QMutexLocker lock(&LoadingMutex);
+    PendingOffsets += offsets;
+    PendingEnd = last;
+    offsets.clear();
+}
+
+//------------------------------------------------------------------------------
+
+bool CXYZTrajSegment::ReadSnapshot(long int index,CSnapshot* p_snap)
+{
+    if( (index < 1) || (index > GetNumberOfSnapshots()) ) return(false);
+
+    const char* p_cur = FileData + FrameOffsets[index-1];
+    const char* p_end = FileData + FrameOffsets[index];
+
+    p_cur = SkipLine(p_cur,p_end); // number of atoms
+    p_cur = SkipLine(p_cur,p_end); // comment
+
+    // the snapshot size is used, this can be executed from the prefetch worker
+    int natoms = p_snap->Coordinates.GetLength();
+    for(int i=0; i < natoms; i++){
         CPoint pos;
-        sin >> symbol >> pos.x >> pos.y >> pos.z;
+        p_cur = SkipToken(p_cur,p_end); // symbol
+        if( (p_cur = ReadNumber(p_cur,p_end,pos.x)) == NULL ) return(false);
+        if( (p_cur = ReadNumber(p_cur,p_end,pos.y)) == NULL ) return(false);
+        if( (p_cur = ReadNumber(p_cur,p_end,pos.z)) == NULL ) return(false);
         p_snap->SetPos(i,pos);
+        p_cur = SkipLine(p_cur,p_end);
     }
 
-    return( sin.fail() == false );
+    return(true);
 }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
+const char* CXYZTrajSegment::SkipLine(const char* p_beg,const char* p_end)
+{
+    const char* p_eol = static_cast<const char*>(memchr(p_beg,'\n',p_end-p_beg));
+    if( p_eol == NULL ) return(p_end);
+    return(p_eol + 1);
+}
+
+//------------------------------------------------------------------------------
+
+const char* CXYZTrajSegment::SkipToken(const char* p_beg,const char* p_end)
+{
+    while( (p_beg < p_end) && ((*p_beg == ' ') || (*p_beg == '\t')) ) p_beg++;
+    while( (p_beg < p_end) && (isspace(*p_beg) == 0) ) p_beg++;
+    return(p_beg);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
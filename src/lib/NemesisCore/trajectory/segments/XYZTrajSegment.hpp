@@ -23,7 +23,9 @@
 #include <NemesisCoreMainHeader.hpp>
 #include <TrajectorySegment.hpp>
 #include <Snapshot.hpp>
-#include <istream>
+#include <QFile>
+#include <QVector>
+#include <QMutex>
 
 // -----------------------------------------------------------------------------
 
@@ -31,7 +33,10 @@ class CTrajectory;
 
 // -----------------------------------------------------------------------------
 
-///  XYZ cached trajectory segment
+///  XYZ trajectory segment
+/*! the file is memory mapped and only the frame index is built during loading,
+    snapshots are decoded on demand and kept in a small LRU cache
+*/
 
 class NEMESIS_CORE_PACKAGE CXYZTrajSegment : public CTrajectorySegment {
 Q_OBJECT
@@ -47,16 +52,50 @@ public:
     /// get current segment
     virtual CSnapshot* GetCurrentSnapshot(void);
 
-// input/output methods --------------------------------------------------------
-    /// load trajectory data
-    virtual void LoadTrajectoryData(void);
+    /// copy snapshot with given index into p_snap
+    virtual bool CopySnapshot(long int index,CSnapshot* p_snap);
+
+    /// snapshots can be decoded by the prefetch worker
+    virtual bool CanPrefetchSnapshots(void);
 
 // section of private data -----------------------------------------------------
 private:
-    QList<CSnapshot*>   Snapshots;
+    QFile               File;
+    const char*         FileData;       // memory mapped file
+    qint64              FileSize;
+    QVector<qint64>     FrameOffsets;   // offsets of snapshot headers, the last item is the end of data
+
+    // data shared with the loading job
+    QMutex              LoadingMutex;
+    QVector<qint64>     PendingOffsets; // offsets of snapshot headers that are not published yet
+    qint64              PendingEnd;     // end of the last read snapshot
+    bool                IndexLoaded;    // the index was read from the sidecar file
+    QString             LoadingError;
+
+    /// data loading
+    virtual bool CanLoadTrajectoryDataInBackground(void);
+    virtual bool BeginTrajectoryDataLoading(void);
+    virtual bool ReadTrajectoryData(CTrajectorySegmentJob* p_job);
+    virtual bool PublishTrajectoryData(void);
+    virtual void EndTrajectoryDataLoading(bool result);
+
+    /// unmap the file and release index and cache
+    void CloseTrajectoryData(void);
+
+    /// build frame index
+    bool IndexSnapshots(CTrajectorySegmentJob* p_job);
+
+    /// move snapshot offsets to the pending list
+    void FlushSnapshotOffsets(QVector<qint64>& offsets,qint64 last);
+
+    /// decode snapshot from the mapped file
+    bool ReadSnapshot(long int index,CSnapshot* p_snap);
+
+    /// return position after the end of line
+    const char* SkipLine(const char* p_beg,const char* p_end);
 
-    // read snapshot
-    bool ReadSnapshot(std::istream& sin,CSnapshot* p_snap,int snap);
+    /// return position after the token
+    const char* SkipToken(const char* p_beg,const char* p_end);
 };
 
 // -----------------------------------------------------------------------------
@@ -189,6 +189,7 @@ CMainWindow::CMainWindow(CProject* p_project)
 
     // single bonds
     actionAddBonds = NULL;
+    actionAddBondsToSelectedAtoms = NULL;
     actionRemoveBonds = NULL;
 
     // panels
@@ -329,6 +329,7 @@ public slots:
 
     // single bonds
     void AddBonds(void);
+    void AddBondsToSelectedAtoms(void);
     void RemoveBonds(void);
 
     // panels
@@ -381,6 +382,7 @@ private:
 
     // single bonds
     QAction* actionAddBonds;
+    QAction* actionAddBondsToSelectedAtoms;
     QAction* actionRemoveBonds;
 
     // panels
@@ -344,7 +344,7 @@ void CMainWindow::OpenProject(void)
     QString filename = QFileDialog::getOpenFileName(NULL,
                        tr("Open Project"),
                        (const char*)GlobalSetup->GetLastOpenFilePath(GenericProjectID),
-                       tr("Nemesis projects (*.npr)"));
+                       tr("Nemesis projects (*.npr *.npb)"));
 
     if( filename == NULL ) return; // no file was selected
 
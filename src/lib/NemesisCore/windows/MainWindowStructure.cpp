@@ -85,6 +85,7 @@ void CMainWindow::ConnectStructureMenu(void)
 
     // single bonds
     CONNECT_ACTION(AddBonds);
+    CONNECT_ACTION(AddBondsToSelectedAtoms);
     CONNECT_ACTION(RemoveBonds);
 
     // panels
@@ -149,6 +150,7 @@ void CMainWindow::UpdateStructureMenu(void)
 
     // single bonds
     actionAddBonds->setEnabled(set1);
+    actionAddBondsToSelectedAtoms->setEnabled(set1);
     actionRemoveBonds->setEnabled(set1);
 
     // panels
@@ -523,6 +525,15 @@ void CMainWindow::AddBonds(void)
 
 //------------------------------------------------------------------------------
 
+void CMainWindow::AddBondsToSelectedAtoms(void)
+{
+    CStructure* p_str = Project->GetActiveStructure();
+    if( p_str == NULL ) return;
+    p_str->GetBonds()->AddBondsWH(true,false);
+}
+
+//------------------------------------------------------------------------------
+
 void CMainWindow::RemoveBonds(void)
 {
     CStructure* p_str = Project->GetActiveStructure();
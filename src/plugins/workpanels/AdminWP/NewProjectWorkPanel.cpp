@@ -307,7 +307,7 @@ void CNewProjectWorkPanel::ProjectOpen(void)
     QString filename = QFileDialog::getOpenFileName(NULL,
                        tr("Open Project"),
                        (const char*)GlobalSetup->GetLastOpenFilePath(GenericProjectID),
-                       tr("Nemesis projects (*.npr)"));
+                       tr("Nemesis projects (*.npr *.npb)"));
 
     if( filename == NULL ) return; // no file was selected
 
@@ -32,6 +32,10 @@
 #include <SelectionRequest.hpp>
 #include <AtomListSelection.hpp>
 #include <ResidueListSelection.hpp>
+#include <Trajectory.hpp>
+#include <TrajectorySelection.hpp>
+#include <Atom.hpp>
+#include <Residue.hpp>
 
 #include "SelectByMaskWorkPanel.hpp"
 #include "StandardWPModule.hpp"
@@ -83,6 +87,7 @@ CSelectByMaskWorkPanel::CSelectByMaskWorkPanel(CProject* p_project)
     WidgetUI.setupUi(this);
 
     SelRequest = new CSelectionRequest(this,tr("Select by Mask"));
+    TrajSelection = NULL;
 
     // local events ------------------------------
     connect(WidgetUI.selectNoneTB,SIGNAL(clicked(bool)),
@@ -94,6 +99,9 @@ CSelectByMaskWorkPanel::CSelectByMaskWorkPanel(CProject* p_project)
     connect(WidgetUI.typeTB,SIGNAL(toggled(bool)),
             this,SLOT(TypeChanged(bool)));
     // -------------
+    connect(WidgetUI.trajectoryTB,SIGNAL(toggled(bool)),
+            this,SLOT(TrajectoryChanged(bool)));
+    // -------------
     connect(WidgetUI.executeTB,SIGNAL(clicked(bool)),
             this,SLOT(ExecuteMask(void)));
     // -------------
@@ -109,6 +117,7 @@ CSelectByMaskWorkPanel::CSelectByMaskWorkPanel(CProject* p_project)
 CSelectByMaskWorkPanel::~CSelectByMaskWorkPanel(void)
 {
     SaveWorkPanelSetup();
+    if( TrajSelection ) delete TrajSelection;
     p_selbm_wp = NULL;
 }
 
@@ -118,6 +127,7 @@ CSelectByMaskWorkPanel::~CSelectByMaskWorkPanel(void)
 
 void CSelectByMaskWorkPanel::SelectNone(void)
 {
+    WidgetUI.trajectoryTB->setChecked(false);
     SelRequest->SetRequest(NULL);
     GetProject()->RepaintProject();
 }
@@ -126,6 +136,7 @@ void CSelectByMaskWorkPanel::SelectNone(void)
 
 void CSelectByMaskWorkPanel::ClearMask(void)
 {
+    WidgetUI.trajectoryTB->setChecked(false);
     GetProject()->GetSelection()->ResetSelection();
     GetProject()->RepaintProject();
 }
@@ -153,7 +164,9 @@ void CSelectByMaskWorkPanel::ExecuteMask(void)
         }
     }
     bool result;
-    if( WidgetUI.typeTB->isChecked() ){
+    if( WidgetUI.trajectoryTB->isChecked() ){
+        result = ExecuteTrajectoryMask();
+    } else if( WidgetUI.typeTB->isChecked() ){
         result = GetProject()->GetSelection()->SelectResiduesByMask(WidgetUI.maskLE->text(),EAMT_ASL);
     } else {
         result = GetProject()->GetSelection()->SelectAtomsByMask(WidgetUI.maskLE->text(),EAMT_ASL);
@@ -169,6 +182,79 @@ void CSelectByMaskWorkPanel::ExecuteMask(void)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+bool CSelectByMaskWorkPanel::ExecuteTrajectoryMask(void)
+{
+    if( TrajSelection ){
+        delete TrajSelection;
+        TrajSelection = NULL;
+    }
+
+    CTrajectory* p_traj = GetProject()->GetActiveTrajectory();
+    if( (p_traj == NULL) || (p_traj->GetStructure() == NULL) ){
+        GetProject()->TextNotification(ETNT_ERROR,tr("no active trajectory"),ETNT_ERROR_DELAY);
+        WidgetUI.trajectoryTB->setChecked(false);
+        return(true);
+    }
+
+    TrajSelection = new CTrajectorySelection(p_traj);
+    if( TrajSelection->SetMask(WidgetUI.maskLE->text()) == false ){
+        delete TrajSelection;
+        TrajSelection = NULL;
+        return(false);
+    }
+
+    connect(TrajSelection,SIGNAL(OnSelectionChanged(void)),
+            this,SLOT(TrajectorySelectionChanged(void)));
+
+    // the current snapshot is selected immediately, other frames in the background
+    TrajSelection->EvaluateAll();
+    TrajectorySelectionChanged();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectByMaskWorkPanel::TrajectoryChanged(bool set)
+{
+    if( set ) return;
+    if( TrajSelection == NULL ) return;
+    delete TrajSelection;
+    TrajSelection = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void CSelectByMaskWorkPanel::TrajectorySelectionChanged(void)
+{
+    if( (TrajSelection == NULL) || (! SelRequest->IsAttached()) ) return;
+
+    // selected objects of the previous snapshot are replaced
+    GetProject()->GetSelection()->ResetSelection();
+
+    QList<CSelObject> objs;
+    if( WidgetUI.typeTB->isChecked() ){
+        QSet<CResidue*> residues;
+        foreach(CAtom* p_atom,TrajSelection->GetCurrentAtoms()){
+            CResidue* p_res = p_atom->GetResidue();
+            if( (p_res == NULL) || residues.contains(p_res) ) continue;
+            residues.insert(p_res);
+            objs.append(CSelObject(p_res,0));
+        }
+    } else {
+        foreach(CAtom* p_atom,TrajSelection->GetCurrentAtoms()){
+            objs.append(CSelObject(p_atom,0));
+        }
+    }
+    GetProject()->GetSelection()->RegisterObjects(objs);
+
+    GetProject()->RepaintProject();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 
 
 
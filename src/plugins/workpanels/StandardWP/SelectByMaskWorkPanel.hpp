@@ -29,6 +29,7 @@
 // -----------------------------------------------------------------------------
 
 class CSelectionRequest;
+class CTrajectorySelection;
 
 // -----------------------------------------------------------------------------
 
@@ -43,12 +44,18 @@ public:
 private:
     Ui::SelectByMaskWorkPanel   WidgetUI;
     CSelectionRequest*          SelRequest;
+    CTrajectorySelection*       TrajSelection;  // mask followed over the active trajectory
+
+    /// evaluate mask for all snapshots of the active trajectory
+    bool ExecuteTrajectoryMask(void);
 
 private slots:
     void SelectNone(void);
     void ClearMask(void);
     void TypeChanged(bool set);
     void ExecuteMask(void);
+    void TrajectoryChanged(bool set);
+    void TrajectorySelectionChanged(void);
 };
 
 // -----------------------------------------------------------------------------